@@ -6,6 +6,7 @@ include( CheckFunctionExists )
 include( CheckLibraryExists )
 include( CheckIncludeFile )
 include( CheckCXXSourceRuns )
+include( CheckCXXSourceCompiles )
 include( XRootDUtils )
 
 #-------------------------------------------------------------------------------
@@ -30,6 +31,11 @@ endif()
 check_include_file( shadow.h HAVE_SHADOWPW )
 compiler_define_if_found( HAVE_SHADOWPW HAVE_SHADOWPW )
 
+check_cxx_source_compiles(
+  "#include <linux/io_uring.h>
+   int main() { return IORING_OP_READ; }" HAVE_IOURING )
+compiler_define_if_found( HAVE_IOURING HAVE_IOURING )
+
 #-------------------------------------------------------------------------------
 # Some socket related functions
 #-------------------------------------------------------------------------------
@@ -34,6 +34,7 @@
 #endif
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/types.h>
 
 #include "XrdOuc/XrdOucUtils.hh"
@@ -46,6 +47,45 @@
 #define XRD_TRACE XrdTrace->
 #include "Xrd/XrdTrace.hh"
 
+/******************************************************************************/
+/*                         L o c a l   C l a s s e s                          */
+/******************************************************************************/
+
+// Each thread that obtains or releases a buffer gets a small cache of buffers
+// per bucket (a magazine) that it alone uses. Most obtain/release pairs are
+// then satisfied without locking the buckets. The reshaper trims the caches
+// by bumping the generation number which makes each thread return its cached
+// buffers to the buckets. A thread's cache is also returned when it exits.
+//
+class XrdBuffTCache
+{
+public:
+
+static void Done(void *tcP)
+                {XrdBuffTCache *tP = static_cast<XrdBuffTCache *>(tcP);
+                 tP->bMan->tcDone(tP);
+                }
+
+XrdBuffTCache  *next;
+XrdBuffTCache  *prev;
+XrdBuffManager *bMan;
+XrdBuffer      *bnext[XRD_BUCKETS];
+int             numbuf[XRD_BUCKETS];
+long long       hits[XRD_BUCKETS];
+long long       miss[XRD_BUCKETS];
+int             memsz;
+int             gen;
+
+                XrdBuffTCache(XrdBuffManager *bmP, int cgen)
+                             : next(0), prev(0), bMan(bmP), memsz(0), gen(cgen)
+                             {memset(bnext,  0, sizeof(bnext));
+                              memset(numbuf, 0, sizeof(numbuf));
+                              memset(hits,   0, sizeof(hits));
+                              memset(miss,   0, sizeof(miss));
+                             }
+               ~XrdBuffTCache() {}
+};
+
 /******************************************************************************/
 /*                     E x t e r n a l   L i n k a g e s                      */
 /******************************************************************************/
@@ -66,6 +106,7 @@ const char *XrdBuffManager::TraceID = "BuffManager";
 namespace
 {
 static const int minBuffSz = 1 << XRD_BUSHIFT;
+static const int tcMaxDflt = 1024*1024;
 }
 
 namespace XrdGlobal
@@ -104,6 +145,16 @@ XrdBuffManager::XrdBuffManager(XrdSysError *lP, XrdOucTrace *tP, int minrst) :
    rsinprog = 0;
    minrsw   = minrst;
    memset(static_cast<void *>(bucket), 0, sizeof(bucket));
+
+// Initialize the per-thread caches (they are disabled if we can't get a key)
+//
+   tcFirst  = 0;
+   tcGen    = 0;
+   memset(tcHits, 0, sizeof(tcHits));
+   memset(tcMiss, 0, sizeof(tcMiss));
+   memset(tcSeen, 0, sizeof(tcSeen));
+   tcOK     = (pthread_key_create(&tcKey, XrdBuffTCache::Done) == 0);
+   tcMax    = (tcOK ? tcMaxDflt : 0);
 }
 
 /******************************************************************************/
@@ -145,6 +196,7 @@ void XrdBuffManager::Init()
   
 XrdBuffer *XrdBuffManager::Obtain(int sz)
 {
+   XrdBuffTCache *tcP;
    XrdBuffer *bp;
    char *memp;
    int mk, pk, bindex;
@@ -162,6 +214,20 @@ XrdBuffer *XrdBuffManager::Obtain(int sz)
    if (mk < sz) {bindex++; mk = mk << 1;}
    if (bindex >= slots) return 0;    // Should never happen!
 
+// Try to give away a buffer from this thread's cache without any locks
+//
+   if (tcMax && (tcP = tcGet()))
+      {if (tcP->gen != tcGen) tcFlush(tcP);
+       if ((bp = tcP->bnext[bindex]))
+          {tcP->bnext[bindex] = bp->next;
+           tcP->numbuf[bindex]--;
+           tcP->memsz -= bp->bsize;
+           tcP->hits[bindex]++;
+           return bp;
+          }
+       tcP->miss[bindex]++;
+      }
+
 // Obtain a lock on the bucket array and try to give away an existing buffer
 //
     Reshaper.Lock();
@@ -226,12 +292,28 @@ int XrdBuffManager::Recalc(int sz)
   
 void XrdBuffManager::Release(XrdBuffer *bp)
 {
+   XrdBuffTCache *tcP;
    int bindex = bp->bindex;
 
 // Check if we should release this via the big buffer object
 //
    if (bindex >= slots) {xlBuff.Release(bp); return;}
 
+// Keep the buffer in this thread's cache if there is room. If the reshaper
+// asked us to trim, return everything in the cache to the buckets instead.
+//
+   if (tcMax && (tcP = tcGet()))
+      {if (tcP->gen != tcGen) tcFlush(tcP);
+          else if (tcP->numbuf[bindex] < XRD_TCBUFFS
+               &&  tcP->memsz + bp->bsize <= tcMax)
+                  {bp->next = tcP->bnext[bindex];
+                   tcP->bnext[bindex] = bp;
+                   tcP->numbuf[bindex]++;
+                   tcP->memsz += bp->bsize;
+                   return;
+                  }
+      }
+
 // Obtain a lock on the bucket array and reclaim the buffer
 //
     Reshaper.Lock();
@@ -248,6 +330,7 @@ void XrdBuffManager::Release(XrdBuffer *bp)
 void XrdBuffManager::Reshape()
 {
 int i, bufprof[XRD_BUCKETS], numfreed;
+long long tchits[XRD_BUCKETS];
 time_t delta, lastshape = time(0);
 long long memslot, memhave, memtarget = (long long)(.80*(float)maxalo);
 XrdSysTimer Timer;
@@ -266,6 +349,20 @@ while(1)
           Reshaper.Lock();
          }
 
+      // Requests satisfied by the per-thread caches never reach the buckets so
+      // add them to the profile. If we need to free memory, have each thread
+      // return its cached buffers so that they can be freed the next time.
+      //
+      if (tcMax)
+         {tcCount(tchits, 0);
+          for (i = 0; i < slots; i++)
+              {bucket[i].numreq += static_cast<int>(tchits[i] - tcSeen[i]);
+               totreq           += static_cast<int>(tchits[i] - tcSeen[i]);
+               tcSeen[i] = tchits[i];
+              }
+          if (totalo > memtarget) tcGen++;
+         }
+
       // We have the lock so compute the request profile
       //
       if (totreq > slots)
@@ -310,14 +407,16 @@ while(1)
 /*                                   S e t                                    */
 /******************************************************************************/
   
-void XrdBuffManager::Set(int maxmem, int minw)
+void XrdBuffManager::Set(int maxmem, int minw, int tcmem)
 {
 
-// Obtain a lock and set the values
+// Obtain a lock and set the values. The thread cache size can only be set
+// prior to threads using the buffer pool (i.e. at configuration time).
 //
    Reshaper.Lock();
    if (maxmem > 0) maxalo = (long long)maxmem;
    if (minw   > 0) minrsw = minw;
+   if (tcmem >= 0 && tcOK) tcMax = tcmem;
    Reshaper.UnLock();
 }
  
@@ -328,19 +427,137 @@ void XrdBuffManager::Set(int maxmem, int minw)
 int XrdBuffManager::Stats(char *buff, int blen, int do_sync)
 {
     static char statfmt[] = "<stats id=\"buff\"><reqs>%d</reqs>"
-                "<mem>%lld</mem><buffs>%d</buffs><adj>%d</adj>%s</stats>";
-    char xlStats[1024];
-    int nlen;
+                "<mem>%lld</mem><buffs>%d</buffs><adj>%d</adj>%s%s</stats>";
+    static char tcfmt[] = "<tc sz=\"%d\"><hit>%lld</hit><miss>%lld</miss></tc>";
+    char xlStats[1024], tcStats[(sizeof(tcfmt) + 16*3)*XRD_BUCKETS];
+    long long tchits[XRD_BUCKETS], tcmiss[XRD_BUCKETS];
+    int i, k, nlen;
 
 // If only size wanted, return it
 //
-   if (!buff) return sizeof(statfmt) + 16*4 + xlBuff.Stats(0,0);
+   if (!buff) return sizeof(statfmt) + 16*4 + xlBuff.Stats(0,0)
+                   + sizeof(tcStats);
 
 // Return formatted stats
 //
    if (do_sync) Reshaper.Lock();
    xlBuff.Stats(xlStats, sizeof(xlStats), do_sync);
-   nlen = snprintf(buff,blen,statfmt,totreq,totalo,totbuf,totadj,xlStats);
+   *tcStats = 0;
+   if (tcMax)
+      {tcCount(tchits, tcmiss);
+       for (i = 0, k = 0; i < slots; i++)
+           k += snprintf(tcStats+k, sizeof(tcStats)-k, tcfmt,
+                         minBuffSz << i, tchits[i], tcmiss[i]);
+      }
+   nlen = snprintf(buff,blen,statfmt,totreq,totalo,totbuf,totadj,xlStats,
+                   tcStats);
    if (do_sync) Reshaper.UnLock();
    return nlen;
 }
+
+/******************************************************************************/
+/*                       P r i v a t e   M e t h o d s                        */
+/******************************************************************************/
+/******************************************************************************/
+/*                               t c C o u n t                                */
+/******************************************************************************/
+
+void XrdBuffManager::tcCount(long long *hits, long long *miss)
+{
+   XrdBuffTCache *tcP;
+   int i;
+
+// Start with the counts of threads that have exited
+//
+   tcMutex.Lock();
+   for (i = 0; i < slots; i++)
+       {hits[i] = tcHits[i];
+        if (miss) miss[i] = tcMiss[i];
+       }
+
+// Add in the counts of every active thread (we don't need an exact count)
+//
+   tcP = tcFirst;
+   while(tcP)
+        {for (i = 0; i < slots; i++)
+             {hits[i] += tcP->hits[i];
+              if (miss) miss[i] += tcP->miss[i];
+             }
+         tcP = tcP->next;
+        }
+   tcMutex.UnLock();
+}
+
+/******************************************************************************/
+/*                                t c D o n e                                 */
+/******************************************************************************/
+
+void XrdBuffManager::tcDone(XrdBuffTCache *tcP)
+{
+
+// Return all of the cached buffers
+//
+   tcFlush(tcP);
+
+// Remove the cache from the list and keep its counts
+//
+   tcMutex.Lock();
+   if (tcP->next) tcP->next->prev = tcP->prev;
+   if (tcP->prev) tcP->prev->next = tcP->next;
+      else tcFirst = tcP->next;
+   for (int i = 0; i < slots; i++)
+       {tcHits[i] += tcP->hits[i];
+        tcMiss[i] += tcP->miss[i];
+       }
+   tcMutex.UnLock();
+   delete tcP;
+}
+
+/******************************************************************************/
+/*                               t c F l u s h                                */
+/******************************************************************************/
+
+void XrdBuffManager::tcFlush(XrdBuffTCache *tcP)
+{
+   XrdBuffer *bp;
+
+// Return every cached buffer to its bucket
+//
+   Reshaper.Lock();
+   for (int i = 0; i < slots; i++)
+       {while((bp = tcP->bnext[i]))
+             {tcP->bnext[i] = bp->next;
+              bp->next = bucket[i].bnext;
+              bucket[i].bnext = bp;
+              bucket[i].numbuf++;
+             }
+        tcP->numbuf[i] = 0;
+       }
+   tcP->gen = tcGen;
+   Reshaper.UnLock();
+   tcP->memsz = 0;
+}
+
+/******************************************************************************/
+/*                                 t c G e t                                  */
+/******************************************************************************/
+
+XrdBuffTCache *XrdBuffManager::tcGet()
+{
+   XrdBuffTCache *tcP;
+
+// Return the cache for this thread if it already has one
+//
+   if ((tcP = static_cast<XrdBuffTCache *>(pthread_getspecific(tcKey))))
+      return tcP;
+
+// Create a new cache and add it to the list of caches
+//
+   tcP = new XrdBuffTCache(this, tcGen);
+   if (pthread_setspecific(tcKey, tcP)) {delete tcP; return 0;}
+   tcMutex.Lock();
+   if ((tcP->next = tcFirst)) tcFirst->prev = tcP;
+   tcFirst = tcP;
+   tcMutex.UnLock();
+   return tcP;
+}
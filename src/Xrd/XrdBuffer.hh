@@ -51,6 +51,7 @@ int      bsize;    // size of this buffer
         ~XrdBuffer() {if (buff) free(buff);}
 
          friend class XrdBuffManager;
+         friend class XrdBuffTCache;
          friend class XrdBuffXL;
 private:
 
@@ -65,9 +66,11 @@ static int pagesz;
 
 #define XRD_BUCKETS 12
 #define XRD_BUSHIFT 10
+#define XRD_TCBUFFS  4
 
 // There should be only one instance of this class per buffer pool.
 //
+class XrdBuffTCache;
 class XrdOucTrace;
 class XrdSysError;
   
@@ -87,7 +90,7 @@ int         MaxSize() {return maxsz;}
 
 void        Reshape();
 
-void        Set(int maxmem=-1, int minw=-1);
+void        Set(int maxmem=-1, int minw=-1, int tcmem=-1);
 
 int         Stats(char *buff, int blen, int do_sync=0);
 
@@ -96,6 +99,12 @@ int         Stats(char *buff, int blen, int do_sync=0);
            ~XrdBuffManager();   // The buffmanager is never deleted
 
 private:
+friend class XrdBuffTCache;
+
+void           tcCount(long long *hits, long long *miss);
+void           tcDone(XrdBuffTCache *tcP);
+void           tcFlush(XrdBuffTCache *tcP);
+XrdBuffTCache *tcGet();
 
 XrdOucTrace *XrdTrace;
 XrdSysError *XrdLog;
@@ -118,6 +127,16 @@ int       minrsw;
 int       rsinprog;
 int       totadj;
 
+XrdBuffTCache *tcFirst;                // Per-thread caches in front of buckets
+long long      tcHits[XRD_BUCKETS];    // Hits  from threads that have exited
+long long      tcMiss[XRD_BUCKETS];    // Misses from threads that have exited
+long long      tcSeen[XRD_BUCKETS];    // Hits already counted by the reshaper
+int            tcMax;                  // Max bytes a thread may cache
+int            tcGen;                  // Flush generation (bumped to trim)
+bool           tcOK;                   // Per-thread caches can be used
+pthread_key_t  tcKey;
+XrdSysMutex    tcMutex;                // Protects the per-thread cache list
+
 XrdSysCondVar      Reshaper;
 static const char *TraceID;
 };
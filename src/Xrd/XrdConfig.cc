@@ -229,7 +229,8 @@ int XrdConfig::Configure(int argc, char **argv)
    char *argbP = argBuff, *argbE = argbP+sizeof(argBuff)-4;
    char *ifList = 0;
    int   myArgc = 1, urArgc = argc, i;
-   bool noV6, ipV4 = false, ipV6 = false;
+   int   aqSize = 0;
+   bool noV6, ipV4 = false, ipV6 = false, aqBlock = false;
 
 // Obtain the protocol name we will be using
 //
@@ -282,10 +283,27 @@ int XrdConfig::Configure(int argc, char **argv)
 //
    opterr = 0;
    if (argc > 1 && '-' == *argv[1]) 
-      while ((c = getopt(urArgc,argv,":bc:dhHI:k:l:L:n:p:P:R:s:S:vz"))
+      while ((c = getopt(urArgc,argv,":A:bc:dhHI:k:l:L:n:p:P:R:s:S:vz"))
              && ((unsigned char)c != 0xff))
      { switch(c)
        {
+       case 'A': {char *comma = index(optarg, ',');
+                  long long aqsz = 65536;
+                  if (comma) *comma = 0;
+                       if (!strcmp("block", optarg)) aqBlock = true;
+                  else if (!strcmp("drop",  optarg)) aqBlock = false;
+                  else {Log.Emsg("Config", "Invalid -A argument -",optarg);
+                        Usage(1);
+                       }
+                  if (comma)
+                     {*comma = ',';
+                      if (XrdOuca2x::a2sz(Log, "-A buffer size", comma+1,
+                                          &aqsz, 16384, 16*1024*1024))
+                         Usage(1);
+                     }
+                  aqSize = static_cast<int>(aqsz);
+                 }
+                 break;
        case 'b': optbg = 1;
                  break;
        case 'c': if (ConfigFN) free(ConfigFN);
@@ -541,6 +559,14 @@ int XrdConfig::Configure(int argc, char **argv)
 //
    if (!NoGo) Manifest(pidFN);
 
+// Switch to asynchronous logging now that fatal configuration errors, which
+// must reach the log before we exit, are behind us.
+//
+   if (!NoGo && aqSize && (retc = Log.logger()->setAsync(aqSize, aqBlock)))
+      {Log.Emsg("Config", -retc, "start asynchronous logging");
+       NoGo = 1;
+      }
+
 // All done, close the stream and return the return code.
 //
    temp = (NoGo ? " initialization failed." : " initialization completed.");
@@ -1067,9 +1093,9 @@ void XrdConfig::Usage(int rc)
 
   if (rc < 0) cerr <<XrdLicense;
      else
-     cerr <<"\nUsage: " <<myProg <<" [-b] [-c <cfn>] [-d] [-h] [-H] [-I {v4|v6}]\n"
-            "[-k {n|sz|sig}] [-l [=]<fn>] [-n name] [-p <port>] [-P <prot>] [-L <libprot>]\n"
-            "[-R] [-s pidfile] [-S site] [-v] [-z] [<prot_options>]" <<endl;
+     cerr <<"\nUsage: " <<myProg <<" [-A {block|drop}[,<bsz>]] [-b] [-c <cfn>] [-d] [-h] [-H]\n"
+            "[-I {v4|v6}] [-k {n|sz|sig}] [-l [=]<fn>] [-n name] [-p <port>] [-P <prot>]\n"
+            "[-L <libprot>] [-R] [-s pidfile] [-S site] [-v] [-z] [<prot_options>]" <<endl;
      _exit(rc > 0 ? rc : 0);
 }
 
@@ -1170,11 +1196,16 @@ int XrdConfig::xallow(XrdSysError *eDest, XrdOucStream &Config)
 
 /* Function: xbuf
 
-   Purpose:  To parse the directive: buffers [maxbsz <bsz>] <memsz> [<rint>]
+   Purpose:  To parse the directive: buffers [maxbsz <bsz>] [tcache <tcsz>]
+                                             <memsz> [<rint>]
 
              <bsz>      maximum size of an individualbuffer. The default is 2m.
                         Specify any value 2m < bsz <= 1g; if specified, it must
                         appear before the <memsz> and <memsz> becomes optional.
+             <tcsz>     maximum amount of memory each thread may keep in its
+                        private buffer cache. The default is 1m. Specify 0 to
+                        disable per-thread caching. If specified, it must
+                        appear before the <memsz> and <memsz> becomes optional.
              <memsz>    maximum amount of memory devoted to buffers
              <rint>     minimum buffer reshape interval in seconds
 
@@ -1184,7 +1215,8 @@ int XrdConfig::xbuf(XrdSysError *eDest, XrdOucStream &Config)
 {
     static const long long minBSZ = 1024*1024*2+1;  // 2mb
     static const long long maxBSZ = 1024*1024*1024; // 1gb
-    int bint = -1;
+    static const long long maxTCZ = 1024*1024*64;   // 64mb
+    int bint = -1, tcsz = -1;
     long long blim;
     char *val;
 
@@ -1200,6 +1232,15 @@ int XrdConfig::xbuf(XrdSysError *eDest, XrdOucStream &Config)
         if (!(val = Config.GetWord())) return 0;
        }
 
+    if (!strcmp("tcache", val))
+       {if (!(val = Config.GetWord()))
+           {eDest->Emsg("Config", "thread cache size not specified"); return 1;}
+        if (XrdOuca2x::a2sz(*eDest,"tcache value",val,&blim,0,maxTCZ))
+           return 1;
+        tcsz = static_cast<int>(blim);
+        if (!(val = Config.GetWord())) {BuffPool.Set(-1, -1, tcsz); return 0;}
+       }
+
     if (XrdOuca2x::a2sz(*eDest,"buffer limit value",val,&blim,
                        (long long)1024*1024)) return 1;
 
@@ -1207,7 +1248,7 @@ int XrdConfig::xbuf(XrdSysError *eDest, XrdOucStream &Config)
        if (XrdOuca2x::a2tm(*eDest,"reshape interval", val, &bint, 300))
           return 1;
 
-    BuffPool.Set((int)blim, bint);
+    BuffPool.Set((int)blim, bint, tcsz);
     return 0;
 }
 
@@ -1220,7 +1261,7 @@ int XrdConfig::xbuf(XrdSysError *eDest, XrdOucStream &Config)
    Purpose:  To parse directive: network [wan] [[no]keepalive] [buffsz <blen>]
                                          [kaparms parms] [cache <ct>] [[no]dnr]
                                          [routes <rtype> [use <ifn1>,<ifn2>]]
-                                         [[no]rpipa]
+                                         [[no]rpipa] [poller {default|uring}]
 
              <rtype>: split | common | local
 
@@ -1232,6 +1273,9 @@ int XrdConfig::xbuf(XrdSysError *eDest, XrdOucStream &Config)
              [no]dnr   do [not] perform a reverse DNS lookup if not needed.
              routes    specifies the network configuration (see reference)
              [no]rpipa do [not] resolve private IP addresses.
+             poller    the mechanism used to poll links for incoming data. The
+                       default is the platform's native poller; uring uses
+                       io_uring on Linux, when available.
 
    Output: 0 upon success or !0 upon failure.
 */
@@ -1257,6 +1301,7 @@ int XrdConfig::xnet(XrdSysError *eDest, XrdOucStream &Config)
         {"routes",     3, 1, 0,         "routes"},
         {"rpipa",      0, 1, &v_rpip,   "rpipa"},
         {"norpipa",    0, 0, &v_rpip,   "norpipa"},
+        {"poller",     5, 0, 0,         "poller"},
         {"wan",        0, 1, &V_iswan,  "option"}
        };
     int numopts = sizeof(ntopts)/sizeof(struct netopts);
@@ -1277,6 +1322,14 @@ int XrdConfig::xnet(XrdSysError *eDest, XrdOucStream &Config)
                          {if (xnkap(eDest, val)) return 1;
                           break;
                          }
+                      if (ntopts[i].hasarg == 5)
+                         {if (!XrdPoll::SetPoller(val))
+                             {eDest->Emsg("Config","Unsupported network "
+                                                   "poller -",val);
+                              return 1;
+                             }
+                          break;
+                         }
                       if (ntopts[i].hasarg == 3)
                          {     if (!strcmp(val, "split"))
                                   XrdNetIF::Routing(XrdNetIF::netSplit);
@@ -1635,6 +1688,7 @@ int XrdConfig::xrep(XrdSysError *eDest, XrdOucStream &Config)
 
    Purpose:  To parse directive: sched [mint <mint>] [maxt <maxt>] [avlt <at>]
                                        [idle <idle>] [stksz <qnt>] [core <cv>]
+                                       [queues {<qn> | cpus}]
 
              <mint>   is the minimum number of threads that we need. Once
                       this number of threads is created, it does not decrease.
@@ -1651,6 +1705,10 @@ int XrdConfig::xrep(XrdSysError *eDest, XrdOucStream &Config)
              <idle>   The time (in time spec) between checks for underused
                       threads. Those found will be terminated. Default is 780.
              <qnt>    The thread stack size in bytes or K, M, or G.
+             <qn>     The number of work queues. Each worker thread is given a
+                      home queue and idle workers steal from other queues.
+                      Specify cpus for one queue per online cpu. The default
+                      is a single shared queue.
 
    Output: 0 upon success or 1 upon failure.
 */
@@ -1660,7 +1718,7 @@ int XrdConfig::xsched(XrdSysError *eDest, XrdOucStream &Config)
     char *val;
     long long lpp;
     int  i, ppp = 0;
-    int  V_mint = -1, V_maxt = -1, V_idle = -1, V_avlt = -1;
+    int  V_mint = -1, V_maxt = -1, V_idle = -1, V_avlt = -1, V_qnum = -1;
     struct schedopts {const char *opname; int minv; int *oploc;
                       const char *opmsg;} scopts[] =
        {
@@ -1669,7 +1727,8 @@ int XrdConfig::xsched(XrdSysError *eDest, XrdOucStream &Config)
         {"maxt",       1, &V_maxt, "sched maxt"},
         {"avlt",       1, &V_avlt, "sched avlt"},
         {"core",       1,       0, "sched core"},
-        {"idle",       0, &V_idle, "sched idle"}
+        {"idle",       0, &V_idle, "sched idle"},
+        {"queues",     1, &V_qnum, "sched queues"}
        };
     int numopts = sizeof(scopts)/sizeof(struct schedopts);
 
@@ -1696,6 +1755,9 @@ int XrdConfig::xsched(XrdSysError *eDest, XrdOucStream &Config)
                                   return 1;
                                  }
                            }
+                   else if (*scopts[i].opname == 'q' && !strcmp("cpus", val))
+                           {if ((ppp = sysconf(_SC_NPROCESSORS_ONLN)) < 1) ppp=1;
+                           }
                    else if (*scopts[i].opname == 's')
                            {if (XrdOuca2x::a2sz(*eDest, scopts[i].opmsg, val,
                                                 &lpp, scopts[i].minv)) return 1;
@@ -1728,6 +1790,7 @@ int XrdConfig::xsched(XrdSysError *eDest, XrdOucStream &Config)
 // Establish scheduler options
 //
    Sched.setParms(V_mint, V_maxt, V_avlt, V_idle);
+   if (V_qnum > 0 && !Sched.setQueues(V_qnum)) return 1;
    return 0;
 }
 
@@ -181,6 +181,7 @@ void XrdLink::Reset()
   isIdle   = 0;
   inQ      = 0;
   isBridged= 0;
+  useRecvQ = 0;
   BytesOut = BytesIn = BytesOutTot = BytesInTot = 0;
   doPost   = 0;
   LockReads= 0;
@@ -271,6 +272,22 @@ XrdLink *XrdLink::Alloc(XrdNetAddr &peer, int opts)
    return lp;
 }
 
+/******************************************************************************/
+/*                              a r m R e c v Q                               */
+/******************************************************************************/
+
+void XrdLink::armRecvQ()
+{
+   XrdPoll *pp = Poller;
+
+// Links are matched to a protocol before they are attached to a poller. So,
+// remember this for XrdPoll::Attach() and tell the poller now if attached.
+// Only pollers that do I/O can receive data on our behalf.
+//
+   useRecvQ = 1;
+   if (pp && pp->doesIO) pp->UseRecvQ(this);
+}
+
 /******************************************************************************/
 /*                               B a c k l o g                                */
 /******************************************************************************/
@@ -537,6 +554,7 @@ int XrdLink::Peek(char *Buff, int Blen, int timeout)
 {
    XrdSysMutexHelper theMutex;
    struct pollfd polltab = {FD, POLLIN|POLLRDNORM, 0};
+   XrdPoll *pp = Poller;
    ssize_t mlen;
    int retc;
 
@@ -544,9 +562,14 @@ int XrdLink::Peek(char *Buff, int Blen, int timeout)
 //
    if (LockReads) theMutex.Lock(&rdMutex);
 
-// Wait until we can actually read something
+// Look at data the poller received for us, if it does so
 //
    isIdle = 0;
+   if (pp && pp->doesIO
+   &&  (retc = pp->RecvQ(this, Buff, Blen, timeout, true)) >= 0) return retc;
+
+// Wait until we can actually read something
+//
    do {retc = poll(&polltab, 1, timeout);} while(retc < 0 && errno == EINTR);
    if (retc != 1)
       {if (retc == 0) return 0;
@@ -579,14 +602,17 @@ int XrdLink::Peek(char *Buff, int Blen, int timeout)
   
 int XrdLink::Recv(char *Buff, int Blen)
 {
+   XrdPoll *pp = Poller;
    ssize_t rlen;
 
 // Note that we will read only as much as is queued. Use Recv() with a
-// timeout to receive as much data as possible.
+// timeout to receive as much data as possible. Data the poller received on
+// our behalf is returned first.
 //
    if (LockReads) rdMutex.Lock();
    isIdle = 0;
-   do {rlen = read(FD, Buff, Blen);} while(rlen < 0 && errno == EINTR);
+   if (!pp || !(pp->doesIO) || (rlen = pp->RecvQ(this, Buff, Blen, -1)) < 0)
+      do {rlen = read(FD, Buff, Blen);} while(rlen < 0 && errno == EINTR);
    if (rlen > 0) AtomicAdd(BytesIn, rlen);
    if (LockReads) rdMutex.UnLock();
 
@@ -601,18 +627,24 @@ int XrdLink::Recv(char *Buff, int Blen, int timeout)
 {
    XrdSysMutexHelper theMutex;
    struct pollfd polltab = {FD, POLLIN|POLLRDNORM, 0};
-   ssize_t rlen, totlen = 0;
+   XrdPoll *pp = Poller;
+   ssize_t rlen = 0, totlen = 0;
    int retc;
 
 // Lock the read mutex if we need to, the helper will unlock it upon exit
 //
    if (LockReads) theMutex.Lock(&rdMutex);
 
-// Wait up to timeout milliseconds for data to arrive
+// Wait up to timeout milliseconds for data to arrive. Data the poller received
+// on our behalf is taken first until the poller says we must read the socket.
 //
    isIdle = 0;
+   if (pp && !(pp->doesIO)) pp = 0;
    while(Blen > 0)
-        {do {retc = poll(&polltab,1,timeout);} while(retc < 0 && errno == EINTR);
+        {if (pp && (rlen = pp->RecvQ(this, Buff, Blen, timeout)) < 0) pp = 0;
+         if (pp) retc = (rlen ? 1 : 0);
+            else do {retc = poll(&polltab,1,timeout);}
+                    while(retc < 0 && errno == EINTR);
          if (retc != 1)
             {if (retc == 0)
                 {tardyCnt++;
@@ -625,21 +657,23 @@ int XrdLink::Recv(char *Buff, int Blen, int timeout)
              return (FD >= 0 ? XrdLog->Emsg("Link", -errno, "poll", ID) : -1);
             }
 
-         // Verify it is safe to read now
-         //
-         if (!(polltab.revents & (POLLIN|POLLRDNORM)))
-            {XrdLog->Emsg("Link", XrdPoll::Poll2Text(polltab.revents),
-                                 "polling", ID);
-             return -1;
-            }
-
-         // Read as much data as you can. Note that we will force an error
-         // if we get a zero-length read after poll said it was OK.
+         // Verify it is safe to read now and read as much data as you can.
+         // Note that we will force an error if we get a zero-length read
+         // after poll said it was OK. Data from the poller is already here.
          //
-         do {rlen = recv(FD, Buff, Blen, 0);} while(rlen < 0 && errno == EINTR);
-         if (rlen <= 0)
-            {if (!rlen) return -ENOMSG;
-             return (FD<0 ? -1 : XrdLog->Emsg("Link",-errno,"receive from",ID));
+         if (!pp)
+            {if (!(polltab.revents & (POLLIN|POLLRDNORM)))
+                {XrdLog->Emsg("Link", XrdPoll::Poll2Text(polltab.revents),
+                                     "polling", ID);
+                 return -1;
+                }
+             do {rlen = recv(FD, Buff, Blen, 0);}
+                while(rlen < 0 && errno == EINTR);
+             if (rlen <= 0)
+                {if (!rlen) return -ENOMSG;
+                 return (FD<0 ? -1
+                              : XrdLog->Emsg("Link",-errno,"receive from",ID));
+                }
             }
          totlen += rlen; Blen -= rlen; Buff += rlen;
         }
@@ -656,8 +690,26 @@ int XrdLink::Recv(char *Buff, int Blen, int timeout)
 int XrdLink::RecvAll(char *Buff, int Blen, int timeout)
 {
    struct pollfd polltab = {FD, POLLIN|POLLRDNORM, 0};
-   ssize_t rlen;
-   int     retc;
+   XrdPoll *pp = Poller;
+   ssize_t rlen, totlen = 0;
+   int     retc = -1;
+
+// Take any data the poller received on our behalf. As below, the timeout only
+// applies to the first piece of data.
+//
+   if (pp && pp->doesIO)
+      {if (LockReads) rdMutex.Lock();
+       while(totlen < Blen
+         &&  (retc = pp->RecvQ(this, Buff+totlen, Blen-totlen,
+                               (totlen ? -1 : timeout))) > 0) totlen += retc;
+       if (LockReads) rdMutex.UnLock();
+       if (!totlen && !retc) return -ETIMEDOUT;
+       if (totlen)
+          {isIdle = 0;
+           if (totlen == Blen) {AtomicAdd(BytesIn, totlen); return Blen;}
+           timeout = -1;
+          }
+      }
 
 // Check if timeout specified. Notice that the timeout is the max we will
 // for some data. We will wait forever for all the data. Yeah, it's weird.
@@ -679,7 +731,9 @@ int XrdLink::RecvAll(char *Buff, int Blen, int timeout)
 //
    if (LockReads) rdMutex.Lock();
    isIdle = 0;
-   do {rlen = recv(FD,Buff,Blen,MSG_WAITALL);} while(rlen < 0 && errno == EINTR);
+   do {rlen = recv(FD, Buff+totlen, Blen-totlen, MSG_WAITALL);}
+      while(rlen < 0 && errno == EINTR);
+   if (rlen >= 0) rlen += totlen;
    if (rlen > 0) AtomicAdd(BytesIn, rlen);
    if (LockReads) rdMutex.UnLock();
 
@@ -696,6 +750,8 @@ int XrdLink::RecvAll(char *Buff, int Blen, int timeout)
   
 int XrdLink::Send(const char *Buff, int Blen)
 {
+   struct iovec myIOV;
+   XrdPoll *pp;
    ssize_t retc = 0, bytesleft = Blen;
 
 // Get a lock
@@ -712,10 +768,14 @@ int XrdLink::Send(const char *Buff, int Blen)
        return retc;
       }
 
-// Write the data out
+// Write the data out, through the poller if it does I/O for us
 //
+   if ((pp = Poller) && !(pp->doesIO)) pp = 0;
    while(bytesleft)
-        {if ((retc = write(FD, Buff, bytesleft)) < 0)
+        {if (pp) {myIOV.iov_base = (void *)Buff; myIOV.iov_len = bytesleft;
+                  retc = pp->SendV(this, &myIOV, 1);
+                 } else retc = write(FD, Buff, bytesleft);
+         if (retc < 0)
             {if (errno == EINTR) continue;
                 else break;
             }
@@ -734,6 +794,7 @@ int XrdLink::Send(const char *Buff, int Blen)
   
 int XrdLink::Send(const struct iovec *iov, int iocnt, int bytes)
 {
+   XrdPoll *pp;
    ssize_t bytesleft, n, retc = 0;
    const char *Buff;
    int i;
@@ -761,11 +822,14 @@ int XrdLink::Send(const struct iovec *iov, int iocnt, int bytes)
 // So, we attempt to resume the writev() using a combination of write() and
 // a writev() continuation. This approach slowly converts a writev() to a
 // series of writes if need be. We must do this inline because we must hold
-// the lock until all the bytes are written or an error occurs.
+// the lock until all the bytes are written or an error occurs. The vector is
+// sent through the poller if it does I/O for us so that it can batch sends.
 //
+   if ((pp = Poller) && !(pp->doesIO)) pp = 0;
    bytesleft = static_cast<ssize_t>(bytes);
    while(bytesleft)
-        {do {retc = writev(FD, iov, iocnt);} while(retc < 0 && errno == EINTR);
+        {do {retc = (pp ? pp->SendV(this, iov, iocnt) : writev(FD, iov, iocnt));}
+            while(retc < 0 && errno == EINTR);
          if (retc >= bytesleft || retc < 0) break;
          bytesleft -= retc;
          while(retc >= (n = static_cast<ssize_t>(iov->iov_len)))
@@ -68,6 +68,7 @@ friend class XrdPoll;
 friend class XrdPollPoll;
 friend class XrdPollDev;
 friend class XrdPollE;
+friend class XrdPollU;
 
 //-----------------------------------------------------------------------------
 //! Obtain the address information for this link.
@@ -247,6 +248,8 @@ time_t        timeCon() {return conTime;}
 int           UseCnt() {return InUse;}
 
 void          armBridge() {isBridged = 1;}
+
+void          armRecvQ();  // Poller may receive data for us (never read the FD)
 int           hasBridge() {return isBridged;}
 
               XrdLink();
@@ -328,6 +331,7 @@ char                isEnabled;
 char                isIdle;
 char                inQ;    // Only used by PollPoll.icc
 char                isBridged;
+char                useRecvQ;       // Poller may receive data for us
 char                KillCnt;        // Protected by opMutex!
 static const char   KillMax =   60;
 static const char   KillMsk = 0x7f;
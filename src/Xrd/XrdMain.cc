@@ -76,6 +76,7 @@ Where:
 
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysHeaders.hh"
+#include "XrdSys/XrdSysLogger.hh"
 #include "XrdSys/XrdSysPthread.hh"
 #include "XrdSys/XrdSysUtils.hh"
 
@@ -184,6 +185,7 @@ int main(int argc, char *argv[])
                              (void *)new XrdMain(Main.Config.NetADM),
                              XRDSYSTHREAD_BIND, "Admin handler")))
       {Main.Config.ProtInfo.eDest->Emsg("main", retc, "create admin thread");
+       Main.Config.ProtInfo.eDest->logger()->Flush();
        _exit(3);
       }
 
@@ -200,6 +202,7 @@ int main(int argc, char *argv[])
            if ((retc = XrdSysThread::Run(&tid, mainAccept, (void *)Parms,
                                          XRDSYSTHREAD_BIND, strdup(buff))))
               {Main.Config.ProtInfo.eDest->Emsg("main", retc, "create", buff);
+               Main.Config.ProtInfo.eDest->logger()->Flush();
                _exit(3);
               }
           }
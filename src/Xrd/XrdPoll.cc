@@ -30,9 +30,11 @@
 #include <unistd.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
   
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysFD.hh"
+#include "XrdSys/XrdSysLogger.hh"
 #include "XrdSys/XrdSysPlatform.hh"
 #include "XrdSys/XrdSysPthread.hh"
 #include "Xrd/XrdLink.hh"
@@ -46,6 +48,9 @@
 #include "Xrd/XrdPollDev.hh"
 #elif defined( __linux__ )
 #include "Xrd/XrdPollE.hh"
+#ifdef HAVE_IOURING
+#include "Xrd/XrdPollU.hh"
+#endif
 #else
 #include "Xrd/XrdPollPoll.hh"
 #endif
@@ -86,6 +91,8 @@ int           Stats(char *buff, int blen, int do_sync=0) {return 0;}
        XrdSysError  *XrdPoll::XrdLog   = 0;
        XrdScheduler *XrdPoll::XrdSched = 0;
 
+       bool          XrdPoll::useURing = false;
+
 /******************************************************************************/
 /*              T h r e a d   S t a r t u p   I n t e r f a c e               */
 /******************************************************************************/
@@ -116,6 +123,7 @@ XrdPoll::XrdPoll()
    int fildes[2];
 
    TID=0;
+   doesIO=false;
    numAttached=numEnabled=numEvents=numInterrupts=0;
 
    if (XrdSysFD_Pipe(fildes) == 0)
@@ -159,6 +167,7 @@ int XrdPoll::Attach(XrdLink *lp)
 // Complete the link setup
 //
    lp->Poller = pp;
+   if (lp->useRecvQ && pp->doesIO) pp->UseRecvQ(lp);
    pp->numAttached++;
    doingAttach.UnLock();
    TRACEI(POLL, "FD " <<lp->FD <<" attached to poller " <<pp->PID <<"; num=" <<pp->numAttached);
@@ -185,7 +194,8 @@ void XrdPoll::Detach(XrdLink *lp)
 //
    doingAttach.Lock();
    if (!pp->numAttached)
-      {XrdLog->Emsg("Poll","Underflow detaching", lp->ID); abort();}
+      {XrdLog->Emsg("Poll","Underflow detaching", lp->ID);
+       XrdLog->logger()->Flush(); abort();}
    pp->numAttached--;
    doingAttach.UnLock();
    TRACEI(POLL, "FD " <<lp->FDnum() <<" detached from poller " <<pp->PID
@@ -282,6 +292,19 @@ char *XrdPoll::Poll2Text(short events)
   return (char *)0;
 }
 
+/******************************************************************************/
+/*                             S e t P o l l e r                              */
+/******************************************************************************/
+
+bool XrdPoll::SetPoller(const char *pname)
+{
+   if (!strcmp(pname, "default")) {useURing = false; return true;}
+#if defined( __linux__ ) && defined( HAVE_IOURING )
+   if (!strcmp(pname, "uring"))   {useURing = true;  return true;}
+#endif
+   return false;
+}
+
 /******************************************************************************/
 /*                                 S e t u p                                  */
 /******************************************************************************/
@@ -362,6 +385,9 @@ int XrdPoll::Stats(char *buff, int blen, int do_sync)
 #include "Xrd/XrdPollDev.icc"
 #elif defined( __linux__ )
 #include "Xrd/XrdPollE.icc"
+#ifdef HAVE_IOURING
+#include "Xrd/XrdPollU.icc"
+#endif
 #else
 #include "Xrd/XrdPollPoll.icc"
 #endif
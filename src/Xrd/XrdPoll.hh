@@ -29,7 +29,9 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <errno.h>
 #include <sys/poll.h>
+#include <sys/uio.h>
 #include "XrdSys/XrdSysPthread.hh"
 
 #define XRD_NUMPOLLERS 3
@@ -73,6 +75,26 @@ static  void  Init(XrdSysError *eP, XrdOucTrace *tP, XrdScheduler *sP)
 //
 static  char *Poll2Text(short events); // Implementation supplied
 
+// RecvQ() is called by a link that allowed the poller to receive data on its
+//         behalf (see UseRecvQ()). It returns the number of bytes placed in
+//         buff, 0 if none arrived within tmo milliseconds (tmo < 0 waits
+//         forever), or -1 if the link must read from its socket instead.
+//         Only called when doesIO is true.
+//
+virtual int   RecvQ(XrdLink *lp, char *buff, int blen, int tmo,
+                    bool peek=false) {return -1;}
+
+// SendV() is called by a link to send data through the poller. The return
+//         value is as for writev(). Only called when doesIO is true.
+//
+virtual int   SendV(XrdLink *lp, const struct iovec *iov, int iocnt)
+                   {errno = ENOTSUP; return -1;}
+
+// SetPoller() is called at config time, prior to Setup(), to select the poll
+//             mechanism. It returns false if it is not supported here.
+//
+static  bool  SetPoller(const char *pname); // Implementation supplied
+
 // Setup() is called at config time to perform poller configuration
 //
 static  int   Setup(int numfd);        // Implementation supplied
@@ -85,10 +107,16 @@ virtual void  Start(XrdSysSemaphore *syncp, int &rc) = 0;
 //
 static  int   Stats(char *buff, int blen, int do_sync=0);
 
+// UseRecvQ() is called when a link allows the poller to receive data on its
+//            behalf. The link must then never read from its socket directly.
+//
+virtual void  UseRecvQ(XrdLink *lp) {}
+
 // Identification of the thread handling this object
 //
            int         PID;       // Poller ID
            pthread_t   TID;       // Thread ID
+           bool        doesIO;    // RecvQ() and SendV() are supported
 
 // The following table reference the pollers in effect
 //
@@ -103,6 +131,7 @@ static     const char   *TraceID;                  // For tracing
 static     XrdOucTrace  *XrdTrace;
 static     XrdSysError  *XrdLog;
 static     XrdScheduler *XrdSched;
+static     bool          useURing;
 
 // Gets the next request on the poll pipe. This is common to all implentations.
 //
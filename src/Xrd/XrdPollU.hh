@@ -0,0 +1,165 @@
+#ifndef __XRD_POLLURING_H__
+#define __XRD_POLLURING_H__
+/******************************************************************************/
+/*                                                                            */
+/*                           X r d P o l l U . h h                            */
+/*                                                                            */
+/* (c) 2026 by the contributors to the XRootD software suite                  */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <poll.h>
+
+#include "Xrd/XrdPoll.hh"
+#include "XrdSys/XrdSysIOURing.hh"
+
+#ifndef POLLRDHUP
+#define POLLRDHUP 0
+#endif
+
+#ifdef XRDSYSIOURING_BUFRING
+#define XRDPOLLU_RECVQ
+#endif
+
+// This poller uses io_uring instead of epoll. Links that allow it (see
+// XrdLink::armRecvQ()) are served by a multishot receive into buffers that
+// are registered with the kernel; the received data is handed to the link's
+// Recv() calls and the link is re-enabled without a system call while the
+// receive is outstanding. Other links are polled with one-shot poll requests.
+// Each request is tagged with a per-arm sequence number so that completions
+// and cancellations for an earlier arm never affect a later one. Sends go
+// through a second ring. Each sender waits for its own completion before it
+// returns, just as writev() would, so every send is still a submission and a
+// wait; sends are not batched. Only reaping is shared: one waiting sender
+// collects the completions for all of them.
+//
+class XrdPollU : public XrdPoll
+{
+public:
+
+       void Disable(XrdLink *lp, const char *etxt=0);
+
+       int  Enable(XrdLink *lp);
+
+static XrdPoll *newPollU(int pollid, int numfd);
+
+       int  RecvQ(XrdLink *lp, char *buff, int blen, int tmo, bool peek=false);
+
+       int  SendV(XrdLink *lp, const struct iovec *iov, int iocnt);
+
+       void Start(XrdSysSemaphore *syncp, int &rc);
+
+       void UseRecvQ(XrdLink *lp);
+
+            XrdPollU(XrdSysIOURing *rp, XrdSysIOURing *sp,
+                     struct io_uring_cqe *ptab, int numfd, bool rqOK);
+           ~XrdPollU();
+
+protected:
+       void  Exclude(XrdLink *lp);
+       int   Include(XrdLink *lp);
+const  char *x2Text(unsigned int evf, char *buff);
+
+private:
+
+// Each file descriptor has an entry describing the requests outstanding for
+// the link using it and the data received on the link's behalf. The data is
+// kept in the provided buffers themselves, chained by buffer id.
+//
+struct uLink
+      {XrdSysCondVar  rqCV;     // Serializes access to the entry
+       XrdLink       *Link;     // The link using the fd (0 if none)
+       unsigned int   Seq;      // Last arm sequence number used
+       unsigned int   pollSeq;  // Sequence of the outstanding poll or 0
+       unsigned int   recvSeq;  // Sequence of the outstanding receive or 0
+       int            rqFirst;  // First buffer holding unread data or -1
+       int            rqLast;   // Last  buffer holding unread data or -1
+       int            rqOff;    // Offset of the unread data in rqFirst
+       int            rqBytes;  // Number of unread bytes
+       int            rqWait;   // Number of readers waiting for data
+       bool           rqOK;     // The link lets us receive data for it
+       bool           rqCancel; // The outstanding receive is being cancelled
+       bool           rqNoBuf;  // The last receive ran out of buffers
+
+                      uLink() : rqCV(0, "uLink"), Link(0), Seq(0), pollSeq(0),
+                                recvSeq(0), rqFirst(-1), rqLast(-1), rqOff(0),
+                                rqBytes(0), rqWait(0), rqOK(false),
+                                rqCancel(false), rqNoBuf(false) {}
+                     ~uLink() {}
+      };
+
+// A sender waits on its own semaphore until the reaping thread finds its
+// completion. Pending sends are chained so that reaping can be handed off.
+//
+struct uSend
+      {XrdSysSemaphore  Sem;
+       uSend           *Next;
+       uSend           *Prev;
+       int              Res;
+       bool             Done;
+
+                        uSend() : Sem(0), Next(0), Prev(0), Res(0),
+                                  Done(false) {}
+                       ~uSend() {}
+      };
+
+       int      Arm(uLink *up, int fd, int type, bool doSub);
+       void     Cancel(int fd, unsigned int seq, int type, bool doSub);
+       void     Drop(uLink *up);
+       XrdLink *Event(struct io_uring_cqe *cqe, char *eBuff);
+       uLink   *getEntry(int fd);
+
+static unsigned long long Tag(int fd, unsigned int seq, int type)
+                             {return (static_cast<unsigned long long>(seq)<<32)
+                                    | (static_cast<unsigned long long>(fd)<<2)
+                                    |  static_cast<unsigned long long>(type);
+                             }
+
+static const int uPollEvents = POLLIN | POLLPRI | POLLRDHUP;
+static const int uTagIgnore  = 0;     // Completion needs no processing
+static const int uTagPoll    = 1;     // Completion of a one-shot poll
+static const int uTagRecv    = 2;     // Completion of a multishot receive
+static const int uTabShift   = 10;    // Entries per table chunk (log2)
+static const int uTabChunks  = 1024;  // Number of table chunks
+static const int uBufSize    = 16384; // Size of each provided buffer
+static const int uBufNum     = 512;   // Number of provided buffers
+static const int uBufMax     = 4;     // Buffers a link may hold before we
+                                      // stop receiving on its behalf
+static const int uSendMax    = 64;    // Send completions reaped at once
+
+XrdSysIOURing       *Ring;
+XrdSysIOURing       *SRing;
+struct io_uring_cqe *PollTab;
+       int           PollMax;
+
+XrdSysMutex          tabMutex;
+uLink               *LinkTab[uTabChunks];
+int                 *BufNext;
+int                 *BufLen;
+bool                 rqBufs;
+
+XrdSysMutex          sMutex;
+uSend               *sPend;
+struct io_uring_cqe  sTab[uSendMax];
+bool                 sReaper;
+};
+#endif
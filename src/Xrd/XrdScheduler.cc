@@ -41,17 +41,45 @@
 
 #include "Xrd/XrdJob.hh"
 #include "Xrd/XrdScheduler.hh"
+#include "XrdSys/XrdSysAtomics.hh"
 #include "XrdSys/XrdSysError.hh"
 
 #define XRD_TRACE XrdTrace->
 #include "Xrd/XrdTrace.hh"
 
+/******************************************************************************/
+/*                         L o c a l   D e f i n e s                          */
+/******************************************************************************/
+
+// Timed jobs are kept in a hierarchical timer wheel with one second ticks. The
+// first level has one slot per second for the next 256 seconds, each higher
+// level has 64 slots each spanning all of the slots of the level below it.
+// Jobs in a higher level slot cascade down when the level below wraps around.
+//
+#define TW_L0Bits  8
+#define TW_LnBits  6
+#define TW_L0Size  (1 << TW_L0Bits)
+#define TW_LnSize  (1 << TW_LnBits)
+#define TW_L0Mask  (TW_L0Size - 1)
+#define TW_LnMask  (TW_LnSize - 1)
+#define TW_Levels  4
+#define TW_Slots   (TW_L0Size + TW_Levels*TW_LnSize)
+
+#define TW_Shift(lvl) (TW_L0Bits + ((lvl)-1)*TW_LnBits)
+#define TW_Index(t, lvl) \
+        (TW_L0Size + ((lvl)-1)*TW_LnSize + (((t) >> TW_Shift(lvl)) & TW_LnMask))
+
 /******************************************************************************/
 /*                        S t a t i c   O b j e c t s                         */
 /******************************************************************************/
 
        const char   *XrdScheduler::TraceID = "Sched";
 
+namespace
+{
+pthread_key_t wqKey;  // Holds home queue number + 1 for each worker thread
+}
+
 /******************************************************************************/
 /*                         L o c a l   C l a s s e s                          */
 /******************************************************************************/
@@ -65,7 +93,40 @@ class XrdSchedulerPID
                         {next = prev; pid = newpid;}
      ~XrdSchedulerPID() {}
      };
+
+// Each worker thread is assigned a home queue. Jobs scheduled by a worker are
+// placed on its home queue and a worker that finds its home queue empty steals
+// work from the other queues. This spreads the queue lock over many mutexes.
+//
+class XrdSchedulerWQ
+     {public:
+      XrdSysMutex      qMutex;
+      XrdJob          *qFirst;
+      XrdJob          *qLast;
+      int              qDepth;
+
+      XrdSchedulerWQ() : qFirst(0), qLast(0), qDepth(0) {}
+     ~XrdSchedulerWQ() {}
+     };
   
+// A timed job is represented in the timer wheel by a node that the scheduler
+// owns. While the job is in the wheel its SchedTime is non-zero and its NextJob
+// points to its node. Each slot is anchored by a node that heads a circular
+// doubly linked list of nodes. This allows any job to be removed in O(1) time.
+//
+class XrdSchedulerTN : public XrdJob
+     {public:
+      XrdSchedulerTN  *tNext;
+      XrdSchedulerTN  *tPrev;
+      XrdJob          *tJob;
+
+      void DoIt() {}
+
+      XrdSchedulerTN() : XrdJob("timer node"), tNext(this), tPrev(this),
+                         tJob(0) {}
+     ~XrdSchedulerTN() {}
+     };
+
 /******************************************************************************/
 /*            E x t e r n a l   T h r e a d   I n t e r f a c e s             */
 /******************************************************************************/
@@ -114,8 +175,18 @@ XrdScheduler::XrdScheduler(XrdSysError *eP, XrdOucTrace *tP,
     num_TDestroy=  0;
     num_Layoffs =  0;
     num_Limited =  0;
+    num_Steals  =  0;
+    max_WQDepth =  0;
     firstPID    =  0;
-    WorkFirst = WorkLast = TimerQueue = 0;
+    WorkFirst = WorkLast = 0;
+    TimerSlot   =  new XrdSchedulerTN[TW_Slots];
+    TimerFree   =  0;
+    TimerBase   =  time(0);
+    TimerWake   =  0;
+    TimerCount  =  0;
+    WorkQ       =  0;
+    num_WorkQ   =  1;
+    nxt_WorkQ   =  0;
 
 // Make sure we are using the maximum number of threads allowed (Linux only)
 //
@@ -176,22 +247,21 @@ XrdScheduler::~XrdScheduler()  // The scheduler is never deleted!
 
 void XrdScheduler::Cancel(XrdJob *jp)
 {
-   XrdJob *p, *pp = 0;
+   XrdSchedulerTN *tp;
 
 // Lock the queue
 //
    TimerMutex.Lock();
 
-// Find the matching job, if any
+// Unlink the job's node from its timer slot, if it is in one
 //
-   p = TimerQueue;
-   while(p && p != jp) {pp = p; p = p->NextJob;}
-
-// Delete the job element
-//
-   if (p)
-      {if (pp) pp->NextJob = p->NextJob;
-          else  TimerQueue = p->NextJob;
+   if (jp->SchedTime)
+      {tp = static_cast<XrdSchedulerTN *>(jp->NextJob);
+       tp->tPrev->tNext = tp->tNext;
+       tp->tNext->tPrev = tp->tPrev;
+       tp->tJob = 0; tp->tNext = TimerFree; TimerFree = tp;
+       jp->NextJob = 0; jp->SchedTime = 0;
+       TimerCount--;
        TRACE(SCHED, "time event " <<jp->Comment <<" cancelled");
       }
 
@@ -210,7 +280,7 @@ void XrdScheduler::DoIt()
 
 // Now check if there are too many idle threads (kill them if there are)
 //
-   if (!num_JobsinQ)
+   if (!jobsInQ())
       {DispatchMutex.Lock(); num_idle = idl_Workers; DispatchMutex.UnLock();
        num_kill = num_idle - min_Workers;
        TRACE(SCHED, num_Workers <<" threads; " <<num_idle <<" idle");
@@ -320,21 +390,33 @@ void *XrdScheduler::Reaper()
   
 void XrdScheduler::Run()
 {
-   int waiting;
+   int waiting, myQ = 0;
    XrdJob *jp;
 
+// If we have multiple work queues, adopt one of them as our home queue
+//
+   if (WorkQ)
+      {AtomicBeg(StatMutex);
+       AtomicFAdd(myQ, nxt_WorkQ, 1);
+       AtomicEnd(StatMutex);
+       myQ = static_cast<unsigned int>(myQ) % num_WorkQ;
+       pthread_setspecific(wqKey, (void *)(long)(myQ+1));
+      }
+
 // Wait for work then do it (an endless task for a worker thread)
 //
-   do {do {DispatchMutex.Lock();          idl_Workers++;DispatchMutex.UnLock();
+   do {do {jp = 0;
+           DispatchMutex.Lock();          idl_Workers++;DispatchMutex.UnLock();
            WorkAvail.Wait();
            DispatchMutex.Lock();waiting = --idl_Workers;DispatchMutex.UnLock();
+           if (WorkQ && (jp = getJob(myQ))) break;
            SchedMutex.Lock();
-           if ((jp = WorkFirst))
+           if (!WorkQ && (jp = WorkFirst))
               {if (!(WorkFirst = jp->NextJob)) WorkLast = 0;
                if (num_JobsinQ) num_JobsinQ--;
                   else XrdLog->Emsg("Scheduler","Job queue count underflow!");
               } else {
-               num_JobsinQ = 0;
+               if (!WorkQ) num_JobsinQ = 0;
                if (num_Layoffs > 0)
                   {num_Layoffs--;
                    if (waiting)
@@ -353,7 +435,7 @@ void XrdScheduler::Run()
     //
        if (!waiting) hireWorker();
        if (TRACING(TRACE_SCHED) && *(jp->Comment) != '.')
-          {TRACE(SCHED, "running " <<jp->Comment <<" inq=" <<num_JobsinQ);}
+          {TRACE(SCHED, "running " <<jp->Comment <<" inq=" <<jobsInQ());}
        jp->DoIt();
       } while(1);
 }
@@ -364,6 +446,10 @@ void XrdScheduler::Run()
   
 void XrdScheduler::Schedule(XrdJob *jp)
 {
+// If we have multiple work queues, place the job on the one for this thread
+//
+   if (WorkQ) {putJob(1, jp, jp); return;}
+
 // Lock down our data area
 //
    SchedMutex.Lock();
@@ -396,6 +482,10 @@ void XrdScheduler::Schedule(XrdJob *jp)
 void XrdScheduler::Schedule(int numjobs, XrdJob *jfirst, XrdJob *jlast)
 {
 
+// If we have multiple work queues, place the jobs on the one for this thread
+//
+   if (WorkQ) {putJob(numjobs, jfirst, jlast); return;}
+
 // Lock down our data area
 //
    SchedMutex.Lock();
@@ -430,29 +520,32 @@ void XrdScheduler::Schedule(int numjobs, XrdJob *jfirst, XrdJob *jlast)
 
 void XrdScheduler::Schedule(XrdJob *jp, time_t atime)
 {
-   XrdJob *pp = 0, *p;
+   XrdSchedulerTN *tp;
+   time_t now = time(0);
 
 // Cancel this event, if scheduled
 //
    Cancel(jp);
 
-// Lock the queue
+// If the time has already arrived, there is no need to go through the timer
 //
    if (TRACING(TRACE_SCHED) && *(jp->Comment) != '.')
-      {TRACE(SCHED, "scheduling " <<jp->Comment <<" in " <<atime-time(0) <<" seconds");}
-   jp->SchedTime = atime;
-   TimerMutex.Lock();
+      {TRACE(SCHED, "scheduling " <<jp->Comment <<" in " <<atime-now <<" seconds");}
+   if (atime <= now) {Schedule(jp); return;}
 
-// Find the insertion point for the work element
+// Lock the queue and get a node for the job
 //
-   p = TimerQueue;
-   while(p && p->SchedTime <= atime) {pp = p; p = p->NextJob;}
+   TimerMutex.Lock();
+   if ((tp = TimerFree)) TimerFree = tp->tNext;
+      else tp = new XrdSchedulerTN;
+   tp->tJob = jp;
+   jp->NextJob = tp;
+   jp->SchedTime = atime;
 
-// Insert the job element
+// Insert the job element and wake up the time scheduler if it would be late
 //
-   jp->NextJob = p;
-   if (pp)  pp->NextJob = jp;
-      else {TimerQueue = jp; TimerRings.Signal();}
+   tmrAdd(tp);
+   if (atime < TimerWake) {TimerWake = atime; TimerRings.Signal();}
 
 // All done
 //
@@ -505,6 +598,49 @@ void XrdScheduler::setParms(int minw, int maxw, int avlw, int maxi, int once)
    TRACE(SCHED,"Set stk_Workers=" <<stk_Workers <<" max_Workidl=" <<max_Workidl);
 }
 
+/******************************************************************************/
+/*                             s e t Q u e u e s                              */
+/******************************************************************************/
+
+int XrdScheduler::setQueues(int numq) // Serialized configuration time call!
+{
+
+// Multiple queues can only be established before any worker is started
+//
+   SchedMutex.Lock();
+   if (num_Workers || WorkQ)
+      {SchedMutex.UnLock();
+       XrdLog->Emsg("Scheduler", "Work queues cannot be changed once started.");
+       return 0;
+      }
+
+// One queue is the default. Otherwise, allocate the queues and move any work
+// that may have already been scheduled to the first one.
+//
+   if (numq > 1)
+      {int retc;
+       if ((retc = pthread_key_create(&wqKey, 0)))
+          {SchedMutex.UnLock();
+           XrdLog->Emsg("Scheduler", retc, "create work queue key");
+           return 0;
+          }
+       WorkQ = new XrdSchedulerWQ[numq];
+       num_WorkQ = numq;
+       if (WorkFirst)
+          {WorkQ[0].qFirst = WorkFirst;
+           WorkQ[0].qLast  = WorkLast;
+           WorkQ[0].qDepth = num_JobsinQ;
+           WorkFirst = WorkLast = 0;
+          }
+      }
+   SchedMutex.UnLock();
+
+// Debug the info
+//
+   TRACE(SCHED,"Set num_WorkQ=" <<num_WorkQ);
+   return 1;
+}
+
 /******************************************************************************/
 /*                                 S t a r t                                  */
 /******************************************************************************/
@@ -541,16 +677,17 @@ void XrdScheduler::Start() // Serialized one time call!
 int XrdScheduler::Stats(char *buff, int blen, int do_sync)
 {
     int cnt_Jobs, cnt_JobsinQ, xam_QLength, cnt_Workers, cnt_idl;
-    int cnt_TCreate, cnt_TDestroy, cnt_Limited;
+    int cnt_TCreate, cnt_TDestroy, cnt_Limited, cnt_Steals, xam_WQDepth;
     static char statfmt[] = "<stats id=\"sched\"><jobs>%d</jobs>"
                 "<inq>%d</inq><maxinq>%d</maxinq>"
                 "<threads>%d</threads><idle>%d</idle>"
                 "<tcr>%d</tcr><tde>%d</tde>"
-                "<tlimr>%d</tlimr></stats>";
+                "<tlimr>%d</tlimr><wq>%d</wq><steal>%d</steal>"
+                "<maxwq>%d</maxwq></stats>";
 
 // If only length wanted, do so
 //
-   if (!buff) return sizeof(statfmt) + 16*8;
+   if (!buff) return sizeof(statfmt) + 16*11;
 
 // Get values protected by the Dispatch lock (avoid lock if no sync needed)
 //
@@ -563,18 +700,26 @@ int XrdScheduler::Stats(char *buff, int blen, int do_sync)
    if (do_sync) SchedMutex.Lock();
    cnt_Workers = num_Workers;
    cnt_Jobs    = num_Jobs;
-   cnt_JobsinQ = num_JobsinQ;
    xam_QLength = max_QLength;
    cnt_TCreate = num_TCreate;
    cnt_TDestroy= num_TDestroy;
    cnt_Limited = num_Limited;
    if (do_sync) SchedMutex.UnLock();
 
+// Get values maintained outside of any lock when we have multiple work queues
+//
+   if (do_sync) {AtomicBeg(StatMutex);}
+   if (WorkQ) cnt_Jobs = AtomicGet(num_Jobs);
+   cnt_Steals  = AtomicGet(num_Steals);
+   if (do_sync) {AtomicEnd(StatMutex);}
+   cnt_JobsinQ = jobsInQ();
+   xam_WQDepth = (WorkQ ? max_WQDepth : xam_QLength);
+
 // Format the stats and return them
 //
    return snprintf(buff, blen, statfmt, cnt_Jobs, cnt_JobsinQ, xam_QLength,
                    cnt_Workers, cnt_idl, cnt_TCreate, cnt_TDestroy,
-                   cnt_Limited);
+                   cnt_Limited, num_WorkQ, cnt_Steals, xam_WQDepth);
 }
 
 /******************************************************************************/
@@ -583,29 +728,64 @@ int XrdScheduler::Stats(char *buff, int blen, int do_sync)
   
 void XrdScheduler::TimeSched()
 {
-   XrdJob *jp;
+   time_t now;
    int wtime;
 
-// Continuous loop until we find some work here
+// Continuous loop dispatching work that has come due and then waiting for
+// the next time something comes due.
 //
    do {TimerMutex.Lock();
-       if (TimerQueue) wtime = TimerQueue->SchedTime-time(0);
-          else wtime = 60*60;
-       if (wtime > 0)
-          {TimerMutex.UnLock();
-           TimerRings.Wait(wtime);
-          } else {
-           jp = TimerQueue;
-           TimerQueue = jp->NextJob;
-           Schedule(jp);
-           TimerMutex.UnLock();
-          }
+       now = time(0);
+       tmrRun(now);
+       wtime = tmrWait(now);
+       TimerWake = now + wtime;
+       TimerMutex.UnLock();
+       TimerRings.Wait(wtime);
        } while(1);
 }
 
 /******************************************************************************/
 /*                       P r i v a t e   M e t h o d s                        */
 /******************************************************************************/
+/******************************************************************************/
+/*                                g e t J o b                                 */
+/******************************************************************************/
+
+XrdJob *XrdScheduler::getJob(int myQ)
+{
+   XrdSchedulerWQ *wq;
+   XrdJob *jp;
+   int i, qN;
+
+// Take work from our home queue and, if it is empty, steal from the others.
+// A job may be queued behind us while we scan and another worker may take the
+// job we were posted for. So, we rescan for as long as any job is counted as
+// queued. This way no job is left behind without a pending post.
+//
+   do {qN = myQ;
+       for (i = 0; i < num_WorkQ; i++)
+           {wq = &WorkQ[qN];
+            wq->qMutex.Lock();
+            if ((jp = wq->qFirst))
+               {if (!(wq->qFirst = jp->NextJob)) wq->qLast = 0;
+                wq->qDepth--;
+                wq->qMutex.UnLock();
+                AtomicBeg(StatMutex);
+                AtomicDec(num_JobsinQ);
+                if (i) AtomicInc(num_Steals);
+                AtomicEnd(StatMutex);
+                return jp;
+               }
+            wq->qMutex.UnLock();
+            if (++qN >= num_WorkQ) qN = 0;
+           }
+      } while(jobsInQ() > 0);
+
+// Nothing was found
+//
+   return 0;
+}
+
 /******************************************************************************/
 /*                           h i r e   W o r k e r                            */
 /******************************************************************************/
@@ -648,6 +828,209 @@ void XrdScheduler::hireWorker(int dotrace)
       } else if (dotrace) TRACE(SCHED, "Now have " <<num_Workers <<" workers" );
 }
  
+/******************************************************************************/
+/*                               j o b s I n Q                                */
+/******************************************************************************/
+
+int XrdScheduler::jobsInQ()
+{
+   int inQ;
+
+// With multiple work queues the count is kept outside of the scheduler lock
+// and may briefly go negative as a job can be taken before it is counted.
+//
+   if (!WorkQ) return num_JobsinQ;
+   AtomicBeg(StatMutex);
+   inQ = AtomicGet(num_JobsinQ);
+   AtomicEnd(StatMutex);
+   return (inQ < 0 ? 0 : inQ);
+}
+
+/******************************************************************************/
+/*                               m y Q u e u e                                */
+/******************************************************************************/
+
+int XrdScheduler::myQueue()
+{
+   void *qP;
+   unsigned int qN;
+
+// Workers use their home queue. Anyone else gets queues in round robin order.
+//
+   if ((qP = pthread_getspecific(wqKey))) return (int)((long)qP - 1);
+   AtomicBeg(StatMutex);
+   AtomicFAdd(qN, nxt_WorkQ, 1);
+   AtomicEnd(StatMutex);
+   return static_cast<int>(qN % num_WorkQ);
+}
+
+/******************************************************************************/
+/*                                p u t J o b                                 */
+/******************************************************************************/
+
+void XrdScheduler::putJob(int numjobs, XrdJob *jfirst, XrdJob *jlast)
+{
+   XrdSchedulerWQ *wq = &WorkQ[myQueue()];
+   int inQ, qDepth;
+
+// Place the request list on our queue
+//
+   jlast->NextJob = 0;
+   wq->qMutex.Lock();
+   if (wq->qFirst)
+      {wq->qLast->NextJob = jfirst;
+       wq->qLast = jlast;
+      } else {
+       wq->qFirst = jfirst;
+       wq->qLast  = jlast;
+      }
+   qDepth = (wq->qDepth += numjobs);
+   wq->qMutex.UnLock();
+
+// Calculate statistics. The high water marks are advisory so we don't lock.
+//
+   AtomicBeg(StatMutex);
+   AtomicAdd(num_Jobs, numjobs);
+   AtomicFAdd(inQ, num_JobsinQ, numjobs);
+   AtomicEnd(StatMutex);
+   if ((inQ += numjobs) > max_QLength) max_QLength = inQ;
+   if (qDepth > max_WQDepth) max_WQDepth = qDepth;
+
+// Indicate number of jobs to work on
+//
+   while(numjobs--) WorkAvail.Post();
+}
+
+/******************************************************************************/
+/*                                t m r A d d                                 */
+/******************************************************************************/
+
+// Caller must hold the TimerMutex
+
+void XrdScheduler::tmrAdd(XrdSchedulerTN *tp)
+{
+   XrdSchedulerTN *slot;
+   time_t when = tp->tJob->SchedTime;
+   long long delta;
+   int lvl;
+
+// Jobs whose time has passed go into the slot that will be processed next
+//
+   if (when < TimerBase) when = TimerBase;
+   delta = static_cast<long long>(when - TimerBase);
+
+// Find the level whose span covers the delta. Anything beyond the last level
+// is placed in the furthest slot and is reinserted when that slot cascades.
+//
+   if (delta < TW_L0Size) slot = &TimerSlot[when & TW_L0Mask];
+      else {for (lvl = 1; lvl < TW_Levels; lvl++)
+                if (delta < (1LL << TW_Shift(lvl+1))) break;
+            if (delta >= (1LL << TW_Shift(TW_Levels+1)))
+               when = TimerBase + static_cast<time_t>((1LL << TW_Shift(TW_Levels+1)) - 1);
+            slot = &TimerSlot[TW_Index(when, lvl)];
+           }
+
+// Append the node to the slot
+//
+   tp->tNext = slot;
+   tp->tPrev = slot->tPrev;
+   slot->tPrev->tNext = tp;
+   slot->tPrev = tp;
+   TimerCount++;
+}
+
+/******************************************************************************/
+/*                            t m r C a s c a d e                             */
+/******************************************************************************/
+
+// Caller must hold the TimerMutex
+
+int XrdScheduler::tmrCascade(int lvl)
+{
+   XrdSchedulerTN *slot = &TimerSlot[TW_Index(TimerBase, lvl)];
+   XrdSchedulerTN *tp, *tnext;
+
+// Detach every job in the slot for the current time and redistribute them
+// into lower levels.
+//
+   tp = slot->tNext;
+   slot->tNext = slot->tPrev = slot;
+   while(tp != slot)
+        {tnext = tp->tNext;
+         TimerCount--;
+         tmrAdd(tp);
+         tp = tnext;
+        }
+
+// Return the index of the slot. Zero means the next level must cascade too.
+//
+   return static_cast<int>((TimerBase >> TW_Shift(lvl)) & TW_LnMask);
+}
+
+/******************************************************************************/
+/*                                t m r R u n                                 */
+/******************************************************************************/
+
+// Caller must hold the TimerMutex
+
+void XrdScheduler::tmrRun(time_t now)
+{
+   XrdSchedulerTN *slot, *tp;
+   XrdJob *jp;
+   int idx, lvl;
+
+// Advance the wheel one second at a time until we catch up. If the wheel is
+// empty there is nothing to cascade so we can simply jump ahead.
+//
+   while(TimerBase <= now)
+        {if (!TimerCount) {TimerBase = now+1; break;}
+         idx = static_cast<int>(TimerBase & TW_L0Mask);
+         if (!idx)
+            for (lvl = 1; lvl <= TW_Levels; lvl++) if (tmrCascade(lvl)) break;
+         slot = &TimerSlot[idx];
+         while((tp = slot->tNext) != slot)
+              {slot->tNext = tp->tNext;
+               tp->tNext->tPrev = slot;
+               jp = tp->tJob;
+               tp->tJob = 0; tp->tNext = TimerFree; TimerFree = tp;
+               jp->NextJob = 0; jp->SchedTime = 0;
+               TimerCount--;
+               Schedule(jp);
+              }
+         TimerBase++;
+        }
+}
+
+/******************************************************************************/
+/*                               t m r W a i t                                */
+/******************************************************************************/
+
+// Caller must hold the TimerMutex
+
+int XrdScheduler::tmrWait(time_t now)
+{
+   XrdSchedulerTN *slot;
+   int i, lim;
+
+// If there is nothing in the wheel we wait for a long time
+//
+   if (!TimerCount) return 60*60;
+
+// Find the next non-empty first level slot. We cannot look beyond the point
+// where the first level wraps as that is when higher level jobs cascade down.
+//
+   lim = TW_L0Size - static_cast<int>(TimerBase & TW_L0Mask);
+   for (i = 0; i < lim; i++)
+       {slot = &TimerSlot[(TimerBase + i) & TW_L0Mask];
+        if (slot->tNext != slot) break;
+       }
+
+// Return the number of seconds to wait
+//
+   i = static_cast<int>(TimerBase + i - now);
+   return (i > 0 ? i : 1);
+}
+
 /******************************************************************************/
 /*                             t r a c e E x i t                              */
 /******************************************************************************/
@@ -37,6 +37,8 @@
 
 class XrdOucTrace;
 class XrdSchedulerPID;
+class XrdSchedulerTN;
+class XrdSchedulerWQ;
 class XrdSysError;
 
 #define MAX_SCHED_PROCS 30000
@@ -45,7 +47,7 @@ class XrdScheduler : public XrdJob
 {
 public:
 
-int           Active() {return num_Workers - idl_Workers + num_JobsinQ;}
+int           Active() {return num_Workers - idl_Workers + jobsInQ();}
 
 void          Cancel(XrdJob *jp);
 
@@ -66,6 +68,8 @@ void          Schedule(XrdJob *jp, time_t atime);
 
 void          setParms(int minw, int maxw, int avlt, int maxi, int once=0);
 
+int           setQueues(int numq);
+
 void          Start();
 
 int           Stats(char *buff, int blen, int do_sync=0);
@@ -79,6 +83,8 @@ int        num_TDestroy;// Number of threads destroyed
 int        num_Jobs;    // Number of jobs scheduled
 int        max_QLength; // Longest queue length we had
 int        num_Limited; // Number of times max was reached
+int        num_Steals;  // Number of jobs taken from another worker's queue
+int        max_WQDepth; // Deepest any single work queue has been
 
 // Constructor and destructor
 //
@@ -107,15 +113,32 @@ XrdJob                *WorkLast;
 XrdSysSemaphore        WorkAvail;
 XrdSysMutex            SchedMutex; // Protects private area
 
-XrdJob                *TimerQueue; // Pending work
+XrdSchedulerWQ        *WorkQ;      // Per-worker queues (null if just one)
+int                    num_WorkQ;  // Number of work queues
+unsigned int           nxt_WorkQ;  // Next queue to assign (round robin)
+XrdSysMutex            StatMutex;  // Protects counters when no atomics
+
+XrdSchedulerTN        *TimerSlot;  // Pending work in a hierarchical timer wheel
+XrdSchedulerTN        *TimerFree;  // Unused timer wheel nodes
+time_t                 TimerBase;  // Next second to be processed by the wheel
+time_t                 TimerWake;  // When the time scheduler will next wake up
+int                    TimerCount; // Number of jobs in the wheel
 XrdSysCondVar          TimerRings;
 XrdSysMutex            TimerMutex; // Protects scheduler area
 
 XrdSchedulerPID       *firstPID;
 XrdSysMutex            ReaperMutex;
 
+XrdJob *getJob(int myQ);
 void hireWorker(int dotrace=1);
+int  jobsInQ();
 void Monitor();
+int  myQueue();
+void putJob(int numjobs, XrdJob *jfirst, XrdJob *jlast);
+void tmrAdd(XrdSchedulerTN *tp);
+int  tmrCascade(int lvl);
+void tmrRun(time_t now);
+int  tmrWait(time_t now);
 void traceExit(pid_t pid, int status);
 static const char *TraceID;
 };
@@ -42,6 +42,7 @@
 #include "XrdNet/XrdNetAddrInfo.hh"
 #include "XrdOuc/XrdOucUtils.hh"
 #include "XrdSys/XrdSysPlugin.hh"
+#include "XrdSys/XrdSysTimer.hh"
   
 /******************************************************************************/
 /*                   E x t e r n a l   R e f e r e n c e s                    */
@@ -90,6 +91,12 @@ XrdAccAccess::XrdAccAccess(XrdSysError *erp)
 // Get the audit option that we should use
 //
    Auditor = XrdAccAuditObject(erp);
+
+// Start with empty tables
+//
+   Atab = new XrdAccAccess_Tables;
+   tabGen = 0;
+   tabReaders[0] = tabReaders[1] = 0;
 }
 
 /******************************************************************************/
@@ -110,11 +117,11 @@ XrdAccPrivs XrdAccAccess::Access(const XrdSecEntity    *Entity,
    const long phash = XrdOucHashVal2(path, plen);
    const char *id   = (Entity->name ? (const char *)Entity->name : "*");
    const char *host = 0;
-   int n, isuser = (*id && (*id != '*' || id[1]));
+   int n, gen, isuser = (*id && (*id != '*' || id[1]));
 
-// Get a shared context for these potentially long running routines
+// Get the current tables, they stay valid until we release them
 //
-   Access_Context.Lock(xs_Shared);
+   const XrdAccAccess_Tables &Atab = *TabsGet(gen);
 
 // Run through the exclusive list first as only one rule will apply
 //
@@ -122,7 +129,7 @@ XrdAccPrivs XrdAccAccess::Access(const XrdSecEntity    *Entity,
    while (xlP)
          {if (xlP->Applies(Entity))
              {xlP->caps->Privs(caps, path, plen, phash);
-              Access_Context.UnLock(xs_Shared);
+              TabsRel(gen);
               return Access(caps, Entity, path, oper);
              }
           xlP = xlP->next;
@@ -214,7 +221,7 @@ XrdAccPrivs XrdAccAccess::Access(const XrdSecEntity    *Entity,
 
 // We are now done with looking at changeable data
 //
-   Access_Context.UnLock(xs_Shared);
+   TabsRel(gen);
 
 // Return the privileges as needed
 //
@@ -313,41 +320,59 @@ const char *XrdAccAccess::Resolve(const XrdSecEntity *Entity)
 /*                              S w a p T a b s                               */
 /******************************************************************************/
 
-#define XrdAccSWAP(x) oldtab.x = Atab.x;   Atab.x  =  newtab.x; \
-                      newtab.x = oldtab.x; oldtab.x = 0;
-
 void XrdAccAccess::SwapTabs(struct XrdAccAccess_Tables &newtab)
 {
-     struct XrdAccAccess_Tables oldtab;
+   struct XrdAccAccess_Tables *oldtab, *tabP = new XrdAccAccess_Tables;
+   int oldGen;
 
-// Get an exclusive context to change the table pointers
+// Take over the new tables, leaving the caller's structure empty
 //
-   Access_Context.Lock(xs_Exclusive);
+   *tabP  = newtab;
+   newtab = XrdAccAccess_Tables();
 
-// Save the old pointer while replacing it with the new pointer
+// Install the new tables and start a new generation of lookups. Then wait for
+// lookups of the previous generation, which may still use the old tables.
 //
-   XrdAccSWAP(D_List);
-   XrdAccSWAP(E_List);
-   XrdAccSWAP(G_Hash);
-   XrdAccSWAP(H_Hash);
-   XrdAccSWAP(N_Hash);
-   XrdAccSWAP(O_Hash);
-   XrdAccSWAP(R_Hash);
-   XrdAccSWAP(S_Hash);
-   XrdAccSWAP(T_Hash);
-   XrdAccSWAP(U_Hash);
-   XrdAccSWAP(X_List);
-   XrdAccSWAP(Z_List);
-   XrdAccSWAP(SXList);
-   XrdAccSWAP(SYList);
+   __sync_synchronize();
+   oldtab = Atab;
+   Atab   = tabP;
+   oldGen = __sync_fetch_and_add(&tabGen, 1) & 1;
+   while(__sync_fetch_and_add(&tabReaders[oldGen], 0)) XrdSysTimer::Wait(1);
 
 // When we set new access tables, we should purge the group cache
 //
    XrdAccConfiguration.GroupMaster.PurgeCache();
 
-// We can now let loose new table searchers
+// Hand back the old tables so that the caller deletes them
+//
+   newtab  = *oldtab;
+   *oldtab = XrdAccAccess_Tables();
+   delete oldtab;
+}
+
+/******************************************************************************/
+/* Private:                      T a b s G e t                                */
+/******************************************************************************/
+
+XrdAccAccess_Tables *XrdAccAccess::TabsGet(int &gen)
+{
+   unsigned int myGen;
+
+// Count ourselves as a reader of the current generation. Should the generation
+// change while doing so, the tables may already be gone by the time SwapTabs()
+// looks at our count; so try again.
+//
+   do {myGen = __sync_fetch_and_add(&tabGen, 0);
+       gen   = myGen & 1;
+       __sync_fetch_and_add(&tabReaders[gen], 1);
+       if (__sync_fetch_and_add(&tabGen, 0) == myGen) break;
+       __sync_fetch_and_sub(&tabReaders[gen], 1);
+      } while(1);
+
+// Return the tables, SwapTabs() installs new ones before changing generation
 //
-   Access_Context.UnLock(xs_Exclusive);
+   __sync_synchronize();
+   return Atab;
 }
 
 /******************************************************************************/
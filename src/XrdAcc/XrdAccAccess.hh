@@ -34,8 +34,7 @@
 #include "XrdAcc/XrdAccAuthorize.hh"
 #include "XrdAcc/XrdAccCapability.hh"
 #include "XrdSec/XrdSecEntity.hh"
-#include "XrdOuc/XrdOucHash.hh"
-#include "XrdSys/XrdSysXSLock.hh"
+#include "XrdOuc/XrdOucFlatHash.hh"
 #include "XrdSys/XrdSysPlatform.hh"
 
 /******************************************************************************/
@@ -81,14 +80,14 @@ struct XrdAccAccess_ID
        };
   
 struct XrdAccAccess_Tables
-       {XrdOucHash<XrdAccCapability> *G_Hash;  // Groups
-        XrdOucHash<XrdAccCapability> *H_Hash;  // Hosts
-        XrdOucHash<XrdAccCapability> *N_Hash;  // Netgroups
-        XrdOucHash<XrdAccCapability> *O_Hash;  // Organizations
-        XrdOucHash<XrdAccCapability> *R_Hash;  // Roles
-        XrdOucHash<XrdAccAccess_ID>  *S_Hash;  // Sets
-        XrdOucHash<XrdAccCapability> *T_Hash;  // Templates
-        XrdOucHash<XrdAccCapability> *U_Hash;  // Users
+       {XrdOucFlatHash<XrdAccCapability> *G_Hash;  // Groups
+        XrdOucFlatHash<XrdAccCapability> *H_Hash;  // Hosts
+        XrdOucFlatHash<XrdAccCapability> *N_Hash;  // Netgroups
+        XrdOucFlatHash<XrdAccCapability> *O_Hash;  // Organizations
+        XrdOucFlatHash<XrdAccCapability> *R_Hash;  // Roles
+        XrdOucFlatHash<XrdAccAccess_ID>  *S_Hash;  // Sets
+        XrdOucFlatHash<XrdAccCapability> *T_Hash;  // Templates
+        XrdOucFlatHash<XrdAccCapability> *U_Hash;  // Users
                   XrdAccCapName     *D_List;  // Domains
                   XrdAccCapName     *E_List;  // Domains (end of list)
                   XrdAccCapability  *X_List;  // Fungable capbailities
@@ -143,7 +142,8 @@ static
 const char       *Resolve(const XrdSecEntity *Entity);
 
 // SwapTabs() is used by the configuration object to establish new access
-// control tables. It may be called whenever the tables change.
+// control tables. It may be called whenever the tables change. The old tables
+// are handed back in newtab once no lookup is using them any more.
 //
 void              SwapTabs(struct XrdAccAccess_Tables &newtab);
 
@@ -160,9 +160,17 @@ XrdAccPrivs Access(      XrdAccPrivCaps  &caps,
                    const char            *path,
                    const Access_Operation oper);
 
-struct XrdAccAccess_Tables Atab;
+// Lookups do not lock the tables. They count themselves in the reader count
+// of the current table generation which SwapTabs() waits to drain after it
+// installs new tables.
+//
+struct XrdAccAccess_Tables *TabsGet(int &gen);
+void                        TabsRel(int gen)
+                                   {__sync_fetch_and_sub(&tabReaders[gen], 1);}
 
-XrdSysXSLock Access_Context;
+struct XrdAccAccess_Tables *Atab;
+unsigned int                tabGen;
+int                         tabReaders[2];
 
 XrdAccAudit *Auditor;
 };
@@ -28,6 +28,8 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <algorithm>
+
 #include "XrdAcc/XrdAccCapability.hh"
 
 /******************************************************************************/
@@ -46,7 +48,7 @@ XrdAccCapability::XrdAccCapability(char *pathval, XrdAccPrivCaps &privval)
 
 // Do common initialization
 //
-   next = 0; ctmp = 0;
+   next = 0; ctmp = 0; trie = 0;
    priv.pprivs = privval.pprivs; priv.nprivs = privval.nprivs;
    plen = strlen(pathval); pins = 0; prem = 0;
    pkey = XrdOucHashVal2((const char *)pathval, plen);
@@ -71,10 +73,21 @@ XrdAccCapability::~XrdAccCapability()
      XrdAccCapability *cp, *np = next;
 
      if (path) {free(path); path = 0;}
+     if (trie) {delete trie; trie = 0;}
 
      while(np) {cp = np; np = np->next; cp->next = 0; delete cp;}
      next = 0;
 }
+/******************************************************************************/
+/*                               C o m p i l e                                */
+/******************************************************************************/
+
+void XrdAccCapability::Compile()
+{
+   if (trie) delete trie;
+   trie = new XrdAccCapTrie(this);
+}
+
 /******************************************************************************/
 /*                                 P r i v s                                  */
 /******************************************************************************/
@@ -87,6 +100,8 @@ int XrdAccCapability::Privs(      XrdAccPrivCaps &pathpriv,
 {XrdAccCapability *cp=this;
  const int psl = (pathsub ? strlen(pathsub) : 0);
 
+ if (trie && !pathsub) return trie->Privs(pathpriv, pathname, pathlen);
+
  do {if (cp->ctmp)
        {if (cp->ctmp->Privs(pathpriv,pathname,pathlen,pathhash,pathsub))
            return 1;
@@ -131,6 +146,116 @@ int XrdAccCapability::Subcomp(const char *pathname, const int pathlen,
    return 1;
 }
 
+/******************************************************************************/
+/*                         X r d A c c C a p T r i e                          */
+/******************************************************************************/
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdAccCapTrie::XrdAccCapTrie(XrdAccCapability *cap)
+{
+   Kids kids;
+   Node root;
+
+// Build the trie with the children of each node kept apart
+//
+   root.rule = noRule;
+   Nodes.push_back(root);
+   kids.resize(1);
+   Expand(cap, 0, kids);
+
+// Now lay out the edges of each node contiguously and sorted by key
+//
+   for (unsigned int i = 0; i < Nodes.size(); i++)
+       {std::sort(kids[i].begin(), kids[i].end());
+        Nodes[i].edge  = eKey.size();
+        Nodes[i].nedge = kids[i].size();
+        for (unsigned int k = 0; k < kids[i].size(); k++)
+            {eKey.push_back(kids[i][k].first);
+             eNode.push_back(kids[i][k].second);
+            }
+       }
+
+// Children are always created after their parent so a backward pass finds
+// the earliest rule in each subtree
+//
+   for (int i = Nodes.size()-1; i >= 0; i--)
+       {Nodes[i].least = Nodes[i].rule;
+        for (int k = 0; k < Nodes[i].nedge; k++)
+            {int least = Nodes[eNode[Nodes[i].edge+k]].least;
+             if (least < Nodes[i].least) Nodes[i].least = least;
+            }
+       }
+}
+
+/******************************************************************************/
+/* Private:                       E x p a n d                                 */
+/******************************************************************************/
+
+int XrdAccCapTrie::Expand(XrdAccCapability *cap, int rule, Kids &kids)
+{
+   unsigned int k;
+   int n;
+
+// Add each path in list order, expanding templates where they are referenced
+//
+   for (; cap; cap = cap->next)
+       {if (cap->ctmp) {rule = Expand(cap->ctmp, rule, kids); continue;}
+        n = 0;
+        for (int i = 0; i < cap->plen; i++)
+            {unsigned char c = cap->path[i];
+             for (k = 0; k < kids[n].size() && kids[n][k].first != c; k++) {}
+             if (k < kids[n].size()) {n = kids[n][k].second; continue;}
+             Node node;
+             node.rule = noRule;
+             kids[n].push_back(std::make_pair(c, (int)Nodes.size()));
+             n = Nodes.size();
+             Nodes.push_back(node);
+             kids.resize(Nodes.size());
+            }
+        if (Nodes[n].rule == noRule)
+           {Nodes[n].rule = rule;
+            Nodes[n].priv = cap->priv;
+           }
+        rule++;
+       }
+   return rule;
+}
+
+/******************************************************************************/
+/*                                 P r i v s                                  */
+/******************************************************************************/
+
+int XrdAccCapTrie::Privs(      XrdAccPrivCaps &pathpriv,
+                         const char           *pathname,
+                         const int             pathlen) const
+{
+   const unsigned char *kBeg, *kEnd, *kP;
+   const Node *np = &Nodes[0], *hit = 0;
+   int best = noRule;
+
+// Walk down the path remembering the earliest rule passed along the way. Stop
+// when no deeper node can hold an earlier rule.
+//
+   if (np->rule < best) {best = np->rule; hit = np;}
+   for (int i = 0; i < pathlen && np->least < best && np->nedge; i++)
+       {kBeg = &eKey[0] + np->edge;
+        kEnd = kBeg + np->nedge;
+        kP   = std::lower_bound(kBeg, kEnd, (unsigned char)pathname[i]);
+        if (kP == kEnd || *kP != (unsigned char)pathname[i]) break;
+        np = &Nodes[eNode[kP - &eKey[0]]];
+        if (np->rule < best) {best = np->rule; hit = np;}
+       }
+
+// Add in the privileges of the rule that applies, if any
+//
+   if (!hit) return 0;
+   pathpriv.pprivs = (XrdAccPrivs)(pathpriv.pprivs | hit->priv.pprivs);
+   pathpriv.nprivs = (XrdAccPrivs)(pathpriv.nprivs | hit->priv.nprivs);
+   return 1;
+}
+
 /******************************************************************************/
 /*                         X r d A c c C a p N a m e                          */
 /******************************************************************************/
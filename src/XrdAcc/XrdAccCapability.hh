@@ -33,9 +33,13 @@
 #include <stdlib.h>
 #include <string.h>
 #include <strings.h>
+#include <utility>
+#include <vector>
 
 #include "XrdAcc/XrdAccPrivs.hh"
 
+class XrdAccCapTrie;
+
 /******************************************************************************/
 /*                      X r d A c c C a p a b i l i t y                       */
 /******************************************************************************/
@@ -76,17 +80,27 @@ int                 Privs(      XrdAccPrivCaps &pathpriv,
 int                 Subcomp(const char *pathname, const int pathlen,
                             const char *pathsub,  const int sublen);
 
+// Compile() turns the list headed by this capability into a prefix trie so
+// that Privs() takes time proportional to the path length instead of the
+// number of capabilities. It is called once the list is complete. Lookups
+// with a substitution (pathsub) still walk the list.
+//
+void                Compile();
+
                   XrdAccCapability(char *pathval, XrdAccPrivCaps &privval);
 
                   XrdAccCapability(XrdAccCapability *taddr)
-                        {next = 0; ctmp = taddr;
+                        {next = 0; ctmp = taddr; trie = 0;
                          pkey = 0; path = 0; plen = 0; pins = 0; prem = 0;
                         }
 
                  ~XrdAccCapability();
 private:
+friend class XrdAccCapTrie;
+
 XrdAccCapability *next;      // -> Next capability
 XrdAccCapability *ctmp;      // -> Capability template
+XrdAccCapTrie    *trie;      // -> Compiled list (list head only)
 
 /*----------- The below fields are valid when template is zero -----------*/
 
@@ -98,6 +112,48 @@ int              pins;    // index of @=
 int              prem;    // remaining length after @=
 };
 
+/******************************************************************************/
+/*                         X r d A c c C a p T r i e                          */
+/******************************************************************************/
+
+// XrdAccCapTrie is an immutable character trie compiled from a capability list
+// with any templates expanded in place. A rule path ends at a node holding the
+// rule's position in the list; a lookup follows the path down the trie and
+// picks the earliest rule it passes, which is the one a walk of the list would
+// have found. Nodes also record the earliest rule below them so that the walk
+// stops as soon as nothing deeper could win.
+//
+class XrdAccCapTrie
+{
+public:
+
+int                 Privs(      XrdAccPrivCaps &pathpriv,
+                          const char           *pathname,
+                          const int             pathlen) const;
+
+                    XrdAccCapTrie(XrdAccCapability *cap);
+                   ~XrdAccCapTrie() {}
+private:
+
+struct Node
+      {XrdAccPrivCaps priv;
+       int            edge;    // Index of the first edge in eKey/eNode
+       int            nedge;   // Number of edges, sorted by key
+       int            rule;    // Rule ending here or noRule
+       int            least;   // Earliest rule in this subtree
+      };
+
+static const int    noRule = 0x7fffffff;
+
+typedef std::vector<std::vector<std::pair<unsigned char, int> > > Kids;
+
+int                 Expand(XrdAccCapability *cap, int rule, Kids &kids);
+
+std::vector<Node>           Nodes;
+std::vector<unsigned char>  eKey;
+std::vector<int>            eNode;
+};
+
 /******************************************************************************/
 /*                         X r d A c c C a p N a m e                          */
 /******************************************************************************/
@@ -185,13 +185,13 @@ int XrdAccConfig::ConfigDB(int Warm, XrdSysError &Eroute)
 
 // Allocate new hash tables
 //
-   if (!(tabs.G_Hash = new XrdOucHash<XrdAccCapability>()) ||
-       !(tabs.H_Hash = new XrdOucHash<XrdAccCapability>()) ||
-       !(tabs.N_Hash = new XrdOucHash<XrdAccCapability>()) ||
-       !(tabs.O_Hash = new XrdOucHash<XrdAccCapability>()) ||
-       !(tabs.R_Hash = new XrdOucHash<XrdAccCapability>()) ||
-       !(tabs.T_Hash = new XrdOucHash<XrdAccCapability>()) ||
-       !(tabs.U_Hash = new XrdOucHash<XrdAccCapability>()) )
+   if (!(tabs.G_Hash = new XrdOucFlatHash<XrdAccCapability>()) ||
+       !(tabs.H_Hash = new XrdOucFlatHash<XrdAccCapability>()) ||
+       !(tabs.N_Hash = new XrdOucFlatHash<XrdAccCapability>()) ||
+       !(tabs.O_Hash = new XrdOucFlatHash<XrdAccCapability>()) ||
+       !(tabs.R_Hash = new XrdOucFlatHash<XrdAccCapability>()) ||
+       !(tabs.T_Hash = new XrdOucFlatHash<XrdAccCapability>()) ||
+       !(tabs.U_Hash = new XrdOucFlatHash<XrdAccCapability>()) )
       {Eroute.Emsg("ConfigDB","Insufficient storage for id tables.");
        Database->Close(); return 1;
       }
@@ -543,7 +543,7 @@ int XrdAccConfig::ConfigDBrec(XrdSysError &Eroute,
     int alluser = 0, anyuser = 0, domname = 0, NoGo = 0;
     DB_RecType rectype;
     XrdAccAccess_ID *sp = 0;
-    XrdOucHash<XrdAccCapability> *hp;
+    XrdOucFlatHash<XrdAccCapability> *hp;
     XrdAccGroupType gtype = XrdAccNoGroup;
     XrdAccPrivCaps xprivs;
     XrdAccCapability mycap((char *)"", xprivs), *currcap, *lastcap = &mycap;
@@ -653,6 +653,11 @@ int XrdAccConfig::ConfigDBrec(XrdSysError &Eroute,
        return -1;
       }
 
+   // Compile the capabilities for lookup. Templates are expanded wherever
+   // they are used and the any user list needs to substitute the user name.
+   //
+   if (rectype != Template_ID && !anyuser) mycap.Next()->Compile();
+
    // Insert the capability into the appropriate table/list
    //
         if (sp) sp->caps = mycap.Next();
@@ -773,7 +778,7 @@ int XrdAccConfig::idDef(XrdSysError &Eroute,
 
 // Make sure this name has not been specified before
 //
-   if (!tabs.S_Hash) tabs.S_Hash = new XrdOucHash<XrdAccAccess_ID>;
+   if (!tabs.S_Hash) tabs.S_Hash = new XrdOucFlatHash<XrdAccAccess_ID>;
       else if (tabs.S_Hash->Find(theID.name))
               {Eroute.Emsg("ConfigXeq","duplicate id definition -",theID.name);
                return -1;
@@ -71,7 +71,8 @@ struct XrdAccGroupArgs {const char   *user;
 /*                           C o n s t r u c t o r                            */
 /******************************************************************************/
   
-XrdAccGroups::XrdAccGroups()
+XrdAccGroups::XrdAccGroups() : NetGroup_Cache(89, 144, 80, true),
+                                  Group_Cache(89, 144, 80, true)
 {
 
 // Do standard initialization
@@ -91,7 +92,7 @@ XrdAccGroups::XrdAccGroups()
 char *XrdAccGroups::AddName(const XrdAccGroupType gtype, const char *name)
 {
    char *np;
-   XrdOucHash<char> *hp;
+   XrdOucFlatHash<char> *hp;
 
 // Prepare to add a group name
 //
@@ -160,11 +161,11 @@ char *Gtab[NGROUPS_MAX];
    if (!HaveGroups) return (XrdAccGroupList *)0;
 
 
-// Check if we already have this user in the group cache. Since we may be
-// modifying the cache, we need to have exclusive control over it. We must
-// copy the group cache because the original may be deleted at any time.
+// Check if we already have this user in the group cache. The cache is
+// read-mostly so lookups never modify it and may run concurrently. We must
+// copy the group cache because the original may be deleted once we unlock.
 //
-   Group_Cache_Context.Lock();
+   Group_Cache_Context.ReadLock();
    if ((glist = Group_Cache.Find(user)))
       {if (glist->First()) glist = new XrdAccGroupList(*glist);
           else glist = 0;
@@ -215,7 +216,7 @@ char *Gtab[NGROUPS_MAX];
 
 // Add this user to the group cache to speed things up the next time
 //
-   Group_Cache_Context.Lock();
+   Group_Cache_Context.WriteLock();
    Group_Cache.Add(user, glist, LifeTime);
    Group_Cache_Context.UnLock();
 
@@ -249,11 +250,12 @@ int XrdAccCheckNetGroup(const char *netgroup, char *key, void *Arg);
    uh_key[i] = '@';
    strcpy(&uh_key[i+1], host);
 
-// Check if we already have this user in the group cache. Since we may be
-// modifying the cache, we need to have exclusive control over it. We must
-// copy the group cache entry because the original may be deleted at any time.
+// Check if we already have this user in the group cache. The cache is
+// read-mostly so lookups never modify it and may run concurrently. We must
+// copy the group cache entry because the original may be deleted once we
+// unlock.
 //
-   NetGroup_Cache_Context.Lock();
+   NetGroup_Cache_Context.ReadLock();
    if ((glist = NetGroup_Cache.Find(uh_key)))
       {if (glist->First()) glist = new XrdAccGroupList(*glist);
           else glist = 0;
@@ -278,7 +280,7 @@ int XrdAccCheckNetGroup(const char *netgroup, char *key, void *Arg);
 
 // Add this user to the group cache to speed things up the next time
 //
-   NetGroup_Cache_Context.Lock();
+   NetGroup_Cache_Context.WriteLock();
    NetGroup_Cache.Add((const char *)uh_key, glist, LifeTime);
    NetGroup_Cache_Context.UnLock();
 
@@ -298,13 +300,13 @@ void XrdAccGroups::PurgeCache()
 
 // Purge the group cache
 //
-   Group_Cache_Context.Lock();
+   Group_Cache_Context.WriteLock();
    Group_Cache.Purge();
    Group_Cache_Context.UnLock();
 
 // Purge the netgroup cache
 //
-   NetGroup_Cache_Context.Lock();
+   NetGroup_Cache_Context.WriteLock();
    NetGroup_Cache.Purge();
    NetGroup_Cache_Context.UnLock();
 }
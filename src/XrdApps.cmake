@@ -23,8 +23,7 @@ target_link_libraries(
   xrdadler32
   XrdPosix
   XrdUtils
-  pthread
-  ${ZLIB_LIBRARY} )
+  pthread )
 
 #-------------------------------------------------------------------------------
 # cconfig
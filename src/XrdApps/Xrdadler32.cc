@@ -46,12 +46,13 @@
 #ifdef __linux__
   #include <sys/xattr.h>
 #endif
-#include <zlib.h>
+#include <netinet/in.h>
 
 #include "XrdPosix/XrdPosixXrootd.hh"
 #include "XrdPosix/XrdPosixXrootdPath.hh"
 #include "XrdOuc/XrdOucString.hh"
 
+#include "XrdCks/XrdCksCalcadler32.hh"
 #include "XrdCks/XrdCksXAttr.hh"
 #include "XrdOuc/XrdOucXAttr.hh"
 
@@ -165,8 +166,8 @@ int main(int argc, char *argv[])
     const char attr[] = "user.checksum.adler32";
     struct stat stbuf;
     int fd, len, rc;
-    uLong adler;
-    adler = adler32(0L, Z_NULL, 0);
+    unsigned int adler;
+    XrdCksCalcadler32 adlerCalc;
 
     if (argc == 2 && ! strcmp(argv[1], "-h"))
     {
@@ -209,15 +210,16 @@ int main(int argc, char *argv[])
             strcpy(path, "-");
         }
         while ( (len = read(fd, buf, N)) > 0 )
-            adler = adler32(adler, (const Bytef*)buf, len);
+            adlerCalc.Update(buf, len);
+        adler = ntohl(*(unsigned int *)adlerCalc.Final());
 
         if (fd != STDIN_FILENO) 
         {   /* try saving adler32 to attribute before close() */
-            sprintf(adler_str, "%08lx", adler);
+            sprintf(adler_str, "%08x", adler);
             fSetXattrAdler32(path, fd, attr, adler_str);
             close(fd);
         }
-        printf("%08lx %s\n", adler, path);
+        printf("%08x %s\n", adler, path);
         return 0;
     }
     else
@@ -238,10 +240,11 @@ int main(int argc, char *argv[])
                 return 1;
             }
             while ( (len = XrdPosixXrootd::Read(fd, buf, N)) > 0 )
-                adler = adler32(adler, (const Bytef*)buf, len);
+                adlerCalc.Update(buf, len);
+            adler = ntohl(*(unsigned int *)adlerCalc.Final());
 
             XrdPosixXrootd::Close(fd);
-            printf("%08lx %s\n", adler, argv[1]);
+            printf("%08x %s\n", adler, argv[1]);
             return 0;
         }
     }
@@ -0,0 +1,314 @@
+/******************************************************************************/
+/*                                                                            */
+/*                  X r d C k s C a l c a d l e r 3 2 . c c                   */
+/*                                                                            */
+/* (c) 2026 by the contributors to the XRootD software suite                  */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <string.h>
+#include <pthread.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define XRDCKS_X86 1
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define XRDCKS_NEON 1
+#endif
+
+#include "XrdCks/XrdCksCalcadler32.hh"
+
+/* The scalar kernel below was derived from zlib 1.1.4 (see the license terms
+   in XrdCksCalcadler32.hh). The vector kernels use the same recurrence, but
+   consume a block of B bytes per step: s1 gains the plain byte sum and s2
+   gains B times the old s1 plus the byte sum weighted B, B-1, ..., 1. Both
+   sums are carried per lane and folded modulo BASE once every NMAX bytes.
+*/
+
+/******************************************************************************/
+/*                        L o c a l   D e f i n e s                           */
+/******************************************************************************/
+  
+#define DO1(buf)  {unSum1 += *buf++; unSum2 += unSum1;}
+#define DO2(buf)  DO1(buf); DO1(buf);
+#define DO4(buf)  DO2(buf); DO2(buf);
+#define DO8(buf)  DO4(buf); DO4(buf);
+#define DO16(buf) DO8(buf); DO8(buf);
+
+namespace
+{
+const unsigned int AdlerBase = 0xFFF1;
+
+/* NMAX is the largest n such that 255n(n+1)/2 + (n+1)(BASE-1) <= 2^32-1 */
+
+const          int AdlerNMax = 5552;
+
+/******************************************************************************/
+/*                         S c a l a r   K e r n e l                          */
+/******************************************************************************/
+  
+void Scalar(unsigned int &s1, unsigned int &s2, const unsigned char *buff,
+            int BLen)
+{
+   unsigned int unSum1 = s1, unSum2 = s2;
+   int k;
+
+   while(BLen > 0)
+        {k = (BLen < AdlerNMax ? BLen : AdlerNMax);
+         BLen -= k;
+         while(k >= 16) {DO16(buff); k -= 16;}
+         if (k != 0) do {DO1(buff);} while (--k);
+         unSum1 %= AdlerBase; unSum2 %= AdlerBase;
+        }
+   s1 = unSum1; s2 = unSum2;
+}
+
+/******************************************************************************/
+/*                            x 8 6   K e r n e l s                           */
+/******************************************************************************/
+
+#ifdef XRDCKS_X86
+
+__attribute__((target("ssse3")))
+void SSSE3(unsigned int &s1, unsigned int &s2, const unsigned char *buff,
+           int BLen)
+{
+   const __m128i wgt  = _mm_setr_epi8(16,15,14,13,12,11,10, 9,
+                                       8, 7, 6, 5, 4, 3, 2, 1);
+   const __m128i ones = _mm_set1_epi16(1);
+   const __m128i zero = _mm_setzero_si128();
+   unsigned int unSum1 = s1, unSum2 = s2;
+   int k, n;
+
+   while(BLen > 0)
+        {k = (BLen < AdlerNMax ? BLen : AdlerNMax);
+         BLen -= k;
+         if ((n = k / 16))
+            {__m128i vs1 = _mm_cvtsi32_si128(unSum1);
+             __m128i vs2 = _mm_cvtsi32_si128(unSum2);
+             __m128i vs0 = zero;
+             k -= n * 16;
+             do {__m128i v = _mm_loadu_si128((const __m128i *)buff);
+                 vs0 = _mm_add_epi32(vs0, vs1);
+                 vs1 = _mm_add_epi32(vs1, _mm_sad_epu8(v, zero));
+                 vs2 = _mm_add_epi32(vs2,
+                       _mm_madd_epi16(_mm_maddubs_epi16(v, wgt), ones));
+                 buff += 16;
+                } while(--n);
+             vs2 = _mm_add_epi32(vs2, _mm_slli_epi32(vs0, 4));
+             vs1 = _mm_add_epi32(vs1, _mm_shuffle_epi32(vs1, 0x4e));
+             vs2 = _mm_add_epi32(vs2, _mm_shuffle_epi32(vs2, 0x4e));
+             vs2 = _mm_add_epi32(vs2, _mm_shuffle_epi32(vs2, 0xb1));
+             unSum1 = _mm_cvtsi128_si32(vs1);
+             unSum2 = _mm_cvtsi128_si32(vs2);
+            }
+         if (k != 0) do {DO1(buff);} while (--k);
+         unSum1 %= AdlerBase; unSum2 %= AdlerBase;
+        }
+   s1 = unSum1; s2 = unSum2;
+}
+
+__attribute__((target("avx2")))
+void AVX2(unsigned int &s1, unsigned int &s2, const unsigned char *buff,
+          int BLen)
+{
+   const __m256i wgt  = _mm256_setr_epi8(32,31,30,29,28,27,26,25,
+                                         24,23,22,21,20,19,18,17,
+                                         16,15,14,13,12,11,10, 9,
+                                          8, 7, 6, 5, 4, 3, 2, 1);
+   const __m256i ones = _mm256_set1_epi16(1);
+   const __m256i zero = _mm256_setzero_si256();
+   unsigned int unSum1 = s1, unSum2 = s2;
+   int k, n;
+
+   while(BLen > 0)
+        {k = (BLen < AdlerNMax ? BLen : AdlerNMax);
+         BLen -= k;
+         if ((n = k / 32))
+            {__m256i vs1 = _mm256_setr_epi32(unSum1, 0, 0, 0, 0, 0, 0, 0);
+             __m256i vs2 = _mm256_setr_epi32(unSum2, 0, 0, 0, 0, 0, 0, 0);
+             __m256i vs0 = zero;
+             k -= n * 32;
+             do {__m256i v = _mm256_loadu_si256((const __m256i *)buff);
+                 vs0 = _mm256_add_epi32(vs0, vs1);
+                 vs1 = _mm256_add_epi32(vs1, _mm256_sad_epu8(v, zero));
+                 vs2 = _mm256_add_epi32(vs2,
+                       _mm256_madd_epi16(_mm256_maddubs_epi16(v, wgt), ones));
+                 buff += 32;
+                } while(--n);
+             vs2 = _mm256_add_epi32(vs2, _mm256_slli_epi32(vs0, 5));
+             __m128i h1 = _mm_add_epi32(_mm256_castsi256_si128(vs1),
+                                        _mm256_extracti128_si256(vs1, 1));
+             __m128i h2 = _mm_add_epi32(_mm256_castsi256_si128(vs2),
+                                        _mm256_extracti128_si256(vs2, 1));
+             h1 = _mm_add_epi32(h1, _mm_shuffle_epi32(h1, 0x4e));
+             h2 = _mm_add_epi32(h2, _mm_shuffle_epi32(h2, 0x4e));
+             h2 = _mm_add_epi32(h2, _mm_shuffle_epi32(h2, 0xb1));
+             unSum1 = _mm_cvtsi128_si32(h1);
+             unSum2 = _mm_cvtsi128_si32(h2);
+            }
+         if (k != 0) do {DO1(buff);} while (--k);
+         unSum1 %= AdlerBase; unSum2 %= AdlerBase;
+        }
+   s1 = unSum1; s2 = unSum2;
+}
+
+bool HaveSSSE3() {__builtin_cpu_init(); return __builtin_cpu_supports("ssse3");}
+bool HaveAVX2()  {__builtin_cpu_init(); return __builtin_cpu_supports("avx2");}
+#endif
+
+/******************************************************************************/
+/*                           N E O N   K e r n e l                            */
+/******************************************************************************/
+
+#ifdef XRDCKS_NEON
+
+void NEON(unsigned int &s1, unsigned int &s2, const unsigned char *buff,
+          int BLen)
+{
+   static const uint8_t wtab[16] = {16,15,14,13,12,11,10, 9,
+                                     8, 7, 6, 5, 4, 3, 2, 1};
+   const uint8x8_t wlo = vld1_u8(wtab), whi = vld1_u8(wtab+8);
+   unsigned int unSum1 = s1, unSum2 = s2;
+   int k, n;
+
+   while(BLen > 0)
+        {k = (BLen < AdlerNMax ? BLen : AdlerNMax);
+         BLen -= k;
+         if ((n = k / 16))
+            {uint32x4_t vs1 = vsetq_lane_u32(unSum1, vdupq_n_u32(0), 0);
+             uint32x4_t vs2 = vsetq_lane_u32(unSum2, vdupq_n_u32(0), 0);
+             uint32x4_t vs0 = vdupq_n_u32(0);
+             k -= n * 16;
+             do {uint8x16_t v = vld1q_u8(buff);
+                 vs0 = vaddq_u32(vs0, vs1);
+                 vs1 = vpadalq_u16(vs1, vpaddlq_u8(v));
+                 uint16x8_t p = vmull_u8(vget_low_u8(v), wlo);
+                 p   = vmlal_u8(p, vget_high_u8(v), whi);
+                 vs2 = vpadalq_u16(vs2, p);
+                 buff += 16;
+                } while(--n);
+             vs2 = vaddq_u32(vs2, vshlq_n_u32(vs0, 4));
+             unSum1 = vaddvq_u32(vs1);
+             unSum2 = vaddvq_u32(vs2);
+            }
+         if (k != 0) do {DO1(buff);} while (--k);
+         unSum1 %= AdlerBase; unSum2 %= AdlerBase;
+        }
+   s1 = unSum1; s2 = unSum2;
+}
+
+bool HaveNEON() {return true;}
+#endif
+
+/******************************************************************************/
+/*                          K e r n e l   T a b l e                           */
+/******************************************************************************/
+
+bool HaveAny() {return true;}
+
+struct AdlerKernel
+      {const char *Name;
+       void      (*Func)(unsigned int &, unsigned int &,
+                         const unsigned char *, int);
+       bool      (*Have)();
+      };
+
+// In order of preference
+//
+const AdlerKernel kTab[] =
+{
+#ifdef XRDCKS_X86
+      {"avx2",   AVX2,   HaveAVX2},
+      {"ssse3",  SSSE3,  HaveSSSE3},
+#endif
+#ifdef XRDCKS_NEON
+      {"neon",   NEON,   HaveNEON},
+#endif
+      {"scalar", Scalar, HaveAny}
+};
+
+const int kNum = sizeof(kTab)/sizeof(kTab[0]);
+
+pthread_once_t kOnce = PTHREAD_ONCE_INIT;
+}
+
+/******************************************************************************/
+/*                        S t a t i c   M e m b e r s                         */
+/******************************************************************************/
+  
+XrdCksCalcadler32::KernelFunc XrdCksCalcadler32::Kernel =
+                              XrdCksCalcadler32::Dispatch;
+
+const char                   *XrdCksCalcadler32::KernelName = 0;
+
+/******************************************************************************/
+/*                              D i s p a t c h                               */
+/******************************************************************************/
+
+void XrdCksCalcadler32::Dispatch(unsigned int &s1, unsigned int &s2,
+                                 const unsigned char *buff, int blen)
+{
+   pthread_once(&kOnce, SetUp);
+   Kernel(s1, s2, buff, blen);
+}
+
+/******************************************************************************/
+/*                                E n g i n e                                 */
+/******************************************************************************/
+
+const char *XrdCksCalcadler32::Engine()
+{
+   pthread_once(&kOnce, SetUp);
+   return KernelName;
+}
+
+/******************************************************************************/
+
+bool XrdCksCalcadler32::Engine(const char *name)
+{
+   pthread_once(&kOnce, SetUp);
+
+// A null name selects the first kernel the cpu supports, as SetUp() does
+//
+   for (int i = 0; i < kNum; i++)
+       {if (name && strcmp(name, kTab[i].Name)) continue;
+        if (!kTab[i].Have()) {if (name) return false; continue;}
+        Kernel = kTab[i].Func; KernelName = kTab[i].Name;
+        return true;
+       }
+   return false;
+}
+
+/******************************************************************************/
+/*                                 S e t U p                                  */
+/******************************************************************************/
+
+void XrdCksCalcadler32::SetUp()
+{
+   for (int i = 0; i < kNum; i++)
+       if (kTab[i].Have())
+          {KernelName = kTab[i].Name; Kernel = kTab[i].Func; return;}
+}
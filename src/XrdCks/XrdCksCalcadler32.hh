@@ -72,12 +72,6 @@
   (zlib format), rfc1951.txt (deflate format) and rfc1952.txt (gzip format).
 */
 
-#define DO1(buf)  {unSum1 += *buf++; unSum2 += unSum1;}
-#define DO2(buf)  DO1(buf); DO1(buf);
-#define DO4(buf)  DO2(buf); DO2(buf);
-#define DO8(buf)  DO4(buf); DO4(buf);
-#define DO16(buf) DO8(buf); DO8(buf);
-
 class XrdCksCalcadler32 : public XrdCksCalc
 {
 public:
@@ -95,29 +89,38 @@ void        Init() {unSum1 = AdlerStart; unSum2 = 0;}
 XrdCksCalc *New() {return (XrdCksCalc *)new XrdCksCalcadler32;}
 
 void        Update(const char *Buff, int BLen)
-                  {int k;
-                   unsigned char *buff = (unsigned char *)Buff;
-                   while(BLen > 0)
-                        {k = (BLen < AdlerNMax ? BLen : AdlerNMax);
-                         BLen -= k;
-                         while(k >= 16) {DO16(buff); k -= 16;}
-                         if (k != 0) do {DO1(buff);} while (--k);
-                         unSum1 %= AdlerBase; unSum2 %= AdlerBase;
-                        }
+                  {if (BLen > 0)
+                      Kernel(unSum1, unSum2, (const unsigned char *)Buff, BLen);
                   }
 
 const char *Type(int &csSize) {csSize = sizeof(AdlerValue); return "adler32";}
 
+// The update kernel is chosen on first use according to what the cpu supports
+// (avx2, ssse3, or neon; otherwise scalar). Engine() returns its name and
+// Engine(name) forces a particular kernel, returning false if the cpu lacks it
+// or name is unknown; a null name restores the automatic choice. Forcing is
+// meant for testing and benchmarking and is process-wide.
+//
+static const char *Engine();
+
+static bool        Engine(const char *name);
+
             XrdCksCalcadler32() {Init();}
 virtual    ~XrdCksCalcadler32() {}
 
 private:
 
-static const unsigned int AdlerBase  = 0xFFF1;
 static const unsigned int AdlerStart = 0x0001;
-static const          int AdlerNMax  = 5552;
 
-/* NMAX is the largest n such that 255n(n+1)/2 + (n+1)(BASE-1) <= 2^32-1 */
+typedef void (*KernelFunc)(unsigned int &, unsigned int &,
+                           const unsigned char *, int);
+
+static  void        Dispatch(unsigned int &s1, unsigned int &s2,
+                             const unsigned char *buff, int blen);
+static  void        SetUp();
+
+static  KernelFunc  Kernel;
+static  const char *KernelName;
 
              unsigned int AdlerValue;
              unsigned int unSum1;
@@ -0,0 +1,243 @@
+/******************************************************************************/
+/*                                                                            */
+/*                   X r d C k s C a l c c r c 3 2 c . c c                    */
+/*                                                                            */
+/* (c) 2026 by the contributors to the XRootD software suite                  */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <string.h>
+#include <pthread.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define XRDCKS_X86 1
+#endif
+
+#if defined(__GNUC__) && defined(__aarch64__) && defined(__linux__)
+#include <arm_acle.h>
+#include <sys/auxv.h>
+#ifndef HWCAP_CRC32
+#define HWCAP_CRC32 (1 << 7)
+#endif
+#define XRDCKS_ARMCRC 1
+#endif
+
+#include "XrdCks/XrdCksCalccrc32c.hh"
+
+namespace
+{
+/******************************************************************************/
+/*                          T a b l e   K e r n e l                           */
+/******************************************************************************/
+
+// Reflected polynomial; crcTab[k][b] is the crc of byte b followed by k zeros.
+//
+const uint32_t Poly = 0x82f63b78;
+
+uint32_t crcTab[8][256];
+
+void MakeTable()
+{
+   for (int b = 0; b < 256; b++)
+       {uint32_t crc = b;
+        for (int i = 0; i < 8; i++) crc = (crc >> 1) ^ (Poly & (0 - (crc & 1)));
+        crcTab[0][b] = crc;
+       }
+   for (int b = 0; b < 256; b++)
+       for (int k = 1; k < 8; k++)
+           crcTab[k][b] = (crcTab[k-1][b] >> 8) ^ crcTab[0][crcTab[k-1][b] & 0xff];
+}
+
+uint32_t Table(uint32_t crc, const unsigned char *buff, int blen)
+{
+   while(blen && ((uintptr_t)buff & 7))
+        {crc = (crc >> 8) ^ crcTab[0][(crc ^ *buff++) & 0xff]; blen--;}
+
+   while(blen >= 8)
+        {uint32_t lo, hi;
+         memcpy(&lo, buff, 4); memcpy(&hi, buff+4, 4);
+#ifdef Xrd_Big_Endian
+         lo = __builtin_bswap32(lo); hi = __builtin_bswap32(hi);
+#endif
+         lo ^= crc;
+         crc = crcTab[7][ lo        & 0xff] ^ crcTab[6][(lo >>  8) & 0xff]
+             ^ crcTab[5][(lo >> 16) & 0xff] ^ crcTab[4][ lo >> 24        ]
+             ^ crcTab[3][ hi        & 0xff] ^ crcTab[2][(hi >>  8) & 0xff]
+             ^ crcTab[1][(hi >> 16) & 0xff] ^ crcTab[0][ hi >> 24        ];
+         buff += 8; blen -= 8;
+        }
+
+   while(blen--) crc = (crc >> 8) ^ crcTab[0][(crc ^ *buff++) & 0xff];
+   return crc;
+}
+
+bool HaveAny() {return true;}
+
+/******************************************************************************/
+/*                            x 8 6   K e r n e l                             */
+/******************************************************************************/
+
+#ifdef XRDCKS_X86
+
+__attribute__((target("sse4.2")))
+uint32_t SSE42(uint32_t crc, const unsigned char *buff, int blen)
+{
+   while(blen && ((uintptr_t)buff & 7))
+        {crc = _mm_crc32_u8(crc, *buff++); blen--;}
+
+#ifdef __x86_64__
+   uint64_t crc64 = crc;
+   while(blen >= 8)
+        {uint64_t v;
+         memcpy(&v, buff, 8);
+         crc64 = _mm_crc32_u64(crc64, v);
+         buff += 8; blen -= 8;
+        }
+   crc = (uint32_t)crc64;
+#endif
+   while(blen >= 4)
+        {uint32_t v;
+         memcpy(&v, buff, 4);
+         crc = _mm_crc32_u32(crc, v);
+         buff += 4; blen -= 4;
+        }
+
+   while(blen--) crc = _mm_crc32_u8(crc, *buff++);
+   return crc;
+}
+
+bool HaveSSE42() {__builtin_cpu_init(); return __builtin_cpu_supports("sse4.2");}
+#endif
+
+/******************************************************************************/
+/*                          A R M v 8   K e r n e l                           */
+/******************************************************************************/
+
+#ifdef XRDCKS_ARMCRC
+
+__attribute__((target("+crc")))
+uint32_t ARMv8(uint32_t crc, const unsigned char *buff, int blen)
+{
+   while(blen && ((uintptr_t)buff & 7))
+        {crc = __crc32cb(crc, *buff++); blen--;}
+
+   while(blen >= 8)
+        {uint64_t v;
+         memcpy(&v, buff, 8);
+         crc = __crc32cd(crc, v);
+         buff += 8; blen -= 8;
+        }
+
+   while(blen--) crc = __crc32cb(crc, *buff++);
+   return crc;
+}
+
+bool HaveARMv8() {return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;}
+#endif
+
+/******************************************************************************/
+/*                          K e r n e l   T a b l e                           */
+/******************************************************************************/
+
+struct CrcKernel
+      {const char *Name;
+       uint32_t  (*Func)(uint32_t, const unsigned char *, int);
+       bool      (*Have)();
+      };
+
+// In order of preference
+//
+const CrcKernel kTab[] =
+{
+#ifdef XRDCKS_X86
+      {"sse4.2",   SSE42, HaveSSE42},
+#endif
+#ifdef XRDCKS_ARMCRC
+      {"armv8crc", ARMv8, HaveARMv8},
+#endif
+      {"table",    Table, HaveAny}
+};
+
+const int kNum = sizeof(kTab)/sizeof(kTab[0]);
+
+pthread_once_t kOnce = PTHREAD_ONCE_INIT;
+}
+
+/******************************************************************************/
+/*                        S t a t i c   M e m b e r s                         */
+/******************************************************************************/
+  
+XrdCksCalccrc32c::KernelFunc XrdCksCalccrc32c::Kernel =
+                             XrdCksCalccrc32c::Dispatch;
+
+const char                  *XrdCksCalccrc32c::KernelName = 0;
+
+/******************************************************************************/
+/*                              D i s p a t c h                               */
+/******************************************************************************/
+
+uint32_t XrdCksCalccrc32c::Dispatch(uint32_t crc, const unsigned char *buff,
+                                    int blen)
+{
+   pthread_once(&kOnce, SetUp);
+   return Kernel(crc, buff, blen);
+}
+
+/******************************************************************************/
+/*                                E n g i n e                                 */
+/******************************************************************************/
+
+const char *XrdCksCalccrc32c::Engine()
+{
+   pthread_once(&kOnce, SetUp);
+   return KernelName;
+}
+
+/******************************************************************************/
+
+bool XrdCksCalccrc32c::Engine(const char *name)
+{
+   pthread_once(&kOnce, SetUp);
+
+// A null name selects the first kernel the cpu supports, as SetUp() does
+//
+   for (int i = 0; i < kNum; i++)
+       {if (name && strcmp(name, kTab[i].Name)) continue;
+        if (!kTab[i].Have()) {if (name) return false; continue;}
+        Kernel = kTab[i].Func; KernelName = kTab[i].Name;
+        return true;
+       }
+   return false;
+}
+
+/******************************************************************************/
+/*                                 S e t U p                                  */
+/******************************************************************************/
+
+void XrdCksCalccrc32c::SetUp()
+{
+   MakeTable();
+   for (int i = 0; i < kNum; i++)
+       if (kTab[i].Have())
+          {KernelName = kTab[i].Name; Kernel = kTab[i].Func; return;}
+}
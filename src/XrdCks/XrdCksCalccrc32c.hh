@@ -0,0 +1,90 @@
+#ifndef __XRDCKSCALCCRC32C_HH__
+#define __XRDCKSCALCCRC32C_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                   X r d C k s C a l c c r c 3 2 c . h h                    */
+/*                                                                            */
+/* (c) 2026 by the contributors to the XRootD software suite                  */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <sys/types.h>
+#include <netinet/in.h>
+#include <inttypes.h>
+
+#include "XrdCks/XrdCksCalc.hh"
+#include "XrdSys/XrdSysPlatform.hh"
+
+/* CRC-32C (Castagnoli polynomial 0x1EDC6F41, reflected, as in iSCSI and ext4).
+   The cpu's crc32 instruction is used when present (sse4.2 on x86, the crc
+   extension on aarch64); otherwise a slice-by-8 table implementation.
+*/
+  
+class XrdCksCalccrc32c : public XrdCksCalc
+{
+public:
+
+char *Final() {TheResult = C32Result ^ CRC32C_XOROT;
+#ifndef Xrd_Big_Endian
+               TheResult = htonl(TheResult);
+#endif
+               return (char *)&TheResult;
+              }
+
+void        Init() {C32Result = CRC32C_XINIT;}
+
+XrdCksCalc *New() {return (XrdCksCalc *)new XrdCksCalccrc32c;}
+
+void        Update(const char *Buff, int BLen)
+                  {if (BLen > 0)
+                      C32Result = Kernel(C32Result, (const unsigned char *)Buff,
+                                         BLen);
+                  }
+
+const char *Type(int &csSz) {csSz = sizeof(TheResult); return "crc32c";}
+
+// The kernel is chosen on first use, see XrdCksCalcadler32::Engine(). The
+// names are "sse4.2", "armv8crc", and "table".
+//
+static const char *Engine();
+
+static bool        Engine(const char *name);
+
+            XrdCksCalccrc32c() {Init();}
+virtual    ~XrdCksCalccrc32c() {}
+
+private:
+
+typedef uint32_t (*KernelFunc)(uint32_t, const unsigned char *, int);
+
+static  uint32_t    Dispatch(uint32_t crc, const unsigned char *buff, int blen);
+static  void        SetUp();
+
+static  KernelFunc  Kernel;
+static  const char *KernelName;
+
+static const uint32_t CRC32C_XINIT = 0xffffffff;
+static const uint32_t CRC32C_XOROT = 0xffffffff;
+             uint32_t C32Result;
+             uint32_t TheResult;
+};
+#endif
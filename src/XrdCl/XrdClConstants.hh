@@ -67,6 +67,8 @@ namespace XrdCl
   const int DefaultMetalinkProcessing   = 1;
   const int DefaultLocalMetalinkFile    = 1;
   const int DefaultXCpBlockSize         = 134217728; // DefaultCPChunkSize * DefaultCPParallelChunks * 2
+  const int DefaultReadAheadWindow      = 0;         // disabled
+  const int DefaultReadAheadBlockSize   = 262144;
 
   const char * const DefaultPollerPreference   = "built-in";
   const char * const DefaultNetworkStack       = "IPAuto";
@@ -287,6 +287,8 @@ namespace XrdCl
     REGISTER_VAR_INT( varsInt, "MetalinkProcessing",   DefaultMetalinkProcessing   );
     REGISTER_VAR_INT( varsInt, "LocalMetalinkFile",    DefaultLocalMetalinkFile    );
     REGISTER_VAR_INT( varsInt, "XCpBlockSize",         DefaultXCpBlockSize    );
+    REGISTER_VAR_INT( varsInt, "ReadAheadWindow",      DefaultReadAheadWindow      );
+    REGISTER_VAR_INT( varsInt, "ReadAheadBlockSize",   DefaultReadAheadBlockSize   );
 
     REGISTER_VAR_STR( varsStr, "PollerPreference",     DefaultPollerPreference     );
     REGISTER_VAR_STR( varsStr, "ClientMonitor",        DefaultClientMonitor        );
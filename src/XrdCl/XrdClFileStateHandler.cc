@@ -36,6 +36,7 @@
 #include "XrdCl/XrdClFileTimer.hh"
 #include "XrdCl/XrdClResponseJob.hh"
 #include "XrdCl/XrdClJobManager.hh"
+#include "XrdCl/XrdClReadAhead.hh"
 #include "XrdCl/XrdClUglyHacks.hh"
 #include "XrdClRedirectorRegistry.hh"
 
@@ -332,7 +333,8 @@ namespace XrdCl
     pDoRecoverWrite( true ),
     pFollowRedirects( true ),
     pUseVirtRedirector( true ),
-    pReOpenHandler( 0 )
+    pReOpenHandler( 0 ),
+    pReadAhead( 0 )
   {
     pFileHandle = new uint8_t[4];
     ResetMonitoringVars();
@@ -361,7 +363,8 @@ namespace XrdCl
     pDoRecoverWrite( true ),
     pFollowRedirects( true ),
     pUseVirtRedirector( useVirtRedirector ),
-    pReOpenHandler( 0 )
+    pReOpenHandler( 0 ),
+    pReadAhead( 0 )
   {
     pFileHandle = new uint8_t[4];
     ResetMonitoringVars();
@@ -383,6 +386,9 @@ namespace XrdCl
     if( DefaultEnv::GetForkHandler() )
       DefaultEnv::GetForkHandler()->UnRegisterFileObject( this );
 
+    if( pReadAhead )
+      pReadAhead->Drain();
+
     if( pFileState != Closed && DefaultEnv::GetLog() )
     {
       XRootDStatus st;
@@ -402,6 +408,7 @@ namespace XrdCl
     delete pFileUrl;
     delete pDataServer;
     delete pLoadBalancer;
+    delete pReadAhead;
     delete [] pFileHandle;
   }
 
@@ -431,6 +438,12 @@ namespace XrdCl
 
     pFileState = OpenInProgress;
 
+    //--------------------------------------------------------------------------
+    // The read-ahead of a previous open has been drained by the close
+    //--------------------------------------------------------------------------
+    delete pReadAhead;
+    pReadAhead = 0;
+
     //--------------------------------------------------------------------------
     // Check if the parameters are valid
     //--------------------------------------------------------------------------
@@ -537,6 +550,12 @@ namespace XrdCl
   XRootDStatus FileStateHandler::Close( ResponseHandler *handler,
                                         uint16_t         timeout )
   {
+    //--------------------------------------------------------------------------
+    // Wait for the read-ahead requests, the blocks arrive without the lock
+    //--------------------------------------------------------------------------
+    if( pReadAhead )
+      pReadAhead->Drain();
+
     XrdSysMutexHelper scopedLock( pMutex );
 
     //--------------------------------------------------------------------------
@@ -663,6 +682,37 @@ namespace XrdCl
     if( pFileState != Opened && pFileState != Recovering )
       return XRootDStatus( stError, errInvalidOp );
 
+    if( !pReadAhead )
+      return SendRead( offset, size, buffer, handler, timeout );
+
+    //--------------------------------------------------------------------------
+    // Send the read unless it is served from the read-ahead blocks, and then
+    // whatever the read-ahead wants to have
+    //--------------------------------------------------------------------------
+    ReadAhead::RequestList toSend;
+    XRootDStatus           st;
+    if( !pReadAhead->Read( offset, size, buffer, handler, toSend ) )
+      st = SendRead( offset, size, buffer, handler, timeout );
+
+    ReadAhead::RequestList::iterator it;
+    for( it = toSend.begin(); it != toSend.end(); ++it )
+    {
+      if( !SendRead( it->offset, it->size, it->buffer, it->handler,
+                     timeout ).IsOK() )
+        pReadAhead->SendFailed( *it );
+    }
+    return st;
+  }
+
+  //----------------------------------------------------------------------------
+  // Send a read request
+  //----------------------------------------------------------------------------
+  XRootDStatus FileStateHandler::SendRead( uint64_t         offset,
+                                           uint32_t         size,
+                                           void            *buffer,
+                                           ResponseHandler *handler,
+                                           uint16_t         timeout )
+  {
     Log *log = DefaultEnv::GetLog();
     log->Debug( FileMsg, "[0x%x@%s] Sending a read command for handle 0x%x to "
                 "%s", this, pFileUrl->GetURL().c_str(),
@@ -1113,6 +1163,26 @@ namespace XrdCl
         pStatInfo = new StatInfo( *openInfo->GetStatInfo() );
       }
 
+      //------------------------------------------------------------------------
+      // Set up the read-ahead, it is kept across the recovery reopens
+      //------------------------------------------------------------------------
+      if( !pReadAhead && IsReadOnly() )
+      {
+        int window    = DefaultReadAheadWindow;
+        int blockSize = DefaultReadAheadBlockSize;
+        Env *env = DefaultEnv::GetEnv();
+        env->GetInt( "ReadAheadWindow", window );
+        env->GetInt( "ReadAheadBlockSize", blockSize );
+        if( window > 0 && blockSize > 0 )
+        {
+          pReadAhead = new ReadAhead( blockSize, window,
+                                      pStatInfo ? pStatInfo->GetSize() : 0 );
+          log->Debug( FileMsg, "[0x%x@%s] Read-ahead enabled, window: %d, "
+                      "block size: %d", this, pFileUrl->GetURL().c_str(),
+                      window, blockSize );
+        }
+      }
+
       log->Debug( FileMsg, "[0x%x@%s] successfully opened at %s, handle: 0x%x, "
                   "session id: %ld", this, pFileUrl->GetURL().c_str(),
                   pDataServer->GetHostId().c_str(), *((uint32_t*)pFileHandle),
@@ -1762,6 +1832,31 @@ namespace XrdCl
   void FileStateHandler::MonitorClose( const XRootDStatus *status )
   {
     Monitor *mon = DefaultEnv::GetMonitor();
+    if( pReadAhead )
+    {
+      ReadAhead::Stats stats = pReadAhead->GetStats();
+      Log *log = DefaultEnv::GetLog();
+      log->Debug( FileMsg, "[0x%x@%s] Read-ahead hits: %llu, misses: %llu, "
+                  "bytes fetched: %llu, bytes wasted: %llu", this,
+                  pFileUrl->GetURL().c_str(),
+                  (unsigned long long)stats.hits,
+                  (unsigned long long)stats.misses,
+                  (unsigned long long)stats.bytesFetched,
+                  (unsigned long long)stats.bytesWasted );
+    }
+
+    if( mon && pReadAhead )
+    {
+      ReadAhead::Stats stats = pReadAhead->GetStats();
+      Monitor::ReadAheadInfo i;
+      i.file         = pFileUrl;
+      i.hits         = stats.hits;
+      i.misses       = stats.misses;
+      i.bytesFetched = stats.bytesFetched;
+      i.bytesWasted  = stats.bytesWasted;
+      mon->Event( Monitor::EvReadAhead, &i );
+    }
+
     if( mon )
     {
       Monitor::CloseInfo i;
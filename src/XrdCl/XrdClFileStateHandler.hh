@@ -36,6 +36,7 @@
 namespace XrdCl
 {
   class ResponseHandlerHolder;
+  class ReadAhead;
   class Message;
 
   //----------------------------------------------------------------------------
@@ -366,6 +367,15 @@ namespace XrdCl
       //------------------------------------------------------------------------
       bool IsReadOnly() const;
 
+      //------------------------------------------------------------------------
+      //! Send a read request, called with the mutex held
+      //------------------------------------------------------------------------
+      XRootDStatus SendRead( uint64_t         offset,
+                             uint32_t         size,
+                             void            *buffer,
+                             ResponseHandler *handler,
+                             uint16_t         timeout );
+
       //------------------------------------------------------------------------
       //! Re-open the current file at a given server
       //------------------------------------------------------------------------
@@ -450,6 +460,11 @@ namespace XrdCl
       // (there is only only OpenHandler reopening a file at a time)
       //------------------------------------------------------------------------
       ResponseHandlerHolder *pReOpenHandler;
+
+      //------------------------------------------------------------------------
+      // Read-ahead of files opened for reading, 0 if disabled
+      //------------------------------------------------------------------------
+      ReadAhead             *pReadAhead;
   };
 }
 
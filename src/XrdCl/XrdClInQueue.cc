@@ -22,9 +22,28 @@
 #include "XrdCl/XrdClMessage.hh"
 
 #include <arpa/inet.h>              // for network unmarshalling stuff
+#include <string.h>
 
 namespace XrdCl
 {
+  //----------------------------------------------------------------------------
+  // Constructor
+  //----------------------------------------------------------------------------
+  InQueue::InQueue()
+  {
+    memset( pPages, 0, sizeof( pPages ) );
+    memset( pPageHandlers, 0, sizeof( pPageHandlers ) );
+  }
+
+  //----------------------------------------------------------------------------
+  // Destructor
+  //----------------------------------------------------------------------------
+  InQueue::~InQueue()
+  {
+    for( uint32_t i = 0; i < NumPages; ++i )
+      delete [] pPages[i];
+  }
+
   //----------------------------------------------------------------------------
   // Filter messages
   //----------------------------------------------------------------------------
@@ -73,21 +92,21 @@ namespace XrdCl
       return true;
     }
 
-    // Lookup the sid in the map of handlers
+    // Lookup the sid in the handler table
     pMutex.Lock();
-    HandlerMap::iterator it = pHandlers.find(msgSid);
+    Slot *slot = FindSlot(msgSid);
 
-    if (it != pHandlers.end())
+    if (slot && slot->handler)
     {
-      handler = it->second.first;
+      handler = slot->handler;
       action  = handler->Examine( msg );
 
       if( action & IncomingMsgHandler::RemoveHandler )
-	pHandlers.erase( it );
+	ClearHandler( msgSid );
     }
 
     if( !(action & IncomingMsgHandler::Take) )
-      pMessages[msgSid] = msg;
+      GetSlot(msgSid).message = msg;
 
     pMutex.UnLock();
 
@@ -105,23 +124,23 @@ namespace XrdCl
     uint16_t action = 0;
     uint16_t handlerSid = handler->GetSid();
     XrdSysMutexHelper scopedLock( pMutex );
-    MessageMap::iterator it = pMessages.find(handlerSid);
+    Slot *slot = FindSlot(handlerSid);
 
-    if (it != pMessages.end())
+    if (slot && slot->message)
     {
-      action = handler->Examine( it->second );
+      Message *msg = slot->message;
+      action = handler->Examine( msg );
 
       if( action & IncomingMsgHandler::Take )
       {
+	slot->message = 0;
 	if( !(action & IncomingMsgHandler::NoProcess ) )
-	  handler->Process( it->second );
-
-	pMessages.erase( it );
+	  handler->Process( msg );
       }
     }
 
     if( !(action & IncomingMsgHandler::RemoveHandler) )
-      pHandlers[handlerSid] = HandlerAndExpire( handler, expires );
+      SetHandler( handlerSid, handler, expires );
   }
 
   //----------------------------------------------------------------------------
@@ -143,16 +162,16 @@ namespace XrdCl
     }
 
     XrdSysMutexHelper scopedLock( pMutex );
-    HandlerMap::iterator it = pHandlers.find(msgSid);
+    Slot *slot = FindSlot(msgSid);
 
-    if (it != pHandlers.end())
+    if (slot && slot->handler)
     {
-      handler = it->second.first;
+      handler = slot->handler;
       act     = handler->Examine( msg );
-      exp     = it->second.second;
+      exp     = slot->expires;
 
       if( act & IncomingMsgHandler::Take )
-	pHandlers.erase( it );
+	ClearHandler( msgSid );
     }
 
     if( handler )
@@ -172,7 +191,7 @@ namespace XrdCl
   {
     uint16_t handlerSid = handler->GetSid();
     XrdSysMutexHelper scopedLock( pMutex );
-    pHandlers[handlerSid] = HandlerAndExpire( handler, expires );
+    SetHandler( handlerSid, handler, expires );
   }
 
   //----------------------------------------------------------------------------
@@ -182,7 +201,7 @@ namespace XrdCl
   {
     uint16_t handlerSid = handler->GetSid();
     XrdSysMutexHelper scopedLock( pMutex );
-    pHandlers.erase(handlerSid);
+    ClearHandler( handlerSid );
   }
 
   //----------------------------------------------------------------------------
@@ -194,14 +213,22 @@ namespace XrdCl
   {
     uint8_t action = 0;
     XrdSysMutexHelper scopedLock( pMutex );
-    for( HandlerMap::iterator it = pHandlers.begin(); it != pHandlers.end(); )
+    for( uint32_t page = 0; page < NumPages; ++page )
     {
-      action = it->second.first->OnStreamEvent( event, streamNum, status );
+      if( !pPageHandlers[page] )
+	continue;
 
-      if( action & IncomingMsgHandler::RemoveHandler )
-	pHandlers.erase( it++ );
-      else
-	++it;
+      for( uint32_t i = 0; i < PageSize; ++i )
+      {
+	IncomingMsgHandler *handler = pPages[page][i].handler;
+	if( !handler )
+	  continue;
+
+	action = handler->OnStreamEvent( event, streamNum, status );
+
+	if( action & IncomingMsgHandler::RemoveHandler )
+	  ClearHandler( (page << PageBits) | i );
+      }
     }
   }
 
@@ -214,17 +241,62 @@ namespace XrdCl
       now = ::time(0);
 
     XrdSysMutexHelper scopedLock( pMutex );
-    HandlerMap::iterator it = pHandlers.begin();
-    while( it != pHandlers.end() )
+    for( uint32_t page = 0; page < NumPages; ++page )
     {
-      if( it->second.second <= now )
+      if( !pPageHandlers[page] )
+	continue;
+
+      for( uint32_t i = 0; i < PageSize; ++i )
       {
-	it->second.first->OnStreamEvent( IncomingMsgHandler::Timeout, 0,
+	Slot &slot = pPages[page][i];
+	if( slot.handler && slot.expires <= now )
+	{
+	  IncomingMsgHandler *handler = slot.handler;
+	  ClearHandler( (page << PageBits) | i );
+	  handler->OnStreamEvent( IncomingMsgHandler::Timeout, 0,
 				  Status( stError, errOperationExpired ) );
-	pHandlers.erase( it++ );
+	}
       }
-      else
-	++it;
     }
   }
+
+  //----------------------------------------------------------------------------
+  // Get the slot for the sid, allocating its page if need be
+  //----------------------------------------------------------------------------
+  InQueue::Slot &InQueue::GetSlot( uint16_t sid )
+  {
+    Slot *&page = pPages[sid >> PageBits];
+    if( !page )
+    {
+      page = new Slot[PageSize];
+      memset( page, 0, PageSize*sizeof( Slot ) );
+    }
+    return page[sid & (PageSize-1)];
+  }
+
+  //----------------------------------------------------------------------------
+  // Set the handler in the slot for the sid
+  //----------------------------------------------------------------------------
+  void InQueue::SetHandler( uint16_t sid, IncomingMsgHandler *handler,
+			    time_t expires )
+  {
+    Slot &slot = GetSlot( sid );
+    if( !slot.handler )
+      ++pPageHandlers[sid >> PageBits];
+    slot.handler = handler;
+    slot.expires = expires;
+  }
+
+  //----------------------------------------------------------------------------
+  // Clear the handler in the slot for the sid
+  //----------------------------------------------------------------------------
+  void InQueue::ClearHandler( uint16_t sid )
+  {
+    Slot *slot = FindSlot( sid );
+    if( !slot || !slot->handler )
+      return;
+    slot->handler = 0;
+    slot->expires = 0;
+    --pPageHandlers[sid >> PageBits];
+  }
 }
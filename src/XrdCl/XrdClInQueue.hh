@@ -20,8 +20,7 @@
 #define __XRD_CL_IN_QUEUE_HH__
 
 #include <XrdSys/XrdSysPthread.hh>
-#include <map>
-#include <utility>
+#include <time.h>
 #include "XrdCl/XrdClStatus.hh"
 #include "XrdCl/XrdClPostMasterInterfaces.hh"
 
@@ -31,10 +30,25 @@ namespace XrdCl
 
   //----------------------------------------------------------------------------
   //! A synchronize queue for incoming data
+  //!
+  //! Handlers and unclaimed messages are kept in a table indexed by SID. The
+  //! table is split into pages that are allocated the first time a SID in
+  //! their range is used so matching is O(1) and does not allocate per
+  //! request.
   //----------------------------------------------------------------------------
   class InQueue
   {
     public:
+      //------------------------------------------------------------------------
+      //! Constructor
+      //------------------------------------------------------------------------
+      InQueue();
+
+      //------------------------------------------------------------------------
+      //! Destructor
+      //------------------------------------------------------------------------
+      ~InQueue();
+
       //------------------------------------------------------------------------
       //! Add a fully reconstructed message to the queue
       //------------------------------------------------------------------------
@@ -98,12 +112,47 @@ namespace XrdCl
       //------------------------------------------------------------------------
       bool DiscardMessage(Message* msg, uint16_t& sid) const;
 
-      typedef std::pair<IncomingMsgHandler *, time_t> HandlerAndExpire;
-      typedef std::map<uint16_t, HandlerAndExpire> HandlerMap;
-      typedef std::map<uint16_t, Message*> MessageMap;
-      MessageMap pMessages;
-      HandlerMap pHandlers;
-      XrdSysRecMutex pMutex;
+      InQueue( const InQueue & );
+      InQueue &operator=( const InQueue & );
+
+      //------------------------------------------------------------------------
+      //! A SID slot
+      //------------------------------------------------------------------------
+      struct Slot
+      {
+        IncomingMsgHandler *handler;
+        time_t              expires;
+        Message            *message;
+      };
+
+      static const uint32_t PageBits = 8;
+      static const uint32_t PageSize = 1 << PageBits;
+      static const uint32_t NumPages = 65536 >> PageBits;
+
+      //------------------------------------------------------------------------
+      //! Get the slot for the sid, allocating its page if need be
+      //------------------------------------------------------------------------
+      Slot &GetSlot( uint16_t sid );
+
+      //------------------------------------------------------------------------
+      //! Find the slot for the sid, returns 0 if its page does not exist
+      //------------------------------------------------------------------------
+      Slot *FindSlot( uint16_t sid ) const
+      {
+        Slot *page = pPages[sid >> PageBits];
+        return page ? &page[sid & (PageSize-1)] : 0;
+      }
+
+      //------------------------------------------------------------------------
+      //! Set or clear the handler in the slot for the sid
+      //------------------------------------------------------------------------
+      void SetHandler( uint16_t sid, IncomingMsgHandler *handler,
+                       time_t expires );
+      void ClearHandler( uint16_t sid );
+
+      Slot           *pPages[NumPages];
+      uint16_t        pPageHandlers[NumPages];
+      XrdSysRecMutex  pMutex;
   };
 }
 
@@ -131,6 +131,21 @@ namespace XrdCl
         const XRootDStatus *status;  //!< Close status
       };
 
+      //------------------------------------------------------------------------
+      //! Describe the read-ahead of a file, sent just before the close event
+      //------------------------------------------------------------------------
+      struct ReadAheadInfo
+      {
+        ReadAheadInfo():
+          file(0), hits(0), misses(0), bytesFetched(0), bytesWasted(0)
+        {}
+        const URL *file;          //!< The file in question
+        uint64_t   hits;          //!< Reads served from read-ahead blocks
+        uint64_t   misses;        //!< Reads sent to the server
+        uint64_t   bytesFetched;  //!< Bytes read ahead
+        uint64_t   bytesWasted;   //!< Bytes read ahead but never used
+      };
+
       //------------------------------------------------------------------------
       //! Describe an encountered file-based error
       //------------------------------------------------------------------------
@@ -214,7 +229,8 @@ namespace XrdCl
         EvClose,          //!< CloseInfo: File closed
         EvErrIO,          //!< ErrorInfo: An I/O error occurred
         EvConnect,        //!< ConnectInfo: Login  into a server
-        EvDisconnect      //!< DisconnectInfo: Logout from a server
+        EvDisconnect,     //!< DisconnectInfo: Logout from a server
+        EvReadAhead       //!< ReadAheadInfo: Read-ahead counters of a file
 
       };
 
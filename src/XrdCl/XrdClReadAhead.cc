@@ -0,0 +1,478 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by the contributors to the XRootD software suite
+//------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+
+#include "XrdCl/XrdClReadAhead.hh"
+#include "XrdCl/XrdClDefaultEnv.hh"
+#include "XrdCl/XrdClPostMaster.hh"
+#include "XrdCl/XrdClJobManager.hh"
+#include "XrdCl/XrdClResponseJob.hh"
+#include "XrdCl/XrdClXRootDResponses.hh"
+
+#include <string.h>
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // A pattern is followed once it has been repeated this many times
+  //----------------------------------------------------------------------------
+  const int MinRepeat  = 2;
+
+  //----------------------------------------------------------------------------
+  // Reads looked ahead when a pattern is first followed
+  //----------------------------------------------------------------------------
+  const uint32_t MinDepth = 2;
+}
+
+namespace XrdCl
+{
+  //----------------------------------------------------------------------------
+  // Response handler of a read-ahead block
+  //----------------------------------------------------------------------------
+  class ReadAhead::BlockHandler: public ResponseHandler
+  {
+    public:
+      BlockHandler( ReadAhead *readAhead, Block *block ):
+        pReadAhead( readAhead ), pBlock( block ) {}
+
+      virtual void HandleResponse( XRootDStatus *status, AnyObject *response )
+      {
+        pReadAhead->BlockDone( pBlock, status, response );
+        delete this;
+      }
+
+    private:
+      ReadAhead *pReadAhead;
+      Block     *pBlock;
+  };
+
+  //----------------------------------------------------------------------------
+  // Constructor
+  //----------------------------------------------------------------------------
+  ReadAhead::ReadAhead( uint32_t blockSize, uint32_t window, uint64_t fileSize ):
+    pCond( 0 ),
+    pBlockSize( blockSize ),
+    pMaxBlocks( window / blockSize ),
+    pDepth( MinDepth ),
+    pFileSize( fileSize ),
+    pLastOffset( 0 ),
+    pLastEnd( 0 ),
+    pStride( 0 ),
+    pStrideCount( -1 ),
+    pInFly( 0 ),
+    pDraining( false )
+  {
+    if( pMaxBlocks < MinDepth )
+      pMaxBlocks = MinDepth;
+  }
+
+  //----------------------------------------------------------------------------
+  // Destructor
+  //----------------------------------------------------------------------------
+  ReadAhead::~ReadAhead()
+  {
+    BlockMap::iterator it;
+    for( it = pBlocks.begin(); it != pBlocks.end(); ++it )
+      delete it->second;
+  }
+
+  //----------------------------------------------------------------------------
+  // Look at a read request
+  //----------------------------------------------------------------------------
+  bool ReadAhead::Read( uint64_t         offset,
+                        uint32_t         size,
+                        void            *buffer,
+                        ResponseHandler *handler,
+                        RequestList     &toSend )
+  {
+    XrdSysCondVarHelper scopedLock( pCond );
+
+    Track( offset, size );
+    if( pDraining || !size )
+      return false;
+
+    //--------------------------------------------------------------------------
+    // Check if the blocks covering the read are all there or on their way
+    //--------------------------------------------------------------------------
+    std::vector<Block*> blocks;
+    int      pending = 0;
+    bool     covered = true;
+    uint64_t last    = ( offset + size - 1 ) / pBlockSize;
+    for( uint64_t idx = offset / pBlockSize; idx <= last; ++idx )
+    {
+      BlockMap::iterator it = pBlocks.find( idx * pBlockSize );
+      if( it == pBlocks.end() )
+      {
+        covered = false;
+        break;
+      }
+      Block *b = it->second;
+      blocks.push_back( b );
+      if( !b->done )
+        ++pending;
+      else if( b->length < b->size )
+        break; // end of file
+    }
+
+    if( !covered )
+    {
+      ++pStats.misses;
+      Issue( toSend );
+      return false;
+    }
+
+    ++pStats.hits;
+    pDepth = pDepth * 2 > pMaxBlocks ? pMaxBlocks : pDepth * 2;
+
+    Waiter *w  = new Waiter;
+    w->offset  = offset;
+    w->size    = size;
+    w->buffer  = buffer;
+    w->handler = handler;
+    w->pending = pending;
+    w->failed  = false;
+    w->blocks  = blocks;
+    for( size_t i = 0; i < blocks.size(); ++i )
+    {
+      blocks[i]->used = true;
+      ++blocks[i]->pins;
+      if( !blocks[i]->done )
+        blocks[i]->waiters.push_back( w );
+    }
+
+    //--------------------------------------------------------------------------
+    // Everything is here, we still answer from a job because the caller
+    // holds the file state lock
+    //--------------------------------------------------------------------------
+    if( !pending )
+    {
+      Reply r = Complete( w );
+      JobManager *jobMan = DefaultEnv::GetPostMaster()->GetJobManager();
+      jobMan->QueueJob( new ResponseJob( r.handler, r.status, r.response, 0 ) );
+    }
+
+    Issue( toSend );
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  // A read-ahead request could not be sent
+  //----------------------------------------------------------------------------
+  void ReadAhead::SendFailed( const Request &req )
+  {
+    XrdSysCondVarHelper scopedLock( pCond );
+
+    BlockMap::iterator it = pBlocks.find( req.offset );
+    if( it != pBlocks.end() )
+    {
+      delete it->second;
+      pBlocks.erase( it );
+    }
+    delete req.handler;
+    if( --pInFly == 0 )
+      pCond.Broadcast();
+  }
+
+  //----------------------------------------------------------------------------
+  // Stop reading ahead and wait for the blocks in flight
+  //----------------------------------------------------------------------------
+  void ReadAhead::Drain()
+  {
+    XrdSysCondVarHelper scopedLock( pCond );
+    pDraining = true;
+    while( pInFly )
+      pCond.Wait();
+  }
+
+  //----------------------------------------------------------------------------
+  // Get the counters
+  //----------------------------------------------------------------------------
+  ReadAhead::Stats ReadAhead::GetStats()
+  {
+    XrdSysCondVarHelper scopedLock( pCond );
+    Stats s = pStats;
+    BlockMap::iterator it;
+    for( it = pBlocks.begin(); it != pBlocks.end(); ++it )
+      if( it->second->done && !it->second->used )
+        s.bytesWasted += it->second->length;
+    return s;
+  }
+
+  //----------------------------------------------------------------------------
+  // A read-ahead block has arrived
+  //----------------------------------------------------------------------------
+  void ReadAhead::BlockDone( Block        *block,
+                             XRootDStatus *status,
+                             AnyObject    *response )
+  {
+    std::vector<Reply> replies;
+    {
+      XrdSysCondVarHelper scopedLock( pCond );
+
+      block->done = true;
+      if( status->IsOK() )
+      {
+        ChunkInfo *chunk = 0;
+        if( response )
+          response->Get( chunk );
+        block->length = chunk ? chunk->length : 0;
+        pStats.bytesFetched += block->length;
+
+        if( block->length < block->size &&
+            ( !pFileSize || block->offset + block->length < pFileSize ) )
+          pFileSize = block->offset + block->length;
+      }
+      else
+      {
+        block->failed = true;
+        pBlocks.erase( block->offset );
+      }
+
+      //------------------------------------------------------------------------
+      // Completing the waiters releases their pins, ours keeps the block
+      // around until we are done with it; a failed block is dropped here
+      // once nobody else pins it, otherwise by the last Complete()
+      //------------------------------------------------------------------------
+      ++block->pins;
+      for( size_t i = 0; i < block->waiters.size(); ++i )
+      {
+        Waiter *w = block->waiters[i];
+        if( block->failed )
+          w->failed = true;
+        if( --w->pending == 0 )
+          replies.push_back( Complete( w ) );
+      }
+      block->waiters.clear();
+
+      if( --block->pins == 0 && block->failed )
+        delete block;
+
+      if( --pInFly == 0 )
+        pCond.Broadcast();
+    }
+
+    delete status;
+    delete response;
+
+    //--------------------------------------------------------------------------
+    // Errors may be reported with the file state lock held, so the waiting
+    // reads are failed from a job
+    //--------------------------------------------------------------------------
+    JobManager *jobMan = DefaultEnv::GetPostMaster()->GetJobManager();
+    for( size_t i = 0; i < replies.size(); ++i )
+    {
+      if( replies[i].status->IsOK() )
+        replies[i].handler->HandleResponse( replies[i].status,
+                                            replies[i].response );
+      else
+        jobMan->QueueJob( new ResponseJob( replies[i].handler,
+                                           replies[i].status, 0, 0 ) );
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Copy the data for a waiter that has all its blocks and release them,
+  // called with the lock held
+  //----------------------------------------------------------------------------
+  ReadAhead::Reply ReadAhead::Complete( Waiter *w )
+  {
+    Reply    r;
+    uint32_t len = 0;
+    r.handler  = w->handler;
+    r.response = 0;
+
+    for( size_t i = 0; i < w->blocks.size() && !w->failed; ++i )
+    {
+      Block    *b   = w->blocks[i];
+      uint64_t  off = w->offset + len;
+      if( off < b->offset || off - b->offset >= b->length )
+        break;
+      uint32_t inBlk = off - b->offset;
+      uint32_t n     = b->length - inBlk;
+      if( n > w->size - len )
+        n = w->size - len;
+      memcpy( (char*)w->buffer + len, b->buffer + inBlk, n );
+      len += n;
+      if( b->length < b->size )
+        break;
+    }
+
+    if( w->failed )
+      r.status = new XRootDStatus( stError, errErrorResponse, 0,
+                                   "read-ahead request failed" );
+    else
+    {
+      r.status   = new XRootDStatus();
+      r.response = new AnyObject();
+      r.response->Set( new ChunkInfo( w->offset, len, w->buffer ) );
+    }
+
+    for( size_t i = 0; i < w->blocks.size(); ++i )
+    {
+      Block *b = w->blocks[i];
+      if( --b->pins == 0 && b->failed && b->done )
+        delete b;
+    }
+    delete w;
+    return r;
+  }
+
+  //----------------------------------------------------------------------------
+  // Follow the read pattern, called with the lock held
+  //----------------------------------------------------------------------------
+  void ReadAhead::Track( uint64_t offset, uint32_t size )
+  {
+    //--------------------------------------------------------------------------
+    // A read starting within or right at the end of the previous one is
+    // sequential, otherwise the stride is the distance between the offsets
+    //--------------------------------------------------------------------------
+    int64_t stride = 0;
+    if( offset < pLastOffset || offset > pLastEnd )
+      stride = (int64_t)offset - (int64_t)pLastOffset;
+
+    if( pStrideCount >= 0 && stride == pStride )
+    {
+      if( pStrideCount < 1000 )
+        ++pStrideCount;
+    }
+    else
+    {
+      pStride      = stride;
+      pStrideCount = 0;
+      pDepth       = MinDepth;
+    }
+    pLastOffset = offset;
+    pLastEnd    = offset + size;
+  }
+
+  //----------------------------------------------------------------------------
+  // Request the blocks expected to be read next, called with the lock held
+  //----------------------------------------------------------------------------
+  void ReadAhead::Issue( RequestList &toSend )
+  {
+    if( pDraining || pStrideCount < MinRepeat )
+      return;
+
+    //--------------------------------------------------------------------------
+    // Sequential reads smaller than a block are looked ahead a block at a
+    // time
+    //--------------------------------------------------------------------------
+    uint64_t size    = pLastEnd - pLastOffset;
+    uint64_t step    = size > pBlockSize ? size : pBlockSize;
+    uint32_t nBlocks = 0;
+    for( uint32_t k = 1; k <= pDepth && nBlocks < pMaxBlocks; ++k )
+    {
+      int64_t start, end;
+      if( pStride == 0 )
+      {
+        start = pLastEnd + ( k - 1 ) * step;
+        end   = start + step;
+      }
+      else
+      {
+        start = (int64_t)pLastOffset + k * pStride;
+        end   = start + size;
+      }
+      if( start < 0 || ( pFileSize && (uint64_t)start >= pFileSize ) )
+        break;
+
+      uint64_t last = ( end - 1 ) / pBlockSize;
+      for( uint64_t idx = start / pBlockSize;
+           idx <= last && nBlocks < pMaxBlocks; ++idx, ++nBlocks )
+      {
+        uint64_t off = idx * pBlockSize;
+        if( pFileSize && off >= pFileSize )
+          break;
+        if( pBlocks.find( off ) != pBlocks.end() )
+          continue;
+        if( pBlocks.size() >= pMaxBlocks && !Evict( off ) )
+          return;
+
+        uint32_t sz = pBlockSize;
+        if( pFileSize && off + sz > pFileSize )
+          sz = pFileSize - off;
+
+        Block *b = new Block( off, sz );
+        pBlocks[off] = b;
+        ++pInFly;
+
+        Request req;
+        req.offset  = off;
+        req.size    = sz;
+        req.buffer  = b->buffer;
+        req.handler = new BlockHandler( this, b );
+        toSend.push_back( req );
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Make room for the block at the given offset by dropping one that has
+  // arrived and is not waited for: one behind the reader, used ones first,
+  // or else the one farthest ahead of the reader if it is farther than the
+  // wanted one; called with the lock held
+  //----------------------------------------------------------------------------
+  bool ReadAhead::Evict( uint64_t wanted )
+  {
+    BlockMap::iterator victim = pBlocks.end();
+    int                vRank  = 0;
+    uint64_t           vDist  = 0;
+    uint64_t           wDist  = Distance( wanted );
+
+    BlockMap::iterator it;
+    for( it = pBlocks.begin(); it != pBlocks.end(); ++it )
+    {
+      Block *b = it->second;
+      if( !b->done || b->pins )
+        continue;
+
+      bool behind = pStride < 0 ? b->offset >= pLastEnd :
+                                  b->offset + b->size <= pLastOffset;
+      uint64_t dist = Distance( b->offset );
+      int      rank;
+      if( behind )
+        rank = b->used ? 3 : 2;
+      else if( dist > wDist )
+        rank = 1;
+      else
+        continue;
+
+      if( rank > vRank || ( rank == vRank && dist > vDist ) )
+      {
+        victim = it;
+        vRank  = rank;
+        vDist  = dist;
+      }
+    }
+
+    if( victim == pBlocks.end() )
+      return false;
+
+    if( !victim->second->used )
+      pStats.bytesWasted += victim->second->length;
+    delete victim->second;
+    pBlocks.erase( victim );
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  // Distance of an offset from the last read
+  //----------------------------------------------------------------------------
+  uint64_t ReadAhead::Distance( uint64_t offset ) const
+  {
+    return offset > pLastOffset ? offset - pLastOffset : pLastOffset - offset;
+  }
+}
@@ -0,0 +1,184 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by the contributors to the XRootD software suite
+//------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+
+#ifndef __XRD_CL_READ_AHEAD_HH__
+#define __XRD_CL_READ_AHEAD_HH__
+
+#include <map>
+#include <vector>
+#include <stdint.h>
+
+#include "XrdSys/XrdSysPthread.hh"
+
+namespace XrdCl
+{
+  class AnyObject;
+  class ResponseHandler;
+  class XRootDStatus;
+
+  //----------------------------------------------------------------------------
+  //! Read-ahead of a file opened for reading
+  //!
+  //! Reads are fed to Read() which follows their pattern. Once reads have
+  //! been sequential, or have kept the same stride, for a few times, blocks
+  //! ahead of the reader are requested asynchronously. Reads falling into
+  //! such blocks are served from them, or wait for them if they are still
+  //! in flight, instead of going to the server. The number of reads looked
+  //! ahead grows with every read served and the blocks held are bounded by
+  //! the window.
+  //!
+  //! Read() is called with the mutex of the FileStateHandler held, the
+  //! responses for the blocks come without it.
+  //----------------------------------------------------------------------------
+  class ReadAhead
+  {
+    public:
+      //------------------------------------------------------------------------
+      //! A block that the caller has to request from the server
+      //------------------------------------------------------------------------
+      struct Request
+      {
+        uint64_t         offset;
+        uint32_t         size;
+        void            *buffer;
+        ResponseHandler *handler;
+      };
+
+      typedef std::vector<Request> RequestList;
+
+      //------------------------------------------------------------------------
+      //! Counters reported to the monitor
+      //------------------------------------------------------------------------
+      struct Stats
+      {
+        Stats(): hits( 0 ), misses( 0 ), bytesFetched( 0 ), bytesWasted( 0 ) {}
+        uint64_t hits;          //!< reads served from read-ahead blocks
+        uint64_t misses;        //!< reads sent to the server
+        uint64_t bytesFetched;  //!< bytes read ahead
+        uint64_t bytesWasted;   //!< bytes read ahead but never used
+      };
+
+      //------------------------------------------------------------------------
+      //! Constructor
+      //!
+      //! @param blockSize size of the read-ahead requests
+      //! @param window    maximum number of bytes held per file
+      //! @param fileSize  size of the file, 0 if not known
+      //------------------------------------------------------------------------
+      ReadAhead( uint32_t blockSize, uint32_t window, uint64_t fileSize );
+
+      //------------------------------------------------------------------------
+      //! Destructor, must not be called with blocks in flight, see Drain()
+      //------------------------------------------------------------------------
+      ~ReadAhead();
+
+      //------------------------------------------------------------------------
+      //! Look at a read request
+      //!
+      //! @param toSend  filled with the read-ahead requests to send
+      //! @return true if the read is served from read-ahead blocks, the
+      //!         handler is then called asynchronously; false if the
+      //!         read has to be sent to the server
+      //------------------------------------------------------------------------
+      bool Read( uint64_t         offset,
+                 uint32_t         size,
+                 void            *buffer,
+                 ResponseHandler *handler,
+                 RequestList     &toSend );
+
+      //------------------------------------------------------------------------
+      //! A request from toSend could not be sent
+      //------------------------------------------------------------------------
+      void SendFailed( const Request &req );
+
+      //------------------------------------------------------------------------
+      //! Stop reading ahead and wait for the blocks in flight
+      //------------------------------------------------------------------------
+      void Drain();
+
+      //------------------------------------------------------------------------
+      //! Get the counters, blocks not used so far count as wasted
+      //------------------------------------------------------------------------
+      Stats GetStats();
+
+    private:
+      struct Waiter;
+      class  BlockHandler;
+
+      struct Block
+      {
+        Block( uint64_t off, uint32_t sz ):
+          offset( off ), size( sz ), length( 0 ), buffer( new char[sz] ),
+          done( false ), used( false ), failed( false ), pins( 0 ) {}
+        ~Block() { delete [] buffer; }
+
+        uint64_t              offset;
+        uint32_t              size;     //!< requested
+        uint32_t              length;   //!< received
+        char                 *buffer;
+        bool                  done;
+        bool                  used;
+        bool                  failed;
+        int                   pins;     //!< waiters covering the block
+        std::vector<Waiter*>  waiters;  //!< waiters for the block to arrive
+      };
+
+      struct Waiter
+      {
+        uint64_t             offset;
+        uint32_t             size;
+        void                *buffer;
+        ResponseHandler     *handler;
+        int                  pending;   //!< blocks still in flight
+        bool                 failed;
+        std::vector<Block*>  blocks;    //!< blocks pinned by the read
+      };
+
+      struct Reply
+      {
+        ResponseHandler *handler;
+        XRootDStatus    *status;
+        AnyObject       *response;
+      };
+
+      typedef std::map<uint64_t, Block*> BlockMap;
+
+      void       BlockDone( Block *block, XRootDStatus *status,
+                            AnyObject *response );
+      Reply      Complete( Waiter *w );
+      void       Track( uint64_t offset, uint32_t size );
+      void       Issue( RequestList &toSend );
+      bool       Evict( uint64_t wanted );
+      uint64_t   Distance( uint64_t offset ) const;
+
+      XrdSysCondVar  pCond;
+      BlockMap       pBlocks;
+      uint32_t       pBlockSize;
+      uint32_t       pMaxBlocks;
+      uint32_t       pDepth;        //!< reads to look ahead of the reader
+      uint64_t       pFileSize;     //!< 0 if not known
+      uint64_t       pLastOffset;
+      uint64_t       pLastEnd;
+      int64_t        pStride;       //!< 0 for sequential reads
+      int            pStrideCount;  //!< times the pattern repeated
+      int            pInFly;
+      bool           pDraining;
+      Stats          pStats;
+  };
+}
+
+#endif // __XRD_CL_READ_AHEAD_HH__
@@ -18,35 +18,59 @@
 
 #include "XrdCl/XrdClSIDManager.hh"
 
+#include <string.h>
+
 namespace XrdCl
 {
+  //----------------------------------------------------------------------------
+  // Constructor
+  //----------------------------------------------------------------------------
+  SIDManager::SIDManager(): pFreeHead( 0 ), pSIDCeiling( 1 ), pAllocated( 0 ),
+                            pTimedOut( 0 )
+  {
+    pNext  = new std::atomic<uint16_t>[NumSlots];
+    pState = new std::atomic<uint8_t>[NumSlots];
+    for( uint32_t i = 0; i < NumSlots; ++i )
+    {
+      pNext[i].store( 0, std::memory_order_relaxed );
+      pState[i].store( SlotFree, std::memory_order_relaxed );
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Destructor
+  //----------------------------------------------------------------------------
+  SIDManager::~SIDManager()
+  {
+    delete [] pNext;
+    delete [] pState;
+  }
+
   //----------------------------------------------------------------------------
   // Allocate a SID
   //---------------------------------------------------------------------------
   Status SIDManager::AllocateSID( uint8_t sid[2] )
   {
-    XrdSysMutexHelper scopedLock( pMutex );
-
-    uint16_t allocSID = 1;
-
     //--------------------------------------------------------------------------
-    // Get a SID from the list of free SIDs if it's not empty
+    // Get a SID from the free stack if it's not empty, otherwise allocate a
+    // new one if possible
     //--------------------------------------------------------------------------
-    if( !pFreeSIDs.empty() )
+    uint16_t allocSID = PopFree();
+    if( !allocSID )
     {
-      allocSID = pFreeSIDs.front();
-      pFreeSIDs.pop_front();
-    }
-    //--------------------------------------------------------------------------
-    // Allocate a new SID if possible
-    //--------------------------------------------------------------------------
-    else
-    {
-      if( pSIDCeiling == 0xffff )
-        return Status( stError, errNoMoreFreeSIDs );
-      allocSID = pSIDCeiling++;
+      uint32_t ceiling = pSIDCeiling.load( std::memory_order_relaxed );
+      do
+      {
+        if( ceiling >= 0xffff )
+          return Status( stError, errNoMoreFreeSIDs );
+      }
+      while( !pSIDCeiling.compare_exchange_weak( ceiling, ceiling+1,
+                                                 std::memory_order_relaxed ) );
+      allocSID = ceiling;
     }
 
+    pState[allocSID].store( SlotInUse, std::memory_order_relaxed );
+    pAllocated.fetch_add( 1, std::memory_order_relaxed );
     memcpy( sid, &allocSID, 2 );
     return Status();
   }
@@ -56,10 +80,12 @@ namespace XrdCl
   //----------------------------------------------------------------------------
   void SIDManager::ReleaseSID( uint8_t sid[2] )
   {
-    XrdSysMutexHelper scopedLock( pMutex );
     uint16_t relSID = 0;
     memcpy( &relSID, sid, 2 );
-    pFreeSIDs.push_back( relSID );
+    if( !relSID )
+      return;
+    Release( relSID, pState[relSID].exchange( SlotFree,
+                                              std::memory_order_relaxed ) );
   }
 
   //----------------------------------------------------------------------------
@@ -67,10 +93,15 @@ namespace XrdCl
   //----------------------------------------------------------------------------
   void SIDManager::TimeOutSID( uint8_t sid[2] )
   {
-    XrdSysMutexHelper scopedLock( pMutex );
     uint16_t tiSID = 0;
     memcpy( &tiSID, sid, 2 );
-    pTimeOutSIDs.insert( tiSID );
+    uint8_t expected = SlotInUse;
+    if( pState[tiSID].compare_exchange_strong( expected, SlotTimedOut,
+                                               std::memory_order_relaxed ) )
+    {
+      pAllocated.fetch_sub( 1, std::memory_order_relaxed );
+      pTimedOut.fetch_add( 1, std::memory_order_relaxed );
+    }
   }
 
   //----------------------------------------------------------------------------
@@ -78,13 +109,9 @@ namespace XrdCl
   //----------------------------------------------------------------------------
   bool SIDManager::IsTimedOut( uint8_t sid[2] )
   {
-    XrdSysMutexHelper scopedLock( pMutex );
     uint16_t tiSID = 0;
     memcpy( &tiSID, sid, 2 );
-    std::set<uint16_t>::iterator it = pTimeOutSIDs.find( tiSID );
-    if( it != pTimeOutSIDs.end() )
-      return true;
-    return false;
+    return pState[tiSID].load( std::memory_order_relaxed ) == SlotTimedOut;
   }
 
   //----------------------------------------------------------------------------
@@ -92,11 +119,12 @@ namespace XrdCl
   //-----------------------------------------------------------------------------
   void SIDManager::ReleaseTimedOut( uint8_t sid[2] )
   {
-    XrdSysMutexHelper scopedLock( pMutex );
     uint16_t tiSID = 0;
     memcpy( &tiSID, sid, 2 );
-    pTimeOutSIDs.erase( tiSID );
-    pFreeSIDs.push_back( tiSID );
+    uint8_t expected = SlotTimedOut;
+    if( pState[tiSID].compare_exchange_strong( expected, SlotFree,
+                                               std::memory_order_relaxed ) )
+      Release( tiSID, SlotTimedOut );
   }
 
   //------------------------------------------------------------------------
@@ -104,11 +132,14 @@ namespace XrdCl
   //------------------------------------------------------------------------
   void SIDManager::ReleaseAllTimedOut()
   {
-    XrdSysMutexHelper scopedLock( pMutex );
-    std::set<uint16_t>::iterator it;
-    for( it = pTimeOutSIDs.begin(); it != pTimeOutSIDs.end(); ++it )
-      pFreeSIDs.push_back( *it );
-    pTimeOutSIDs.clear();
+    uint32_t ceiling = pSIDCeiling.load( std::memory_order_relaxed );
+    for( uint32_t i = 1; i < ceiling; ++i )
+    {
+      uint8_t expected = SlotTimedOut;
+      if( pState[i].compare_exchange_strong( expected, SlotFree,
+                                             std::memory_order_relaxed ) )
+        Release( i, SlotTimedOut );
+    }
   }
 
   //----------------------------------------------------------------------------
@@ -116,7 +147,60 @@ namespace XrdCl
   //----------------------------------------------------------------------------
   uint16_t SIDManager::GetNumberOfAllocatedSIDs() const
   {
-    XrdSysMutexHelper scopedLock( pMutex );
-    return pSIDCeiling - pFreeSIDs.size() - pTimeOutSIDs.size() - 1;
+    return pAllocated.load( std::memory_order_relaxed );
+  }
+
+  //----------------------------------------------------------------------------
+  // Pop a SID off the free stack
+  //----------------------------------------------------------------------------
+  uint16_t SIDManager::PopFree()
+  {
+    uint64_t head = pFreeHead.load( std::memory_order_acquire );
+    uint64_t next;
+    uint16_t top;
+
+    do
+    {
+      if( !(top = head & 0xffff) )
+        return 0;
+      next = ((head >> 32) + 1) << 32 |
+             pNext[top].load( std::memory_order_relaxed );
+    }
+    while( !pFreeHead.compare_exchange_weak( head, next,
+                                             std::memory_order_acquire,
+                                             std::memory_order_acquire ) );
+    return top;
+  }
+
+  //----------------------------------------------------------------------------
+  // Push a SID onto the free stack
+  //----------------------------------------------------------------------------
+  void SIDManager::PushFree( uint16_t sid )
+  {
+    uint64_t head = pFreeHead.load( std::memory_order_relaxed );
+    uint64_t next;
+
+    do
+    {
+      pNext[sid].store( head & 0xffff, std::memory_order_relaxed );
+      next = ((head >> 32) + 1) << 32 | sid;
+    }
+    while( !pFreeHead.compare_exchange_weak( head, next,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed ) );
+  }
+
+  //----------------------------------------------------------------------------
+  // Release a SID that was in the given state
+  //----------------------------------------------------------------------------
+  void SIDManager::Release( uint16_t sid, uint8_t state )
+  {
+    if( state == SlotInUse )
+      pAllocated.fetch_sub( 1, std::memory_order_relaxed );
+    else if( state == SlotTimedOut )
+      pTimedOut.fetch_sub( 1, std::memory_order_relaxed );
+    else
+      return;
+    PushFree( sid );
   }
 }
@@ -19,16 +19,19 @@
 #ifndef __XRD_CL_SID_MANAGER_HH__
 #define __XRD_CL_SID_MANAGER_HH__
 
-#include <list>
-#include <set>
+#include <atomic>
 #include <stdint.h>
-#include "XrdSys/XrdSysPthread.hh"
 #include "XrdCl/XrdClStatus.hh"
 
 namespace XrdCl
 {
   //----------------------------------------------------------------------------
   //! Handle XRootD stream IDs
+  //!
+  //! The SIDs are kept in a fixed table with one slot per possible SID. Free
+  //! SIDs are linked into a lock-free stack through the table so that
+  //! allocation, lookup and release are O(1) and never allocate memory.
+  //! SID 0 is never handed out and terminates the free stack.
   //----------------------------------------------------------------------------
   class SIDManager
   {
@@ -37,7 +40,12 @@ namespace XrdCl
       //------------------------------------------------------------------------
       //! Constructor
       //------------------------------------------------------------------------
-      SIDManager(): pSIDCeiling(1) {}
+      SIDManager();
+
+      //------------------------------------------------------------------------
+      //! Destructor
+      //------------------------------------------------------------------------
+      ~SIDManager();
 
       //------------------------------------------------------------------------
       //! Allocate a SID
@@ -77,8 +85,7 @@ namespace XrdCl
       //------------------------------------------------------------------------
       uint32_t NumberOfTimedOutSIDs() const
       {
-        XrdSysMutexHelper scopedLock( pMutex );
-        return pTimeOutSIDs.size();
+        return pTimedOut.load( std::memory_order_relaxed );
       }
 
       //------------------------------------------------------------------------
@@ -87,10 +94,46 @@ namespace XrdCl
       uint16_t GetNumberOfAllocatedSIDs() const;
 
     private:
-      std::list<uint16_t>  pFreeSIDs;
-      std::set<uint16_t>   pTimeOutSIDs;
-      uint16_t             pSIDCeiling;
-      mutable XrdSysMutex  pMutex;
+      SIDManager( const SIDManager & );
+      SIDManager &operator=( const SIDManager & );
+
+      //------------------------------------------------------------------------
+      //! Slot states
+      //------------------------------------------------------------------------
+      enum SlotState
+      {
+        SlotFree     = 0,
+        SlotInUse    = 1,
+        SlotTimedOut = 2
+      };
+
+      static const uint32_t NumSlots = 65536;
+
+      //------------------------------------------------------------------------
+      //! Pop a SID off the free stack, returns 0 if the stack is empty
+      //------------------------------------------------------------------------
+      uint16_t PopFree();
+
+      //------------------------------------------------------------------------
+      //! Push a SID onto the free stack
+      //------------------------------------------------------------------------
+      void PushFree( uint16_t sid );
+
+      //------------------------------------------------------------------------
+      //! Release a SID that was in the given state
+      //------------------------------------------------------------------------
+      void Release( uint16_t sid, uint8_t state );
+
+      //------------------------------------------------------------------------
+      // The free stack head holds an ABA tag in the upper 32 bits and the top
+      // SID in the lower ones
+      //------------------------------------------------------------------------
+      std::atomic<uint64_t>  pFreeHead;
+      std::atomic<uint32_t>  pSIDCeiling;
+      std::atomic<uint32_t>  pAllocated;
+      std::atomic<uint32_t>  pTimedOut;
+      std::atomic<uint16_t> *pNext;
+      std::atomic<uint8_t>  *pState;
   };
 }
 
@@ -150,12 +150,19 @@ namespace XrdCl
     Log *log = DefaultEnv::GetLog();
     log->Debug( UtilityMsg, "Generating the TPC URLs" );
 
+    //--------------------------------------------------------------------------
+    // Ask the destination to use as many streams as we would use ourselves
+    //--------------------------------------------------------------------------
+    int nbStreams = DefaultSubStreamsPerChannel;
+    DefaultEnv::GetEnv()->GetInt( "SubStreamsPerChannel", nbStreams );
+
     std::string  tpcKey = GenerateKey();
     char        *cgiBuff = new char[2048];
     const char  *cgiP = XrdOucTPC::cgiC2Dst( tpcKey.c_str(),
                                              tpcSource.GetHostId().c_str(),
                                              tpcSource.GetPath().c_str(),
-                                             0, cgiBuff, 2048 );
+                                             0, cgiBuff, 2048,
+                                             nbStreams > 1 ? nbStreams : 0 );
     if( *cgiP == '!' )
     {
       log->Error( UtilityMsg, "Unable to setup target url: %s", cgiP+1 );
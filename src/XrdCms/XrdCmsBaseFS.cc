@@ -188,9 +188,7 @@ int XrdCmsBaseFS::Exists(char *Path, int fnPos, int UpAT)
        Path[fnPos] = '\0';
        if (!Config.ossFS->Stat(Path, &buf, XRDOSS_resonly))
           {xLife = dpLife; xVal = &dirPres;}
-       fsMutex.Lock();
        fsDirMP.Rep(Path, xVal, xLife, Hash_keepdata);
-       fsMutex.UnLock();
        DEBUG("add " <<xLife <<(xVal->Present ? " okdir " : " nodir ") <<Path);
        Path[fnPos] = '/';
       }
@@ -206,12 +204,11 @@ int XrdCmsBaseFS::hasDir(char *Path, int fnPos)
    struct dMoP *dP;
    int Have;
 
-// Strip to directory and check if we have it
+// Strip to directory and check if we have it. The table is read-mostly so
+// lookups run concurrently. The data is static so it can't go away on us.
 //
    Path[fnPos] = '\0';
-   fsMutex.Lock();
    Have = ((dP = fsDirMP.Find(Path)) ? dP->Present : 1);
-   fsMutex.UnLock();
    Path[fnPos] = '/';
    return Have;
 }
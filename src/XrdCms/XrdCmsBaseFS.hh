@@ -36,7 +36,7 @@
 #include "XrdCms/XrdCmsPList.hh"
 #include "XrdCms/XrdCmsRRData.hh"
 #include "XrdCms/XrdCmsTypes.hh"
-#include "XrdOuc/XrdOucHash.hh"
+#include "XrdOuc/XrdOucFlatHash.hh"
 #include "XrdSys/XrdSysPthread.hh"
 
 /******************************************************************************/
@@ -147,7 +147,8 @@ inline int              Trim() {return preSel;}
 inline int              Traverse() {return Punt;}
 
        XrdCmsBaseFS(void (*theCB)(XrdCmsBaseFR *, int))
-                   : cBack(theCB), dfsMaxTries(dfltDfsTries),
+                   : fsDirMP(89, 144, 80, true),
+                     cBack(theCB), dfsMaxTries(dfltDfsTries),
                                    stgMaxTries(dfltStgTries),
                      dmLife(0), dpLife(0), lclStat(0), preSel(1),
                      dfsSys(0), Server(0), Fixed(0), Punt(0) {}
@@ -164,8 +165,7 @@ struct dMoP {int        Present;};
                               int dln, int Frc=0);
        void             Xeq(XrdCmsBaseFR *rP);
 
-       XrdSysMutex      fsMutex;
-       XrdOucHash<dMoP> fsDirMP;
+       XrdOucFlatHash<dMoP> fsDirMP;  // Read-mostly, it has its own lock
        void             (*cBack)(XrdCmsBaseFR *, int);
 
 struct RequestQ
@@ -29,6 +29,7 @@
 /******************************************************************************/
   
 #include <stdio.h>
+#include <time.h>
 #include <sys/types.h>
 
 #include "XrdCms/XrdCmsCache.hh"
@@ -61,17 +62,36 @@ class XrdCmsCacheJob : XrdJob
 {
 public:
 
-void   DoIt() {Cache.Recycle(myList); delete this;}
+void   DoIt() {for (int i = 0; i < XrdCmsCache::ShardNum; i++)
+                   if (myList[i]) Cache.Recycle(myList[i], i);
+               delete this;
+              }
 
-       XrdCmsCacheJob(XrdCmsKeyItem *List)
-                     : XrdJob("cache scrubber"), myList(List) {}
+       XrdCmsCacheJob(XrdCmsKeyItem **List)
+                     : XrdJob("cache scrubber")
+                     {memcpy(myList, List, sizeof(myList));}
       ~XrdCmsCacheJob() {}
 
 private:
 
-XrdCmsKeyItem *myList;
+XrdCmsKeyItem *myList[XrdCmsCache::ShardNum];
 };
 
+/******************************************************************************/
+/*                       L o c a l   F u n c t i o n s                        */
+/******************************************************************************/
+
+namespace
+{
+long long luClock()
+{
+   struct timespec ts;
+
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return static_cast<long long>(ts.tv_sec)*1000000000LL + ts.tv_nsec;
+}
+}
+
 /******************************************************************************/
 /*            E x t e r n a l   T h r e a d   I n t e r f a c e s             */
 /******************************************************************************/
@@ -116,18 +136,19 @@ void *XrdCmsStartTickTock(void *carg)
   
 int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
 {
+   CacheShard &Sh = getShard(Sel.Path);
    XrdCmsKeyItem *iP;
    SMask_t xmask;
    int isrw = (Sel.Opts & XrdCmsSelect::Write), isnew = 0;
 
 // Serialize processing
 //
-   myMutex.Lock();
+   Sh.myMutex.Lock();
 
 // Check for fast path processing
 //
    if (  !(iP = Sel.Path.TODRef) || !(iP->Key.Equiv(Sel.Path)))
-      if ((iP = Sel.Path.TODRef = CTable.Find(Sel.Path)))
+      if ((iP = Sel.Path.TODRef = Sh.CTable.Find(Sel.Path)))
          Sel.Path.Ref = iP->Key.Ref;
 
 // Add/Modify the entry
@@ -137,8 +158,8 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
           {iP->Loc.deadline = QDelay + time(0);
            iP->Loc.lifeline = nilTMO + iP->Loc.deadline;
            iP->Loc.hfvec = 0; iP->Loc.pfvec = 0; iP->Loc.qfvec = 0;
-           iP->Loc.TOD_B = BClock;
-           iP->Key.TOD = Tock;
+           iP->Loc.TOD_B = Sh.BClock;
+           iP->Key.TOD = Sh.Tock;
           } else {
            xmask = iP->Loc.pfvec;
            if (Sel.Opts & XrdCmsSelect::Pending) iP->Loc.pfvec |= mask;
@@ -155,11 +176,11 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
                      }
           }
       } else if (!(Sel.Opts & XrdCmsSelect::Advisory))
-                {Sel.Path.TOD = Tock;
-                 if ((iP = CTable.Add(Sel.Path)))
+                {Sel.Path.TOD = Sh.Tock;
+                 if ((iP = Sh.CTable.Add(Sel.Path)))
                     {iP->Loc.pfvec    = (Sel.Opts&XrdCmsSelect::Pending?mask:0);
                      iP->Loc.hfvec    = mask;
-                     iP->Loc.TOD_B    = BClock;
+                     iP->Loc.TOD_B    = Sh.BClock;
                      iP->Loc.qfvec    = 0;
                      iP->Loc.deadline = QDelay + time(0);
                      iP->Loc.lifeline = nilTMO + iP->Loc.deadline;
@@ -170,7 +191,7 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
 
 // All done
 //
-   myMutex.UnLock();
+   Sh.myMutex.UnLock();
    return isnew;
 }
   
@@ -190,29 +211,30 @@ int XrdCmsCache::AddFile(XrdCmsSelect &Sel, SMask_t mask)
   
 int XrdCmsCache::DelFile(XrdCmsSelect &Sel, SMask_t mask)
 {
+   CacheShard &Sh = getShard(Sel.Path);
    XrdCmsKeyItem *iP;
    int gone4good;
 
 // Lock the hash table
 //
-   myMutex.Lock();
+   Sh.myMutex.Lock();
 
 // Look up the entry and remove server
 //
-   if ((iP = CTable.Find(Sel.Path)))
+   if ((iP = Sh.CTable.Find(Sel.Path)))
       {iP->Loc.hfvec &= ~mask;
        iP->Loc.pfvec &= ~mask;
        if ((gone4good = (iP->Loc.hfvec == 0)))
           {if (nilTMO) iP->Loc.lifeline = nilTMO + time(0);
            if (!(Sel.Opts & XrdCmsSelect::Advisory)
-           &&  XrdCmsKeyItem::Unload(iP) && !CTable.Recycle(iP))
+           &&  Sh.CTable.Unload(iP) && !Sh.CTable.Recycle(iP))
               Say.Emsg("DelFile", "Delete failed for", iP->Key.Val);
           }
       } else gone4good = 0;
 
 // All done
 //
-   myMutex.UnLock();
+   Sh.myMutex.UnLock();
    return gone4good;
 }
   
@@ -231,19 +253,21 @@ int XrdCmsCache::DelFile(XrdCmsSelect &Sel, SMask_t mask)
   
 int  XrdCmsCache::GetFile(XrdCmsSelect &Sel, SMask_t mask)
 {
+   CacheShard &Sh = getShard(Sel.Path);
    XrdCmsKeyItem *iP;
    SMask_t bVec;
+   long long luStart = luClock();
    int retc;
 
 // Lock the hash table
 //
-   myMutex.Lock();
+   Sh.myMutex.Lock();
 
 // Look up the entry and return location information
 //
-   if ((iP = CTable.Find(Sel.Path)))
-      {if ((bVec = (iP->Loc.TOD_B < BClock 
-                 ? getBVec(iP->Key.TOD, iP->Loc.TOD_B) & mask : 0)))
+   if ((iP = Sh.CTable.Find(Sel.Path)))
+      {if ((bVec = (iP->Loc.TOD_B < Sh.BClock
+                 ? getBVec(Sh, iP->Key.TOD, iP->Loc.TOD_B) & mask : 0)))
           {iP->Loc.hfvec &= ~bVec; 
            iP->Loc.pfvec &= ~bVec;
            iP->Loc.qfvec &= ~mask;
@@ -258,15 +282,18 @@ int  XrdCmsCache::GetFile(XrdCmsSelect &Sel, SMask_t mask)
        if (nilTMO && retc == 1 && iP->Loc.hfvec == 0
        &&  iP->Loc.lifeline <= time(0)) retc = 0;
 
-       Sel.Vec.hf      = okVec & iP->Loc.hfvec;
-       Sel.Vec.pf      = okVec & iP->Loc.pfvec;
-       Sel.Vec.bf      = okVec & (bVec | iP->Loc.qfvec); iP->Loc.qfvec = 0;
+       Sel.Vec.hf      = Sh.okVec & iP->Loc.hfvec;
+       Sel.Vec.pf      = Sh.okVec & iP->Loc.pfvec;
+       Sel.Vec.bf      = Sh.okVec & (bVec | iP->Loc.qfvec); iP->Loc.qfvec = 0;
        Sel.Path.Ref    = iP->Key.Ref;
+       Sh.luHit++;
       } else retc = 0;
 
 // All done
 //
-   myMutex.UnLock();
+   Sh.luNum++;
+   Sh.luTime += luClock() - luStart;
+   Sh.myMutex.UnLock();
    Sel.Path.TODRef = iP;
    return retc;
 }
@@ -278,14 +305,17 @@ int  XrdCmsCache::GetFile(XrdCmsSelect &Sel, SMask_t mask)
 int XrdCmsCache::UnkFile(XrdCmsSelect &Sel, SMask_t mask)
 {
    EPNAME("UnkFile");
+   CacheShard &Sh = getShard(Sel.Path);
    XrdCmsKeyItem *iP;
 
 // Make sure we have the proper information. If so, lock the hash table
 //
-   myMutex.Lock();
+   Sh.myMutex.Lock();
 
 // Look up the entry and if valid update the unqueried vector. Note that
-// this method may only be called after GetFile() or AddFile() for a new entry
+// this method may only be called after GetFile() or AddFile() for a new entry.
+// An item only moves to another shard via the free list, which clears its
+// hash, so a stale reference never passes the Equiv() test.
 //
    if ((iP = Sel.Path.TODRef))
       {if (iP->Key.Equiv(Sel.Path)) iP->Loc.qfvec = mask;
@@ -294,7 +324,7 @@ int XrdCmsCache::UnkFile(XrdCmsSelect &Sel, SMask_t mask)
 
 // Return result
 //
-   myMutex.UnLock();
+   Sh.myMutex.UnLock();
    DEBUG("rc=" <<(iP ? 1 : 0) <<" path=" <<Sel.Path.Val);
    return (iP ? 1 : 0);
 }
@@ -306,6 +336,7 @@ int XrdCmsCache::UnkFile(XrdCmsSelect &Sel, SMask_t mask)
 int XrdCmsCache::WT4File(XrdCmsSelect &Sel, SMask_t mask)
 {
    EPNAME("WT4File");
+   CacheShard &Sh = getShard(Sel.Path);
    XrdCmsKeyItem *iP;
    time_t  Now;
    int     retc;
@@ -313,7 +344,7 @@ int XrdCmsCache::WT4File(XrdCmsSelect &Sel, SMask_t mask)
 // Make sure we have the proper information. If so, lock the hash table
 //
    if (!Sel.InfoP) return DLTime;
-   myMutex.Lock();
+   Sh.myMutex.Lock();
 
 // Look up the entry and if valid add it to the callback queue. Note that
 // this method may only be called after GetFile() or AddFile() for a new entry
@@ -328,7 +359,7 @@ int XrdCmsCache::WT4File(XrdCmsSelect &Sel, SMask_t mask)
 
 // Return result
 //
-   myMutex.UnLock();
+   Sh.myMutex.UnLock();
    DEBUG("rc=" <<retc <<" path=" <<Sel.Path.Val);
    return retc;
 }
@@ -343,13 +374,16 @@ int XrdCmsCache::WT4File(XrdCmsSelect &Sel, SMask_t mask)
 void XrdCmsCache::Bounce(SMask_t smask, int SNum)
 {
 
-// Simply indicate that this server bounced
+// Simply indicate that this server bounced, one shard at a time
 //
-   myMutex.Lock();
-   Bounced[SNum] = ++BClock;
-   okVec |= smask;
-   if (SNum > vecHi) vecHi = SNum;
-   myMutex.UnLock();
+   for (int i = 0; i < ShardNum; i++)
+       {CacheShard &Sh = Shard[i];
+        Sh.myMutex.Lock();
+        Sh.Bounced[SNum] = ++Sh.BClock;
+        Sh.okVec |= smask;
+        if (SNum > Sh.vecHi) Sh.vecHi = SNum;
+        Sh.myMutex.UnLock();
+       }
 }
 
 /******************************************************************************/
@@ -364,13 +398,16 @@ void XrdCmsCache::Drop(SMask_t smask, int SNum, int xHi)
 //
    Paths.Remove(smask);
 
-// Remove the node from the list of valid nodes
+// Remove the node from the list of valid nodes, one shard at a time
 //
-   myMutex.Lock();
-   Bounced[SNum] = 0;
-   okVec &= nmask;
-   vecHi = xHi;
-   myMutex.UnLock();
+   for (int i = 0; i < ShardNum; i++)
+       {CacheShard &Sh = Shard[i];
+        Sh.myMutex.Lock();
+        Sh.Bounced[SNum] = 0;
+        Sh.okVec &= nmask;
+        Sh.vecHi = xHi;
+        Sh.myMutex.UnLock();
+       }
 }
 
 /******************************************************************************/
@@ -379,7 +416,6 @@ void XrdCmsCache::Drop(SMask_t smask, int SNum, int xHi)
   
 int XrdCmsCache::Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold)
 {
-   XrdCmsKeyItem *iP;
    pthread_t tid;
 
 // Indicate whether we are a shared-everything setup as this changes how we
@@ -411,32 +447,67 @@ int XrdCmsCache::Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold
 
 // Get the first reserve of cache items
 //
-   iP = XrdCmsKeyItem::Alloc(0);
-   XrdCmsKeyItem::Unload((unsigned int)0);
-   iP->Recycle();
+   XrdCmsKeyItem::Replenish();
 
 // All done
 //
    return 1;
 }
 
+/******************************************************************************/
+/* public                          S t a t s                                  */
+/******************************************************************************/
+
+int XrdCmsCache::Stats(char *bfr, int bln)
+{
+   static const char statfmt[] = "<cch id=\"%d\"><lu>%lld</lu>"
+                                 "<hit>%lld</hit><lt>%lld</lt></cch>";
+   long long luNum, luHit, luTime;
+   int mlen, tlen = 0;
+
+// Check if actual length wanted
+//
+   if (!bfr) return ShardNum * (sizeof(statfmt) + 3 + 20*3);
+
+// Format the lookup count, the number of hits and the average lookup time
+// in nanoseconds for each shard.
+//
+   for (int i = 0; i < ShardNum; i++)
+       {CacheShard &Sh = Shard[i];
+        Sh.myMutex.Lock();
+        luNum = Sh.luNum; luHit = Sh.luHit; luTime = Sh.luTime;
+        Sh.myMutex.UnLock();
+        mlen = snprintf(bfr, bln, statfmt, i, luNum, luHit,
+                        (luNum ? luTime/luNum : 0));
+        if ((bln -= mlen) <= 0) return 0;
+        bfr += mlen; tlen += mlen;
+       }
+   return tlen;
+}
+
 /******************************************************************************/
 /* public                       T i c k T o c k                               */
 /******************************************************************************/
 
 void *XrdCmsCache::TickTock()
 {
-   XrdCmsKeyItem *iP;
+   XrdCmsKeyItem *iP[ShardNum];
+   bool aged;
 
-// Simply adjust the clock and trim old entries
+// Simply adjust the clock and trim old entries. Each shard keeps its own
+// clock so that it can be advanced while holding only that shard's lock.
 //
    do {XrdSysTimer::Snooze(Tick);
-       myMutex.Lock();
-       Tock = (Tock+1) & XrdCmsKeyItem::TickMask;
-       Bhistory[Tock].Start = Bhistory[Tock].End = 0;
-       iP = XrdCmsKeyItem::Unload(Tock);
-       myMutex.UnLock();
-       if (iP) Sched->Schedule((XrdJob *)new XrdCmsCacheJob(iP));
+       aged = false;
+       for (int i = 0; i < ShardNum; i++)
+           {CacheShard &Sh = Shard[i];
+            Sh.myMutex.Lock();
+            Sh.Tock = (Sh.Tock+1) & XrdCmsKeyItem::TickMask;
+            Sh.Bhistory[Sh.Tock].Start = Sh.Bhistory[Sh.Tock].End = 0;
+            if ((iP[i] = Sh.CTable.Unload(Sh.Tock))) aged = true;
+            Sh.myMutex.UnLock();
+           }
+       if (aged) Sched->Schedule((XrdJob *)new XrdCmsCacheJob(iP));
       } while(1);
 
 // Keep compiler happy
@@ -502,7 +573,8 @@ void XrdCmsCache::Dispatch(XrdCmsSelect &Sel, XrdCmsKeyItem *iP,
 /*                               g e t B V e c                                */
 /******************************************************************************/
   
-SMask_t XrdCmsCache::getBVec(unsigned int TODa, unsigned int &TODb)
+SMask_t XrdCmsCache::getBVec(CacheShard &Sh, unsigned int TODa,
+                                             unsigned int &TODb)
 {
    EPNAME("getBVec");
    SMask_t BVec(0);
@@ -510,20 +582,20 @@ SMask_t XrdCmsCache::getBVec(unsigned int TODa, unsigned int &TODb)
 
 // See if we can use a previously calculated bVec
 //
-   if (Bhistory[TODa].End == BClock && Bhistory[TODa].Start <= TODb)
-      {Bhits++; TODb = BClock; return Bhistory[TODa].Vec;}
+   if (Sh.Bhistory[TODa].End == Sh.BClock && Sh.Bhistory[TODa].Start <= TODb)
+      {Sh.Bhits++; TODb = Sh.BClock; return Sh.Bhistory[TODa].Vec;}
 
 // Calculate the new vector
 //
-   for (i = 0; i <= vecHi; i++)
-       if (TODb < Bounced[i]) BVec |= 1ULL << i;
+   for (i = 0; i <= Sh.vecHi; i++)
+       if (TODb < Sh.Bounced[i]) BVec |= 1ULL << i;
 
-   Bhistory[TODa].Vec   = BVec;
-   Bhistory[TODa].Start = TODb;
-   Bhistory[TODa].End   = BClock;
-   TODb                 = BClock;
-   Bmiss++;
-   if (!(Bmiss & 0xff)) DEBUG("hits=" <<Bhits <<" miss=" <<Bmiss);
+   Sh.Bhistory[TODa].Vec   = BVec;
+   Sh.Bhistory[TODa].Start = TODb;
+   Sh.Bhistory[TODa].End   = Sh.BClock;
+   TODb                    = Sh.BClock;
+   Sh.Bmiss++;
+   if (!(Sh.Bmiss & 0xff)) DEBUG("hits=" <<Sh.Bhits <<" miss=" <<Sh.Bmiss);
    return BVec;
 }
 
@@ -531,8 +603,9 @@ SMask_t XrdCmsCache::getBVec(unsigned int TODa, unsigned int &TODb)
 /*                               R e c y c l e                                */
 /******************************************************************************/
   
-void XrdCmsCache::Recycle(XrdCmsKeyItem *theList)
+void XrdCmsCache::Recycle(XrdCmsKeyItem *theList, int sNum)
 {
+   CacheShard &Sh = Shard[sNum];
    XrdCmsKeyItem *iP;
    char msgBuff[100];
    int numNull, numHave, numFree, numRecycled = 0;
@@ -543,28 +616,22 @@ void XrdCmsCache::Recycle(XrdCmsKeyItem *theList)
         {theList = iP->Key.TODRef;
          if (iP->Loc.roPend) RRQ.Del(iP->Loc.roPend, iP);
          if (iP->Loc.rwPend) RRQ.Del(iP->Loc.rwPend, iP);
-         myMutex.Lock(); CTable.Recycle(iP); myMutex.UnLock();
+         Sh.myMutex.Lock(); Sh.CTable.Recycle(iP); Sh.myMutex.UnLock();
          numRecycled++;
         }
 
 // See if we have enough items in reserve
 //
-   myMutex.Lock();
    XrdCmsKeyItem::Stats(numHave, numFree, numNull);
    if (numFree < XrdCmsKeyItem::minFree)
-      {myMutex.UnLock();
-       if (!(numNull /= 4)) numNull = 1;
+      {if (!(numNull /= 4)) numNull = 1;
        numHave += XrdCmsKeyItem::minAlloc * numNull;
-       while(numNull--)
-            {myMutex.Lock();
-             numFree = XrdCmsKeyItem::Replenish();
-             myMutex.UnLock();
-            }
-      } else myMutex.UnLock();
+       while(numNull--) numFree = XrdCmsKeyItem::Replenish();
+      }
 
 // Log the stats
 //
-   sprintf(msgBuff, "%d cache items; %d allocated %d free",
-           numRecycled, numHave, numFree);
+   sprintf(msgBuff, "%d cache items in shard %d; %d allocated %d free",
+           numRecycled, sNum, numHave, numFree);
    Say.Emsg("Recycle", msgBuff);
 }
@@ -76,45 +76,70 @@ void        Drop(SMask_t mask, int SNum, int xHi);
 
 int         Init(int fxHold, int fxDelay, int fxQuery, int seFS, int nxHold);
 
+// Stats() formats the per-shard lookup statistics. When bfr is nil, the
+// maximum length of the result is returned.
+//
+int         Stats(char *bfr, int bln);
+
 void       *TickTock();
 
 static const int min_nxTime = 60;
 
-            XrdCmsCache() : okVec(0), Tick(8*60*60), Tock(0), BClock(0), 
-                            nilTMO(0),
-                            DLTime(5), QDelay(5), Bhits(0), Bmiss(0), vecHi(-1),
-                            isDFS(0)
-                          {memset(Bounced,  0, sizeof(Bounced));
-                           memset(Bhistory, 0, sizeof(Bhistory));
-                          }
+// The cache is split into shards by key hash. Each shard has its own lock,
+// table, aging clock and copy of the bounce state so that lookups of
+// different paths do not serialize and the clock and bounce updates sweep
+// one shard at a time.
+//
+static const int ShardNum  = 16;   // Must be a power of 2
+static const int ShardMask = ShardNum-1;
+
+            XrdCmsCache() : Tick(8*60*60), nilTMO(0),
+                            DLTime(5), QDelay(5), isDFS(0) {}
            ~XrdCmsCache() {}   // Never gets deleted
 
 private:
 
+struct CacheShard
+      {XrdSysMutex   myMutex;
+       XrdCmsNash    CTable;
+       struct {SMask_t      Vec;
+               unsigned int Start;
+               unsigned int End;
+              }      Bhistory[XrdCmsKeyItem::TickRate];
+       unsigned int  Bounced[STMax];
+       SMask_t       okVec;
+       unsigned int  Tock;
+       unsigned int  BClock;
+                int  Bhits;
+                int  Bmiss;
+                int  vecHi;
+       long long     luNum;     // Lookups
+       long long     luHit;     // Lookups that found the path
+       long long     luTime;    // Nanoseconds spent in lookups
+
+                     CacheShard() : CTable(1597, 2584), okVec(0), Tock(0),
+                                    BClock(0), Bhits(0), Bmiss(0), vecHi(-1),
+                                    luNum(0), luHit(0), luTime(0)
+                                  {memset(Bhistory, 0, sizeof(Bhistory));
+                                   memset(Bounced,  0, sizeof(Bounced));
+                                  }
+      };
+
 void          Add2Q(XrdCmsRRQInfo *Info, XrdCmsKeyItem *cp, int selOpts);
 void          Dispatch(XrdCmsSelect &Sel, XrdCmsKeyItem *cinfo,
                        short roQ, short rwQ);
-SMask_t       getBVec(unsigned int todA, unsigned int &todB);
-void          Recycle(XrdCmsKeyItem *theList);
-
-struct  {SMask_t      Vec;
-         unsigned int Start;
-         unsigned int End;
-        }             Bhistory[XrdCmsKeyItem::TickRate];
-
-XrdSysMutex   myMutex;
-XrdCmsNash    CTable;
-unsigned int  Bounced[STMax];
-SMask_t       okVec;
+SMask_t       getBVec(CacheShard &Sh, unsigned int todA, unsigned int &todB);
+CacheShard   &getShard(XrdCmsKey &Key)
+                      {if (!Key.Hash) Key.setHash();
+                       return Shard[(Key.Hash >> 16) & ShardMask];
+                      }
+void          Recycle(XrdCmsKeyItem *theList, int sNum);
+
+CacheShard    Shard[ShardNum];
 unsigned int  Tick;
-unsigned int  Tock;
-unsigned int  BClock;
          int  nilTMO;
          int  DLTime;
          int  QDelay;
-         int  Bhits;
-         int  Bmiss;
-         int  vecHi;
          int  isDFS;
 };
 
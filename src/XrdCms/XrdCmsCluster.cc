@@ -118,6 +118,7 @@ XrdCmsCluster::XrdCmsCluster()
      SelRcnt = 0;
      SelRtot = 0;
      SelTcnt = 0;
+     P2CSeed = static_cast<unsigned int>(time(0)) | 1;
      doReset = 0;
      resetMask = 0;
      peerHost  = 0;
@@ -1100,7 +1101,9 @@ int XrdCmsCluster::Select(SMask_t pmask, int &port, char *hbuff, int &hlen,
 //
    if (isMulti || baseFS.isDFS())
       {STMutex.Lock();
-       nP = (Config.sched_RR ? SelbyRef(pmask,selR) : SelbyLoad(pmask,selR));
+            if (Config.sched_P2C) nP = SelbyP2C (pmask, selR);
+       else if (Config.sched_RR)  nP = SelbyRef (pmask, selR);
+       else                       nP = SelbyLoad(pmask, selR);
        if (nP) hlen = nP->netIF.GetName(hbuff, port, nType) + 1;
           else hlen = 0;
        STMutex.UnLock();
@@ -1124,8 +1127,8 @@ int XrdCmsCluster::Select(SMask_t pmask, int &port, char *hbuff, int &hlen,
        if (nP)
           {if (isrw)
               if (nP->isNoStage || nP->DiskFree < nP->DiskMinF)    nP = 0;
-                 else {SelWcnt++; nP->RefTotW++; nP->RefW++;}
-              else    {SelRcnt++; nP->RefTotR++; nP->RefR++;}
+                 else {SelWcnt++; nP->RefTotW++; nP->RefW++; nP->RefOut++;}
+              else    {SelRcnt++; nP->RefTotR++; nP->RefR++; nP->RefOut++;}
           }
       }
 
@@ -1253,6 +1256,7 @@ int XrdCmsCluster::Statt(char *bfr, int bln)
           "<lf>%lld</lf><ls>%lld</ls><rf>%lld</rf><rs>%lld</rs></frq>";
 
    static int AddFrq = (Config.RepStats & XrdCmsConfig::RepStat_frq);
+   static int AddCch = (Config.RepStats & XrdCmsConfig::RepStat_cch);
    static int AddShr = (Config.RepStats & XrdCmsConfig::RepStat_shr)
                        && Config.asMetaMan();
 
@@ -1280,6 +1284,7 @@ int XrdCmsCluster::Statt(char *bfr, int bln)
           (sizeof(statfmt2) + 10*2 + 256 + 16) * STMax + sizeof(statfmt4);
        if (AddShr) n += sizeof(statfmt3) + 12;
        if (AddFrq) n += sizeof(statfmt4) + (10*8);
+       if (AddCch) n += Cache.Stats(0, 0);
        return n;
       }
 
@@ -1336,6 +1341,11 @@ int XrdCmsCluster::Statt(char *bfr, int bln)
        bfr += mlen; bln -= mlen; tlen += mlen;
       }
 
+   if (AddCch && bln > 0)
+      {if (!(mlen = Cache.Stats(bfr, bln))) return 0;
+       bfr += mlen; bln -= mlen; tlen += mlen;
+      }
+
 // See if we overflowed. otherwise finish up
 //
    if (sp || bln < (int)sizeof(statfmt0)) return 0;
@@ -1571,8 +1581,10 @@ int XrdCmsCluster::SelNode(XrdCmsSelect &Sel, SMask_t pmask, SMask_t amask)
    mask = pmask & peerMask;
    while(pass--)
         {if (mask)
-            {nP = (Config.sched_RR || (Sel.Opts & XrdCmsSelect::UseRef)
-                ?  SelbyRef(mask,selR) : SelbyLoad(mask,selR));
+            {     if (Sel.Opts & XrdCmsSelect::UseRef) nP = SelbyRef (mask,selR);
+             else if (Config.sched_P2C && !selR.selPack) nP = SelbyP2C (mask,selR);
+             else if (Config.sched_RR)                   nP = SelbyRef (mask,selR);
+             else                                        nP = SelbyLoad(mask,selR);
              if (nP || (selR.nPick && selR.delay)
              ||  NodeCnt < Config.SUPCount) break;
             }
@@ -1670,6 +1682,7 @@ int XrdCmsCluster::SelNode(XrdCmsSelect &Sel, SMask_t pmask, SMask_t amask)
 #define RefCount(sP, sPMulti, NeedSpace)                       \
         if (NeedSpace) {SelWcnt++; sP->RefTotW++; sP->RefW++;} \
            else        {SelRcnt++; sP->RefTotR++; sP->RefR++;} \
+        sP->RefOut++;                                          \
         if (sPMulti && sP->Share && !sP->Shrem--)              \
            {sP->RefW += sP->Shrip; sP->RefR += sP->Shrip;      \
             sP->Shrem = sP->Share; sP->Shrin++;                \
@@ -1773,6 +1786,70 @@ XrdCmsNode *XrdCmsCluster::SelbyLoad(SMask_t mask, XrdCmsSelector &selR)
    return sp;
 }
 
+/******************************************************************************/
+/*                              S e l b y P 2 C                               */
+/******************************************************************************/
+
+// Two-choice selection samples two random eligible nodes from the mask and
+// picks the one with the lower score. The score is the smoothed load (or mass
+// when space is needed) plus a penalty for every redirection made since the
+// node last reported its load, as such redirections are not yet reflected in
+// the load, and a penalty for its smoothed ping response time. This avoids
+// sending a burst of clients to the same least loaded node. Should no node be
+// eligible we fall back to a full scan which establishes the delay reason.
+
+// Caller must have the STMutex locked. The returned node. if any, is unlocked.
+
+XrdCmsNode *XrdCmsCluster::SelbyP2C(SMask_t mask, XrdCmsSelector &selR)
+{
+    XrdCmsNode *np, *cand[2];
+    SMask_t cmask = mask, bits;
+    long long score[2];
+    bool reqSS = (selR.needSpace & XrdCmsNode::allowsSS) != 0;
+    int i, n = 0, nth;
+
+// Draw nodes at random until we have two eligible ones or run out of nodes
+//
+   while(n < 2 && cmask)
+        {P2CSeed ^= P2CSeed << 13; P2CSeed ^= P2CSeed >> 17;
+         P2CSeed ^= P2CSeed << 5;
+         nth = P2CSeed % __builtin_popcountll(cmask);
+         for (bits = cmask; nth; nth--) bits &= bits - 1;
+         i = __builtin_ctzll(bits);
+         cmask &= ~(1ULL << i);
+         if (i > STHi || !(np = NodeTab[i])) continue;
+         if (!(selR.needNet & np->hasNet) || np->isOffline || np->isBad)
+            continue;
+         if (!Config.sched_RR && np->myLoad > Config.MaxLoad) continue;
+         if (selR.needSpace && (np->DiskFree < np->DiskMinF
+                                || (reqSS && np->isNoStage))) continue;
+         score[n] = (Config.sched_RR ? 0
+                  : (selR.needSpace ? np->avgMass : np->avgLoad))
+                  + static_cast<long long>(Config.P_redir) * np->RefOut
+                  + static_cast<long long>(Config.P_rtt)   * np->myRTT / 1000;
+         cand[n++] = np;
+        }
+
+// If nothing is eligible do a full scan so that we get the reason why
+//
+   if (!n) return (Config.sched_RR ? SelbyRef(mask, selR)
+                                   : SelbyLoad(mask, selR));
+
+// Pick the better node, on a tie use the one referenced less often
+//
+   selR.Reset(); SelTcnt++;
+   np = cand[0];
+   if (n > 1)
+      {if (score[1] < score[0]) np = cand[1];
+          else if (score[1] == score[0])
+                  {if (selR.needSpace) {if (cand[1]->RefW < np->RefW) np = cand[1];}
+                      else             {if (cand[1]->RefR < np->RefR) np = cand[1];}
+                  }
+      }
+   RefCount(np, (n > 1), selR.needSpace);
+   return np;
+}
+ 
 /******************************************************************************/
 /*                              S e l b y R e f                               */
 /******************************************************************************/
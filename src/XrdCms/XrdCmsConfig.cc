@@ -667,6 +667,8 @@ void XrdCmsConfig::ConfigDefaults(void)
    P_load   = 0;
    P_mem    = 0;
    P_pag    = 0;
+   P_redir  = 5;
+   P_rtt    = 1;
    AskPerf  = 10;         // Every 10 pings
    AskPing  = 60;         // Every  1 minute
    PingTick = 0;
@@ -684,7 +686,7 @@ void XrdCmsConfig::ConfigDefaults(void)
    DiskOK   = 0;          // Does not have any disk
    myPaths  = (char *)""; // Default is 'r /'
    ConfigFN = 0;
-   sched_RR = sched_Pack = sched_Level = 0; sched_Force = 1;
+   sched_RR = sched_Pack = sched_Level = sched_P2C = 0; sched_Force = 1;
    isManager= 0;
    isMeta   = 0;
    isPeer   = 0;
@@ -1050,10 +1052,11 @@ int XrdCmsConfig::setupManager()
 //
    sched_RR = (100 == P_fuzz) || !AskPerf
               || !(P_cpu || P_io || P_load || P_mem || P_pag);
-   if (sched_RR)
-      {Say.Say("Config round robin scheduling in effect.");
-       sched_Level = 0;
-      }
+   if (sched_P2C) Say.Say("Config two-choice scheduling in effect.");
+      else if (sched_RR)
+              {Say.Say("Config round robin scheduling in effect.");
+               sched_Level = 0;
+              }
 
 // Create statistical monitoring thread
 //
@@ -2395,6 +2398,7 @@ int XrdCmsConfig::xreps(XrdSysError *eDest, XrdOucStream &CFile)
     static struct repsopts {const char *opname; int opval;} rsopts[] =
        {
         {"all",      RepStat_All},
+        {"cch",      RepStat_cch},
         {"frq",      RepStat_frq},
         {"shr",      RepStat_shr}
        };
@@ -2606,6 +2610,7 @@ int XrdCmsConfig::xrole(XrdSysError *eDest, XrdOucStream &CFile)
                                        [io <p>] [runq <p>]
                                        [mem <p>] [pag <p>] [space <p>]
                                        [fuzz <p>] [maxload <p>] [refreset <sec>]
+                                       [p2c {0 | 1}] [redir <p>] [rtt <p>]
                 [affinity [default] {none | weak | strong | strict}]
 
              <p>      is the percentage to include in the load as a value
@@ -2616,7 +2621,11 @@ int XrdCmsConfig::xrole(XrdSysError *eDest, XrdOucStream &CFile)
                       between reference counter resets. gshr is the percentage
                       share of requests that should be redirected here via the 
                       metamanager (i.e. global share). The gsdflt is the
-                      default to be used by the metamanager.
+                      default to be used by the metamanager. When p2c is 1,
+                      two eligible nodes are picked at random and the one with
+                      the lower smoothed load is selected; each redirection
+                      made since its last load report adds redir and each ms
+                      of its smoothed ping response time adds rtt to the load.
 
    Type: Any, dynamic.
 
@@ -2626,7 +2635,7 @@ int XrdCmsConfig::xrole(XrdSysError *eDest, XrdOucStream &CFile)
 int XrdCmsConfig::xsched(XrdSysError *eDest, XrdOucStream &CFile)
 {
     char *val;
-    int  i, ppp, V_hntry = -1;
+    int  i, ppp, V_hntry = -1, V_p2c = -1;
     static struct schedopts {const char *opname; int maxv; int *oploc;}
            scopts[] =
        {
@@ -2640,6 +2649,9 @@ int XrdCmsConfig::xsched(XrdSysError *eDest, XrdOucStream &CFile)
         {"pag",      100, &P_pag},
         {"space",    100, &P_dsk},
         {"maxload",  100, &MaxLoad},
+        {"p2c",        1, &V_p2c},
+        {"redir",    100, &P_redir},
+        {"rtt",      100, &P_rtt},
         {"refreset", -1,  &RefReset},
         {"affinity", -2,  0},
         {"tryhname",   1, &V_hntry}
@@ -2678,6 +2690,7 @@ int XrdCmsConfig::xsched(XrdSysError *eDest, XrdOucStream &CFile)
 // Handle non-int settings
 //
    if (V_hntry >= 0) DoHnTry = static_cast<char>(V_hntry);
+   if (V_p2c   >= 0) sched_P2C = static_cast<char>(V_p2c);
 
     return 0;
 }
@@ -103,6 +103,8 @@ int         P_io;         // % I/O Capacity in load factor
 int         P_load;       // % MSC Capacity in load factor
 int         P_mem;        // % MEM Capacity in load factor
 int         P_pag;        // % PAG Capacity in load factor
+int         P_redir;      // %     Load added per outstanding redirection (p2c)
+int         P_rtt;        // %     Load added per ms of ping response (p2c)
 
 char        DoMWChk;      // When true (default) perform multiple write check
 char        DoHnTry;      // When true (default) use hostnames for try redirs
@@ -123,6 +125,7 @@ char        sched_RR;     // 1 -> Simply do round robin scheduling
 char        sched_Pack;   // 1 -> Pick oldest node (>1 same but wait for resps)
 char        sched_Level;  // 1 -> Use load-based level for "pack" selection
 char        sched_Force;  // 1 -> Client cannot select mode
+char        sched_P2C;    // 1 -> Pick the better of two random nodes
 int         doWait;       // 1 -> Wait for a data end-point
 
 int         adsPort;      // Alternate server port
@@ -183,6 +186,7 @@ XrdNetSecurity    *Police;
 //
 static const int RepStat_frq    = 0x0001; // Fast Response Queue
 static const int RepStat_shr    = 0x0002; // Share
+static const int RepStat_cch    = 0x0004; // Location cache shards
 static const int RepStat_All    = 0xffff; // All
 
 private:
@@ -58,7 +58,7 @@ void XrdCmsKey::setHash()
 /*                           S t a t i c   D a t a                            */
 /******************************************************************************/
   
-XrdCmsKeyItem *XrdCmsKeyItem::TockTable[TickRate] = {0};
+XrdSysMutex    XrdCmsKeyItem::FreeMutex;
 XrdCmsKeyItem *XrdCmsKeyItem::Free    = 0;
 int            XrdCmsKeyItem::numFree = 0;
 int            XrdCmsKeyItem::numHave = 0;
@@ -68,8 +68,9 @@ int            XrdCmsKeyItem::numNull = 0;
 /* static public                   A l l o c                                  */
 /******************************************************************************/
   
-XrdCmsKeyItem *XrdCmsKeyItem::Alloc(unsigned int theTock)
+XrdCmsKeyItem *XrdCmsKeyItem::Alloc()
 {
+  XrdSysMutexHelper frMon(FreeMutex);
   XrdCmsKeyItem *kP;
 
 // Try to allocate an existing item or replenish the list
@@ -77,16 +78,12 @@ XrdCmsKeyItem *XrdCmsKeyItem::Alloc(unsigned int theTock)
    do {if ((kP = Free))
           {Free = kP->Next;
            numFree--;
-           theTock &= TickMask;
-           kP->Key.TOD    = theTock;
-           kP->Key.TODRef = TockTable[theTock];
-           TockTable[theTock] = kP;
            if (!(kP->Key.Ref++)) kP->Key.Ref = 1;
             kP->Loc.roPend = kP->Loc.rwPend = 0;
            return kP;
           }
        numNull++;
-       } while(Replenish());
+       } while(Refill());
 
 // We failed
 //
@@ -109,19 +106,10 @@ void XrdCmsKeyItem::Recycle()
 
 // Put entry on the free list
 //
+   FreeMutex.Lock();
    Next = Free; Free = this;
    numFree++;
-}
-
-/******************************************************************************/
-/* public                         R e l o a d                                 */
-/******************************************************************************/
-  
-void XrdCmsKeyItem::Reload()
-{
-   Key.TOD &= static_cast<unsigned char>(TickMask);
-   Key.TODRef = TockTable[Key.TOD];
-   TockTable[Key.TOD] = this;
+   FreeMutex.UnLock();
 }
 
 /******************************************************************************/
@@ -130,26 +118,9 @@ void XrdCmsKeyItem::Reload()
 
 int XrdCmsKeyItem::Replenish()
 {
-   EPNAME("Replenish");
-   XrdCmsKeyItem *kP;
-   int i;
-
-// Allocate a quantum of free elements and chain them into the free list
-//
-   if (!(kP = new XrdCmsKeyItem[minAlloc])) return 0;
-   DEBUG("old free " <<numFree <<" + " <<minAlloc <<" = " <<numHave+minAlloc);
+   XrdSysMutexHelper frMon(FreeMutex);
 
-// We would do this in an initializer but that causes problems when alloacting
-// temporary items on the stack. So, manually put these on the free list.
-//
-   i = minAlloc;
-   while(i--) {kP->Next = Free; Free = kP; kP++;}
-  
-// Return the number we have free
-//
-   numHave += minAlloc;
-   numFree += minAlloc;
-   return numFree;
+   return Refill();
 }
 
 /******************************************************************************/
@@ -158,6 +129,7 @@ int XrdCmsKeyItem::Replenish()
 
 void XrdCmsKeyItem::Stats(int &isAlloc, int &isFree, int &wasNull)
 {
+   XrdSysMutexHelper frMon(FreeMutex);
 
    isAlloc  = numHave;
    isFree   = numFree;
@@ -166,45 +138,31 @@ void XrdCmsKeyItem::Stats(int &isAlloc, int &isFree, int &wasNull)
 }
 
 /******************************************************************************/
-/* static public                  U n l o a d                                 */
+/* static private                  R e f i l l                                */
 /******************************************************************************/
-  
-XrdCmsKeyItem *XrdCmsKeyItem::Unload(unsigned int theTock)
+
+// The caller must hold FreeMutex.
+//
+int XrdCmsKeyItem::Refill()
 {
-   XrdCmsKeyItem myItem, *nP, *pP = &myItem;
+   EPNAME("Replenish");
+   XrdCmsKeyItem *kP;
+   int i;
 
-// Remove all entries from the indicated list. If any entries have been
-// reassigned to a different list, move them to the right list. Otherwise,
-// make the entry unfindable by clearing the hash code. Since item recycling
-// requires knowing the hash code, we save it elsewhere in the object.
+// Allocate a quantum of free elements and chain them into the free list
 //
-   theTock &= TickMask;
-   myItem.Key.TODRef = TockTable[theTock]; TockTable[theTock] = 0;
-   while((nP = pP->Key.TODRef))
-         if (nP->Key.TOD == theTock) 
-            {nP->Loc.HashSave = nP->Key.Hash; nP->Key.Hash = 0; pP = nP;}
-            else {pP->Key.TODRef = nP->Key.TODRef;
-                  nP->Key.TODRef = TockTable[nP->Key.TOD];
-                  TockTable[nP->Key.TOD] = nP;
-                 }
-   return myItem.Key.TODRef;
-}
+   if (!(kP = new XrdCmsKeyItem[minAlloc])) return 0;
+   DEBUG("old free " <<numFree <<" + " <<minAlloc <<" = " <<numHave+minAlloc);
 
-/******************************************************************************/
+// We would do this in an initializer but that causes problems when alloacting
+// temporary items on the stack. So, manually put these on the free list.
+//
+   i = minAlloc;
+   while(i--) {kP->Next = Free; Free = kP; kP++;}
   
-XrdCmsKeyItem *XrdCmsKeyItem::Unload(XrdCmsKeyItem *theItem)
-{
-   XrdCmsKeyItem *kP, *pP = 0;
-   unsigned int theTock = theItem->Key.TOD & TickMask;
-
-// Remove the entry from the right list
+// Return the number we have free
 //
-   kP = TockTable[theTock];
-   while(kP && kP != theItem) {pP = kP; kP = kP->Key.TODRef;}
-   if (kP)
-      {if (pP) pP->Key.TODRef     = kP->Key.TODRef;
-          else TockTable[theTock] = kP->Key.TODRef;
-       kP->Loc.HashSave = kP->Key.Hash; kP->Key.Hash = 0;
-      }
-   return kP;
+   numHave += minAlloc;
+   numFree += minAlloc;
+   return numFree;
 }
@@ -45,6 +45,7 @@ XrdCmsNash::XrdCmsNash(int psize, int csize)
      nashtable     = (XrdCmsKeyItem **)
                      malloc( (size_t)(csize*sizeof(XrdCmsKeyItem *)) );
      memset((void *)nashtable, 0, (size_t)(csize*sizeof(XrdCmsKeyItem *)));
+     memset((void *)TockTable, 0, sizeof(TockTable));
 }
 
 /******************************************************************************/
@@ -54,11 +55,14 @@ XrdCmsNash::XrdCmsNash(int psize, int csize)
 XrdCmsKeyItem *XrdCmsNash::Add(XrdCmsKey &Key)
 {
    XrdCmsKeyItem *hip;
-   unsigned int kent;
+   unsigned int kent, theTock = Key.TOD & XrdCmsKeyItem::TickMask;
 
-// Allocate the entry
+// Allocate the entry and place it on the aging list for its tick
 //
-   if (!(hip = XrdCmsKeyItem::Alloc(Key.TOD))) return (XrdCmsKeyItem *)0;
+   if (!(hip = XrdCmsKeyItem::Alloc())) return (XrdCmsKeyItem *)0;
+   hip->Key.TOD    = theTock;
+   hip->Key.TODRef = TockTable[theTock];
+   TockTable[theTock] = hip;
 
 // Check if we should expand the table
 //
@@ -177,3 +181,47 @@ int XrdCmsNash::Recycle(XrdCmsKeyItem *rip)
       }
    return nip != 0;
 }
+
+/******************************************************************************/
+/* public                         U n l o a d                                 */
+/******************************************************************************/
+  
+XrdCmsKeyItem *XrdCmsNash::Unload(unsigned int theTock)
+{
+   XrdCmsKeyItem myItem, *nP, *pP = &myItem;
+
+// Remove all entries from the indicated list. If any entries have been
+// reassigned to a different list, move them to the right list. Otherwise,
+// make the entry unfindable by clearing the hash code. Since item recycling
+// requires knowing the hash code, we save it elsewhere in the object.
+//
+   theTock &= XrdCmsKeyItem::TickMask;
+   myItem.Key.TODRef = TockTable[theTock]; TockTable[theTock] = 0;
+   while((nP = pP->Key.TODRef))
+         if (nP->Key.TOD == theTock) 
+            {nP->Loc.HashSave = nP->Key.Hash; nP->Key.Hash = 0; pP = nP;}
+            else {pP->Key.TODRef = nP->Key.TODRef;
+                  nP->Key.TODRef = TockTable[nP->Key.TOD];
+                  TockTable[nP->Key.TOD] = nP;
+                 }
+   return myItem.Key.TODRef;
+}
+
+/******************************************************************************/
+  
+XrdCmsKeyItem *XrdCmsNash::Unload(XrdCmsKeyItem *theItem)
+{
+   XrdCmsKeyItem *kP, *pP = 0;
+   unsigned int theTock = theItem->Key.TOD & XrdCmsKeyItem::TickMask;
+
+// Remove the entry from the right list
+//
+   kP = TockTable[theTock];
+   while(kP && kP != theItem) {pP = kP; kP = kP->Key.TODRef;}
+   if (kP)
+      {if (pP) pP->Key.TODRef     = kP->Key.TODRef;
+          else TockTable[theTock] = kP->Key.TODRef;
+       kP->Loc.HashSave = kP->Key.Hash; kP->Key.Hash = 0;
+      }
+   return kP;
+}
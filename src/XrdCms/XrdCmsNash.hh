@@ -41,6 +41,14 @@ XrdCmsKeyItem *Find(XrdCmsKey &Key);
 
 int            Recycle(XrdCmsKeyItem *rip);
 
+// Unload() removes items from the aging lists, making them unfindable. The
+// first form returns the chain of all items aged on tick theTock (the chain
+// is linked via Key.TODRef) and the second removes a single item.
+//
+XrdCmsKeyItem *Unload(unsigned int   theTock);
+
+XrdCmsKeyItem *Unload(XrdCmsKeyItem *theItem);
+
 // When allocateing a new nash, specify the required starting size. Make
 // sure that the previous number is the correct Fibonocci antecedent. The
 // series is simply n[j] = n[j-1] + n[j-2].
@@ -54,6 +62,7 @@ static const int LoadMax = 80;
 
 void               Expand();
 
+XrdCmsKeyItem   *TockTable[XrdCmsKeyItem::TickRate];
 XrdCmsKeyItem  **nashtable;
 int              prevtablesize;
 int              nashtablesize;
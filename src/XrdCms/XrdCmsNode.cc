@@ -114,6 +114,11 @@ XrdCmsNode::XrdCmsNode(XrdLink *lnkp, const char *theIF, const char *nid,
     myCost   =  0;
     myLoad   =  0;
     myMass   =  0;
+    avgLoad  =  0;
+    avgMass  =  0;
+    myRTT    =  0;
+    RefOut   =  0;
+    pingTime =  0;
     DiskTotal=  0;
     DiskFree =  0;
     DiskMinF =  0;
@@ -322,6 +327,23 @@ void XrdCmsNode::Disc(const char *reason, int needLock)
    if (needLock) nodeMutex.UnLock();
 }
   
+/******************************************************************************/
+/*                                P i n g e d                                 */
+/******************************************************************************/
+
+// Called when a ping is sent to the node. Only the oldest unanswered ping is
+// timed as a node that is slow to respond may well have several outstanding.
+//
+void XrdCmsNode::Pinged()
+{
+   struct timespec tNow;
+
+   if (!pingTime)
+      {clock_gettime(CLOCK_MONOTONIC, &tNow);
+       pingTime = tNow.tv_sec*1000000LL + tNow.tv_nsec/1000;
+      }
+}
+
 /******************************************************************************/
 /*                              d o _ A v a i l                               */
 /******************************************************************************/
@@ -523,6 +545,13 @@ const char *XrdCmsNode::do_Load(XrdCmsRRData &Arg)
    DiskFree = Arg.dskFree;
    DiskUtil = pdsk;
 
+// Keep a smoothed load for two-choice selection. The redirections made since
+// the previous report are now reflected in the load so we start counting anew.
+//
+   avgLoad = (3*avgLoad + myLoad) / 4;
+   avgMass = (3*avgMass + myMass) / 4;
+   RefOut  = 0;
+
 // Do some debugging
 //
    DEBUGR("cpu=" <<pcpu <<" net=" <<pnet <<" xeq=" <<pxeq
@@ -903,9 +932,23 @@ const char *XrdCmsNode::do_Ping(XrdCmsRRData &Arg)
 //
 const char *XrdCmsNode::do_Pong(XrdCmsRRData &Arg)
 {
+   struct timespec tNow;
+   long long rtt;
+
 // Process: pong
 // Reponds: n/a
 
+// Fold the response time of the outstanding ping, if any, into the smoothed
+// response time used for two-choice selection.
+//
+   if (pingTime)
+      {clock_gettime(CLOCK_MONOTONIC, &tNow);
+       rtt = (tNow.tv_sec*1000000LL + tNow.tv_nsec/1000) - pingTime;
+       if (rtt > INT_MAX) rtt = INT_MAX;
+       myRTT = (myRTT ? (3*myRTT + static_cast<int>(rtt)) / 4
+                      : static_cast<int>(rtt));
+       pingTime = 0;
+      }
    return 0;
 }
   
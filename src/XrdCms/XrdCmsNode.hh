@@ -130,6 +130,8 @@ inline int    ID(int &INum) {INum = Instance; return NodeID;}
 
 inline int    Inst() {return Instance;}
 
+       void   Pinged();
+
        bool   inDomain() {return netIF.InDomain(&netID);}
 
 inline int    isNode(SMask_t smask) {return (smask & NodeMask) != 0;}
@@ -257,6 +259,11 @@ int                logload;
 int                myCost;       // Overall cost (determined by location)
 int                myLoad;       // Overall load
 int                myMass;       // Overall load including space utilization
+int                avgLoad;      // Smoothed myLoad
+int                avgMass;      // Smoothed myMass
+int                myRTT;        // Smoothed ping response time in microseconds
+int                RefOut;       // Redirections since the last load report
+long long          pingTime;     // When the unanswered ping was sent (0 -> none)
 int                RefW;         // Number of times used for writing
 int                RefTotW;
 int                RefR;         // Number of times used for redirection
@@ -1164,6 +1164,7 @@ bool XrdCmsProtocol::SendPing()
 
 // Send the ping
 //
+   myNode->Pinged();
    if (Link->Send((char *)&Ping, sizeof(Ping)) < 0) return false;
    return true;
 }
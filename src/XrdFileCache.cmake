@@ -19,6 +19,8 @@ add_library(
   XrdFileCache/XrdFileCache.cc              XrdFileCache/XrdFileCache.hh
   XrdFileCache/XrdFileCacheConfiguration.cc
   XrdFileCache/XrdFileCachePurge.cc
+  XrdFileCache/XrdFileCacheIndex.cc         XrdFileCache/XrdFileCacheIndex.hh
+  XrdFileCache/XrdFileCacheBlockArena.cc    XrdFileCache/XrdFileCacheBlockArena.hh
   XrdFileCache/XrdFileCacheFile.cc          XrdFileCache/XrdFileCacheFile.hh
   XrdFileCache/XrdFileCacheVRead.cc
   XrdFileCache/XrdFileCacheStats.hh
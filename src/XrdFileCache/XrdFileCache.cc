@@ -20,6 +20,7 @@
 #include <sstream>
 #include <algorithm>
 #include <sys/statvfs.h>
+#include <time.h>
 
 #include "XrdCl/XrdClConstants.hh"
 #include "XrdCl/XrdClURL.hh"
@@ -42,6 +43,15 @@ Cache * Cache::m_factory = NULL;
 
 XrdScheduler *Cache::schedP = NULL;
 
+namespace
+{
+long long NowUs()
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ts.tv_sec * 1000000LL + ts.tv_nsec / 1000;
+}
+}
 
 void *CacheDirCleanupThread(void* cache_void)
 {
@@ -80,11 +90,17 @@ XrdOucCache2 *XrdOucGetCache2(XrdSysLogger *logger,
    }
    err.Emsg("Retrieve", "Success - returning a factory.");
 
-   pthread_t tid1;
-   XrdSysThread::Run(&tid1, ProcessWriteTaskThread, (void*)(&factory), 0, "XrdFileCache WriteTasks ");
+   for (int wti = 0; wti < factory.RefConfiguration().m_wqueue_threads; ++wti)
+   {
+      pthread_t tid1;
+      XrdSysThread::Run(&tid1, ProcessWriteTaskThread, (void*)(&factory), 0, "XrdFileCache WriteTasks ");
+   }
 
-   pthread_t tid2;
-   XrdSysThread::Run(&tid2, PrefetchThread, (void*)(&factory), 0, "XrdFileCache Prefetch ");
+   for (int pti = 0; pti < factory.RefConfiguration().m_prefetch_threads; ++pti)
+   {
+      pthread_t tid2;
+      XrdSysThread::Run(&tid2, PrefetchThread, (void*)(&factory), 0, "XrdFileCache Prefetch ");
+   }
 
    pthread_t tid;
    XrdSysThread::Run(&tid, CacheDirCleanupThread, NULL, 0, "XrdFileCache CacheDirCleanup");
@@ -148,7 +164,11 @@ Cache::Cache() : XrdOucCache(),
    m_traceID("Manager"),
    m_prefetch_condVar(0),
    m_RAMblocks_used(0),
-   m_isClient(false)
+   m_isClient(false),
+   m_purge_condVar(0),
+   m_prefetchNext(0),
+   m_prefetchInFlight(0),
+   m_prefetchBudget(0)
 {
    m_trace = new XrdSysTrace("XrdFileCache");
    // default log level is Warning
@@ -194,11 +214,14 @@ Cache::AddWriteTask(Block* b, bool fromRead)
 {
    TRACE(Dump, "Cache::AddWriteTask() bOff=%ld " <<  b->m_offset);
    m_writeQ.condVar.Lock();
+   b->m_queued = NowUs();
    if (fromRead)
       m_writeQ.queue.push_back(b);
    else
       m_writeQ.queue.push_front(b);
    m_writeQ.size++;
+   if ((long long) m_writeQ.size > m_writeQ.stats.m_maxDepth)
+      m_writeQ.stats.m_maxDepth = m_writeQ.size;
    m_writeQ.condVar.Signal();
    m_writeQ.condVar.UnLock();
 }
@@ -230,6 +253,15 @@ void Cache::RemoveWriteQEntriesFor(File *iFile)
 void
 Cache::ProcessWriteTasks()
 {
+   // Take the first block and up to m_wqueue_blocks - 1 more blocks of the
+   // same file from the queue. The scan is bounded so that a long queue of
+   // other files' blocks does not hold the lock for long.
+   const size_t maxBlocks = m_configuration.m_wqueue_blocks;
+   const size_t maxScan   = 8 * maxBlocks;
+
+   std::vector<Block*> blocks;
+   blocks.reserve(maxBlocks);
+
    while (true)
    {
       m_writeQ.condVar.Lock();
@@ -239,11 +271,60 @@ Cache::ProcessWriteTasks()
       }
       Block* block = m_writeQ.queue.front();
       m_writeQ.queue.pop_front();
-      m_writeQ.size--;
-      TRACE(Dump, "Cache::ProcessWriteTasks  for %p " <<  (void*)(block) << " path " << block->m_file->lPath());
+      blocks.push_back(block);
+
+      std::list<Block*>::iterator i = m_writeQ.queue.begin();
+      for (size_t n = 0; n < maxScan && blocks.size() < maxBlocks && i != m_writeQ.queue.end(); ++n)
+      {
+         if ((*i)->m_file == block->m_file)
+         {
+            blocks.push_back(*i);
+            i = m_writeQ.queue.erase(i);
+         }
+         else
+         {
+            ++i;
+         }
+      }
+      m_writeQ.size -= blocks.size();
+      TRACE(Dump, "Cache::ProcessWriteTasks  for %p " <<  (void*)(block) << " path " << block->m_file->lPath()
+            << " batch of " << blocks.size());
       m_writeQ.condVar.UnLock();
 
-      block->m_file->WriteBlockToDisk(block);
+      // Blocks can be freed once written, so take the queueing times now.
+      long long qsum = 0, qmin = block->m_queued;
+      for (std::vector<Block*>::iterator j = blocks.begin(); j != blocks.end(); ++j)
+      {
+         qsum += (*j)->m_queued;
+         if ((*j)->m_queued < qmin) qmin = (*j)->m_queued;
+      }
+      long long nblk = blocks.size();
+
+      block->m_file->WriteBlocksToDisk(blocks);
+
+      long long now = NowUs();
+      m_writeQ.condVar.Lock();
+      m_writeQ.stats.m_blocks     += nblk;
+      m_writeQ.stats.m_batches    += 1;
+      m_writeQ.stats.m_latencySum += nblk * now - qsum;
+      if (now - qmin > m_writeQ.stats.m_latencyMax)
+         m_writeQ.stats.m_latencyMax = now - qmin;
+      m_writeQ.condVar.UnLock();
+      blocks.clear();
+   }
+}
+
+//______________________________________________________________________________
+void
+Cache::GetWriteQStats(WriteQStats &s, bool reset)
+{
+   XrdSysCondVarHelper lock(m_writeQ.condVar);
+   s = m_writeQ.stats;
+   s.m_depth = m_writeQ.size;
+   if (reset)
+   {
+      m_writeQ.stats = WriteQStats();
+      m_writeQ.stats.m_maxDepth = m_writeQ.size;
    }
 }
 
@@ -279,6 +360,18 @@ File* Cache::GetFile(const std::string& path, IO* iIO, long long off, long long
    
    XrdSysMutexHelper lock(&m_active_mutex);
 
+   // The purge removes blocks without holding the lock; wait until it is done
+   // with this file. The condition variable is taken before the active-file
+   // mutex is released so that its broadcast can not be missed.
+   while (m_purging.find(path) != m_purging.end())
+   {
+      m_purge_condVar.Lock();
+      lock.UnLock();
+      m_purge_condVar.Wait();
+      m_purge_condVar.UnLock();
+      lock.Lock(&m_active_mutex);
+   }
+
    ActiveMap_i it = m_active.find(path);
 
    if (it != m_active.end())
@@ -462,22 +555,36 @@ Cache::DeRegisterPrefetchFile(File* file)
 File*
 Cache::GetNextFileToPrefetch()
 {
+   const long long bs = m_configuration.m_bufferSize;
+
    m_prefetch_condVar.Lock();
-   while (m_prefetchList.empty())
+   while (m_prefetchList.empty() || m_prefetchInFlight + bs > m_prefetchBudget)
    {
       m_prefetch_condVar.Wait();
    }
 
    //  std::sort(m_prefetchList.begin(), m_prefetchList.end(), myobject);
 
-   size_t l = m_prefetchList.size();
-   int idx = rand() % l;
-   File* f = m_prefetchList[idx];
+   // Round-robin so that every file gets its share of the workers.
+   if (m_prefetchNext >= m_prefetchList.size()) m_prefetchNext = 0;
+   File* f = m_prefetchList[m_prefetchNext++];
+   m_prefetchInFlight += bs;
 
    m_prefetch_condVar.UnLock();
    return f;
 }
 
+//______________________________________________________________________________
+
+void
+Cache::PrefetchDone()
+{
+   m_prefetch_condVar.Lock();
+   m_prefetchInFlight -= m_configuration.m_bufferSize;
+   m_prefetch_condVar.Signal();
+   m_prefetch_condVar.UnLock();
+}
+
 //______________________________________________________________________________
 //! Preapare the cache for a file open request. This method is called prior to
 //! actually opening a file. This method is meant to allow defering an open
@@ -558,6 +665,17 @@ void
 Cache::Prefetch()
 {
    int limitRAM = int( Cache::GetInstance().RefConfiguration().m_NRamBuffers * 0.7 );
+
+   // A quarter of the RAM may be taken by prefetch requests that have not
+   // arrived yet, but at least one block per worker.
+   m_prefetch_condVar.Lock();
+   if ( ! m_prefetchBudget)
+   {
+      m_prefetchBudget = std::max(m_configuration.m_RamAbsAvailable / 4,
+                                  m_configuration.m_bufferSize * m_configuration.m_prefetch_threads);
+   }
+   m_prefetch_condVar.UnLock();
+
    while (true)
    {
       m_RAMblock_mutex.Lock();
@@ -567,7 +685,8 @@ Cache::Prefetch()
       if (doPrefetch)
       {
          File* f = GetNextFileToPrefetch();
-         f->Prefetch();
+         if ( ! f->Prefetch())
+            PrefetchDone();
       }
       else
       {
@@ -19,6 +19,7 @@
 //----------------------------------------------------------------------------------
 #include <string>
 #include <list>
+#include <set>
 
 #include "Xrd/XrdScheduler.hh"
 #include "XrdVersion.hh"
@@ -28,6 +29,8 @@
 #include "XrdCl/XrdClDefaultEnv.hh"
 #include "XrdFileCacheFile.hh"
 #include "XrdFileCacheDecision.hh"
+#include "XrdFileCacheIndex.hh"
+#include "XrdFileCacheBlockArena.hh"
 
 class XrdOucStream;
 class XrdSysError;
@@ -56,12 +59,17 @@ struct Configuration
       m_diskUsageLWM(-1),
       m_diskUsageHWM(-1),
       m_purgeInterval(300),
+      m_purgeBlocks(true),
       m_bufferSize(1024*1024),
       m_RamAbsAvailable(0),
+      m_RamHugePages(false),
       m_NRamBuffers(-1),
       m_prefetch_max_blocks(10),
+      m_prefetch_threads(4),
       m_hdfsbsize(128*1024*1024),
-      m_flushCnt(100)
+      m_flushCnt(100),
+      m_wqueue_blocks(16),
+      m_wqueue_threads(4)
    {}
 
    bool m_hdfsmode;                     //!< flag for enabling block-level operation
@@ -73,14 +81,20 @@ struct Configuration
    long long m_diskUsageLWM;            //!< cache purge low water mark
    long long m_diskUsageHWM;            //!< cache purge high water mark
    int       m_purgeInterval;           //!< sleep interval between cache purges
+   bool      m_purgeBlocks;             //!< purge individual blocks rather than whole files
 
    long long m_bufferSize;              //!< prefetch buffer size, default 1MB
    long long m_RamAbsAvailable;         //!< available from configuration
+   bool      m_RamHugePages;            //!< back RAM blocks with huge pages
    int       m_NRamBuffers;             //!< number of total in-memory cache blocks, cached
    size_t    m_prefetch_max_blocks;     //!< maximum number of blocks to prefetch per file
+   int       m_prefetch_threads;        //!< number of threads issuing prefetch requests
 
    long long m_hdfsbsize;               //!< used with m_hdfsmode, default 128MB
    long long m_flushCnt;                //!< nuber of unsynced blcoks on disk before flush is called
+
+   int       m_wqueue_blocks;           //!< maximum number of blocks written in one batch
+   int       m_wqueue_threads;          //!< number of threads writing blocks to disk
 };
 
 struct TmpConfiguration
@@ -100,6 +114,22 @@ struct TmpConfiguration
 class Cache : public XrdOucCache2
 {
 public:
+   //---------------------------------------------------------------------
+   //! Write queue statistics, latency is from queueing to written.
+   //---------------------------------------------------------------------
+   struct WriteQStats
+   {
+      long long m_depth;           //!< blocks currently queued
+      long long m_maxDepth;        //!< largest depth since last reset
+      long long m_blocks;          //!< blocks written since last reset
+      long long m_batches;         //!< writes used for them
+      long long m_latencySum;      //!< summed latency, microseconds
+      long long m_latencyMax;      //!< largest latency, microseconds
+
+      WriteQStats() : m_depth(0), m_maxDepth(0), m_blocks(0), m_batches(0),
+                      m_latencySum(0), m_latencyMax(0) {}
+   };
+
    //---------------------------------------------------------------------
    //! Constructor
    //---------------------------------------------------------------------
@@ -182,19 +212,51 @@ public:
    void RemoveWriteQEntriesFor(File *f);
 
    //---------------------------------------------------------------------
-   //! Separate task which writes blocks from ram to disk.
+   //! Separate task which writes blocks from ram to disk. Runs in each of
+   //! the writer threads; blocks of the same file found in the queue are
+   //! written together.
    //---------------------------------------------------------------------
    void ProcessWriteTasks();
 
+   //---------------------------------------------------------------------
+   //! Get write queue statistics, optionally resetting the counters.
+   //---------------------------------------------------------------------
+   void GetWriteQStats(WriteQStats &s, bool reset);
+
    bool RequestRAMBlock();
 
    void RAMBlockReleased();
 
+   //---------------------------------------------------------------------
+   //! Get page aligned, uninitialized buffer for a RAM block.
+   //---------------------------------------------------------------------
+   char* RequestBlockBuffer() { return m_blockArena.Get(); }
+
+   //---------------------------------------------------------------------
+   //! Return buffer of a RAM block.
+   //---------------------------------------------------------------------
+   void  ReleaseBlockBuffer(char *buf) { m_blockArena.Put(buf); }
+
    void RegisterPrefetchFile(File*);
    void DeRegisterPrefetchFile(File*);
 
+   //---------------------------------------------------------------------
+   //! \brief Take the next file to prefetch from, round-robin.
+   //!
+   //! Waits until a file is registered and the prefetch requests in flight
+   //! are within budget, then reserves one block of the budget. The
+   //! reservation is returned with PrefetchDone().
+   //---------------------------------------------------------------------
    File* GetNextFileToPrefetch();
 
+   //---------------------------------------------------------------------
+   //! Prefetch block has arrived or was not requested after all.
+   //---------------------------------------------------------------------
+   void PrefetchDone();
+
+   //---------------------------------------------------------------------
+   //! Thread function of the prefetch workers.
+   //---------------------------------------------------------------------
    void Prefetch();
 
    XrdOss* GetOss() const { return m_output_fs; }
@@ -211,12 +273,21 @@ public:
    
    XrdSysTrace* GetTrace() { return m_trace; }
 
+   //---------------------------------------------------------------------
+   //! Reference index of files and blocks on disk, used for purge.
+   //---------------------------------------------------------------------
+   Index& RefIndex() { return m_index; }
+
 private:
    bool ConfigParameters(std::string, XrdOucStream&, TmpConfiguration &tmpc);
    bool ConfigXeq(char *, XrdOucStream &);
    bool xdlib(XrdOucStream &);
    bool xtrace(XrdOucStream &);
 
+   void FillIndex();
+   long long PurgeFromIndex(long long bytesToRemove);
+   bool PunchBlocks(const std::string &path, Index::Victim &v);
+
    static Cache     *m_factory;         //!< this object
    static 
    XrdScheduler     *schedP;
@@ -238,6 +309,7 @@ private:
 
    XrdSysMutex m_RAMblock_mutex;            //!< central lock for this class
    int         m_RAMblocks_used;
+   BlockArena  m_blockArena;                //!< buffers of RAM blocks
    bool        m_isClient;                  //!< True if running as client
 
    struct WriteQ
@@ -246,6 +318,7 @@ private:
       XrdSysCondVar     condVar;      //!< write list condVar
       size_t            size;         //!< cache size of a container
       std::list<Block*> queue;        //!< container
+      WriteQStats       stats;        //!< counters, protected by condVar
    };
 
    WriteQ m_writeQ;
@@ -257,6 +330,11 @@ private:
    ActiveMap_t  m_active;
    XrdSysMutex  m_active_mutex;
 
+   std::set<std::string> m_purging;         //!< files being purged, protected by m_active_mutex
+   XrdSysCondVar         m_purge_condVar;   //!< signalled when a file leaves m_purging
+
+   Index        m_index;                    //!< files and blocks on disk
+
    void inc_ref_cnt(File*, bool lock);
    void dec_ref_cnt(File*);
 
@@ -265,6 +343,9 @@ private:
    // prefetching
    typedef std::vector<File*>  PrefetchList;
    PrefetchList m_prefetchList;
+   size_t       m_prefetchNext;             //!< round-robin position in prefetch list
+   long long    m_prefetchInFlight;         //!< bytes of prefetch requests in flight
+   long long    m_prefetchBudget;           //!< limit of m_prefetchInFlight
 };
 
 }
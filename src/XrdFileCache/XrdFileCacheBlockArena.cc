@@ -0,0 +1,147 @@
+//----------------------------------------------------------------------------------
+// Copyright (c) 2026 by the contributors to the XRootD software suite
+//----------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//----------------------------------------------------------------------------------
+
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "XrdFileCacheBlockArena.hh"
+
+using namespace XrdFileCache;
+
+BlockArena::BlockArena() :
+   m_base(0), m_mapSize(0), m_slotSize(0), m_bufSize(0), m_nSlots(0), m_huge(false),
+   m_freeHead(0), m_next(0), m_nHeap(0)
+{}
+
+BlockArena::~BlockArena()
+{
+   if (m_base) munmap(m_base, m_mapSize);
+   delete [] m_next;
+}
+
+//------------------------------------------------------------------------------
+
+bool BlockArena::Init(int nSlots, long long bufSize, bool hugePages)
+{
+   const size_t page = sysconf(_SC_PAGESIZE);
+
+   m_bufSize  = bufSize;
+   m_slotSize = (bufSize + page - 1) / page * page;
+   if (nSlots <= 0) return false;
+
+   void *p = MAP_FAILED;
+   size_t len = m_slotSize * nSlots;
+#ifdef MAP_HUGETLB
+   if (hugePages)
+   {
+      // explicit huge pages must be reserved by the admin, length rounded to 2 MB
+      const size_t huge = 2 * 1024 * 1024;
+      size_t hlen = (len + huge - 1) / huge * huge;
+      p = mmap(0, hlen, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+      if (p != MAP_FAILED)
+      {
+         len    = hlen;
+         m_huge = true;
+      }
+   }
+#endif
+   if (p == MAP_FAILED)
+   {
+      p = mmap(0, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (p == MAP_FAILED) return false;
+#ifdef MADV_HUGEPAGE
+      if (hugePages) m_huge = (madvise(p, len, MADV_HUGEPAGE) == 0);
+#endif
+   }
+
+   m_base    = (char*) p;
+   m_mapSize = len;
+   m_nSlots  = nSlots;
+   m_next    = new std::atomic<int32_t>[nSlots];
+   for (int i = nSlots - 1; i >= 0; --i)
+      Push(i);
+   return true;
+}
+
+//------------------------------------------------------------------------------
+
+char* BlockArena::Get()
+{
+   int slot = Pop();
+   if (slot >= 0) return m_base + slot * m_slotSize;
+
+   void *p = 0;
+   const size_t page = sysconf(_SC_PAGESIZE);
+   if (posix_memalign(&p, page, m_bufSize)) return 0;
+   m_nHeap.fetch_add(1, std::memory_order_relaxed);
+   return (char*) p;
+}
+
+//------------------------------------------------------------------------------
+
+void BlockArena::Put(char *buf)
+{
+   if ( ! buf) return;
+
+   if (m_base && buf >= m_base && buf < m_base + m_nSlots * m_slotSize)
+   {
+      Push((buf - m_base) / m_slotSize);
+   }
+   else
+   {
+      free(buf);
+      m_nHeap.fetch_sub(1, std::memory_order_relaxed);
+   }
+}
+
+//------------------------------------------------------------------------------
+
+int BlockArena::Pop()
+{
+   uint64_t head = m_freeHead.load(std::memory_order_acquire);
+   uint64_t next;
+   uint32_t top;
+
+   do
+   {
+      if ( ! (top = head & 0xffffffff)) return -1;
+      next = ((head >> 32) + 1) << 32 |
+             (uint32_t) m_next[top - 1].load(std::memory_order_relaxed);
+   }
+   while ( ! m_freeHead.compare_exchange_weak(head, next,
+                                              std::memory_order_acquire,
+                                              std::memory_order_acquire));
+   return top - 1;
+}
+
+//------------------------------------------------------------------------------
+
+void BlockArena::Push(int slot)
+{
+   uint64_t head = m_freeHead.load(std::memory_order_relaxed);
+   uint64_t next;
+
+   do
+   {
+      m_next[slot].store(head & 0xffffffff, std::memory_order_relaxed);
+      next = ((head >> 32) + 1) << 32 | (uint32_t) (slot + 1);
+   }
+   while ( ! m_freeHead.compare_exchange_weak(head, next,
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed));
+}
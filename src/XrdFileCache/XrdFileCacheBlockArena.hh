@@ -0,0 +1,86 @@
+#ifndef __XRDFILECACHE_BLOCK_ARENA_HH__
+#define __XRDFILECACHE_BLOCK_ARENA_HH__
+//----------------------------------------------------------------------------------
+// Copyright (c) 2026 by the contributors to the XRootD software suite
+//----------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//----------------------------------------------------------------------------------
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+namespace XrdFileCache
+{
+//----------------------------------------------------------------------------
+//! Preallocated memory for the buffers of RAM blocks.
+//!
+//! The arena is one anonymous mapping cut into equal, page aligned slots, so
+//! block buffers are neither zero-filled nor returned to the system between
+//! uses and are suitably aligned for O_DIRECT. Free slots are kept on a
+//! lock-free stack whose head carries a generation count against ABA.
+//! When the arena is exhausted, or could not be mapped, buffers come from
+//! the heap instead, still page aligned.
+//----------------------------------------------------------------------------
+class BlockArena
+{
+public:
+   BlockArena();
+   ~BlockArena();
+
+   //---------------------------------------------------------------------
+   //! \brief Map the arena.
+   //!
+   //! @param nSlots     number of buffers
+   //! @param bufSize    size of a buffer, rounded up to whole pages
+   //! @param hugePages  try explicit huge pages, then transparent ones
+   //!
+   //! @return false if the arena could not be mapped.
+   //---------------------------------------------------------------------
+   bool Init(int nSlots, long long bufSize, bool hugePages);
+
+   //---------------------------------------------------------------------
+   //! Get a buffer of at least bufSize bytes, content undefined.
+   //---------------------------------------------------------------------
+   char* Get();
+
+   //---------------------------------------------------------------------
+   //! Return buffer obtained from Get().
+   //---------------------------------------------------------------------
+   void  Put(char *buf);
+
+   bool  IsHuge()     const { return m_huge; }
+   int   GetNSlots()  const { return m_nSlots; }
+   long long GetNHeap() const { return m_nHeap.load(std::memory_order_relaxed); }
+
+private:
+   BlockArena(const BlockArena&);
+   BlockArena& operator=(const BlockArena&);
+
+   int  Pop();
+   void Push(int slot);
+
+   char                  *m_base;      //!< start of mapping, 0 if not mapped
+   size_t                 m_mapSize;   //!< length of mapping
+   size_t                 m_slotSize;  //!< buffer size rounded up to pages
+   size_t                 m_bufSize;   //!< requested buffer size
+   int                    m_nSlots;    //!< number of buffers in mapping
+   bool                   m_huge;      //!< mapping uses huge pages
+   std::atomic<uint64_t>  m_freeHead;  //!< generation << 32 | (slot + 1)
+   std::atomic<int32_t>  *m_next;      //!< next free slot + 1, 0 ends the stack
+   std::atomic<long long> m_nHeap;     //!< buffers currently taken from heap
+};
+}
+
+#endif
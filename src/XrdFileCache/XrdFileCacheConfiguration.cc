@@ -252,6 +252,15 @@ bool Cache::Config(XrdSysLogger *logger, const char *config_filename, const char
       TRACE(Warning, buff2);
    }
    m_configuration.m_NRamBuffers = static_cast<int>(m_configuration.m_RamAbsAvailable/ m_configuration.m_bufferSize);
+
+   if ( ! m_blockArena.Init(m_configuration.m_NRamBuffers, m_configuration.m_bufferSize, m_configuration.m_RamHugePages))
+   {
+      m_log.Emsg("Config", errno, "map RAM block arena; using heap");
+   }
+   else if (m_configuration.m_RamHugePages && ! m_blockArena.IsHuge())
+   {
+      m_log.Emsg("Config", "Huge pages not available for RAM blocks.");
+   }
    
 
    // Set tracing to debug if this is set in environment
@@ -265,23 +274,29 @@ bool Cache::Config(XrdSysLogger *logger, const char *config_filename, const char
       float rg =  (m_configuration.m_RamAbsAvailable)/float(1024*1024*1024);
       loff = snprintf(buff, sizeof(buff), "Config effective %s pfc configuration:\n"
                       "       pfc.blocksize %lld\n"
-                      "       pfc.prefetch %zu\n"
-                      "       pfc.ram %.fg\n"
-                      "       pfc.diskusage %lld %lld sleep %d\n"
+                      "       pfc.prefetch %zu threads %d\n"
+                      "       pfc.ram %.fg%s\n"
+                      "       pfc.diskusage %lld %lld sleep %d purge %s\n"
                       "       pfc.spaces %s %s\n"
                       "       pfc.trace %d\n"
-                      "       pfc.flush %lld",
+                      "       pfc.flush %lld\n"
+                      "       pfc.writequeue %d %d",
                       config_filename,
                       m_configuration.m_bufferSize,
                       m_configuration.m_prefetch_max_blocks,
+                      m_configuration.m_prefetch_threads,
                       rg,
+                      m_configuration.m_RamHugePages ? " hugepages" : "",
                       m_configuration.m_diskUsageLWM,
                       m_configuration.m_diskUsageHWM,
                       m_configuration.m_purgeInterval,
+                      m_configuration.m_purgeBlocks ? "block" : "file",
                       m_configuration.m_data_space.c_str(),
                       m_configuration.m_meta_space.c_str(),
                       m_trace->What,
-                      m_configuration.m_flushCnt);
+                      m_configuration.m_flushCnt,
+                      m_configuration.m_wqueue_blocks,
+                      m_configuration.m_wqueue_threads);
 
 
 
@@ -334,12 +349,33 @@ bool Cache::ConfigParameters(std::string part, XrdOucStream& config, TmpConfigur
          m_log.Emsg("Config", "Error: diskusage parameter requires two arguments.");
          return false;
       }
-      const char *p = config.GetWord();
-      if (p && strcmp(p, "sleep") == 0)
+      const char *p;
+      while ((p = config.GetWord()))
       {
-         p = config.GetWord();
-         if (XrdOuca2x::a2i(m_log, "Error getting purge interval", p, &m_configuration.m_purgeInterval, 60, 3600))
+         if (strcmp(p, "sleep") == 0)
+         {
+            p = config.GetWord();
+            if (XrdOuca2x::a2i(m_log, "Error getting purge interval", p, &m_configuration.m_purgeInterval, 60, 3600))
+            {
+               return false;
+            }
+         }
+         else if (strcmp(p, "purge") == 0)
          {
+            p = config.GetWord();
+            if (p && strcmp(p, "block") == 0)
+               m_configuration.m_purgeBlocks = true;
+            else if (p && strcmp(p, "file") == 0)
+               m_configuration.m_purgeBlocks = false;
+            else
+            {
+               m_log.Emsg("Config", "Error: diskusage purge requires block or file.");
+               return false;
+            }
+         }
+         else
+         {
+            m_log.Emsg("Config", "Error: invalid diskusage option", p);
             return false;
          }
       }
@@ -380,6 +416,22 @@ bool Cache::ConfigParameters(std::string part, XrdOucStream& config, TmpConfigur
          m_log.Emsg("Config", "Error setting prefetch level.");
          return false;
       }
+      const char *p;
+      while ((p = config.GetWord()))
+      {
+         if (strcmp(p, "threads") == 0)
+         {
+            if (XrdOuca2x::a2i(m_log, "Error getting prefetch threads", config.GetWord(), &m_configuration.m_prefetch_threads, 1, 64))
+            {
+               return false;
+            }
+         }
+         else
+         {
+            m_log.Emsg("Config", "Error: invalid prefetch option", p);
+            return false;
+         }
+      }
    }
    else if ( part == "nramread" )
    {
@@ -394,6 +446,19 @@ bool Cache::ConfigParameters(std::string part, XrdOucStream& config, TmpConfigur
       {
          return false;
       }
+      const char *p;
+      while ((p = config.GetWord()))
+      {
+         if (strcmp(p, "hugepages") == 0)
+         {
+            m_configuration.m_RamHugePages = true;
+         }
+         else
+         {
+            m_log.Emsg("Config", "Error: invalid ram option", p);
+            return false;
+         }
+      }
    }
    else if ( part == "spaces" )
    {
@@ -440,6 +505,14 @@ bool Cache::ConfigParameters(std::string part, XrdOucStream& config, TmpConfigur
    {
       tmpc.m_flushRaw = config.GetWord();
    }
+   else if ( part == "writequeue" )
+   {
+      if (XrdOuca2x::a2i(m_log, "Error getting write queue batch size", config.GetWord(), &m_configuration.m_wqueue_blocks, 1, 1024) ||
+          XrdOuca2x::a2i(m_log, "Error getting write queue threads",    config.GetWord(), &m_configuration.m_wqueue_threads, 1, 64))
+      {
+         return false;
+      }
+   }
    else
    {
       m_log.Emsg("Cache::ConfigParameters() unmatched pfc parameter", part.c_str());
@@ -24,6 +24,7 @@
 #include <sstream>
 #include <fcntl.h>
 #include <assert.h>
+#include <algorithm>
 #include "XrdCl/XrdClLog.hh"
 #include "XrdCl/XrdClConstants.hh"
 #include "XrdCl/XrdClFile.hh"
@@ -44,12 +45,29 @@ const int PREFETCH_MAX_ATTEMPTS = 10;
 
 
 Cache* cache() { return &Cache::GetInstance(); }
+
+bool BlockOffsetLess(const Block* a, const Block* b) { return a->m_offset < b->m_offset; }
 }
 
 const char *File::m_traceID = "File";
 
 //------------------------------------------------------------------------------
 
+Block::~Block()
+{
+   cache()->ReleaseBlockBuffer(m_buff);
+}
+
+void Block::set_error_and_free(int err)
+{
+   m_errno = err;
+   cache()->ReleaseBlockBuffer(m_buff);
+   m_buff = 0;
+   m_size = 0;
+}
+
+//------------------------------------------------------------------------------
+
 File::File(IO *io, const std::string& path, long long iOffset, long long iFileSize) :
    m_ref_cnt(0),
    m_is_open(false),
@@ -57,6 +75,7 @@ File::File(IO *io, const std::string& path, long long iOffset, long long iFileSi
    m_output(0),
    m_infoFile(0),
    m_cfi(Cache::GetInstance().GetTrace(), Cache::GetInstance().RefConfiguration().m_prefetch_max_blocks > 0),
+   m_indexEntry(0),
    m_filename(path),
    m_offset(iOffset),
    m_fileSize(iFileSize),
@@ -67,6 +86,10 @@ File::File(IO *io, const std::string& path, long long iOffset, long long iFileSi
    m_prefetchReadCnt(0),
    m_prefetchHitCnt(0),
    m_prefetchScore(1),
+   m_lastReadFirst(-1),
+   m_lastReadLast(-1),
+   m_readStride(0),
+   m_readStrideCnt(0),
    m_detachTimeIsLogged(false)
 {
    Open();
@@ -74,6 +97,12 @@ File::File(IO *io, const std::string& path, long long iOffset, long long iFileSi
 
 File::~File()
 {
+   if (m_indexEntry)
+   {
+      cache()->RefIndex().Detach(m_indexEntry);
+      m_indexEntry = 0;
+   }
+
    if (m_infoFile)
    {
       TRACEF(Debug, "File::~File() close info ");
@@ -286,6 +315,7 @@ bool File::Open()
    }
 
    m_cfi.WriteIOStatAttach();
+   m_indexEntry = cache()->RefIndex().Attach(m_filename, m_cfi);
    m_downloadCond.Lock();
    m_is_open = true;
    m_prefetchState = (m_cfi.IsComplete()) ? kComplete : kOn;
@@ -347,7 +377,15 @@ Block* File::PrepareBlockRequest(int i, bool prefetch)
    long long off     = i * BS;
    long long this_bs = (i == last_block) ? m_fileSize - off : BS;
 
-   Block *b = new Block(this, off, this_bs, prefetch); // should block be reused to avoid recreation
+   char *buf = cache()->RequestBlockBuffer();
+   if ( ! buf)
+   {
+      TRACEF(Error, "File::PrepareBlockRequest() no memory for block " << i);
+      cache()->RAMBlockReleased();
+      return 0;
+   }
+
+   Block *b = new Block(this, buf, off, this_bs, prefetch);
 
    m_block_map[i] = b;
 
@@ -427,6 +465,7 @@ int File::ReadBlocksFromDisk(std::list<int>& blocks,
 
       long long rs = m_output->Read(req_buf + off, *ii * BS + blk_off -m_offset, size);
       TRACEF(Dump, "File::ReadBlocksFromDisk block idx = " <<  *ii << " size= " << size);
+      cache()->RefIndex().Access(m_indexEntry, offsetIdx(*ii));
 
       if (rs < 0)
       {
@@ -478,6 +517,8 @@ int File::Read(char* iUserBuff, long long iUserOff, int iUserSize)
    BlockList_t blks_to_request, blks_to_process, blks_processed;
    IntList_t blks_on_disk,    blks_direct;
 
+   TrackReadPattern(idx_first, idx_last);
+
    for (int block_idx = idx_first; block_idx <= idx_last; ++block_idx)
    {
       TRACEF(Dump, "File::Read() idx " << block_idx);
@@ -574,7 +615,6 @@ int File::Read(char* iUserBuff, long long iUserOff, int iUserSize)
    }
 
    // Third, loop over blocks that are available or incoming
-   int prefetchHitsRam = 0;
    while ( ! blks_to_process.empty() && bytes_read >= 0)
    {
       BlockList_t finished;
@@ -621,8 +661,6 @@ int File::Read(char* iUserBuff, long long iUserOff, int iUserSize)
             memcpy(&iUserBuff[user_off], &((*bi)->m_buff[off_in_block]), size_to_copy);
             bytes_read += size_to_copy;
             m_stats.m_BytesRam += size_to_copy;
-            if ((*bi)->m_prefetch)
-               prefetchHitsRam++;
          }
          else // it has failed ... krap up.
          {
@@ -672,20 +710,34 @@ int File::Read(char* iUserBuff, long long iUserOff, int iUserSize)
       // blks_to_process can be non-empty, if we're exiting with an error.
       std::copy(blks_to_process.begin(), blks_to_process.end(), std::back_inserter(blks_processed));
 
+      // A prefetched block counts as a hit the first time it is read, its
+      // prefetch flag and bit are cleared so that it is not counted again.
+      int prefetchHits = 0;
       for (BlockList_i bi = blks_processed.begin(); bi != blks_processed.end(); ++bi)
       {
+         if ((*bi)->is_ok() && (*bi)->m_prefetch)
+         {
+            (*bi)->m_prefetch = false;
+            m_cfi.ResetBitPrefetch(offsetIdx((*bi)->m_offset/BS));
+            prefetchHits++;
+         }
          TRACEF(Dump, "File::Read() dec_ref_count " << (void*)(*bi) << " idx = " << (int)((*bi)->m_offset/BufferSize()));
          dec_ref_count(*bi);
       }
-
-      // update prefetch score
-      m_prefetchHitCnt += prefetchHitsRam;
       for (IntList_i d = blks_on_disk.begin(); d !=  blks_on_disk.end(); ++d)
       {
          if (m_cfi.TestPrefetchBit(offsetIdx(*d)))
-            m_prefetchHitCnt++;
+         {
+            m_cfi.ResetBitPrefetch(offsetIdx(*d));
+            prefetchHits++;
+         }
       }
-      m_prefetchScore = float(m_prefetchHitCnt)/m_prefetchReadCnt;
+
+      // update prefetch score
+      m_prefetchHitCnt += prefetchHits;
+      m_stats.m_PrefetchHits += prefetchHits;
+      if (m_prefetchReadCnt)
+         m_prefetchScore = float(m_prefetchHitCnt)/m_prefetchReadCnt;
    }
 
    return bytes_read;
@@ -722,8 +774,54 @@ void File::WriteBlockToDisk(Block* b)
       }
    }
 
-   // set bit fetched
    TRACEF(Dump, "File::WriteToDisk() success set bit for block " <<  b->m_offset << " size " <<  size);
+   BlockWritten(b);
+}
+
+//------------------------------------------------------------------------------
+
+void File::WriteBlocksToDisk(std::vector<Block*>& blocks)
+{
+   if (blocks.size() == 1)
+   {
+      WriteBlockToDisk(blocks[0]);
+      return;
+   }
+
+   std::sort(blocks.begin(), blocks.end(), BlockOffsetLess);
+
+   std::vector<XrdOucIOVec> iov(blocks.size());
+   long long total = 0;
+   for (size_t i = 0; i < blocks.size(); ++i)
+   {
+      long long offset = blocks[i]->m_offset - m_offset;
+      iov[i].offset = offset;
+      iov[i].size   = (offset + m_cfi.GetBufferSize()) > m_fileSize ? (m_fileSize - offset) : m_cfi.GetBufferSize();
+      iov[i].info   = 0;
+      iov[i].data   = &blocks[i]->m_buff[0];
+      total += iov[i].size;
+   }
+
+   ssize_t retval = m_output->WriteV(&iov[0], (int) iov.size());
+   if (retval != total)
+   {
+      TRACEF(Warning, "File::WriteBlocksToDisk() vectored write of " << blocks.size() << " blocks failed, retval = "
+             << retval << "; writing blocks one by one");
+      for (size_t i = 0; i < blocks.size(); ++i)
+         WriteBlockToDisk(blocks[i]);
+      return;
+   }
+
+   TRACEF(Dump, "File::WriteBlocksToDisk() wrote " << blocks.size() << " blocks, " << total << " bytes");
+   for (size_t i = 0; i < blocks.size(); ++i)
+      BlockWritten(blocks[i]);
+}
+
+//------------------------------------------------------------------------------
+
+void File::BlockWritten(Block* b)
+{
+   // set bit fetched
    int pfIdx =  (b->m_offset - m_offset)/m_cfi.GetBufferSize();
 
    bool schedule_sync = false;
@@ -757,6 +855,8 @@ void File::WriteBlockToDisk(Block* b)
       }
    }
 
+   cache()->RefIndex().Written(m_indexEntry, pfIdx);
+
    if (schedule_sync)
    {
       cache()->ScheduleFileSync(this);
@@ -838,6 +938,8 @@ void File::free_block(Block* b)
 
 void File::ProcessBlockResponse(Block* b, int res)
 {
+   if (b->m_prefetch) cache()->PrefetchDone();
+
    m_downloadCond.Lock();
 
    TRACEF(Dump, "File::ProcessBlockResponse " << (void*)b << "  " << b->m_offset/BufferSize());
@@ -884,10 +986,9 @@ int File::offsetIdx(int iIdx)
 
 //------------------------------------------------------------------------------
 
-void File::Prefetch()
+bool File::Prefetch()
 {
    // Check that block is not on disk and not in RAM.
-   // TODO: Could prefetch several blocks at once!
 
    BlockList_t blks;
 
@@ -896,31 +997,38 @@ void File::Prefetch()
       XrdSysCondVarHelper _lck(m_downloadCond);
 
       if (m_prefetchState != kOn)
-         return;
+         return false;
 
-      for (int f = 0; f < m_cfi.GetSizeInBits(); ++f)
+      int f = PredictBlockToPrefetch();
+      for (int i = 0; f < 0 && i < m_cfi.GetSizeInBits(); ++i)
       {
-         if ( ! m_cfi.TestBit(f))
+         if ( ! m_cfi.TestBit(i))
          {
-            f += m_offset/m_cfi.GetBufferSize();
-            BlockMap_i bi = m_block_map.find(f);
-            if (bi == m_block_map.end())
-            {
-               TRACEF(Dump, "File::Prefetch take block " << f);
-               cache()->RequestRAMBlock();
-               blks.push_back( PrepareBlockRequest(f, true) );
-               m_prefetchReadCnt++;
-               m_prefetchScore = float(m_prefetchHitCnt)/m_prefetchReadCnt;
-               break;
-            }
+            int bi = i + m_offset/m_cfi.GetBufferSize();
+            if (m_block_map.find(bi) == m_block_map.end())
+               f = bi;
          }
       }
+
+      if (f >= 0)
+      {
+         TRACEF(Dump, "File::Prefetch take block " << f);
+         cache()->RequestRAMBlock();
+         Block *b = PrepareBlockRequest(f, true);
+         if ( ! b)
+            return false;
+         blks.push_back(b);
+         m_prefetchReadCnt++;
+         m_prefetchScore = float(m_prefetchHitCnt)/m_prefetchReadCnt;
+         m_stats.m_BlocksPrefetched++;
+      }
    }
 
 
    if ( ! blks.empty())
    {
       ProcessBlockRequests(blks);
+      return true;
    }
    else
    {
@@ -929,9 +1037,71 @@ void File::Prefetch()
       m_prefetchState = kComplete;
       m_downloadCond.UnLock();
       cache()->DeRegisterPrefetchFile(this);
+      return false;
    }
 }
 
+//------------------------------------------------------------------------------
+
+void File::TrackReadPattern(int idx_first, int idx_last)
+{
+   // Called with m_downloadCond locked.
+   // A read that starts in or right after the last block of the previous one
+   // is sequential, otherwise the stride is the distance between the first
+   // blocks. The stride is trusted once it has been repeated.
+
+   if (m_lastReadFirst >= 0)
+   {
+      int stride = (idx_first >= m_lastReadFirst && idx_first <= m_lastReadLast + 1) ? 1 : idx_first - m_lastReadFirst;
+
+      if (stride == m_readStride)
+      {
+         if (m_readStrideCnt < 1000) ++m_readStrideCnt;
+      }
+      else
+      {
+         m_readStride    = stride;
+         m_readStrideCnt = 0;
+      }
+   }
+   m_lastReadFirst = idx_first;
+   m_lastReadLast  = idx_last;
+}
+
+//------------------------------------------------------------------------------
+
+int File::PredictBlockToPrefetch()
+{
+   // Called with m_downloadCond locked.
+   // Returns the nearest block the next reads are expected to touch that is
+   // neither on disk nor in RAM, or -1. The look-ahead is limited to the
+   // number of blocks a file may prefetch.
+
+   if (m_readStrideCnt < 2) return -1;
+
+   const int first = m_offset/m_cfi.GetBufferSize();
+   const int end   = first + m_cfi.GetSizeInBits();
+   const int width = m_lastReadLast - m_lastReadFirst + 1;
+   const int depth = std::max(1, (int) Cache::GetInstance().RefConfiguration().m_prefetch_max_blocks);
+
+   for (int k = 1, n = 0; n < depth; ++k)
+   {
+      int start = (m_readStride == 1) ? m_lastReadLast + k : m_lastReadFirst + k * m_readStride;
+      int len   = (m_readStride == 1) ? 1 : width;
+      if (start + len <= first || start >= end) break;
+
+      for (int bi = start; bi < start + len && n < depth; ++bi, ++n)
+      {
+         if (bi < first || bi >= end) continue;
+         if ( ! m_cfi.TestBit(bi - first) && m_block_map.find(bi) == m_block_map.end())
+         {
+            TRACEF(Dump, "File::PredictBlockToPrefetch stride " << m_readStride << " block " << bi);
+            return bi;
+         }
+      }
+   }
+   return -1;
+}
 
 //------------------------------------------------------------------------------
 
@@ -26,6 +26,7 @@
 
 #include "XrdFileCacheInfo.hh"
 #include "XrdFileCacheStats.hh"
+#include "XrdFileCacheIndex.hh"
 
 #include <string>
 #include <map>
@@ -59,35 +60,36 @@ class File;
 class Block
 {
 public:
-   std::vector<char>   m_buff;
+   char               *m_buff;                          // from Cache::RequestBlockBuffer()
+   int                 m_size;
    long long           m_offset;
    File               *m_file;
    bool                m_prefetch;
    int                 m_refcnt;
    int                 m_errno;                         // stores negative errno
    bool                m_downloaded;
+   long long           m_queued;                        // time put in write queue, us
 
-   Block(File *f, long long off, int size, bool m_prefetch) :
-      m_offset(off), m_file(f), m_prefetch(m_prefetch), m_refcnt(0),
-      m_errno(0), m_downloaded(false)
-   {
-      m_buff.resize(size);
-   }
+   Block(File *f, char *buff, long long off, int size, bool m_prefetch) :
+      m_buff(buff), m_size(size), m_offset(off), m_file(f), m_prefetch(m_prefetch), m_refcnt(0),
+      m_errno(0), m_downloaded(false), m_queued(0)
+   {}
 
-   char*     get_buff(long long pos = 0) { return &m_buff[pos]; }
-   int       get_size()   { return (int) m_buff.size(); }
+   ~Block();
+
+   char*     get_buff(long long pos = 0) { return m_buff + pos; }
+   int       get_size()   { return m_size; }
    long long get_offset() { return m_offset; }
 
    bool is_finished() { return m_downloaded || m_errno != 0; }
    bool is_ok()       { return m_downloaded; }
    bool is_failed()   { return m_errno != 0; }
 
-   void set_error_and_free(int err)
-   {
-      m_errno = err;
-      std::vector<char> x;
-      m_buff.swap(x);
-   }
+   void set_error_and_free(int err);
+
+private:
+   Block(const Block&);
+   Block& operator=(const Block&);
 };
 
 // ================================================================
@@ -180,7 +182,21 @@ public:
    void ProcessBlockResponse(Block* b, int res);
    void WriteBlockToDisk(Block* b);
 
-   void Prefetch();
+   //----------------------------------------------------------------------
+   //! Write blocks of this file with one vectored write, falling back to
+   //! block by block writes if it fails.
+   //----------------------------------------------------------------------
+   void WriteBlocksToDisk(std::vector<Block*>& blocks);
+
+   //----------------------------------------------------------------------
+   //! \brief Request one block ahead of the reader.
+   //!
+   //! Blocks predicted from the read pattern are taken first, then the
+   //! first block that is neither on disk nor in RAM.
+   //!
+   //! @return true if a block was requested.
+   //----------------------------------------------------------------------
+   bool Prefetch();
 
    float GetPrefetchScore() const;
 
@@ -212,11 +228,14 @@ private:
    XrdOssDF      *m_output;             //!< file handle for data file on disk
    XrdOssDF      *m_infoFile;           //!< file handle for data-info file on disk
    Info           m_cfi;                //!< download status of file blocks and access statistics
+   Index::Entry  *m_indexEntry;         //!< purge index entry, set while open
 
    std::string    m_filename;           //!< filename of data file on disk
    long long      m_offset;             //!< offset of cached file for block-based operation
    long long      m_fileSize;           //!< size of cached disk file for block-based operation
 
+   void BlockWritten(Block* b);
+
    // fsync
    std::vector<int>  m_writes_during_sync;
    int  m_non_flushed_cnt;
@@ -243,6 +262,13 @@ private:
    int   m_prefetchReadCnt;
    int   m_prefetchHitCnt;
    float m_prefetchScore;              //cached
+
+   // read pattern, block indices of the last read and the distance between
+   // the first blocks of consecutive reads, 1 for sequential reads
+   int   m_lastReadFirst;
+   int   m_lastReadLast;
+   int   m_readStride;
+   int   m_readStrideCnt;               //!< number of reads that repeated the stride
    
    bool  m_detachTimeIsLogged;
 
@@ -281,6 +307,9 @@ private:
    long long BufferSize();
    void AppendIOStatToFileInfo();
 
+   void TrackReadPattern(int idx_first, int idx_last);
+   int  PredictBlockToPrefetch();
+
    void inc_ref_count(Block*);
    void dec_ref_count(Block*);
    void free_block(Block*);
@@ -0,0 +1,312 @@
+//----------------------------------------------------------------------------------
+// Copyright (c) 2026 by the contributors to the XRootD software suite
+//----------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//----------------------------------------------------------------------------------
+
+#include <algorithm>
+
+#include "XrdFileCacheIndex.hh"
+#include "XrdFileCacheInfo.hh"
+
+using namespace XrdFileCache;
+
+namespace
+{
+unsigned int Now()
+{
+   return (unsigned int) time(0);
+}
+
+unsigned int ToStamp(time_t t)
+{
+   // zero marks a block that is not on disk
+   return t > 0 ? (unsigned int) t : 1;
+}
+}
+
+//------------------------------------------------------------------------------
+
+long long Index::Entry::BlockBytes(int i) const
+{
+   long long off = i * m_bufferSize;
+   return (off + m_bufferSize) > m_fileSize ? (m_fileSize - off) : m_bufferSize;
+}
+
+//------------------------------------------------------------------------------
+
+Index::~Index()
+{
+   for (FileMap_i i = m_files.begin(); i != m_files.end(); ++i)
+      delete i->second;
+}
+
+//------------------------------------------------------------------------------
+
+Index::Entry* Index::FindOrAdd(const std::string &path, const Info &cfi, bool &isNew)
+{
+   // Called with lock held.
+
+   FileMap_i it = m_files.find(path);
+   isNew = (it == m_files.end());
+
+   Entry *e = isNew ? new Entry(path) : it->second;
+   if (isNew) m_files[path] = e;
+
+   int nBlk = cfi.GetSizeInBits();
+   if (e->m_fileSize != cfi.GetFileSize() || e->m_bufferSize != cfi.GetBufferSize() ||
+       (int) e->m_last.size() != nBlk)
+   {
+      // layout changed (or new entry), forget what we knew about the blocks
+      for (int i = 0; i < (int) e->m_last.size(); ++i)
+         if (e->m_last[i]) Drop(e, i);
+
+      e->m_fileSize   = cfi.GetFileSize();
+      e->m_bufferSize = cfi.GetBufferSize();
+      e->m_last.assign(nBlk, 0);
+      e->m_prev.assign(nBlk, 0);
+   }
+   return e;
+}
+
+//------------------------------------------------------------------------------
+
+void Index::Load(const std::string &path, const Info &cfi)
+{
+   // Initial reference times come from the access records of the cinfo file,
+   // a file accessed more than once has all its blocks referenced twice.
+
+   const std::vector<Info::AStat> &as = cfi.RefStoredData().m_astats;
+   time_t last = cfi.RefStoredData().m_creationTime;
+   time_t prev = 0;
+   if ( ! as.empty())
+   {
+      const Info::AStat &a = as.back();
+      last = a.DetachTime ? a.DetachTime : a.AttachTime;
+   }
+   if (as.size() > 1)
+   {
+      const Info::AStat &a = as[as.size() - 2];
+      prev = a.DetachTime ? a.DetachTime : a.AttachTime;
+   }
+
+   XrdSysMutexHelper lck(&m_mutex);
+
+   if (m_files.find(path) != m_files.end()) return;
+
+   bool isNew;
+   Entry *e = FindOrAdd(path, cfi, isNew);
+   e->m_detach = last;
+   for (int i = 0; i < (int) e->m_last.size(); ++i)
+   {
+      if (cfi.TestBit(i))
+      {
+         e->m_last[i] = ToStamp(last);
+         e->m_prev[i] = prev ? ToStamp(prev) : 0;
+         e->m_bytes  += e->BlockBytes(i);
+         m_nBytes    += e->BlockBytes(i);
+         ++m_nBlocks;
+      }
+   }
+   Enqueue(e);
+}
+
+//------------------------------------------------------------------------------
+
+Index::Entry* Index::Attach(const std::string &path, const Info &cfi)
+{
+   XrdSysMutexHelper lck(&m_mutex);
+
+   bool isNew;
+   Entry *e = FindOrAdd(path, cfi, isNew);
+   Dequeue(e);
+   ++e->m_nActive;
+
+   // the cinfo file is authoritative
+   const unsigned int now = Now();
+   for (int i = 0; i < (int) e->m_last.size(); ++i)
+   {
+      bool onDisk = cfi.TestBit(i);
+      if (onDisk && ! e->m_last[i])
+      {
+         e->m_last[i] = now;
+         e->m_bytes  += e->BlockBytes(i);
+         m_nBytes    += e->BlockBytes(i);
+         ++m_nBlocks;
+      }
+      else if ( ! onDisk && e->m_last[i])
+      {
+         Drop(e, i);
+      }
+   }
+   return e;
+}
+
+//------------------------------------------------------------------------------
+
+void Index::Detach(Entry *e)
+{
+   XrdSysMutexHelper lck(&m_mutex);
+
+   e->m_detach = time(0);
+   if (--e->m_nActive == 0) Enqueue(e);
+}
+
+//------------------------------------------------------------------------------
+
+void Index::Written(Entry *e, int blk)
+{
+   XrdSysMutexHelper lck(&m_mutex);
+
+   if ( ! e || blk < 0 || blk >= (int) e->m_last.size()) return;
+
+   if (e->m_last[blk])
+   {
+      e->m_prev[blk] = e->m_last[blk];
+   }
+   else
+   {
+      e->m_prev[blk] = 0;
+      e->m_bytes    += e->BlockBytes(blk);
+      m_nBytes      += e->BlockBytes(blk);
+      ++m_nBlocks;
+   }
+   e->m_last[blk] = Now();
+}
+
+//------------------------------------------------------------------------------
+
+void Index::Access(Entry *e, int blk)
+{
+   XrdSysMutexHelper lck(&m_mutex);
+
+   if ( ! e || blk < 0 || blk >= (int) e->m_last.size() || ! e->m_last[blk]) return;
+
+   // references within the same second are taken as correlated
+   const unsigned int now = Now();
+   if (e->m_last[blk] != now)
+   {
+      e->m_prev[blk] = e->m_last[blk];
+      e->m_last[blk] = now;
+   }
+}
+
+//------------------------------------------------------------------------------
+
+bool Index::Select(long long nBytes, bool whole, Victim &v)
+{
+   XrdSysMutexHelper lck(&m_mutex);
+
+   v = Victim();
+   if (m_order.empty()) return false;
+
+   Entry *e = m_order.begin()->second;
+   Dequeue(e);
+   Key_t next = m_order.empty() ? ~0ull : m_order.begin()->first;
+
+   std::vector<std::pair<Key_t, int> > blks;
+   blks.reserve(e->m_last.size());
+   for (int i = 0; i < (int) e->m_last.size(); ++i)
+      if (e->m_last[i]) blks.push_back(std::make_pair(BlockKey(e, i), i));
+
+   // Take the coldest blocks of this file for as long as they are colder than
+   // anything in the next file. The rest is requeued by Evicted().
+   std::sort(blks.begin(), blks.end());
+   size_t n = 0;
+   if (whole)
+   {
+      n = blks.size();
+      v.m_bytes = e->m_bytes;
+   }
+   else
+   {
+      while (n < blks.size() && v.m_bytes < nBytes && (n == 0 || blks[n].first <= next))
+         v.m_bytes += e->BlockBytes(blks[n++].second);
+   }
+
+   v.m_entry = e;
+   v.m_whole = (n == blks.size());
+   for (size_t i = 0; i < n; ++i) v.m_blocks.push_back(blks[i].second);
+   std::sort(v.m_blocks.begin(), v.m_blocks.end());
+   return true;
+}
+
+//------------------------------------------------------------------------------
+
+void Index::Evicted(Victim &v)
+{
+   XrdSysMutexHelper lck(&m_mutex);
+
+   Entry *e = v.m_entry;
+   if (v.m_whole)
+   {
+      for (int i = 0; i < (int) e->m_last.size(); ++i)
+         if (e->m_last[i]) Drop(e, i);
+      m_files.erase(e->m_path);
+      delete e;
+   }
+   else
+   {
+      for (std::vector<int>::iterator i = v.m_blocks.begin(); i != v.m_blocks.end(); ++i)
+         if (e->m_last[*i]) Drop(e, *i);
+      Enqueue(e);
+   }
+   v.m_entry = 0;
+}
+
+//------------------------------------------------------------------------------
+
+void Index::Enqueue(Entry *e)
+{
+   // Called with lock held. An entry without blocks is queued by its detach
+   // time so that the empty files also get cleaned up eventually.
+
+   if (e->m_queued || e->m_nActive) return;
+
+   Key_t key = ToStamp(e->m_detach);
+   bool  any = false;
+   for (int i = 0; i < (int) e->m_last.size(); ++i)
+   {
+      if (e->m_last[i] && ( ! any || BlockKey(e, i) < key))
+      {
+         key = BlockKey(e, i);
+         any = true;
+      }
+   }
+   e->m_pos    = m_order.insert(std::make_pair(key, e));
+   e->m_queued = true;
+}
+
+//------------------------------------------------------------------------------
+
+void Index::Dequeue(Entry *e)
+{
+   // Called with lock held.
+
+   if ( ! e->m_queued) return;
+   m_order.erase(e->m_pos);
+   e->m_queued = false;
+}
+
+//------------------------------------------------------------------------------
+
+void Index::Drop(Entry *e, int blk)
+{
+   // Called with lock held.
+
+   e->m_bytes  -= e->BlockBytes(blk);
+   m_nBytes    -= e->BlockBytes(blk);
+   --m_nBlocks;
+   e->m_last[blk] = e->m_prev[blk] = 0;
+}
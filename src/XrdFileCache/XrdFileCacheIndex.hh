@@ -0,0 +1,154 @@
+#ifndef __XRDFILECACHE_INDEX_HH__
+#define __XRDFILECACHE_INDEX_HH__
+//----------------------------------------------------------------------------------
+// Copyright (c) 2026 by the contributors to the XRootD software suite
+//----------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//----------------------------------------------------------------------------------
+
+#include <string>
+#include <vector>
+#include <map>
+#include <time.h>
+
+#include "XrdSys/XrdSysPthread.hh"
+
+namespace XrdFileCache
+{
+class Info;
+
+//----------------------------------------------------------------------------
+//! In-memory index of cached files and the blocks they hold on disk.
+//!
+//! The index is filled once from the cinfo files at startup and is then kept
+//! up to date by File on attach, detach, block write and disk read. Each block
+//! carries the times of its last two references so that the purge can evict
+//! with LRU-2 at block granularity: blocks referenced only once are evicted
+//! first, the others in order of their second to last reference. Files that
+//! are not attached are kept in a map ordered by their coldest block, which
+//! makes selecting the next victim independent of the size of the namespace.
+//!
+//! Attach and Detach must be called with Cache's active-file mutex held, and
+//! so must Select and Evicted. Between the two, the purge marks the victim
+//! so that it is not opened while its blocks are being removed.
+//----------------------------------------------------------------------------
+class Index
+{
+public:
+   typedef unsigned long long Key_t;
+
+   struct Entry
+   {
+      std::string               m_path;       //!< local path of data file
+      long long                 m_bufferSize; //!< block size
+      long long                 m_fileSize;   //!< size of data file
+      long long                 m_bytes;      //!< bytes held on disk
+      int                       m_nActive;    //!< number of attached File objects
+      time_t                    m_detach;     //!< last detach time
+      std::vector<unsigned int> m_last;       //!< last reference, 0 if not on disk
+      std::vector<unsigned int> m_prev;       //!< second to last reference
+      bool                      m_queued;     //!< entry is in purge order
+      std::multimap<Key_t, Entry*>::iterator m_pos; //!< position in purge order
+
+      Entry(const std::string &p) : m_path(p), m_bufferSize(0), m_fileSize(0), m_bytes(0),
+                                    m_nActive(0), m_detach(0), m_queued(false) {}
+
+      long long BlockBytes(int i) const;
+   };
+
+   //---------------------------------------------------------------------
+   //! Blocks chosen for eviction from a single file.
+   //---------------------------------------------------------------------
+   struct Victim
+   {
+      Entry            *m_entry;
+      std::vector<int>  m_blocks;  //!< block indices, ascending
+      long long         m_bytes;   //!< bytes held by the blocks
+      bool              m_whole;   //!< all blocks chosen, remove the file
+
+      Victim() : m_entry(0), m_bytes(0), m_whole(false) {}
+   };
+
+   Index() : m_nBytes(0), m_nBlocks(0) {}
+   ~Index();
+
+   //---------------------------------------------------------------------
+   //! Add file found at startup; ignored if the file is already known.
+   //---------------------------------------------------------------------
+   void Load(const std::string &path, const Info &cfi);
+
+   //---------------------------------------------------------------------
+   //! File has been opened; reconcile the entry with its cinfo.
+   //---------------------------------------------------------------------
+   Entry* Attach(const std::string &path, const Info &cfi);
+
+   //---------------------------------------------------------------------
+   //! File has been closed; make it eligible for purge.
+   //---------------------------------------------------------------------
+   void Detach(Entry *e);
+
+   //---------------------------------------------------------------------
+   //! Block has been written to disk.
+   //---------------------------------------------------------------------
+   void Written(Entry *e, int blk);
+
+   //---------------------------------------------------------------------
+   //! Block has been read from disk.
+   //---------------------------------------------------------------------
+   void Access(Entry *e, int blk);
+
+   //---------------------------------------------------------------------
+   //! \brief Choose blocks to evict from the coldest detached file.
+   //!
+   //! @param nBytes  number of bytes still to be freed
+   //! @param whole   choose whole files only
+   //! @param v       filled with the blocks to evict
+   //!
+   //! @return false if there is nothing to evict.
+   //---------------------------------------------------------------------
+   bool Select(long long nBytes, bool whole, Victim &v);
+
+   //---------------------------------------------------------------------
+   //! Blocks in victim have been removed from disk. A whole victim's entry
+   //! is deleted.
+   //---------------------------------------------------------------------
+   void Evicted(Victim &v);
+
+   long long GetNBytes()  { XrdSysMutexHelper lck(&m_mutex); return m_nBytes; }
+   int       GetNFiles()  { XrdSysMutexHelper lck(&m_mutex); return (int) m_files.size(); }
+   long long GetNBlocks() { XrdSysMutexHelper lck(&m_mutex); return m_nBlocks; }
+
+private:
+   typedef std::map<std::string, Entry*>  FileMap_t;
+   typedef FileMap_t::iterator            FileMap_i;
+   typedef std::multimap<Key_t, Entry*>   Order_t;
+   typedef Order_t::iterator              Order_i;
+
+   static Key_t BlockKey(const Entry *e, int i)
+   { return ((Key_t) e->m_prev[i] << 32) | e->m_last[i]; }
+
+   Entry* FindOrAdd(const std::string &path, const Info &cfi, bool &isNew);
+   void   Enqueue(Entry *e);
+   void   Dequeue(Entry *e);
+   void   Drop(Entry *e, int blk);
+
+   XrdSysMutex m_mutex;
+   FileMap_t   m_files;    //!< all known files
+   Order_t     m_order;    //!< detached files by coldest block
+   long long   m_nBytes;   //!< bytes on disk in all files
+   long long   m_nBlocks;  //!< blocks on disk in all files
+};
+}
+
+#endif
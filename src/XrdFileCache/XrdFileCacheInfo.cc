@@ -99,7 +99,7 @@ using namespace XrdFileCache;
 
 const char*  Info::m_infoExtension  = ".cinfo";
 const char*  Info::m_traceID        = "Cinfo";
-const int    Info::m_defaultVersion = 2;
+const int    Info::m_defaultVersion = 3;
 const size_t Info::m_maxNumAccess   = 20;
 
 //------------------------------------------------------------------------------
@@ -223,12 +223,33 @@ bool Info::Read(XrdOssDF* fp, const std::string &fname)
    if (r.Read(m_store.m_accessCnt, false)) m_store.m_accessCnt = 0;  // was: return false;
    TRACE(Dump, trace_pfx << " complete "<< m_complete << " access_cnt " << m_store.m_accessCnt);
 
-   // read access statistics
+   // read access statistics, version 2 has no prefetch counters
+   struct AStatV2 {
+      time_t    AttachTime;
+      time_t    DetachTime;
+      long long BytesDisk;
+      long long BytesRam;
+      long long BytesMissed;
+   };
+
    int vs = m_store.m_accessCnt < m_maxNumAccess ? m_store.m_accessCnt : m_maxNumAccess;
    m_store.m_astats.resize(vs);
    for (std::vector<AStat>::iterator it = m_store.m_astats.begin(); it != m_store.m_astats.end(); ++it)
    {
-      if (r.Read(*it, sizeof(AStat))) return false;
+      if (abs(m_store.m_version) == 2)
+      {
+         AStatV2 av2;
+         if (r.ReadRaw(&av2, sizeof(AStatV2))) return false;
+         it->AttachTime  = av2.AttachTime;
+         it->DetachTime  = av2.DetachTime;
+         it->BytesDisk   = av2.BytesDisk;
+         it->BytesRam    = av2.BytesRam;
+         it->BytesMissed = av2.BytesMissed;
+      }
+      else
+      {
+         if (r.ReadRaw(&(*it), sizeof(AStat))) return false;
+      }
    }
 
 
@@ -359,6 +380,11 @@ void Info::WriteIOStatDetach(Stats& s)
    m_store.m_astats.back().BytesDisk   = s.m_BytesDisk;
    m_store.m_astats.back().BytesRam    = s.m_BytesRam;
    m_store.m_astats.back().BytesMissed = s.m_BytesMissed;
+
+   // Blocks prefetched in an earlier session can be hit in this one.
+   long long waste = s.m_BlocksPrefetched - s.m_PrefetchHits;
+   m_store.m_astats.back().PrefetchHits  = s.m_PrefetchHits;
+   m_store.m_astats.back().PrefetchWaste = waste > 0 ? waste : 0;
 }
 
 void Info::WriteIOStatAttach()
@@ -55,8 +55,11 @@ public:
       long long BytesDisk;        //! read from disk
       long long BytesRam;         //! read from ram
       long long BytesMissed;      //! read remote client
+      long long PrefetchHits;     //! prefetched blocks that were read
+      long long PrefetchWaste;    //! prefetched blocks that were not read
 
-      AStat() : AttachTime(0), DetachTime(0), BytesDisk(0), BytesRam(0), BytesMissed(0) {}
+      AStat() : AttachTime(0), DetachTime(0), BytesDisk(0), BytesRam(0), BytesMissed(0),
+                PrefetchHits(0), PrefetchWaste(0) {}
    };
 
    struct Store {
@@ -103,6 +106,20 @@ public:
    //---------------------------------------------------------------------
    void SetBitPrefetch(int i);
 
+   //---------------------------------------------------------------------
+   //! \brief Clear prefetch mark once the block has been read
+   //!
+   //! @param i block index
+   //---------------------------------------------------------------------
+   void ResetBitPrefetch(int i);
+
+   //---------------------------------------------------------------------
+   //! \brief Mark block as not downloaded, used when it is purged
+   //!
+   //! @param i block index
+   //---------------------------------------------------------------------
+   void ResetBit(int i);
+
    void SetBufferSize(long long);
    
    void SetFileSize(long long);
@@ -355,6 +372,29 @@ inline void Info::SetBitPrefetch(int i)
    m_buff_prefetch[cn] |= cfiBIT(off);
 }
 
+inline void Info::ResetBitPrefetch(int i)
+{
+   if (!m_buff_prefetch) return;
+
+   const int cn = i/8;
+   assert(cn < GetSizeInBytes());
+
+   const int off = i - cn*8;
+   m_buff_prefetch[cn] &= ~cfiBIT(off);
+}
+
+inline void Info::ResetBit(int i)
+{
+   const int cn = i/8;
+   assert(cn < GetSizeInBytes());
+
+   const int off = i - cn*8;
+   m_buff_written[cn]        &= ~cfiBIT(off);
+   m_store.m_buff_synced[cn] &= ~cfiBIT(off);
+   if (m_buff_prefetch) m_buff_prefetch[cn] &= ~cfiBIT(off);
+   m_complete = false;
+}
+
 
 inline long long Info::GetBufferSize() const
 {
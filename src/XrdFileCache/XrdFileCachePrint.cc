@@ -136,7 +136,8 @@ void Print::printFile(const std::string& path)
          snprintf(ot, 500, "%02d:%02d:%02d", hours, min, sec);
       }
 
-      printf("%s, duration %s, bytesDisk=%lld, bytesRAM=%lld, bytesMissed=%lld\n", as, ot, it->BytesDisk, it->BytesRam, it->BytesMissed);
+      printf("%s, duration %s, bytesDisk=%lld, bytesRAM=%lld, bytesMissed=%lld, prefetchHits=%lld, prefetchWaste=%lld\n",
+             as, ot, it->BytesDisk, it->BytesRam, it->BytesMissed, it->PrefetchHits, it->PrefetchWaste);
    }
 
    delete fh;
@@ -4,58 +4,22 @@
 using namespace XrdFileCache;
 
 #include <fcntl.h>
+#include <errno.h>
+#ifdef __linux__
+#include <linux/falloc.h>
+#endif
 #include "XrdOuc/XrdOucEnv.hh"
 #include "XrdSys/XrdSysTrace.hh"
 
 namespace
 {
-class FPurgeState
-{
-public:
-   struct FS
-   {
-      std::string path;
-      long long nByte;
-      FS(const char* p, long long n) : path(p), nByte(n) {}
-   };
-
-   typedef std::multimap<time_t, FS> map_t;
-   typedef map_t::iterator map_i;
-   map_t fmap;
-   
-   FPurgeState(long long iNByteReq) : nByteReq(iNByteReq), nByteAccum(0) {}
-
-   void checkFile (time_t iTime, const char* iPath,  long long iNByte)
-   {
-      if (nByteAccum < nByteReq || iTime < fmap.rbegin()->first)
-      {
-         fmap.insert(std::pair<const time_t, FS> (iTime, FS(iPath, iNByte)));
-         nByteAccum += iNByte;
-
-         // remove newest files from map if necessary
-         while (nByteAccum > nByteReq)
-         {
-            time_t nt = fmap.begin()->first;
-            std::pair<map_i, map_i> ret = fmap.equal_range(nt);
-            for (map_i it2 = ret.first; it2 != ret.second; ++it2)
-               nByteAccum -= it2->second.nByte;
-            fmap.erase(ret.first, ret.second);
-         }
-      }
-   }
-
-private:
-   long long nByteReq;
-   long long nByteAccum;
-};
-
 XrdSysTrace* GetTrace()
 {
    // needed for logging macros
    return Cache::GetInstance().GetTrace();
 }
 
-void FillFileMapRecurse( XrdOssDF* iOssDF, const std::string& path, FPurgeState& purgeState)
+void FillIndexRecurse( XrdOssDF* iOssDF, const std::string& path, Index& index)
 {
    char buff[256];
    XrdOucEnv env;
@@ -66,12 +30,10 @@ void FillFileMapRecurse( XrdOssDF* iOssDF, const std::string& path, FPurgeState&
    Cache& factory = Cache::GetInstance();
    while ((rdr = iOssDF->Readdir(&buff[0], 256)) >= 0)
    {
-      // printf("readdir [%s]\n", buff);
       std::string np = path + "/" + std::string(buff);
       size_t fname_len = strlen(&buff[0]);
       if (fname_len == 0)
       {
-         // std::cout << "Finish read dir.[" << np <<"] Break loop \n";
          break;
       }
 
@@ -82,57 +44,28 @@ void FillFileMapRecurse( XrdOssDF* iOssDF, const std::string& path, FPurgeState&
 
          if (fname_len > InfoExtLen && strncmp(&buff[fname_len - InfoExtLen], XrdFileCache::Info::m_infoExtension, InfoExtLen) == 0)
          {
-            // We could also check if it is currently opened with Cache::HaveActiveFileWihtLocalPath()
-            // This is not relay necessary because we do that check before unlinking the file
+            // Files opened in the meantime are already in the index and are skipped by Load().
             Info cinfo(Cache::GetInstance().GetTrace());
+            std::string dataPath = np.substr(0, np.size() - InfoExtLen);
             if (fh->Open(np.c_str(), O_RDONLY, 0600, env) == XrdOssOK && cinfo.Read(fh, np))
             {
-               time_t accessTime;
-               if (cinfo.GetLatestDetachTime(accessTime))
-               {
-                  TRACE(Dump, "FillFileMapRecurse() checking " << buff << " accessTime  " << accessTime);
-                  purgeState.checkFile(accessTime, np.c_str(), cinfo.GetNDownloadedBytes());
-               }
-               else
-               {
-                  // cinfo file does not contain any known accesses, use stat.mtime instead.
-
-                  TRACE(Debug, "FillFileMapRecurse() could not get access time for " << np << ", trying stat");
-
-                  XrdOss* oss = Cache::GetInstance().GetOss();
-                  struct stat fstat;
-
-                  if (oss->Stat(np.c_str(), &fstat) == XrdOssOK)
-                  {
-                     accessTime = fstat.st_mtime;
-                     TRACE(Dump, "FillFileMapRecurse() have access time for " << np << " via stat: " << accessTime);
-                     purgeState.checkFile(accessTime, np.c_str(), cinfo.GetNDownloadedBytes());
-                  }
-                  else
-                  {
-                     // This really shouldn't happen ... but if it does remove cinfo and the data file right away.
-
-                     TRACE(Warning, "FillFileMapRecurse() could not get access time for " << np
-                                                                                          << "; purging.");
-                     oss->Unlink(np.c_str());
-                     np = np.substr(0, np.size() - strlen(XrdFileCache::Info::m_infoExtension));
-                     oss->Unlink(np.c_str());
-                  }
-               }
+               TRACE(Dump, "FillIndexRecurse() adding " << dataPath << " with " << cinfo.GetNDownloadedBlocks() << " blocks");
+               index.Load(dataPath, cinfo);
             }
-            else
+            else if ( ! factory.HaveActiveFileWithLocalPath(dataPath))
             {
-               TRACE(Warning, "FillFileMapRecurse() can't open or read " << np << ", err " << strerror(errno)
-                                                                         << "; purging.");
+               TRACE(Warning, "FillIndexRecurse() can't open or read " << np << ", err " << strerror(errno)
+                                                                       << "; purging.");
                XrdOss* oss = Cache::GetInstance().GetOss();
                oss->Unlink(np.c_str());
-               np = np.substr(0, np.size() - strlen(XrdFileCache::Info::m_infoExtension));
-               oss->Unlink(np.c_str());
+               oss->Unlink(dataPath.c_str());
             }
+            fh->Close();
          }
          else if (dh->Opendir(np.c_str(), env) == XrdOssOK)
          {
-            FillFileMapRecurse(dh, np, purgeState);
+            FillIndexRecurse(dh, np, index);
+            dh->Close();
          }
 
          delete dh; dh = 0;
@@ -141,12 +74,173 @@ void FillFileMapRecurse( XrdOssDF* iOssDF, const std::string& path, FPurgeState&
    }
 }
 }
-void Cache::CacheDirCleanup()
+
+//------------------------------------------------------------------------------
+
+void Cache::FillIndex()
 {
+   // One namespace scan at startup, from then on the index is kept up to
+   // date by the File objects.
+
    XrdOucEnv env;
+   XrdOssDF* dh = m_output_fs->newDir(m_configuration.m_username.c_str());
+   if (dh->Opendir("", env) == XrdOssOK)
+   {
+      FillIndexRecurse(dh, "", m_index);
+      dh->Close();
+   }
+   delete dh;
+
+   TRACE(Info, "Cache::FillIndex() found " << m_index.GetNFiles() << " files with "
+               << m_index.GetNBlocks() << " blocks, " << m_index.GetNBytes() << " bytes.");
+}
+
+//------------------------------------------------------------------------------
+
+bool Cache::PunchBlocks(const std::string &dataPath, Index::Victim &v)
+{
+   // Clear the blocks in the cinfo file first, only then release their space
+   // in the data file. Returns false if the file has to be removed instead.
+
+#if defined(__linux__) && defined(FALLOC_FL_PUNCH_HOLE)
+   XrdOucEnv   env;
+   std::string infoPath = dataPath + Info::m_infoExtension;
+   XrdOssDF   *fh = m_output_fs->newFile(m_configuration.m_username.c_str());
+   Info        cinfo(m_trace);
+
+   bool ok = (fh->Open(infoPath.c_str(), O_RDWR, 0600, env) == XrdOssOK && cinfo.Read(fh, infoPath));
+   if (ok)
+   {
+      for (std::vector<int>::iterator i = v.m_blocks.begin(); i != v.m_blocks.end(); ++i)
+         cinfo.ResetBit(*i);
+      ok = cinfo.Write(fh, infoPath) && fh->Fsync() == XrdOssOK;
+      fh->Close();
+   }
+   delete fh;
+   if ( ! ok)
+   {
+      TRACE(Warning, "Cache::PunchBlocks() can't update " << infoPath << ", err " << strerror(errno));
+      return false;
+   }
+
+   fh = m_output_fs->newFile(m_configuration.m_username.c_str());
+   ok = (fh->Open(dataPath.c_str(), O_RDWR, 0600, env) == XrdOssOK && fh->getFD() >= 0);
+   const Index::Entry *e = v.m_entry;
+   size_t i = 0;
+   while (ok && i < v.m_blocks.size())
+   {
+      // release adjacent blocks with a single call
+      size_t j = i + 1;
+      while (j < v.m_blocks.size() && v.m_blocks[j] == v.m_blocks[j-1] + 1) ++j;
+      long long off = v.m_blocks[i] * e->m_bufferSize;
+      long long len = (v.m_blocks[j-1] - v.m_blocks[i]) * e->m_bufferSize + e->BlockBytes(v.m_blocks[j-1]);
+      ok = (fallocate(fh->getFD(), FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, off, len) == 0);
+      i = j;
+   }
+   if ( ! ok)
+   {
+      TRACE(Warning, "Cache::PunchBlocks() can't release blocks in " << dataPath << ", err " << strerror(errno));
+      if (errno == EOPNOTSUPP)
+      {
+         TRACE(Warning, "Cache::PunchBlocks() not supported by the file system, purging whole files from now on.");
+         m_configuration.m_purgeBlocks = false;
+      }
+   }
+   fh->Close();
+   delete fh;
+   return ok;
+#else
+   m_configuration.m_purgeBlocks = false;
+   return false;
+#endif
+}
+
+//------------------------------------------------------------------------------
+
+long long Cache::PurgeFromIndex(long long bytesToRemove)
+{
+   XrdOss*       oss = m_output_fs;
+   Index::Victim v;
+   std::vector<Index::Victim> skipped;
+   long long     removed = 0;
+
+   while (removed < bytesToRemove)
+   {
+      // Select the victim and mark it as being purged while holding the
+      // active-file mutex; GetFile() waits for the mark to go away. The disk
+      // I/O is done without the lock so that opening other files is not held up.
+      std::string dataPath;
+      {
+         XrdSysMutexHelper lock(&m_active_mutex);
+
+         if ( ! m_index.Select(bytesToRemove - removed, ! m_configuration.m_purgeBlocks, v))
+            break;
+
+         dataPath = v.m_entry->m_path;
+
+         if (m_active.find(dataPath) != m_active.end())
+         {
+            // open failed earlier but the file object is still around
+            v.m_blocks.clear();
+            v.m_whole = false;
+            skipped.push_back(v);
+            continue;
+         }
+         m_purging.insert(dataPath);
+      }
+
+      std::string infoPath = dataPath + Info::m_infoExtension;
+
+      if ( ! v.m_whole)
+      {
+         if (PunchBlocks(dataPath, v))
+         {
+            TRACE(Info, "Cache::CacheDirCleanup() removed " << v.m_blocks.size() << " blocks from " << dataPath
+                        << " size " << v.m_bytes);
+         }
+         else
+         {
+            v.m_whole = true;
+            v.m_bytes = v.m_entry->m_bytes;
+         }
+      }
+
+      if (v.m_whole)
+      {
+         oss->Unlink(infoPath.c_str());
+         oss->Unlink(dataPath.c_str());
+         TRACE(Info, "Cache::CacheDirCleanup() removed file: " << dataPath << " size " << v.m_bytes);
+      }
+
+      removed += v.m_bytes;
+
+      m_active_mutex.Lock();
+      m_index.Evicted(v);
+      m_purging.erase(dataPath);
+      m_active_mutex.UnLock();
+
+      m_purge_condVar.Lock();
+      m_purge_condVar.Broadcast();
+      m_purge_condVar.UnLock();
+   }
+
+   // put back the files we could not touch
+   XrdSysMutexHelper lock(&m_active_mutex);
+   for (std::vector<Index::Victim>::iterator i = skipped.begin(); i != skipped.end(); ++i)
+      m_index.Evicted(*i);
+
+   return removed;
+}
+
+//------------------------------------------------------------------------------
+
+void Cache::CacheDirCleanup()
+{
    XrdOss*      oss = Cache::GetInstance().GetOss();
    XrdOssVSInfo sP;
 
+   FillIndex();
+
    while (1)
    {
       // get amount of space to erase
@@ -160,6 +254,13 @@ void Cache::CacheDirCleanup()
       {
          long long ausage = sP.Total - sP.Free;
          TRACE(Info, "Cache::CacheDirCleanup() used disk space " << ausage << " bytes.");
+
+         WriteQStats wqs;
+         GetWriteQStats(wqs, true);
+         TRACE(Info, "Cache::CacheDirCleanup() write queue depth " << wqs.m_depth << " max " << wqs.m_maxDepth
+                     << ", wrote " << wqs.m_blocks << " blocks in " << wqs.m_batches << " writes, latency avg "
+                     << (wqs.m_blocks ? wqs.m_latencySum / wqs.m_blocks / 1000 : 0) << " ms max "
+                     << wqs.m_latencyMax / 1000 << " ms.");
          if (ausage > m_configuration.m_diskUsageHWM)
          {
             bytesToRemove = ausage - m_configuration.m_diskUsageLWM;
@@ -169,49 +270,10 @@ void Cache::CacheDirCleanup()
 
       if (bytesToRemove > 0)
       {
-         // make a sorted map of file patch by access time
-         XrdOssDF* dh = oss->newDir(m_configuration.m_username.c_str());
-         if (dh->Opendir("", env) == XrdOssOK)
-         {
-            FPurgeState purgeState(bytesToRemove * 5 / 4); // prepare 20% more volume than required
-
-            FillFileMapRecurse(dh, "", purgeState);
-
-            // loop over map and remove files with highest value of access time
-            struct stat fstat;
-            for (FPurgeState::map_i it = purgeState.fmap.begin(); it != purgeState.fmap.end(); ++it)
-            {
-
-               std::string infoPath = it->second.path;
-               std::string dataPath = infoPath.substr(0, infoPath.size() - strlen(XrdFileCache::Info::m_infoExtension));
-
-               if (HaveActiveFileWithLocalPath(dataPath))
-                  continue;
-
-               // remove info file
-               if (oss->Stat(infoPath.c_str(), &fstat) == XrdOssOK)
-               {
-                  // cinfo file can be on another oss.space, do not subtract for now.
-                  // bytesToRemove -= fstat.st_size;
-                  oss->Unlink(infoPath.c_str());
-                  TRACE(Info, "Cache::CacheDirCleanup() removed file:" <<  infoPath <<  " size: " << fstat.st_size);
-               }
-
-               // remove data file
-               if (oss->Stat(dataPath.c_str(), &fstat) == XrdOssOK)
-               {
-                  bytesToRemove -= it->second.nByte;
-
-                  oss->Unlink(dataPath.c_str());
-                  TRACE(Info, "Cache::CacheDirCleanup() removed file: %s " << dataPath << " size " << it->second.nByte);
-               }
-
-               if (bytesToRemove <= 0)
-                  break;
-            }
-         }
-         dh->Close();
-         delete dh; dh = 0;
+         // evict from the index, coldest blocks first
+         long long removed = PurgeFromIndex(bytesToRemove);
+         TRACE(Info, "Cache::CacheDirCleanup() removed " << removed << " bytes, " << m_index.GetNBytes()
+                     << " bytes in " << m_index.GetNFiles() << " files remain.");
       }
 
       sleep(m_configuration.m_purgeInterval);
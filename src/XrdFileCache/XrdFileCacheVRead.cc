@@ -296,6 +296,7 @@ int File::VReadFromDisk(const XrdOucIOVec *readV, int n, ReadVBlockListDisk& blo
          {
             bytes_read += rs;
             m_stats.m_BytesDisk += rs;
+            Cache::GetInstance().RefIndex().Access(m_indexEntry, offsetIdx(blockIdx));
          }
          else
          {
@@ -55,6 +55,8 @@ set( XROOTD_PUBLIC_HEADERS
   XrdOuc/XrdOucGMap.hh
   XrdOuc/XrdOucHash.hh
   XrdOuc/XrdOucHash.icc
+  XrdOuc/XrdOucFlatHash.hh
+  XrdOuc/XrdOucFlatHash.icc
   XrdOuc/XrdOucIOVec.hh
   XrdOuc/XrdOucLock.hh
   XrdOuc/XrdOucName2Name.hh
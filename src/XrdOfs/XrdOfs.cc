@@ -43,6 +43,7 @@
 #include <sys/types.h>
 
 #include "XrdCks/XrdCks.hh"
+#include "XrdCks/XrdCksCalc.hh"
 #include "XrdCks/XrdCksConfig.hh"
 #include "XrdCks/XrdCksData.hh"
 
@@ -51,6 +52,7 @@
 #include "XrdNet/XrdNetUtils.hh"
 
 #include "XrdOfs/XrdOfs.hh"
+#include "XrdOfs/XrdOfsCksWrite.hh"
 #include "XrdOfs/XrdOfsEvs.hh"
 #include "XrdOfs/XrdOfsHandle.hh"
 #include "XrdOfs/XrdOfsPoscq.hh"
@@ -160,6 +162,7 @@ XrdOfs::XrdOfs()
 //
    Cks       = 0;
    CksPfn    = true;
+   CksWrite  = 0;
 }
   
 /******************************************************************************/
@@ -635,6 +638,12 @@ int XrdOfsFile::open(const char          *path,      // In
        dorawio = (open_mode & SFS_O_RAWIO ? 1 : 0);
       }
    oP.hP->Activate(oP.fP);
+
+// If the file starts out empty and so wanted, compute its checksum as it is
+// being written. This saves reading the file back to compute the checksum.
+//
+   if (XrdOfsFS->CksWrite && (open_flag & (O_TRUNC | O_EXCL)))
+      XrdOfsCksWrite::Start(oP.hP);
    oP.hP->UnLock();
 
 // Send an open event if we must
@@ -680,7 +689,9 @@ int XrdOfsFile::close()  // In
    static XrdOfsHanCB *hCB = static_cast<XrdOfsHanCB *>(new CloseFH);
 
    XrdOfsHandle *hP;
-   int   poscNum, retc, cRetc = 0;
+   XrdCksCalc   *csP = 0;
+   char  csPath[MAXPATHLEN+8];
+   int   poscNum, retc, numLeft, cRetc = 0;
    short theMode;
 
 // Trace the call
@@ -713,6 +724,12 @@ int XrdOfsFile::close()  // In
            }
    OfsStats.sdMutex.UnLock();
 
+// If the checksum was computed as the file was written, we can use it only if
+// this is the last close and the writes covered the whole file.
+//
+   if (XrdOfsFS->CksWrite && (csP = XrdOfsCksWrite::End(hP)))
+      strlcpy(csPath, hP->Name(), sizeof(csPath));
+
 // If this file was tagged as a POSC then we need to make sure it will persist
 // Note that we unpersist the file immediately when it's inactive or if no hold
 // time is allowed. Also, close events occur only for active handles. If the
@@ -724,6 +741,7 @@ int XrdOfsFile::close()  // In
           {if (hP->Inactive() || !XrdOfsFS->poscHold)
               {XrdOfsFS->Unpersist(hP, !hP->Inactive()); hP->Retire(cRetc);}
               else hP->Retire(hCB, XrdOfsFS->poscHold);
+           if (csP) csP->Recycle();
            return SFS_OK;
           }
        if ((retc = hP->Select().Fchmod(theMode)))
@@ -747,11 +765,18 @@ int XrdOfsFile::close()  // In
        XrdOfsEvs::Event theEvent;
        if (hP->isRW) {theEvent = XrdOfsEvs::Closew; retsz = &FSize;}
           else {      theEvent = XrdOfsEvs::Closer; retsz = 0; FSize=0;}
-       if (!(hP->Retire(cRetc, retsz, pathbuff, sizeof(pathbuff))))
+       if (!(numLeft = hP->Retire(cRetc, retsz, pathbuff, sizeof(pathbuff))))
           {XrdOfsEvsInfo evInfo(tident, pathbuff, "" , 0, 0, FSize);
            XrdOfsFS->evsObject->Notify(theEvent, evInfo);
           }
-      } else hP->Retire(cRetc);
+      } else numLeft = hP->Retire(cRetc);
+
+// Record the checksum now that the file is closed and its time is final
+//
+   if (csP)
+      {if (!numLeft && !cRetc) XrdOfsCksWrite::Save(csPath, csP);
+       csP->Recycle();
+      }
 
 // All done
 //
@@ -999,6 +1024,7 @@ XrdSfsXferSize XrdOfsFile::write(XrdSfsFileOffset  offset,    // In
 {
    EPNAME("write");
    XrdSfsXferSize nbytes;
+   bool cksOn = false;
 
 // Perform any required tracing
 //
@@ -1019,8 +1045,10 @@ XrdSfsXferSize XrdOfsFile::write(XrdSfsFileOffset  offset,    // In
 // Write the requested bytes
 //
    oh->isPending = 1;
+   if (XrdOfsFS->CksWrite) cksOn = XrdOfsCksWrite::Update(oh,offset,buff,blen);
    nbytes = (XrdSfsXferSize)(oh->Select().Write((const void *)buff,
                             (off_t)offset, (size_t)blen));
+   if (nbytes != blen && cksOn) XrdOfsCksWrite::Update(oh, -1, 0, 0);
    if (nbytes < 0)
       return XrdOfsFS->Emsg(epname, error, (int)nbytes, "write", oh);
 
@@ -1046,8 +1074,10 @@ int XrdOfsFile::write(XrdSfsAio *aiop)
 
 // If this is a POSC file, we must convert the async call to a sync call as we
 // must trap any errors that unpersist the file. We can't do that via aio i/f.
+// The same applies when the checksum is computed as the file is written.
 //
-   if (oh->isRW == XrdOfsHandle::opPC)
+   if (oh->isRW == XrdOfsHandle::opPC
+   || (XrdOfsFS->CksWrite && XrdOfsCksWrite::Active(oh)))
       {aiop->Result = this->write(aiop->sfsAio.aio_offset,
                                   (const char *)aiop->sfsAio.aio_buf,
                                   aiop->sfsAio.aio_nbytes);
@@ -1227,6 +1257,7 @@ int XrdOfsFile::truncate(XrdSfsFileOffset  flen)  // In
 // Perform the function
 //
    oh->isPending = 1;
+   if (XrdOfsFS->CksWrite) XrdOfsCksWrite::Update(oh, flen, 0, 0);
    if ((retc = oh->Select().Ftruncate(flen)))
       return XrdOfsFS->Emsg(epname, error, retc, "truncate", oh);
 
@@ -378,7 +378,7 @@ char              ossRW;          // The oss r/w capability
 bool              CksPfn;         // Checksum needs a pfn
 XrdOfsConfigPI   *ofsConfig;      // Plugin   configurator
 XrdCks           *Cks;            // Checksum manager
-int               Reserved4;      // Reserved for future checksum stuff
+int               CksWrite;       // Compute checksum as the file is written
 
 char              myRType[4];     // Role type for consistency with the cms
 
@@ -409,6 +409,7 @@ int           Forward(int &Result, XrdOucErrInfo &Resp, struct fwdOpt &Fwd,
 int           Reformat(XrdOucErrInfo &);
 const char   *theRole(int opts);
 int           xcrds(XrdOucStream &, XrdSysError &);
+int           xcksw(XrdOucStream &, XrdSysError &);
 int           xexp(XrdOucStream &, XrdSysError &, bool);
 int           xforward(XrdOucStream &, XrdSysError &);
 int           xmaxd(XrdOucStream &, XrdSysError &);
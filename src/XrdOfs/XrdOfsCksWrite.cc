@@ -0,0 +1,215 @@
+/******************************************************************************/
+/*                                                                            */
+/*                     X r d O f s C k s W r i t e . c c                      */
+/*                                                                            */
+/* (c) 2026 by the contributors to the XRootD software suite                  */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <map>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/param.h>
+#include <sys/stat.h>
+
+#include "XrdCks/XrdCks.hh"
+#include "XrdCks/XrdCksCalc.hh"
+#include "XrdCks/XrdCksData.hh"
+#include "XrdOfs/XrdOfsCksWrite.hh"
+#include "XrdOfs/XrdOfsHandle.hh"
+#include "XrdOss/XrdOss.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+/******************************************************************************/
+/*                        S t a t i c   O b j e c t s                         */
+/******************************************************************************/
+
+namespace
+{
+struct CksWInfo
+      {XrdCksCalc *csP;     // Checksum of what was written so far
+       long long   next;    // Offset of the next in-order write
+      };
+
+typedef std::map<XrdOfsHandle *, CksWInfo> CksWTab;
+
+XrdSysMutex  cksWMutex;     // Protects the table but not the entries
+CksWTab      cksWTab;       // Handles whose checksum is being computed
+
+XrdSysError *cksWErr  = 0;
+XrdOss      *cksWOss  = 0;
+XrdCks      *cksWMgr  = 0;
+char        *cksWName = 0;  // Checksum computed upon write (0->default)
+bool         cksWPfn  = true;
+
+/******************************************************************************/
+/*                                  D r o p                                   */
+/******************************************************************************/
+
+void Drop(CksWTab::iterator it)
+{
+   it->second.csP->Recycle();
+   cksWTab.erase(it);
+}
+}
+
+/******************************************************************************/
+/*                                A c t i v e                                 */
+/******************************************************************************/
+  
+bool XrdOfsCksWrite::Active(XrdOfsHandle *hP)
+{
+   XrdSysMutexHelper cksMon(cksWMutex);
+
+   return cksWTab.find(hP) != cksWTab.end();
+}
+
+/******************************************************************************/
+/*                                   E n d                                    */
+/******************************************************************************/
+  
+XrdCksCalc *XrdOfsCksWrite::End(XrdOfsHandle *hP)
+{
+   XrdSysMutexHelper cksMon(cksWMutex);
+   CksWTab::iterator it;
+   XrdCksCalc *csP;
+   struct stat Stat;
+
+// The checksum can only be used upon the last close and only if the writes
+// covered the whole file. Either way, the handle is done with it.
+//
+   if (hP->Usage() != 1 || (it = cksWTab.find(hP)) == cksWTab.end()) return 0;
+   if (hP->Select().Fstat(&Stat) || Stat.st_size != it->second.next)
+      {Drop(it); return 0;}
+   csP = it->second.csP;
+   cksWTab.erase(it);
+   return csP;
+}
+
+/******************************************************************************/
+/*                                  I n i t                                   */
+/******************************************************************************/
+  
+bool XrdOfsCksWrite::Init(XrdSysError *eP, XrdOss *oP, XrdCks *cP, bool usePfn)
+{
+   cksWErr = eP;
+   cksWOss = oP;
+   cksWMgr = cP;
+   cksWPfn = usePfn;
+
+// Make sure that we can actually compute the wanted checksum
+//
+   return cP && cP->Size(cksWName) > 0;
+}
+
+/******************************************************************************/
+/*                                  N a m e                                   */
+/******************************************************************************/
+  
+const char *XrdOfsCksWrite::Name() {return (cksWName ? cksWName : "default");}
+
+/******************************************************************************/
+/*                                  S a v e                                   */
+/******************************************************************************/
+
+void XrdOfsCksWrite::Save(const char *path, XrdCksCalc *csP)
+{
+   XrdCksData cksData;
+   const char *pfn = path;
+   char buff[MAXPATHLEN+8];
+   int csLen, rc;
+
+// Get the checksum that was computed
+//
+   cksData.Set(csP->Type(csLen));
+   if (csLen <= 0 || csLen > XrdCksData::ValuSize) return;
+   memcpy(cksData.Value, csP->Final(), csLen);
+   cksData.Length = csLen;
+
+// Set it in the file's extended attributes just as a calculation would
+//
+   if (cksWPfn && !(pfn = cksWOss->Lfn2Pfn(path, buff, MAXPATHLEN, rc)))
+      {cksWErr->Emsg("CksSave", rc, "save checksum for", path); return;}
+   if ((rc = cksWMgr->Set(pfn, cksData)))
+      cksWErr->Emsg("CksSave", rc, "save checksum for", path);
+}
+
+/******************************************************************************/
+/*                               S e t N a m e                                */
+/******************************************************************************/
+  
+void XrdOfsCksWrite::SetName(const char *csName)
+{
+   if (cksWName) free(cksWName);
+   cksWName = (csName && *csName ? strdup(csName) : 0);
+}
+
+/******************************************************************************/
+/*                                 S t a r t                                  */
+/******************************************************************************/
+  
+void XrdOfsCksWrite::Start(XrdOfsHandle *hP)
+{
+   XrdSysMutexHelper cksMon(cksWMutex);
+   CksWTab::iterator it;
+   XrdCksCalc *csP;
+
+// The file starts out empty, so any previous checksum no longer applies
+//
+   if ((it = cksWTab.find(hP)) != cksWTab.end()) Drop(it);
+   if ((csP = cksWMgr->Object(cksWName)))
+      {CksWInfo &cwInfo = cksWTab[hP];
+       cwInfo.csP  = csP;
+       cwInfo.next = 0;
+      }
+}
+
+/******************************************************************************/
+/*                                U p d a t e                                 */
+/******************************************************************************/
+  
+bool XrdOfsCksWrite::Update(XrdOfsHandle *hP, long long offset,
+                            const char *buff, int blen)
+{
+   CksWTab::iterator it;
+   CksWInfo *cwP;
+
+// Data written at the end of what has been checksummed so far is added to the
+// checksum. Anything else (a hole, an overwrite, a truncate other than at the
+// end, or a failed write) ends it and the checksum will be calculated from the
+// file when asked for. A nil buffer only checks the offset. The table mutex
+// is only held for the lookup as the handle lock serializes the entry.
+//
+   hP->Lock();
+   cksWMutex.Lock();
+   if ((it = cksWTab.find(hP)) == cksWTab.end())
+      {cksWMutex.UnLock(); hP->UnLock(); return false;}
+   if (offset != it->second.next)
+      {Drop(it); cksWMutex.UnLock(); hP->UnLock(); return true;}
+   cwP = &(it->second);
+   cksWMutex.UnLock();
+
+   if (buff && blen > 0) {cwP->csP->Update(buff, blen); cwP->next += blen;}
+   hP->UnLock();
+   return true;
+}
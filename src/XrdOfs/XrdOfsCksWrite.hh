@@ -0,0 +1,61 @@
+#ifndef __OFSCKSWRITE_H__
+#define __OFSCKSWRITE_H__
+/******************************************************************************/
+/*                                                                            */
+/*                     X r d O f s C k s W r i t e . h h                      */
+/*                                                                            */
+/* (c) 2026 by the contributors to the XRootD software suite                  */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+class XrdCks;
+class XrdCksCalc;
+class XrdOfsHandle;
+class XrdOss;
+class XrdSysError;
+
+// This class keeps the checksum of a file that is being written in order from
+// its start. The state is kept per handle but outside of the handle itself.
+// Start() and End() must be called with the handle locked, Update() locks it.
+//
+class XrdOfsCksWrite
+{
+public:
+
+static XrdCksCalc *End(XrdOfsHandle *hP);
+
+static bool        Init(XrdSysError *eP, XrdOss *oP, XrdCks *cP, bool usePfn);
+
+static const char *Name();
+
+static void        Save(const char *path, XrdCksCalc *csP);
+
+static void        SetName(const char *csName);
+
+static void        Start(XrdOfsHandle *hP);
+
+static bool        Update(XrdOfsHandle *hP, long long offset,
+                          const char *buff, int blen);
+
+static bool        Active(XrdOfsHandle *hP);
+};
+#endif
@@ -44,6 +44,7 @@
 #include "XrdCks/XrdCks.hh"
 
 #include "XrdOfs/XrdOfs.hh"
+#include "XrdOfs/XrdOfsCksWrite.hh"
 #include "XrdOfs/XrdOfsConfigPI.hh"
 #include "XrdOfs/XrdOfsEvs.hh"
 #include "XrdOfs/XrdOfsPoscq.hh"
@@ -256,6 +257,16 @@ int XrdOfs::Configure(XrdSysError &Eroute, XrdOucEnv *EnvInfo) {
                }
            }
 
+// If checksums are to be computed as files are written, make sure that we
+// can actually compute the wanted checksum.
+//
+   if (CksWrite && !NoGo
+   &&  !XrdOfsCksWrite::Init(&Eroute, XrdOfsOss, Cks, CksPfn))
+      {Eroute.Say("Config warning: ckswrite ignored; ",
+                  XrdOfsCksWrite::Name(), " checksum is not configured.");
+       CksWrite = 0;
+      }
+
 // Initialize redirection.  We type te herald here to minimize confusion
 //
    if (Options & haveRole)
@@ -341,6 +352,8 @@ void XrdOfs::Config_Display(XrdSysError &Eroute)
                (poscLog ? poscLog    : ""), OfsTrace.What);
 
      Eroute.Say(buff);
+     if (CksWrite)
+        Eroute.Say("       ofs.ckswrite   ", XrdOfsCksWrite::Name());
      ofsConfig->Display();
 
      if (Options & Forwarding)
@@ -578,6 +591,7 @@ int XrdOfs::ConfigXeq(char *var, XrdOucStream &Config,
     TS_XPI("authlib",       theAutLib);
     TS_XPI("ckslib",        theCksLib);
     TS_Xeq("cksrdsz",       xcrds);
+    TS_Xeq("ckswrite",      xcksw);
     TS_XPI("cmslib",        theCmsLib);
     TS_Xeq("forward",       xforward);
     TS_Xeq("maxdelay",      xmaxd);
@@ -641,6 +655,38 @@ int XrdOfs::xcrds(XrdOucStream &Config, XrdSysError &Eroute)
    return 0;
 }
   
+/******************************************************************************/
+/*                                 x c k s w                                  */
+/******************************************************************************/
+  
+/* Function: xcksw
+
+   Purpose:  To parse the directive: ckswrite [<ckname>]
+
+             <ckname> the checksum to compute as files are written. The
+                      default is the default checksum. The checksum is
+                      computed only for files written in order from the start
+                      and is saved in the file's extended attributes when the
+                      file is closed. Otherwise, it is calculated from the
+                      file when first asked for. This is always so for files
+                      written by in-process third party copies (tpc inproc)
+                      as they bypass the ofs write path.
+
+  Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdOfs::xcksw(XrdOucStream &Config, XrdSysError &Eroute)
+{
+   char *val;
+
+// Get the optional checksum name
+//
+   val = Config.GetWord();
+   XrdOfsCksWrite::SetName(val);
+   CksWrite = 1;
+   return 0;
+}
+
 /******************************************************************************/
 /*                                  x e x p                                   */
 /******************************************************************************/
@@ -1188,7 +1234,8 @@ int XrdOfs::xrole(XrdOucStream &Config, XrdSysError &Eroute)
                                          [require {all|client|dest} <auth>[+]]
                                          [restrict <path>] [streams <num>]
                                          [echo] [scan {stderr | stdout}]
-                                         [autorm] [pgm <path> [parms]]
+                                         [autorm] [inproc] [chunk <sz>]
+                                         [pgm <path> [parms]]
 
              parms: [dn <name>] [group <grp>] [host <hn>] [vo <vo>]
 
@@ -1199,7 +1246,9 @@ int XrdOfs::xrole(XrdOucStream &Config, XrdSysError &Eroute)
              allow   only allow destinations that match the specified
                      authentication specification.
              <n>     maximum number of simultaneous transfers.
-             <num>   the number of TCP streams to use for the copy.
+             <num>   the number of TCP streams to use for the copy. For
+                     in-process copies this is the default and the maximum
+                     that the client may ask for using tpc.str.
              <auth>  require that the client, destination, or both (i.e. all)
                      use the specified authentication protocol. Additional
                      require statements may be specified to add additional
@@ -1208,6 +1257,13 @@ int XrdOfs::xrole(XrdOucStream &Config, XrdSysError &Eroute)
                      the authentication's session key.
              echo    echo the pgm's output to the log.
              autorm  Remove file when copy fails.
+             inproc  copy using the in-process engine in libXrdOfsTPCXfr.so
+                     instead of running the transfer command. The engine
+                     writes the destination directly through the oss, so
+                     ofs.ckswrite does not apply to these copies. Use cksum
+                     to have them verified against the source instead.
+             <sz>    the size of each read from the source for in-process
+                     copies. The default is 8m.
              scan    scan fr error messages either in stderr or stdout. The
                      default is to scan both.
              pgm     specifies the transfer command with optional paramaters.
@@ -1246,6 +1302,16 @@ int XrdOfs::xtpc(XrdOucStream &Config, XrdSysError &Eroute)
          if (!strcmp(val, "echo"))  {Parms.xEcho = 1; continue;}
          if (!strcmp(val, "logok")) {Parms.Logok = 1; continue;}
          if (!strcmp(val, "autorm")){Parms.autoRM = 1; continue;}
+         if (!strcmp(val, "inproc")){Parms.inProc = 1; continue;}
+         if (!strcmp(val, "chunk"))
+            {long long csz;
+             if (!(val = Config.GetWord()))
+                {Eroute.Emsg("Config","tpc chunk value not specified"); return 1;}
+             if (XrdOuca2x::a2sz(Eroute,"tpc chunk",val,&csz,
+                                 64*1024, 256*1024*1024)) return 1;
+             Parms.Chunk = static_cast<int>(csz);
+             continue;
+            }
          if (!strcmp(val, "pgm"))
             {if (!Config.GetRest(pgm, sizeof(pgm)))
                 {Eroute.Emsg("Config", "tpc command line too long"); return 1;}
@@ -55,6 +55,10 @@ int         numTPCgrant;
 int         numTPCdeny;
 int         numTPCerrs;
 int         numTPCexpr;
+int         numTPCxfr;  // In-process copies
+int         numTPCstrm; // Streams used by them
+long long   tpcBytes;   // Bytes copied by them
+long long   tpcStrmMs;  // Milliseconds their streams were busy
 }           Data;
 
 XrdSysMutex sdMutex;
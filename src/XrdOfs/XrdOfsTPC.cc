@@ -68,11 +68,13 @@ char              *cksType  = 0;
 int                LogOK    = 0;
 int                nStrms   = 0;
 int                xfrMax   = 9;
+int                xfrChunk = 8*1024*1024;
 int                tpcOK    = 0;
 int                encTPC   = 0;
 int                errMon   =-3;
 bool               doEcho   = false;
 bool               autoRM   = false;
+bool               inProc   = false;
 };
 
 using namespace XrdOfsTPCParms;
@@ -360,6 +362,8 @@ void XrdOfsTPC::Init(XrdOfsTPC::iParm &Parms)
    if (Parms.Grab   <  0) errMon = Parms.Grab;
    if (Parms.xEcho  >= 0) doEcho = Parms.xEcho != 0;
    if (Parms.autoRM >= 0) autoRM = Parms.autoRM != 0;
+   if (Parms.Chunk  >  0) xfrChunk = Parms.Chunk;
+   if (Parms.inProc >= 0) inProc = Parms.inProc != 0;
 }
 
 /******************************************************************************/
@@ -483,9 +487,10 @@ int XrdOfsTPC::Validate(XrdOfsTPC **theTPC, XrdOfsTPC::Facts &Args)
    const char *tpcLfn = Args.Env->Get(XrdOucTPC::tpcLfn);
    const char *tpcSrc = Args.Env->Get(XrdOucTPC::tpcSrc);
    const char *tpcCks = Args.Env->Get(XrdOucTPC::tpcCks);
+   const char *tpcStr = Args.Env->Get(XrdOucTPC::tpcStr);
    const char *theCGI;
          char  Buff[512], myURL[4096];
-         int   n, doRN = 0, myURLen = sizeof(myURL);
+         int   n, doRN = 0, myURLen = sizeof(myURL), nStr;
          short lfnLoc[2];
 
 // Determine if we can handle any TPC requests
@@ -521,11 +526,22 @@ int XrdOfsTPC::Validate(XrdOfsTPC **theTPC, XrdOfsTPC::Facts &Args)
    theCGI = XrdOucTPC::cgiD2Src(Args.Key, Buff, myURL+n, myURLen-n);
    if (*theCGI == '!') return Fatal(Args, theCGI+1, EINVAL);
 
+// The number of streams to use is what was asked for but no more than what
+// was configured, which is also the default.
+//
+   nStr = (nStrms > 1 ? nStrms : 1);
+   if (tpcStr)
+      {char *ePtr;
+       n = strtol(tpcStr, &ePtr, 10);
+       if (n <= 0 || *ePtr) return Fatal(Args, "invalid tpc streams", EINVAL);
+       if (n < nStr) nStr = n;
+      }
+
 // Create a pseudo tpc object that will contain the information we need to
 // actually peform this copy.
 //
    if (!(myTPC = new XrdOfsTPCJob(myURL, Args.Usr->tident,
-                                  Args.Lfn, Args.Pfn, tpcCks, lfnLoc)))
+                                  Args.Lfn, Args.Pfn, tpcCks, lfnLoc, nStr)))
       return Fatal(Args, "insufficient memory", ENOMEM);
 
 // All done
@@ -82,9 +82,11 @@ struct  iParm {char *Pgm;
                int   Grab;
                int   xEcho;
                int   autoRM;
+               int   Chunk;
+               int   inProc;
                      iParm() : Pgm(0), Ckst(0), Dflttl(-1), Maxttl(-1),
                                Logok(-1), Strm(-1), Xmax(-1), Grab(0), 
-                               xEcho(-1), autoRM(-1) {}
+                               xEcho(-1), autoRM(-1), Chunk(-1), inProc(-1) {}
               };
 
 static  void  Init(iParm &Parms);
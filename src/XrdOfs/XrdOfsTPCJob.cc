@@ -55,9 +55,9 @@ XrdOfsTPCJob      *XrdOfsTPCJob::jobLast  = 0;
   
 XrdOfsTPCJob::XrdOfsTPCJob(const char *Url, const char *Org,
                            const char *Lfn, const char *Pfn,
-                           const char *Cks, short lfnLoc[2])
+                           const char *Cks, short lfnLoc[2], int Strm)
                           : XrdOfsTPC(Url, Org, Lfn, Pfn, Cks), myProg(0),
-                            Status(isWaiting)
+                            Status(isWaiting), nStrm(Strm)
 {  lfnPos[0] = lfnLoc[0]; lfnPos[1] = lfnLoc[1]; }
   
 /******************************************************************************/
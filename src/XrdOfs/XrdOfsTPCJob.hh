@@ -43,11 +43,13 @@ void          Del();
 
 XrdOfsTPCJob *Done(XrdOfsTPCProg *pgmP, const char *eTxt, int rc);
 
+int           Streams() {return nStrm;}
+
 int           Sync(XrdOucErrInfo *eRR);
 
               XrdOfsTPCJob(const char *Url, const char *Org,
                            const char *Lfn, const char *Pfn,
-                           const char *Cks, short lfnLoc[2]);
+                           const char *Cks, short lfnLoc[2], int Strm=1);
 
              ~XrdOfsTPCJob() {}
 
@@ -61,5 +63,6 @@ static XrdOfsTPCJob      *jobLast;
 enum   jobStat {isWaiting, isRunning, isDone};
        jobStat            Status;
        short              lfnPos[2];
+       int                nStrm;
 };
 #endif
@@ -28,36 +28,49 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <fcntl.h>
 #include <stdio.h>
+#include <string.h>
 #include <strings.h>
   
+#include "XrdOfs/XrdOfsStats.hh"
 #include "XrdOfs/XrdOfsTPC.hh"
 #include "XrdOfs/XrdOfsTPCJob.hh"
 #include "XrdOfs/XrdOfsTPCProg.hh"
+#include "XrdOfs/XrdOfsTPCXfr.hh"
 #include "XrdOfs/XrdOfsTrace.hh"
 #include "XrdOss/XrdOss.hh"
 #include "XrdOuc/XrdOucCallBack.hh"
+#include "XrdOuc/XrdOucEnv.hh"
+#include "XrdOuc/XrdOucPinLoader.hh"
 #include "XrdOuc/XrdOucProg.hh"
 #include "XrdOuc/XrdOucTrace.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysHeaders.hh"
+#include "XrdVersion.hh"
 
 /******************************************************************************/
 /*                        G l o b a l   O b j e c t s                         */
 /******************************************************************************/
   
 extern XrdSysError  OfsEroute;
+extern XrdOfsStats  OfsStats;
 extern XrdOucTrace  OfsTrace;
 extern XrdOss      *XrdOfsOss;
 
+XrdVERSIONINFOREF(XrdOfs);
+
 namespace XrdOfsTPCParms
 {
 extern char        *XfrProg;
 extern char        *cksType;
+extern int          nStrms;
 extern int          xfrMax;
+extern int          xfrChunk;
 extern int          errMon;
 extern bool         doEcho;
 extern bool         autoRM;
+extern bool         inProc;
 };
 
 using namespace XrdOfsTPCParms;
@@ -87,24 +100,120 @@ void *XrdOfsTPCProgRun(void *pp)
 XrdOfsTPCProg::XrdOfsTPCProg(XrdOfsTPCProg *Prev, int num, int errMon)
              : Prog(&OfsEroute, errMon),
                JobStream(&OfsEroute),
-               Next(Prev), Job(0)
+               Next(Prev), Job(0), Engine(0)
              {snprintf(Pname, sizeof(Pname), "TPC job %d: ", num);
               Pname[sizeof(Pname)-1] = 0;
              }
 
+/******************************************************************************/
+/*                                C a n c e l                                 */
+/******************************************************************************/
+
+void XrdOfsTPCProg::Cancel()
+{
+   if (Engine) Engine->Cancel();
+      else JobStream.Drain();
+}
+
+/******************************************************************************/
+/* Private:                         C o p y                                   */
+/******************************************************************************/
+  
+int XrdOfsTPCProg::Copy()
+{
+   EPNAME("Copy");
+   const char *tident = Job->Info.Org;
+   XrdOfsTPCXfr::Parms Parms;
+   XrdOfsTPCXfr::Stats Stats;
+   XrdOssDF  *dstFile;
+   XrdOucEnv  dstEnv;
+   long long sUsec = 0;
+   int i, n, rc;
+
+// Describe the copy. The source url is in the key and the requester is the org
+//
+   Parms.Src     = Job->Info.Key;
+   Parms.Cks     = (Job->Info.Cks ? Job->Info.Cks : XrdOfsTPCParms::cksType);
+   Parms.Tident  = tident;
+   Parms.Streams = Job->Streams();
+
+// Open the destination through the oss and do the copy. Since the ofs is
+// bypassed, ofs.ckswrite never sees the data and no checksum is saved for
+// the file at close; it will be calculated when first asked for.
+//
+   *eRec = 0;
+   memset(&Stats, 0, sizeof(Stats));
+   dstFile = XrdOfsOss->newFile(tident);
+   if ((rc = dstFile->Open(Job->Info.Lfn, O_WRONLY, 0, dstEnv)))
+      {rc = -rc;
+       snprintf(eRec, sizeof(eRec), "Copy failed; unable to open "
+                "destination; %s", strerror(rc));
+      } else {
+       rc = Engine->Copy(Parms, *dstFile, Stats, eRec, sizeof(eRec));
+       if ((n = dstFile->Close()) && !rc)
+          {rc = -n;
+           snprintf(eRec, sizeof(eRec), "Copy failed; unable to close "
+                    "destination; %s", strerror(rc));
+          }
+      }
+   delete dstFile;
+   DEBUG(Pname <<"ended with rc=" <<rc);
+
+// Account for the copy. Per-stream throughput is the bytes over the time the
+// streams were busy.
+//
+   for (i = 0; i < Stats.Streams; i++) sUsec += Stats.sUsec[i];
+   OfsStats.sdMutex.Lock();
+   OfsStats.Data.numTPCxfr++;
+   OfsStats.Data.numTPCstrm += Stats.Streams;
+   OfsStats.Data.tpcBytes   += Stats.Bytes;
+   OfsStats.Data.tpcStrmMs  += sUsec/1000;
+   OfsStats.sdMutex.UnLock();
+
+// Echo out how the streams did, if so wanted
+//
+   if (doEcho)
+      {char sBuff[XrdOfsTPCXfr::maxStreams*16+128];
+       n = snprintf(sBuff, sizeof(sBuff), "%lld bytes in %.3f sec using %d "
+                    "stream(s) at %.1f MB/s; per stream MB/s:", Stats.Bytes,
+                    Stats.Usec/1000000.0, Stats.Streams,
+                    (Stats.Usec ? double(Stats.Bytes)/Stats.Usec : 0.0));
+       for (i = 0; i < Stats.Streams && n < (int)sizeof(sBuff); i++)
+           n += snprintf(sBuff+n, sizeof(sBuff)-n, " %.1f", (Stats.sUsec[i]
+                    ? double(Stats.sBytes[i])/Stats.sUsec[i] : 0.0));
+       OfsEroute.Say(Pname, "copied ", sBuff);
+      }
+   return rc;
+}
+
 /******************************************************************************/
 /*                                  I n i t                                   */
 /******************************************************************************/
   
 int XrdOfsTPCProg::Init()
 {
+   XrdOfsTPCGetXfr_t getXfr = 0;
    int n;
 
+// If copies are done in-process, load the copy engine
+//
+   if (inProc)
+      {XrdOucPinLoader myLib(&OfsEroute, &XrdVERSIONINFOVAR(XrdOfs),
+                             "tpc inproc", "libXrdOfsTPCXfr.so");
+       if (!(getXfr = (XrdOfsTPCGetXfr_t)myLib.Resolve("XrdOfsTPCGetXfr")))
+          return 0;
+      }
+
 // Allocate copy program objects
 //
    for (n = 0; n < xfrMax; n++)
        {pgmIdle = new XrdOfsTPCProg(pgmIdle, n, errMon);
-        if (pgmIdle->Prog.Setup(XfrProg, &OfsEroute)) return 0;
+        if (getXfr)
+           {if (!(pgmIdle->Engine = getXfr(&OfsEroute,
+                                           (nStrms > 1 ? nStrms : 1),
+                                           xfrChunk))) return 0;
+           }
+           else if (pgmIdle->Prog.Setup(XfrProg, &OfsEroute)) return 0;
        }
 
 // All done
@@ -184,6 +293,17 @@ int XrdOfsTPCProg::Xeq()
        if (Quest) *Quest = '?';
       }
 
+// Copy in-process if so configured
+//
+   if (Engine)
+      {if ((rc = Copy()))
+          {if (!(*eRec)) sprintf(eRec, "Copy failed with return code %d", rc);
+           OfsEroute.Emsg("TPC", Job->Info.Org, Job->Info.Lfn, eRec);
+           if (autoRM) XrdOfsOss->Unlink(Job->Info.Dst, XRDOSS_isPFN);
+          }
+       return rc;
+      }
+
 // Determine checksum option
 //
    cksVal = (Job->Info.Cks ? Job->Info.Cks : XrdOfsTPCParms::cksType);
@@ -35,13 +35,14 @@
 #include "XrdSys/XrdSysPthread.hh"
   
 class XrdOfsTPCJob;
+class XrdOfsTPCXfr;
 class XrdOucProg;
   
 class XrdOfsTPCProg
 {
 public:
 
-       void      Cancel() {JobStream.Drain();}
+       void      Cancel();
 
 static int       Init();
 
@@ -57,6 +58,8 @@ XrdOfsTPCProg   *Start(XrdOfsTPCJob *jP, int &rc);
                 ~XrdOfsTPCProg() {}
 private:
 
+       int            Copy();
+
 static XrdSysMutex    pgmMutex;
 static XrdOfsTPCProg *pgmIdle;
 
@@ -64,6 +67,7 @@ static XrdOfsTPCProg *pgmIdle;
        XrdOucStream   JobStream;
        XrdOfsTPCProg *Next;
        XrdOfsTPCJob  *Job;
+       XrdOfsTPCXfr  *Engine;
        char           Pname[32];
        char           eRec[1024];
 };
@@ -0,0 +1,120 @@
+#ifndef __XRDOFSTPCXFR_HH__
+#define __XRDOFSTPCXFR_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                       X r d O f s T P C X f r . h h                        */
+/*                                                                            */
+/* (c) 2026 by the contributors to the XRootD software suite                  */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+class XrdOssDF;
+class XrdSysError;
+
+//------------------------------------------------------------------------------
+//! The XrdOfsTPCXfr class defines the interface to an in-process third party
+//! copy engine. When "ofs.tpc inproc" is specified, each transfer slot gets
+//! one of these objects instead of running the copy program. The engine reads
+//! the source using the specified number of streams and writes the data, in
+//! order, to the destination file which the caller has opened through the
+//! oss. Copy() is only called by
+//! the thread running the transfer while Cancel() may be called by any thread.
+//------------------------------------------------------------------------------
+
+class XrdOfsTPCXfr
+{
+public:
+
+static const int maxStreams = 16;
+
+//------------------------------------------------------------------------------
+//! Describe a copy.
+//------------------------------------------------------------------------------
+
+struct Parms
+      {const char *Src;      //!< Source URL including the tpc cgi
+       const char *Cks;      //!< Checksum <type>[:{<value>|source|print}] as
+                             //!< for xrdcp or nil
+       const char *Tident;   //!< Trace identifier of the requester
+       int         Streams;  //!< Number of streams to use (1 to maxStreams)
+      };
+
+//------------------------------------------------------------------------------
+//! Describe how a copy went. Stream throughput is the bytes a stream received
+//! over the time it had a read outstanding.
+//------------------------------------------------------------------------------
+
+struct Stats
+      {long long Bytes;                  //!< Bytes written to the destination
+       long long Usec;                   //!< Elapsed time of the copy
+       long long sBytes[maxStreams];     //!< Bytes received by each stream
+       long long sUsec[maxStreams];      //!< Time each stream was busy
+       int       Streams;                //!< Number of streams used
+      };
+
+//------------------------------------------------------------------------------
+//! Cancel the copy in progress, if any. The copy ends with ECANCELED.
+//------------------------------------------------------------------------------
+
+virtual void Cancel() = 0;
+
+//------------------------------------------------------------------------------
+//! Perform a copy.
+//!
+//! @param  parms  The description of the copy.
+//! @param  dst    The destination file opened for writing.
+//! @param  stats  Where the statistics of the copy are returned.
+//! @param  eBuff  Where the reason for a failure is placed.
+//! @param  eBlen  The size of eBuff.
+//!
+//! @return 0 upon success or the errno describing the failure.
+//------------------------------------------------------------------------------
+
+virtual int  Copy(const Parms &parms, XrdOssDF &dst, Stats &stats,
+                  char *eBuff, int eBlen) = 0;
+
+             XrdOfsTPCXfr() {}
+virtual     ~XrdOfsTPCXfr() {}
+};
+
+/******************************************************************************/
+/*                       X r d O f s T P C G e t X f r                        */
+/******************************************************************************/
+
+//------------------------------------------------------------------------------
+//! Obtain an instance of a copy engine. This function is defined by the shared
+//! library named libXrdOfsTPCXfr.so which is loaded when in-process copies are
+//! configured. The function is called once for each transfer slot.
+//!
+//! @param  eDest      Where messages are to be routed.
+//! @param  maxStrm    The maximum number of streams that will be requested.
+//! @param  chunkSize  The size of each read from the source.
+//!
+//! @return Pointer to the engine or nil upon failure.
+//!
+//! extern "C" XrdOfsTPCXfr *XrdOfsTPCGetXfr(XrdSysError *eDest,
+//!                                          int maxStrm, int chunkSize);
+//------------------------------------------------------------------------------
+
+typedef XrdOfsTPCXfr *(*XrdOfsTPCGetXfr_t)(XrdSysError *eDest,
+                                           int maxStrm, int chunkSize);
+#endif
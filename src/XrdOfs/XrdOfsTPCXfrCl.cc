@@ -0,0 +1,444 @@
+/******************************************************************************/
+/*                                                                            */
+/*                     X r d O f s T P C X f r C l . c c                      */
+/*                                                                            */
+/* (c) 2026 by the contributors to the XRootD software suite                  */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+
+#include <string>
+
+#include "XProtocol/XProtocol.hh"
+#include "XrdCks/XrdCksCalc.hh"
+#include "XrdCks/XrdCksData.hh"
+#include "XrdCks/XrdCksLoader.hh"
+#include "XrdCl/XrdClBuffer.hh"
+#include "XrdCl/XrdClDefaultEnv.hh"
+#include "XrdCl/XrdClFile.hh"
+#include "XrdCl/XrdClFileSystem.hh"
+#include "XrdCl/XrdClURL.hh"
+#include "XrdOfs/XrdOfsTPCXfr.hh"
+#include "XrdOss/XrdOss.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysPthread.hh"
+#include "XrdVersion.hh"
+
+/******************************************************************************/
+/*                         V e r s i o n   I n f o                            */
+/******************************************************************************/
+
+XrdVERSIONINFO(XrdOfsTPCGetXfr,XrdOfsTPCXfr);
+
+/******************************************************************************/
+/*                       L o c a l   F u n c t i o n s                        */
+/******************************************************************************/
+
+namespace
+{
+long long Now()
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ts.tv_sec*1000000LL + ts.tv_nsec/1000;
+}
+
+int Status2Errno(const XrdCl::XRootDStatus &st)
+{
+   if (st.code == XrdCl::errErrorResponse) return XProtocol::toErrno(st.errNo);
+   return (st.code == XrdCl::errOperationExpired ? ETIMEDOUT : ECOMM);
+}
+}
+
+/******************************************************************************/
+/*                   C l a s s   X r d O f s T P C X f r C l                  */
+/******************************************************************************/
+
+class XrdOfsTPCXfrCl : public XrdOfsTPCXfr
+{
+public:
+
+void Cancel();
+
+int  Copy(const Parms &parms, XrdOssDF &dst, Stats &stats,
+          char *eBuff, int eBlen);
+
+     XrdOfsTPCXfrCl(XrdSysError *eP, int csz)
+                   : cksLoader(XrdVERSIONINFOVAR(XrdOfsTPCGetXfr)),
+                     xfrCV(0), eDest(eP), curStats(0),
+                     chunkSz(csz), inFlight(0), isCancelled(false) {}
+
+    ~XrdOfsTPCXfrCl() {}
+
+private:
+
+// Each stream has one read outstanding at a time into its own buffer
+//
+class Slot : public XrdCl::ResponseHandler
+{
+public:
+
+void            HandleResponse(XrdCl::XRootDStatus *status,
+                               XrdCl::AnyObject    *response);
+
+XrdOfsTPCXfrCl *Xfr;
+char           *Buff;
+long long       Begin;    // When the read was issued
+int             Blen;     // Bytes requested
+int             Rlen;     // Bytes received or -errno
+int             Num;      // Stream number
+bool            isDone;
+
+                Slot() : Xfr(0), Buff(0), Begin(0), Blen(0), Rlen(0),
+                         Num(0), isDone(false) {}
+               ~Slot() {if (Buff) delete [] Buff;}
+};
+
+int   Fail(char *eBuff, int eBlen, const char *what, int rc);
+int   Fail(char *eBuff, int eBlen, const char *what,
+           const XrdCl::XRootDStatus &st);
+int   Issue(XrdCl::File &src, Slot &sP, long long offset, long long fSize,
+            char *eBuff, int eBlen);
+int   Move(XrdCl::File &src, XrdOssDF &dst, XrdCksCalc *csP,
+           long long fSize, Stats &stats, char *eBuff, int eBlen);
+int   Verify(const Parms &parms, XrdCksCalc *csP, char *eBuff, int eBlen);
+
+XrdCksLoader   cksLoader;
+XrdSysCondVar  xfrCV;
+XrdSysError   *eDest;
+Stats         *curStats;
+int            chunkSz;
+int            inFlight;
+bool           isCancelled;
+};
+
+/******************************************************************************/
+/*                        H a n d l e R e s p o n s e                         */
+/******************************************************************************/
+
+void XrdOfsTPCXfrCl::Slot::HandleResponse(XrdCl::XRootDStatus *status,
+                                          XrdCl::AnyObject    *response)
+{
+   XrdCl::ChunkInfo *ciP = 0;
+   int rlen;
+
+// Get the result of the read
+//
+   if (!status->IsOK()) rlen = -Status2Errno(*status);
+      else {if (response) response->Get(ciP);
+            rlen = (ciP ? static_cast<int>(ciP->length) : 0);
+           }
+   delete status;
+   if (response) delete response;
+
+// Post it and account for the time the stream was busy
+//
+   Xfr->xfrCV.Lock();
+   Rlen = rlen; isDone = true; Xfr->inFlight--;
+   Xfr->curStats->sUsec[Num] += Now() - Begin;
+   if (rlen > 0) Xfr->curStats->sBytes[Num] += rlen;
+   Xfr->xfrCV.Broadcast();
+   Xfr->xfrCV.UnLock();
+}
+
+/******************************************************************************/
+/*                                C a n c e l                                 */
+/******************************************************************************/
+
+void XrdOfsTPCXfrCl::Cancel()
+{
+   xfrCV.Lock();
+   isCancelled = true;
+   xfrCV.Broadcast();
+   xfrCV.UnLock();
+}
+
+/******************************************************************************/
+/*                                  C o p y                                   */
+/******************************************************************************/
+
+int XrdOfsTPCXfrCl::Copy(const Parms &parms, XrdOssDF &dst, Stats &stats,
+                         char *eBuff, int eBlen)
+{
+   XrdCl::File         srcFile;
+   XrdCl::StatInfo    *sInfo = 0;
+   XrdCl::XRootDStatus st;
+   XrdCksCalc         *csP = 0;
+   long long           tBeg = Now();
+   int                 n, rc;
+
+// Reset for this copy. The cancel flag is left alone as the copy may have
+// been cancelled before it got here.
+//
+   memset(&stats, 0, sizeof(stats));
+   stats.Streams = (parms.Streams < 1 ? 1 : parms.Streams);
+   if (stats.Streams > maxStreams) stats.Streams = maxStreams;
+   xfrCV.Lock();
+   inFlight = 0; curStats = &stats;
+   xfrCV.UnLock();
+
+// Get a checksum object should we need to verify the copy. The checksum is
+// computed as the data is written since it is written in order.
+//
+   if (parms.Cks)
+      {char csName[32];
+       n = strcspn(parms.Cks, ":");
+       if (n >= (int)sizeof(csName)) n = sizeof(csName)-1;
+       strncpy(csName, parms.Cks, n); csName[n] = 0;
+       if (!(csP = cksLoader.Load(csName)))
+          {snprintf(eBuff, eBlen, "Copy failed; %s checksum not supported.",
+                    csName);
+           return ENOTSUP;
+          }
+      }
+
+// Open the source and find out how much there is to copy
+//
+        if (!(st = srcFile.Open(parms.Src, XrdCl::OpenFlags::Read)).IsOK())
+           rc = Fail(eBuff, eBlen, "open source", st);
+   else if (!(st = srcFile.Stat(false, sInfo)).IsOK())
+           rc = Fail(eBuff, eBlen, "stat source", st);
+
+// Move the data
+//
+   else {long long fSize = sInfo->GetSize();
+         delete sInfo;
+         rc = Move(srcFile, dst, csP, fSize, stats, eBuff, eBlen);
+        }
+
+// Close the source and verify the checksum if all went well
+//
+   if (srcFile.IsOpen()) st = srcFile.Close();
+   if (!rc && csP) rc = Verify(parms, csP, eBuff, eBlen);
+   if (csP) csP->Recycle();
+
+// All done. A cancel only applies to the copy it was meant for as this
+// engine is reused for the next copy in its slot.
+//
+   xfrCV.Lock();
+   isCancelled = false;
+   xfrCV.UnLock();
+   stats.Usec = Now() - tBeg;
+   return rc;
+}
+
+/******************************************************************************/
+/*                                  F a i l                                   */
+/******************************************************************************/
+
+int XrdOfsTPCXfrCl::Fail(char *eBuff, int eBlen, const char *what, int rc)
+{
+   if (rc == ECANCELED) snprintf(eBuff, eBlen, "Copy cancelled.");
+      else snprintf(eBuff, eBlen, "Copy failed; unable to %s; %s",
+                    what, strerror(rc));
+   return rc;
+}
+
+/******************************************************************************/
+
+int XrdOfsTPCXfrCl::Fail(char *eBuff, int eBlen, const char *what,
+                         const XrdCl::XRootDStatus &st)
+{
+   snprintf(eBuff, eBlen, "Copy failed; unable to %s; %s",
+            what, st.ToStr().c_str());
+   return Status2Errno(st);
+}
+
+/******************************************************************************/
+/*                                 I s s u e                                  */
+/******************************************************************************/
+
+int XrdOfsTPCXfrCl::Issue(XrdCl::File &src, Slot &sP, long long offset,
+                          long long fSize, char *eBuff, int eBlen)
+{
+   XrdCl::XRootDStatus st;
+
+// Setup the read for the next chunk
+//
+   sP.Blen   = (fSize - offset < chunkSz ? fSize - offset : chunkSz);
+   sP.isDone = false;
+   xfrCV.Lock();
+   inFlight++; sP.Begin = Now();
+   xfrCV.UnLock();
+
+// Start the read, the response handler accounts for it upon success
+//
+   if (!(st = src.Read(offset, sP.Blen, sP.Buff, &sP)).IsOK())
+      {xfrCV.Lock(); inFlight--; xfrCV.UnLock();
+       return Fail(eBuff, eBlen, "read source", st);
+      }
+   return 0;
+}
+
+/******************************************************************************/
+/*                                  M o v e                                   */
+/******************************************************************************/
+
+int XrdOfsTPCXfrCl::Move(XrdCl::File &src, XrdOssDF &dst, XrdCksCalc *csP,
+                         long long fSize, Stats &stats,
+                         char *eBuff, int eBlen)
+{
+   Slot slot[maxStreams];
+   long long rdOff = 0, wrOff = 0;
+   int i, n, rc = 0, nStrm = stats.Streams;
+
+// Start a read on each stream. Chunk k is always read by stream k % nStrm so
+// that chunks can be written in order as they come in.
+//
+   for (i = 0; i < nStrm; i++)
+       {slot[i].Xfr = this; slot[i].Num = i;
+        slot[i].Buff = new char[chunkSz];
+       }
+   for (i = 0; i < nStrm && rdOff < fSize; i++)
+       {if ((rc = Issue(src, slot[i], rdOff, fSize, eBuff, eBlen))) break;
+        rdOff += slot[i].Blen;
+       }
+
+// Write each chunk when it arrives and have its stream read the next one
+//
+   for (i = 0; !rc && wrOff < fSize; i = (i+1) % nStrm)
+       {Slot &sP = slot[i];
+        xfrCV.Lock();
+        while(!sP.isDone && !isCancelled) xfrCV.Wait();
+        n = (isCancelled ? -ECANCELED : sP.Rlen);
+        xfrCV.UnLock();
+        if (n < 0) {rc = Fail(eBuff, eBlen, "read source", -n); break;}
+        if (n != sP.Blen)
+           {rc = Fail(eBuff, eBlen, "read source", ENODATA); break;}
+        if ((n = dst.Write(sP.Buff, wrOff, sP.Blen)) != sP.Blen)
+           {rc = Fail(eBuff, eBlen, "write destination", (n < 0 ? -n : EIO));
+            break;
+           }
+        if (csP) csP->Update(sP.Buff, sP.Blen);
+        wrOff += sP.Blen; stats.Bytes = wrOff;
+        if (rdOff < fSize)
+           {if ((rc = Issue(src, sP, rdOff, fSize, eBuff, eBlen))) break;
+            rdOff += sP.Blen;
+           }
+       }
+
+// Wait for any reads still outstanding as they refer to our buffers
+//
+   xfrCV.Lock();
+   while(inFlight) xfrCV.Wait();
+   xfrCV.UnLock();
+   return rc;
+}
+
+/******************************************************************************/
+/*                                V e r i f y                                 */
+/******************************************************************************/
+
+int XrdOfsTPCXfrCl::Verify(const Parms &parms, XrdCksCalc *csP,
+                           char *eBuff, int eBlen)
+{
+   XrdCksData  csData;
+   std::string srcVal;
+   const char *csVal, *csName;
+   char        myVal[XrdCksData::ValuSize*2+1];
+   int         csLen;
+
+// Convert our checksum to its text form
+//
+   csName = csP->Type(csLen);
+   if (csLen > XrdCksData::ValuSize) csLen = XrdCksData::ValuSize;
+   memcpy(csData.Value, csP->Final(), csLen);
+   csData.Length = csLen;
+   if (!csData.Get(myVal, sizeof(myVal)))
+      {snprintf(eBuff, eBlen, "Copy failed; unable to format checksum.");
+       return EINVAL;
+      }
+
+// As with xrdcp, "<type>:print" only reports the checksum of the copy
+//
+   if ((csVal = index(parms.Cks, ':'))) csVal++;
+   if (csVal && !strcmp(csVal, "print"))
+      {eDest->Say("TPC ", parms.Tident, " copy ", csName, " checksum ",
+                   myVal);
+       return 0;
+      }
+
+// Use the value that was passed along or ask the source for it. The source
+// responds with "<type> <value>". As with xrdcp, "<type>:source" only
+// reports the checksum of the source.
+//
+   if (!csVal || !strcmp(csVal, "source"))
+      {XrdCl::URL          srcURL(parms.Src);
+       XrdCl::FileSystem   srcFS(srcURL);
+       XrdCl::Buffer       qArg, *qResp = 0;
+       XrdCl::XRootDStatus st;
+       std::string::size_type n;
+       qArg.FromString(srcURL.GetPathWithParams());
+       if (!(st = srcFS.Query(XrdCl::QueryCode::Checksum, qArg,
+                              qResp)).IsOK())
+          return Fail(eBuff, eBlen, "get source checksum", st);
+       srcVal = qResp->ToString();
+       delete qResp;
+       if ((n = srcVal.find(' ')) != std::string::npos)
+          srcVal.erase(0, n+1);
+       if (csVal)
+          {eDest->Say("TPC ", parms.Tident, " source ", csName,
+                      " checksum ", srcVal.c_str());
+           return 0;
+          }
+       csVal = srcVal.c_str();
+      }
+
+// Compare the two
+//
+   if (strcasecmp(csVal, myVal))
+      {snprintf(eBuff, eBlen, "Copy failed; checksum mismatch "
+                "(source %s destination %s).", csVal, myVal);
+       return EIO;
+      }
+   return 0;
+}
+
+/******************************************************************************/
+/*                       X r d O f s T P C G e t X f r                        */
+/******************************************************************************/
+
+extern "C"
+{
+XrdOfsTPCXfr *XrdOfsTPCGetXfr(XrdSysError *eDest,
+                              int maxStrm, int chunkSize)
+{
+// Have the client open as many substreams per channel as we may use streams
+// so that reads in flight are returned over separate connections.
+//
+   if (maxStrm > 1)
+      {XrdCl::Env *envP = XrdCl::DefaultEnv::GetEnv();
+       int curStrm = 1;
+       envP->GetInt("SubStreamsPerChannel", curStrm);
+       if (curStrm < maxStrm) envP->PutInt("SubStreamsPerChannel", maxStrm);
+      }
+
+// Return a new engine
+//
+   return new XrdOfsTPCXfrCl(eDest, chunkSize);
+}
+}
@@ -45,6 +45,7 @@
 
 #include "XrdOss/XrdOssApi.hh"
 #include "XrdOss/XrdOssTrace.hh"
+#include "XrdOss/XrdOssURing.hh"
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysPlatform.hh"
 #include "XrdSys/XrdSysPthread.hh"
@@ -148,6 +149,15 @@ int XrdOssFile::Fsync(XrdSfsAio *aiop)
 int XrdOssFile::Read(XrdSfsAio *aiop)
 {
 
+// Use io_uring if it has been enabled, falling back should it be unavailable
+//
+#ifdef HAVE_IOURING
+   if (XrdOssURing::isOn())
+      {aiop->TIdent = tident;
+       if (!XrdOssURing::Read(aiop, fd)) return 0;
+      }
+#endif
+
 #ifdef _POSIX_ASYNCHRONOUS_IO
    EPNAME("AioRead");
    int rc;
@@ -253,6 +263,7 @@ int XrdOssFile::Write(XrdSfsAio *aiop)
 /******************************************************************************/
 
 int   XrdOssSys::AioAllOk = 0;
+int   XrdOssSys::AioURing = 0;
   
 #if defined(_POSIX_ASYNCHRONOUS_IO) && !defined(HAVE_SIGWTI)
 // The folowing is for sigwaitinfo() emulation
@@ -335,10 +346,20 @@ int XrdOssSys::AioInit()
                     }
            }
 
+// Start the io_uring read engine if so wanted. Failure is not fatal as reads
+// simply revert to POSIX aio.
+//
+#ifdef HAVE_IOURING
+   if (AioURing) XrdOssURing::Init(OssEroute);
+#endif
+
 // All done
 //
    return AioAllOk;
 #else
+#ifdef HAVE_IOURING
+   if (AioURing) XrdOssURing::Init(OssEroute);
+#endif
    return 1;
 #endif
 }
@@ -41,6 +41,7 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/param.h>
+#include <sys/uio.h>
 #ifdef __solaris__
 #include <sys/vnode.h>
 #endif
@@ -53,6 +54,7 @@
 #include "XrdOss/XrdOssConfig.hh"
 #include "XrdOss/XrdOssError.hh"
 #include "XrdOss/XrdOssMio.hh"
+#include "XrdOss/XrdOssURing.hh"
 #include "XrdOss/XrdOssTrace.hh"
 #include "XrdOuc/XrdOucEnv.hh"
 #include "XrdOuc/XrdOucName2Name.hh"
@@ -374,13 +376,18 @@ int XrdOssSys::Stats(char *buff, int blen)
 {
    static const char statfmt1[] = "<stats id=\"oss\" v=\"2\">";
    static const char statfmt2[] = "</stats>";
-   static const int  statflen = sizeof(statfmt1) + sizeof(statfmt2);
+   static const char statfmtv[] = "<readv><calls>%lld</calls><elem>%lld</elem>"
+                                  "<reads>%lld</reads><waste>%lld</waste></readv>";
+   static const int  statflen = sizeof(statfmt1) + sizeof(statfmt2)
+                              + sizeof(statfmtv) + (16*4);
+   long long rvCnt[4];
    char *bp = buff;
    int n;
 
 // If only size wanted, return what size we need
 //
-   if (!buff) return statflen + getStats(0,0);
+   if (!buff) return statflen + getStats(0,0)
+                   + (tryMmap ? XrdOssMio::Stats(0,0) : 0);
 
 // Make sure we have enough space
 //
@@ -393,6 +400,24 @@ int XrdOssSys::Stats(char *buff, int blen)
    n = getStats(bp, blen);
    bp += n; blen -= n;
 
+// Generate readv coalescing statistics
+//
+   AtomicBeg(rvMutex);
+   rvCnt[0] = AtomicGet(rvCalls); rvCnt[1] = AtomicGet(rvElems);
+   rvCnt[2] = AtomicGet(rvReads); rvCnt[3] = AtomicGet(rvWaste);
+   AtomicEnd(rvMutex);
+   if (blen > (int)sizeof(statfmtv) + (16*4))
+      {n = snprintf(bp, blen, statfmtv, rvCnt[0], rvCnt[1], rvCnt[2], rvCnt[3]);
+       bp += n; blen -= n;
+      }
+
+// Generate memory mapped file statistics
+//
+   if (tryMmap)
+      {n = XrdOssMio::Stats(bp, blen);
+       bp += n; blen -= n;
+      }
+
 // Add trailer
 //
    if (blen >= (int)sizeof(statfmt2))
@@ -874,67 +899,11 @@ ssize_t XrdOssFile::Read(void *buff, off_t offset, size_t blen)
 
 ssize_t XrdOssFile::ReadV(XrdOucIOVec *readV, int n)
 {
-   ssize_t rdsz, totBytes = 0;
-   int i;
-
-// For platforms that support fadvise, pre-advise what we will be reading
-//
-#if defined(__linux__) && defined(HAVE_ATOMICS)
-   EPNAME("ReadV");
-   long long begOff, endOff, begLst = -1, endLst = -1;
-   int nPR = n;
-
-// Indicate we are in preread state and see if we have exceeded the limit
-//
-   if (XrdOssSS->prDepth
-   && AtomicInc((XrdOssSS->prActive)) < XrdOssSS->prQSize && n > 2)
-      {int faBytes = 0;
-       for (nPR=0;nPR < XrdOssSS->prDepth && faBytes < XrdOssSS->prBytes;nPR++)
-           if (readV[nPR].size > 0)
-              {begOff = XrdOssSS->prPMask &  readV[nPR].offset;
-               endOff = XrdOssSS->prPBits | (readV[nPR].offset+readV[nPR].size);
-               rdsz = endOff - begOff + 1;
-               if ((begOff > endLst || endOff < begLst)
-               &&  rdsz < XrdOssSS->prBytes)
-                  {posix_fadvise(fd, begOff, rdsz, POSIX_FADV_WILLNEED);
-                   TRACE(Debug,"fadvise(" <<fd <<',' <<begOff <<',' <<rdsz <<')');
-                   faBytes += rdsz;
-                  }
-               begLst = begOff; endLst = endOff;
-              }
-      }
-#endif
-
-// Read in the vector and do a pre-advise if we support that
-//
-   for (i = 0; i < n; i++)
-       {do {rdsz = pread(fd, readV[i].data, readV[i].size, readV[i].offset);}
-           while(rdsz < 0 && errno == EINTR);
-        if (rdsz < 0 || rdsz != readV[i].size)
-           {totBytes =  (rdsz < 0 ? -errno : -ESPIPE); break;}
-        totBytes += rdsz;
-#if defined(__linux__) && defined(HAVE_ATOMICS)
-        if (nPR < n && readV[nPR].size > 0)
-           {begOff = XrdOssSS->prPMask &  readV[nPR].offset;
-            endOff = XrdOssSS->prPBits | (readV[nPR].offset+readV[nPR].size);
-            rdsz = endOff - begOff + 1;
-            if ((begOff > endLst || endOff < begLst)
-            &&  rdsz <= XrdOssSS->prBytes)
-               {posix_fadvise(fd, begOff, rdsz, POSIX_FADV_WILLNEED);
-                TRACE(Debug,"fadvise(" <<fd <<',' <<begOff <<',' <<rdsz <<')');
-               }
-            begLst = begOff; endLst = endOff;
-           }
-        nPR++;
-#endif
-       }
 
-// All done, return bytes read.
+// If so configured, coalesce nearby elements into fewer, larger reads
 //
-#if defined(__linux__) && defined(HAVE_ATOMICS)
-   if (XrdOssSS->prDepth) AtomicDec((XrdOssSS->prActive));
-#endif
-   return totBytes;
+   if (XrdOssSS->rvGap >= 0 && n > 1) return ReadVMerge(readV, n);
+   return ReadVAll(readV, n);
 }
 
 /******************************************************************************/
@@ -1000,6 +969,70 @@ ssize_t XrdOssFile::Write(const void *buff, off_t offset, size_t blen)
      return retval;
 }
 
+/******************************************************************************/
+/*                                W r i t e V                                 */
+/******************************************************************************/
+
+/*
+  Function: Perform all the writes specified in the writeV vector. Runs of
+            elements that are contiguous in the file are written with a single
+            pwritev() call.
+
+  Input:    writeV    - A description of the writes to perform; includes the
+                        absolute offset, the size of the write, and the buffer
+                        holding the data.
+            n         - The size of the writeV vector.
+
+  Output:   Returns the number of bytes written upon success and -errno o/w.
+            Writing fewer bytes than requested is considered an error.
+*/
+
+ssize_t XrdOssFile::WriteV(XrdOucIOVec *writeV, int n)
+{
+#if defined(__linux__) || defined(__FreeBSD__)
+   struct iovec iov[64];
+   long long runOff, runEnd, nbytes = 0;
+   ssize_t retval;
+   int i = 0, k, iovcnt, iovdone;
+
+   if (fd < 0) return (ssize_t)-XRDOSS_E8004;
+
+   while(i < n)
+        {runOff = runEnd = writeV[i].offset;
+         for (iovcnt = 0; i < n && iovcnt < 64 && writeV[i].offset == runEnd;
+              i++, iovcnt++)
+             {iov[iovcnt].iov_base = (void *)writeV[i].data;
+              iov[iovcnt].iov_len  = writeV[i].size;
+              runEnd += writeV[i].size;
+             }
+         if (XrdOssSS->MaxSize && runEnd > XrdOssSS->MaxSize)
+            return (ssize_t)-XRDOSS_E8007;
+
+      // Write the run, picking up where a short write left off
+      //
+         iovdone = 0;
+         while(runOff < runEnd)
+              {do {retval = pwritev(fd, iov+iovdone, iovcnt-iovdone, runOff);}
+                  while(retval < 0 && errno == EINTR);
+               if (retval <= 0)
+                  return (retval < 0 ? (ssize_t)-errno : (ssize_t)-ESPIPE);
+               runOff += retval; nbytes += retval;
+               for (k = iovdone; k < iovcnt && retval > 0; k++)
+                   {if ((size_t)retval < iov[k].iov_len)
+                       {iov[k].iov_base = (char *)iov[k].iov_base + retval;
+                        iov[k].iov_len -= retval;
+                        break;
+                       }
+                    retval -= iov[k].iov_len; iovdone++;
+                   }
+              }
+        }
+   return nbytes;
+#else
+   return XrdOssDF::WriteV(writeV, n);
+#endif
+}
+
 /******************************************************************************/
 /*                                F c h m o d                                 */
 /******************************************************************************/
@@ -1208,3 +1241,191 @@ int XrdOssFile::Open_ufs(const char *path, int Oflag, int Mode,
 //
     return myfd;
 }
+
+/******************************************************************************/
+/*                              R e a d V A l l                               */
+/******************************************************************************/
+
+/*
+  Function: Perform all the reads specified in the readV vector as is.
+
+  Output:   See ReadV().
+*/
+
+ssize_t XrdOssFile::ReadVAll(XrdOucIOVec *readV, int n)
+{
+   ssize_t rdsz, totBytes = 0;
+   int i;
+
+// If io_uring is available, submit the whole vector as a single batch. There
+// is no need to pre-advise as all of the reads are issued concurrently.
+//
+#ifdef HAVE_IOURING
+   if (XrdOssURing::useVec(n)) return XrdOssURing::ReadV(fd, readV, n);
+#endif
+
+// For platforms that support fadvise, pre-advise what we will be reading
+//
+#if defined(__linux__) && defined(HAVE_ATOMICS)
+   EPNAME("ReadV");
+   long long begOff, endOff, begLst = -1, endLst = -1;
+   int nPR = n;
+
+// Indicate we are in preread state and see if we have exceeded the limit
+//
+   if (XrdOssSS->prDepth
+   && AtomicInc((XrdOssSS->prActive)) < XrdOssSS->prQSize && n > 2)
+      {int faBytes = 0;
+       for (nPR=0;nPR < XrdOssSS->prDepth && faBytes < XrdOssSS->prBytes;nPR++)
+           if (readV[nPR].size > 0)
+              {begOff = XrdOssSS->prPMask &  readV[nPR].offset;
+               endOff = XrdOssSS->prPBits | (readV[nPR].offset+readV[nPR].size);
+               rdsz = endOff - begOff + 1;
+               if ((begOff > endLst || endOff < begLst)
+               &&  rdsz < XrdOssSS->prBytes)
+                  {posix_fadvise(fd, begOff, rdsz, POSIX_FADV_WILLNEED);
+                   TRACE(Debug,"fadvise(" <<fd <<',' <<begOff <<',' <<rdsz <<')');
+                   faBytes += rdsz;
+                  }
+               begLst = begOff; endLst = endOff;
+              }
+      }
+#endif
+
+// Read in the vector and do a pre-advise if we support that
+//
+   for (i = 0; i < n; i++)
+       {do {rdsz = pread(fd, readV[i].data, readV[i].size, readV[i].offset);}
+           while(rdsz < 0 && errno == EINTR);
+        if (rdsz < 0 || rdsz != readV[i].size)
+           {totBytes =  (rdsz < 0 ? -errno : -ESPIPE); break;}
+        totBytes += rdsz;
+#if defined(__linux__) && defined(HAVE_ATOMICS)
+        if (nPR < n && readV[nPR].size > 0)
+           {begOff = XrdOssSS->prPMask &  readV[nPR].offset;
+            endOff = XrdOssSS->prPBits | (readV[nPR].offset+readV[nPR].size);
+            rdsz = endOff - begOff + 1;
+            if ((begOff > endLst || endOff < begLst)
+            &&  rdsz <= XrdOssSS->prBytes)
+               {posix_fadvise(fd, begOff, rdsz, POSIX_FADV_WILLNEED);
+                TRACE(Debug,"fadvise(" <<fd <<',' <<begOff <<',' <<rdsz <<')');
+               }
+            begLst = begOff; endLst = endOff;
+           }
+        nPR++;
+#endif
+       }
+
+// All done, return bytes read.
+//
+#if defined(__linux__) && defined(HAVE_ATOMICS)
+   if (XrdOssSS->prDepth) AtomicDec((XrdOssSS->prActive));
+#endif
+   return totBytes;
+}
+
+/******************************************************************************/
+/*                            R e a d V M e r g e                             */
+/******************************************************************************/
+
+/*
+  Function: Perform all the reads specified in the readV vector by sorting the
+            elements by offset and coalescing those that overlap or are no
+            more than rvGap bytes apart into a single read of at most rvMax
+            bytes. Coalesced data is read into a scratch buffer and scattered
+            back into the caller's buffers.
+
+  Output:   See ReadV().
+*/
+
+namespace
+{
+int rvOrder(const void *a, const void *b)
+{
+   long long aOff = (*(XrdOucIOVec * const *)a)->offset;
+   long long bOff = (*(XrdOucIOVec * const *)b)->offset;
+
+   return (aOff < bOff ? -1 : (aOff > bOff ? 1 : 0));
+}
+}
+
+ssize_t XrdOssFile::ReadVMerge(XrdOucIOVec *readV, int n)
+{
+   EPNAME("ReadVMerge");
+   XrdOucIOVec **sortV, *mrgV, *mP = 0;
+   long long curEnd = 0, eltEnd, need = 0, waste = 0, totBytes = 0;
+   char *scratch = 0, *sP;
+   int i, k, numS = 0, numM = 0, gap = XrdOssSS->rvGap, max = XrdOssSS->rvMax;
+   ssize_t rc;
+
+// Sort pointers to the non-empty elements by offset
+//
+   sortV = new XrdOucIOVec *[n];
+   for (i = 0; i < n; i++)
+       if (readV[i].size > 0)
+          {sortV[numS++] = &readV[i]; totBytes += readV[i].size;}
+   qsort(sortV, numS, sizeof(XrdOucIOVec *), rvOrder);
+
+// Plan the reads. Each planned read records the index of its first sorted
+// element in the info field. Gap bytes that are read only to be discarded
+// are counted as waste.
+//
+   mrgV = new XrdOucIOVec[numS ? numS : 1];
+   for (i = 0; i < numS; i++)
+       {eltEnd = sortV[i]->offset + sortV[i]->size;
+        if (mP && sortV[i]->offset <= curEnd + gap
+        &&  (eltEnd <= curEnd || eltEnd - mP->offset <= max))
+           {if (sortV[i]->offset > curEnd) waste += sortV[i]->offset - curEnd;
+            if (eltEnd > curEnd) curEnd = eltEnd;
+            mP->size = static_cast<int>(curEnd - mP->offset);
+            continue;
+           }
+        mP = &mrgV[numM++];
+        mP->offset = sortV[i]->offset;
+        mP->size   = sortV[i]->size;
+        mP->info   = i;
+        curEnd     = eltEnd;
+       }
+
+// Reads covering a single element go directly into the caller's buffer while
+// coalesced reads go into the scratch buffer.
+//
+   for (k = 0; k < numM; k++)
+       if ((k+1 < numM ? mrgV[k+1].info : numS) - mrgV[k].info > 1)
+          need += mrgV[k].size;
+   if (need && !(scratch = (char *)malloc(need)))
+      {delete [] sortV; delete [] mrgV; return -ENOMEM;}
+   for (sP = scratch, k = 0; k < numM; k++)
+       {if ((k+1 < numM ? mrgV[k+1].info : numS) - mrgV[k].info == 1)
+           mrgV[k].data = sortV[mrgV[k].info]->data;
+           else {mrgV[k].data = sP; sP += mrgV[k].size;}
+       }
+
+// Issue the planned reads and scatter coalesced data to where it belongs
+//
+   if ((rc = ReadVAll(mrgV, numM)) >= 0)
+      {for (k = 0; k < numM; k++)
+           {int eEnd = (k+1 < numM ? mrgV[k+1].info : numS);
+            if (eEnd - mrgV[k].info == 1) continue;
+            for (i = mrgV[k].info; i < eEnd; i++)
+                {sP = mrgV[k].data + (sortV[i]->offset - mrgV[k].offset);
+                 memcpy(sortV[i]->data, sP, sortV[i]->size);
+                }
+           }
+       TRACE(Debug, n <<" elements in " <<numM <<" reads; " <<rc <<" bytes read "
+                    <<waste <<" wasted");
+       AtomicBeg(XrdOssSS->rvMutex);
+       AtomicAdd(XrdOssSS->rvCalls, 1);
+       AtomicAdd(XrdOssSS->rvElems, numS);
+       AtomicAdd(XrdOssSS->rvReads, numM);
+       AtomicAdd(XrdOssSS->rvWaste, waste);
+       AtomicEnd(XrdOssSS->rvMutex);
+       rc = totBytes;
+      }
+
+// All done
+//
+   if (scratch) free(scratch);
+   delete [] sortV; delete [] mrgV;
+   return rc;
+}
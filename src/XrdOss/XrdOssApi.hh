@@ -106,6 +106,7 @@ ssize_t ReadV(XrdOucIOVec *readV, int);
 ssize_t ReadRaw(    void *, off_t, size_t);
 ssize_t Write(const void *, off_t, size_t);
 int     Write(XrdSfsAio *aiop);
+ssize_t WriteV(XrdOucIOVec *writeV, int n);
  
         // Constructor and destructor
         XrdOssFile(const char *tid)
@@ -117,6 +118,8 @@ virtual ~XrdOssFile() {if (fd >= 0) Close();}
 
 private:
 int     Open_ufs(const char *, int, int, unsigned long long);
+ssize_t ReadVAll(XrdOucIOVec *readV, int n);
+ssize_t ReadVMerge(XrdOucIOVec *readV, int n);
 
 static int      AioFailure;
 oocx_CXFile    *cxobj;
@@ -193,6 +196,7 @@ int       Stats(char *bp, int bl);
 
 static int   AioInit();
 static int   AioAllOk;
+static int   AioURing;
 
 static int   runOld;            // Run in backward compatability mode
 
@@ -271,6 +275,14 @@ int               prActive;  //    preread activity count
 short             prDepth;   //    preread depth
 short             prQSize;   //    preread maximum allowed
 
+XrdSysMutex       rvMutex;   //    readv statistics serialization
+long long         rvCalls;   //    readv requests that were coalesced
+long long         rvElems;   //    readv elements in those requests
+long long         rvReads;   //    readv reads issued after coalescing
+long long         rvWaste;   //    readv gap bytes read but not returned
+int               rvGap;     //    readv coalescing gap (-1 -> disabled)
+int               rvMax;     //    readv maximum coalesced read size
+
 XrdVersionInfo   *myVersion; //    Compilation version set by constructor
    
          XrdOssSys();
@@ -335,6 +347,7 @@ void   ConfigStats(XrdSysError &Eroute);
 void   ConfigStats(dev_t Devnum, char *lP);
 int    ConfigXeq(char *, XrdOucStream &, XrdSysError &);
 void   List_Path(const char *, const char *, unsigned long long, XrdSysError &);
+int    xaio(XrdOucStream &Config, XrdSysError &Eroute);
 int    xalloc(XrdOucStream &Config, XrdSysError &Eroute);
 int    xcache(XrdOucStream &Config, XrdSysError &Eroute);
 int    xcachescan(XrdOucStream &Config, XrdSysError &Eroute);
@@ -345,6 +358,7 @@ int    xmemf(XrdOucStream &Config, XrdSysError &Eroute);
 int    xnml(XrdOucStream &Config, XrdSysError &Eroute);
 int    xpath(XrdOucStream &Config, XrdSysError &Eroute);
 int    xprerd(XrdOucStream &Config, XrdSysError &Eroute);
+int    xreadv(XrdOucStream &Config, XrdSysError &Eroute);
 int    xspace(XrdOucStream &Config, XrdSysError &Eroute, int *isCD=0);
 int    xspaceBuild(char *grp, char *fn, int isxa, XrdSysError &Eroute);
 int    xstg(XrdOucStream &Config, XrdSysError &Eroute);
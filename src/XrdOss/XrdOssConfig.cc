@@ -49,6 +49,7 @@
 #include "XrdOss/XrdOssConfig.hh"
 #include "XrdOss/XrdOssError.hh"
 #include "XrdOss/XrdOssMio.hh"
+#include "XrdOss/XrdOssURing.hh"
 #include "XrdOss/XrdOssOpaque.hh"
 #include "XrdOss/XrdOssSpace.hh"
 #include "XrdOss/XrdOssTrace.hh"
@@ -212,6 +213,9 @@ XrdOssSys::XrdOssSys()
    prActive      = 0;
    prDepth       = 0;
    prQSize       = 0;
+   rvCalls = rvElems = rvReads = rvWaste = 0;
+   rvGap         = -1;
+   rvMax         = 1048576;
    STT_Lib       = 0;
    STT_Parms     = 0;
    STT_Func      = 0;
@@ -417,6 +421,14 @@ void XrdOssSys::Config_Display(XrdSysError &Eroute)
      Eroute.Say(buff);
 
      XrdOssMio::Display(Eroute);
+     if (rvGap >= 0)
+        {snprintf(buff, sizeof(buff), "       oss.readv        coalesce %d "
+                                      "maxsize %d", rvGap, rvMax);
+         Eroute.Say(buff);
+        }
+#ifdef HAVE_IOURING
+     XrdOssURing::Display(Eroute);
+#endif
 
      XrdOssCache::List("       oss.", Eroute);
            List_Path("       oss.defaults ", "", DirFlags, Eroute);
@@ -490,7 +502,7 @@ void XrdOssSys::ConfigMio(XrdSysError &Eroute)
 // If no memory flags are set, turn off memory mapped files
 //
    if (!(flags & XRDEXP_MEMAP) || setoff)
-     {XrdOssMio::Set(0, 0, 0);
+     {XrdOssMio::Set(0, 0, 0, 0, 0);
       tryMmap = 0; chkMmap = 0;
      }
 }
@@ -943,6 +955,7 @@ int XrdOssSys::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError &Eroute)
     int nosubs;
     XrdOucEnv *myEnv = 0;
 
+   TS_Xeq("aio",           xaio);
    TS_Xeq("alloc",         xalloc);
    TS_Xeq("cache",         xcache);
    TS_Xeq("cachescan",     xcachescan);
@@ -953,6 +966,7 @@ int XrdOssSys::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError &Eroute)
    TS_Xeq("namelib",       xnml);
    TS_Xeq("path",          xpath);
    TS_Xeq("preread",       xprerd);
+   TS_Xeq("readv",         xreadv);
    TS_Xeq("space",         xspace);
    TS_Xeq("stagecmd",      xstg);
    TS_Xeq("statlib",       xstl);
@@ -1012,6 +1026,65 @@ int XrdOssSys::ConfigXeq(char *var, XrdOucStream &Config, XrdSysError &Eroute)
    return 0;
 }
 
+/******************************************************************************/
+/*                                  x a i o                                   */
+/******************************************************************************/
+
+/* Function: xaio
+
+   Purpose:  To parse the directive: aio {posix | uring [qdepth <n>] [minvec <n>]}
+
+             posix       use POSIX aio for asynchronous reads (the default).
+             uring       use io_uring for asynchronous reads and for vector
+                         reads; writes continue to use POSIX aio.
+             qdepth      the number of io_uring submission entries (def 1024).
+             minvec      the minimum number of elements in a vector read for it
+                         to be submitted via io_uring (default 2).
+
+   Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdOssSys::xaio(XrdOucStream &Config, XrdSysError &Eroute)
+{
+    char *val;
+    int qdepth = 0, minvec = 0;
+
+      if (!(val = Config.GetWord()))
+         {Eroute.Emsg("Config", "aio type not specified"); return 1;}
+
+      if (!strcmp(val, "posix")) {AioURing = 0; return 0;}
+      if (strcmp(val, "uring"))
+         {Eroute.Emsg("Config", "invalid aio type -", val); return 1;}
+
+      while((val = Config.GetWord()))
+           {     if (!strcmp(val, "qdepth"))
+                    {if (!(val = Config.GetWord()))
+                        {Eroute.Emsg("Config","aio qdepth not specified");
+                         return 1;
+                        }
+                     if (XrdOuca2x::a2i(Eroute,"aio qdepth",val,&qdepth,8,32768))
+                        return 1;
+                    }
+            else if (!strcmp(val, "minvec"))
+                    {if (!(val = Config.GetWord()))
+                        {Eroute.Emsg("Config","aio minvec not specified");
+                         return 1;
+                        }
+                     if (XrdOuca2x::a2i(Eroute,"aio minvec",val,&minvec,1))
+                        return 1;
+                    }
+            else {Eroute.Emsg("Config","invalid aio option -",val); return 1;}
+           }
+
+#ifdef HAVE_IOURING
+      XrdOssURing::Set(qdepth, minvec);
+      AioURing = 1;
+#else
+      Eroute.Say("Config warning: io_uring is not supported; using posix aio.");
+#endif
+      return 0;
+}
+
 /******************************************************************************/
 /*                                x a l l o c                                 */
 /******************************************************************************/
@@ -1200,6 +1273,7 @@ int XrdOssSys::xmaxsz(XrdOucStream &Config, XrdSysError &Eroute)
 
    Purpose:  Parse the directive: memfile [off] [max <msz>]
                                           [check xattr] [preload]
+                                          [hugepages] [prefault]
 
              check      Applies memory mapping options based on file's xattrs.
                         For backward compatibility, we also accept:
@@ -1208,6 +1282,9 @@ int XrdOssSys::xmaxsz(XrdOucStream &Config, XrdSysError &Eroute)
              off        Disables memory mapping regardless of other options.
              on         Enables memory mapping
              preload    Preloads the file after every opn reference.
+             hugepages  Backs kept or locked files with transparent huge pages.
+             prefault   Populates the page tables of kept or locked files
+                        when they are mapped.
              <msz>      Maximum amount of memory to use (can be n% or real mem).
 
    Output: 0 upon success or !0 upon failure.
@@ -1216,7 +1293,7 @@ int XrdOssSys::xmaxsz(XrdOucStream &Config, XrdSysError &Eroute)
 int XrdOssSys::xmemf(XrdOucStream &Config, XrdSysError &Eroute)
 {
     char *val;
-    int i, j, V_check=-1, V_preld = -1, V_on=-1;
+    int i, j, V_check=-1, V_preld = -1, V_on=-1, V_huge=-1, V_pflt=-1;
     long long V_max = 0;
 
     static struct mmapopts {const char *opname; int otyp;
@@ -1225,7 +1302,9 @@ int XrdOssSys::xmemf(XrdOucStream &Config, XrdSysError &Eroute)
         {"off",        0, ""},
         {"preload",    1, "memfile preload"},
         {"check",      2, "memfile check"},
-        {"max",        3, "memfile max"}};
+        {"max",        3, "memfile max"},
+        {"hugepages",  4, "memfile hugepages"},
+        {"prefault",   5, "memfile prefault"}};
     int numopts = sizeof(mmopts)/sizeof(struct mmapopts);
 
     if (!(val = Config.GetWord()))
@@ -1236,7 +1315,8 @@ int XrdOssSys::xmemf(XrdOucStream &Config, XrdSysError &Eroute)
               if (!strcmp(val, mmopts[i].opname)) break;
           if (i >= numopts)
              Eroute.Say("Config warning: ignoring invalid memfile option '",val,"'.");
-             else {if (mmopts[i].otyp >  1 && !(val = Config.GetWord()))
+             else {if (mmopts[i].otyp >  1 && mmopts[i].otyp < 4
+                   && !(val = Config.GetWord()))
                       {Eroute.Emsg("Config","memfile",mmopts[i].opname,
                                    "value not specified");
                        return 1;
@@ -1263,6 +1343,10 @@ int XrdOssSys::xmemf(XrdOucStream &Config, XrdSysError &Eroute)
                                                 mmopts[i].opmsg, val, &V_max,
                                                 10*1024*1024)) return 1;
                                   break;
+                          case 4: V_huge = 1;
+                                  break;
+                          case 5: V_pflt = 1;
+                                  break;
                           default: V_on = 0; break;
                          }
                   val = Config.GetWord();
@@ -1271,7 +1355,7 @@ int XrdOssSys::xmemf(XrdOucStream &Config, XrdSysError &Eroute)
 
 // Set the values
 //
-   XrdOssMio::Set(V_on, V_preld, V_check);
+   XrdOssMio::Set(V_on, V_preld, V_check, V_huge, V_pflt);
    XrdOssMio::Set(V_max);
    return 0;
 }
@@ -1427,6 +1511,57 @@ int XrdOssSys::xprerd(XrdOucStream &Config, XrdSysError &Eroute)
       return 0;
 }
   
+/******************************************************************************/
+/*                                x r e a d v                                 */
+/******************************************************************************/
+
+/* Function: xreadv
+
+   Purpose:  To parse the directive: readv {nocoalesce | coalesce <gap>}
+                                           [maxsize <bytes>]
+
+             nocoalesce  do not coalesce readv elements (the default).
+             coalesce    sort readv elements by offset and merge those that
+                         overlap or are separated by no more than <gap> bytes
+                         into a single read.
+             maxsize     the maximum size of a merged read (default 1m).
+
+   Output: 0 upon success or !0 upon failure.
+*/
+
+int XrdOssSys::xreadv(XrdOucStream &Config, XrdSysError &Eroute)
+{
+    static const long long m64 = 67108864LL;
+    char *val;
+    long long gap, lim = rvMax;
+
+      if (!(val = Config.GetWord()))
+         {Eroute.Emsg("Config", "readv option not specified"); return 1;}
+
+           if (!strcmp(val, "nocoalesce")) gap = -1;
+      else if (!strcmp(val, "coalesce"))
+              {if (!(val = Config.GetWord()))
+                  {Eroute.Emsg("Config","readv coalesce gap not specified");
+                   return 1;
+                  }
+               if (XrdOuca2x::a2sz(Eroute,"readv gap",val,&gap,0,m64)) return 1;
+              }
+      else {Eroute.Emsg("Config","invalid readv option -",val); return 1;}
+
+      if ((val = Config.GetWord()))
+         {if (strcmp(val, "maxsize"))
+             {Eroute.Emsg("Config","invalid readv option -",val); return 1;}
+          if (!(val = Config.GetWord()))
+             {Eroute.Emsg("Config","readv maxsize not specified"); return 1;}
+          if (XrdOuca2x::a2sz(Eroute,"readv maxsize",val,&lim,4096,m64*8))
+             return 1;
+         }
+
+      rvGap = static_cast<int>(gap);
+      rvMax = static_cast<int>(lim);
+      return 0;
+}
+
 /******************************************************************************/
 /*                                x s p a c e                                 */
 /******************************************************************************/
@@ -31,6 +31,7 @@
 #include <unistd.h>
 #include <stdio.h>
 #include <sys/param.h>
+#include <sys/resource.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 
@@ -47,18 +48,15 @@
 /*                      S t a t i c   V a r i a b l e s                       */
 /******************************************************************************/
 
-XrdOucHash<XrdOssMioFile> XrdOssMio::MM_Hash;
-
-XrdSysMutex    XrdOssMio::MM_Mutex;
-
-XrdOssMioFile *XrdOssMio::MM_Perm     = 0;
-XrdOssMioFile *XrdOssMio::MM_Idle     = 0;
-XrdOssMioFile *XrdOssMio::MM_IdleLast = 0;
+XrdOssMio::MioShard XrdOssMio::MM_Shard[XrdOssMio::MM_Shards];
+int            XrdOssMio::MM_Rover    = 0;
 
 char           XrdOssMio::MM_on       = 1;
 char           XrdOssMio::MM_chk      = 0;
 char           XrdOssMio::MM_okmlock  = 1;
 char           XrdOssMio::MM_preld    = 0;
+char           XrdOssMio::MM_huge     = 0;
+char           XrdOssMio::MM_pflt     = 0;
 long long      XrdOssMio::MM_pagsz    = (long long)sysconf(_SC_PAGESIZE);
 #ifdef __APPLE__
 long long      XrdOssMio::MM_pages    = 1024*1024*1024;
@@ -67,6 +65,10 @@ long long      XrdOssMio::MM_pages    = (long long)sysconf(_SC_PHYS_PAGES);
 #endif
 long long      XrdOssMio::MM_max      = MM_pagsz*MM_pages/2;
 long long      XrdOssMio::MM_inuse    = 0;
+long long      XrdOssMio::MM_maps     = 0;
+long long      XrdOssMio::MM_reclaimed= 0;
+long long      XrdOssMio::MM_minflt   = 0;
+long long      XrdOssMio::MM_majflt   = 0;
 
 extern XrdSysError OssEroute;
 
@@ -79,10 +81,12 @@ extern XrdOucTrace OssTrace;
 void XrdOssMio::Display(XrdSysError &Eroute)
 {
      char buff[1080];
-     snprintf(buff, sizeof(buff), "       oss.memfile %s%s%s max %lld",
-             (MM_on      ? ""            : "off "),
-             (MM_preld   ? "preload"     : ""),
-             (MM_chk     ? "check xattr" : ""), MM_max);
+     snprintf(buff, sizeof(buff), "       oss.memfile%s%s%s%s%s max %lld",
+             (MM_on      ? ""             : " off"),
+             (MM_preld   ? " preload"     : ""),
+             (MM_huge    ? " hugepages"   : ""),
+             (MM_pflt    ? " prefault"    : ""),
+             (MM_chk     ? " check xattr" : ""), MM_max);
      Eroute.Say(buff);
 }
 
@@ -96,8 +100,11 @@ XrdOssMioFile *XrdOssMio::Map(char *path, int fd, int opts)
    EPNAME("MioMap");
    XrdSysMutexHelper mapMutex;
    struct stat statb;
-   XrdOssMioFile *mp;
+   XrdOssMioFile *mp, *xp;
+   MioShard *sP;
    void *thefile;
+   long long newuse, fltv[2];
+   int mflags = MAP_PRIVATE, isHot = opts & (OSSMIO_MPRM | OSSMIO_MLOK);
    char hashname[64];
 
 // Get the size of the file
@@ -107,40 +114,50 @@ XrdOssMioFile *XrdOssMio::Map(char *path, int fd, int opts)
        return 0;
       }
 
-// Develop hash name for this file
+// Develop hash name for this file and select the shard that holds it
 //
    XrdOucTrace::bin2hex((char *)&statb.st_dev,
                          int(sizeof(statb.st_dev)), hashname);
    XrdOucTrace::bin2hex((char *)&statb.st_ino, int(sizeof(statb.st_ino)),
                                          hashname+(sizeof(statb.st_dev)*2));
+   sP = &MM_Shard[(statb.st_ino ^ statb.st_dev) % MM_Shards];
 
-// Because of potntial race conditions, we must serialize execution
+// Check if we already have this mapping. Only this shard is locked so opens
+// of files in other shards proceed concurrently.
 //
-   mapMutex.Lock(&MM_Mutex);
-
-// Check if we already have this mapping
-//
-   if ((mp = MM_Hash.Find(hashname)))
+   mapMutex.Lock(&sP->Mutex);
+   if ((mp = sP->Hash.Find(hashname)))
       {DEBUG("Reusing mmap; usecnt=" <<mp->inUse <<" path=" <<path);
-       if (!(mp->Status & OSSMIO_MPRM) && !mp->inUse) Reclaim(mp);
-       mp->inUse++;
+       if (!__sync_fetch_and_add(&mp->inUse, 1) && mp->onIdle) Reclaim(mp);
        return mp;
       }
+   mapMutex.UnLock();
 
 // Check if memory will be over committed
 //
-   if (MM_inuse + statb.st_size > MM_max)
-      {if (!Reclaim(statb.st_size))
-          {OssEroute.Emsg("Mio", "Unable to reclaim enough storage to mmap",path);
-           return 0;
-          }
+   newuse = __sync_add_and_fetch(&MM_inuse, (long long)statb.st_size);
+   if (newuse > MM_max && !Reclaim(newuse - MM_max))
+      {__sync_sub_and_fetch(&MM_inuse, (long long)statb.st_size);
+       OssEroute.Emsg("Mio", "Unable to reclaim enough storage to mmap",path);
+       return 0;
       }
-   MM_inuse += statb.st_size;
 
-// Memory map the file
+// Files that are to be kept or locked in memory are considered hot. When so
+// requested, their page tables are populated as part of the mapping unless
+// huge pages are wanted, in which case we must advise the kernel first.
 //
-   if ((thefile = mmap(0,statb.st_size,PROT_READ,MAP_PRIVATE,fd,0))==MAP_FAILED)
+#ifdef MAP_POPULATE
+   if (MM_pflt && !MM_huge && isHot) mflags |= MAP_POPULATE;
+#endif
+
+// Memory map the file. This is done without any lock held.
+//
+   if (mflags != MAP_PRIVATE) Faults(fltv, 1);
+   thefile = mmap(0, statb.st_size, PROT_READ, mflags, fd, 0);
+   if (mflags != MAP_PRIVATE) Faults(fltv, 0);
+   if (thefile == MAP_FAILED)
       {OssEroute.Emsg("Mio", errno, "mmap file", path);
+       __sync_sub_and_fetch(&MM_inuse, (long long)statb.st_size);
        return 0;
       } else {DEBUG("mmap " <<statb.st_size <<" bytes for " <<path);}
 
@@ -165,6 +182,7 @@ XrdOssMioFile *XrdOssMio::Map(char *path, int fd, int opts)
    if (!(mp = new XrdOssMioFile(hashname)))
       {OssEroute.Emsg("Mio", "Unable to allocate mmap file object for", path);
        munmap((char *)thefile, statb.st_size);
+       __sync_sub_and_fetch(&MM_inuse, (long long)statb.st_size);
        return 0;
       }
 
@@ -176,31 +194,49 @@ XrdOssMioFile *XrdOssMio::Map(char *path, int fd, int opts)
    mp->Ino    = statb.st_ino;
    mp->Status = opts;
 
-// Add the mapping to our hash table
+// Apply huge page and prefault handling to hot files
 //
-   if (MM_Hash.Add(hashname, mp))
-      {OssEroute.Emsg("Mio", "Hash add failed for", path);
-       munmap((char *)thefile, statb.st_size);
+   if ((MM_huge || MM_pflt) && isHot) Hot(mp, path, mflags != MAP_PRIVATE);
+
+// Add the mapping to our hash table. Someone may have mapped the same file
+// while we were not holding the lock. If so, we use theirs and drop ours.
+//
+   mapMutex.Lock(&sP->Mutex);
+   if ((xp = sP->Hash.Find(hashname)))
+      {if (!__sync_fetch_and_add(&xp->inUse, 1) && xp->onIdle) Reclaim(xp);
+       mapMutex.UnLock();
+       DEBUG("Lost mmap race; usecnt=" <<xp->inUse <<" path=" <<path);
+       __sync_sub_and_fetch(&MM_inuse, (long long)mp->Size);
+       delete mp;
+       return xp;
+      }
+   if (sP->Hash.Add(hashname, mp, 0, Hash_keepdata))
+      {mapMutex.UnLock();
+       OssEroute.Emsg("Mio", "Hash add failed for", path);
+       __sync_sub_and_fetch(&MM_inuse, (long long)mp->Size);
        delete mp;
        return 0;
       }
+   __sync_fetch_and_add(&MM_maps, 1);
 
 // If this is a permanent file, place it on the permanent queue
 //
    if (opts & OSSMIO_MPRM)
-      {mp->Next = MM_Perm; MM_Perm = mp;
+      {mp->Next = sP->Perm; sP->Perm = mp;
        DEBUG("Placed file on permanent queue " <<path);
       }
 
-// If this file is to be preloaded, start it now
+// If this file is to be preloaded, start it now. The extra reference keeps
+// the mapping alive until the preload thread recycles it.
 //
    if (MM_preld && mp->inUse == 1)
       {pthread_t tid;
        int retc;
-       mp->inUse++;
+       __sync_fetch_and_add(&mp->inUse, 1);
+       mapMutex.UnLock();
        if ((retc = XrdSysThread::Run(&tid, preLoad, (void *)mp)) < 0)
           {OssEroute.Emsg("Mio", retc, "creating mmap preload thread");
-           mp->inUse--;
+           Recycle(mp);
           }
           else DEBUG("started mmap preload thread; tid=" <<(unsigned long)tid);
       }
@@ -222,12 +258,14 @@ void *XrdOssMio::preLoad(void *arg)
    XrdOssMioFile *mp = (XrdOssMioFile *)arg;
    char *Base = (char *)(mp->Base);
    char *Bend = Base + mp->Size;
-   long long MY_pagsz = MM_pagsz;
+   long long MY_pagsz = MM_pagsz, fltv[2];
 
 // Reference each page until we are done. This is somewhat obtuse but we
 // are trying to keep the compiler from optimizing out the code.
 //
+   Faults(fltv, 1);
    while(Base < Bend) Base += (*Base ? MY_pagsz : MM_pagsz);
+   Faults(fltv, 0);
 
 // All done
 //
@@ -239,22 +277,39 @@ void *XrdOssMio::preLoad(void *arg)
 /*                               R e c l a i m                                */
 /******************************************************************************/
   
-// Reclaim() can only be called if the caller has the MM_Mutex lock!
+// Reclaim() must be called without holding any shard lock. Shards are visited
+// round-robin and the least recently used idle mapping of each is released
+// until enough memory has been freed or no idle mappings remain.
 //
 int XrdOssMio::Reclaim(off_t amount)
 {
    EPNAME("MioReclaim");
    XrdOssMioFile *mp;
+   MioShard *sP;
+   int i, idle;
    DEBUG("Trying to reclaim " <<amount <<" bytes.");
 
 // Try to reclaim memory
 //
-   while((mp = MM_Idle) && amount > 0)
-        {MM_Idle = mp->Next;
-         MM_inuse -= mp->Size;
-         amount   -= mp->Size;
-         MM_Hash.Del(mp->HashName);  // This will delete the object
-        }
+   do {idle = 0;
+       for (i = 0; i < MM_Shards && amount > 0; i++)
+           {sP = &MM_Shard[__sync_fetch_and_add(&MM_Rover, 1) % MM_Shards];
+            sP->Mutex.Lock();
+            if ((mp = sP->Idle))
+               {Reclaim(mp);
+                sP->Hash.Del(mp->HashName);
+                idle = 1;
+               }
+            sP->Mutex.UnLock();
+            if (mp)
+               {__sync_sub_and_fetch(&MM_inuse, (long long)mp->Size);
+                __sync_fetch_and_sub(&MM_maps, 1);
+                __sync_fetch_and_add(&MM_reclaimed, 1);
+                amount -= mp->Size;
+                delete mp;
+               }
+           }
+      } while(idle && amount > 0);
 
 // Indicate whether we cleared enough
 //
@@ -263,25 +318,19 @@ int XrdOssMio::Reclaim(off_t amount)
 
 /******************************************************************************/
 
-int XrdOssMio::Reclaim(XrdOssMioFile *mp)
-{
-   EPNAME("MioReclaim");
-   XrdOssMioFile *pmp = 0, *cmp = MM_Idle;
-
-// Try to find the mapping
-//
-   while(cmp && mp != cmp) {pmp = cmp; cmp = cmp->Next;}
-
-// Remove mapping from the idle list
+// This Reclaim() must be called with the mapping's shard lock held. It simply
+// unchains the mapping from the shard's idle list.
 //
-   if (cmp)
-      {if (pmp) pmp->Next = mp->Next;
-          else  MM_Idle   = mp->Next;
-       if (MM_IdleLast == cmp) MM_IdleLast = pmp;
-      }
-      else {DEBUG("Cannot find mapping for " <<mp->Dev <<':' <<mp->Ino);}
-
-   return (cmp != 0);
+void XrdOssMio::Reclaim(XrdOssMioFile *mp)
+{
+   MioShard *sP = &MM_Shard[(mp->Ino ^ mp->Dev) % MM_Shards];
+
+   if (mp->Prev) mp->Prev->Next = mp->Next;
+      else       sP->Idle        = mp->Next;
+   if (mp->Next) mp->Next->Prev = mp->Prev;
+      else       sP->IdleLast    = mp->Prev;
+   mp->Next = mp->Prev = 0;
+   mp->onIdle = false;
 }
  
 /******************************************************************************/
@@ -290,23 +339,37 @@ int XrdOssMio::Reclaim(XrdOssMioFile *mp)
   
 void XrdOssMio::Recycle(XrdOssMioFile *mp)
 {
-   XrdSysMutexHelper mmMutex(&MM_Mutex);
+   MioShard *sP;
+   int n;
+
+// If others still reference this mapping, simply drop our reference. No lock
+// is needed as the mapping cannot become idle here.
+//
+   do {if ((n = mp->inUse) <= 1) break;
+      } while(!__sync_bool_compare_and_swap(&mp->inUse, n, n-1));
+   if (n > 1) return;
+
+// This may be the last reference so we must serialize with Map() and Reclaim()
+//
+   sP = &MM_Shard[(mp->Ino ^ mp->Dev) % MM_Shards];
+   XrdSysMutexHelper mmMutex(&sP->Mutex);
 
 // Decrement the use count
 //
-   mp->inUse--;
-   if (mp->inUse < 0)
+   n = __sync_sub_and_fetch(&mp->inUse, 1);
+   if (n < 0)
       {OssEroute.Emsg("Mio", "MM usecount underflow for ", mp->HashName);
        mp->inUse = 0;
-      } else if (mp->inUse > 0) return;
+      } else if (n > 0) return;
 
-// If this is not a kept mapping, put it on the reclaim list
+// If this is not a kept mapping, put it at the tail of the shard's LRU list
 //
-   if (!(mp->Status & OSSMIO_MPRM))
-      {if (MM_IdleLast) MM_IdleLast->Next = mp;
-          else MM_Idle = mp;
-       MM_IdleLast = mp;
-       mp->Next = 0;
+   if (!(mp->Status & OSSMIO_MPRM) && !mp->onIdle)
+      {mp->Prev = sP->IdleLast; mp->Next = 0;
+       if (sP->IdleLast) sP->IdleLast->Next = mp;
+          else sP->Idle = mp;
+       sP->IdleLast = mp;
+       mp->onIdle = true;
       }
 }
   
@@ -314,11 +377,13 @@ void XrdOssMio::Recycle(XrdOssMioFile *mp)
 /*                                   S e t                                    */
 /******************************************************************************/
   
-void XrdOssMio::Set(int V_on, int V_preld,  int V_check)
+void XrdOssMio::Set(int V_on, int V_preld,  int V_check, int V_huge, int V_pflt)
 {
    if (V_on      >= 0) MM_on      = (char)V_on;
    if (V_preld   >= 0) MM_preld   = (char)V_preld;
    if (V_check   >= 0) MM_chk     = (char)V_check;
+   if (V_huge    >= 0) MM_huge    = (char)V_huge;
+   if (V_pflt    >= 0) MM_pflt    = (char)V_pflt;
 }
 
 void XrdOssMio::Set(long long V_max)
@@ -326,6 +391,141 @@ void XrdOssMio::Set(long long V_max)
    if (V_max > 0) MM_max = V_max;
       else if (V_max < 0) MM_max = MM_pagsz*MM_pages*(-V_max)/100;
 }
+
+/******************************************************************************/
+/*                                 S t a t s                                  */
+/******************************************************************************/
+
+int XrdOssMio::Stats(char *buff, int blen)
+{
+   static const char statfmt[] = "<mio><maps>%lld</maps><mapped>%lld</mapped>"
+                   "<resident>%lld</resident><reclaim>%lld</reclaim>"
+                   "<minflt>%lld</minflt><majflt>%lld</majflt></mio>";
+   long long resident = 0;
+   int i, n;
+
+// If only size wanted, return what size we need
+//
+   if (!buff) return sizeof(statfmt) + (16*6);
+   if (blen < (int)sizeof(statfmt) + (16*6)) return 0;
+
+// Compute the number of bytes currently resident in all of the mappings
+//
+   for (i = 0; i < MM_Shards; i++)
+       {MM_Shard[i].Mutex.Lock();
+        MM_Shard[i].Hash.Apply(Resident, (void *)&resident);
+        MM_Shard[i].Mutex.UnLock();
+       }
+
+// Format the statistics
+//
+   n = snprintf(buff, blen, statfmt,
+                __sync_fetch_and_add(&MM_maps,     0),
+                __sync_fetch_and_add(&MM_inuse,    0), resident,
+                __sync_fetch_and_add(&MM_reclaimed,0),
+                __sync_fetch_and_add(&MM_minflt,   0),
+                __sync_fetch_and_add(&MM_majflt,   0));
+   return (n < blen ? n : 0);
+}
+  
+/******************************************************************************/
+/*                       P r i v a t e   M e t h o d s                        */
+/******************************************************************************/
+/******************************************************************************/
+/*                                F a u l t s                                 */
+/******************************************************************************/
+
+// Faults() is called in pairs by the same thread. The first call records the
+// thread's page fault counts and the second adds the difference to the totals.
+//
+void XrdOssMio::Faults(long long *fltv, int beg)
+{
+#ifdef RUSAGE_THREAD
+   struct rusage ru;
+
+   if (getrusage(RUSAGE_THREAD, &ru)) {fltv[0] = -1; return;}
+   if (beg) {fltv[0] = ru.ru_minflt; fltv[1] = ru.ru_majflt;}
+      else if (fltv[0] >= 0)
+              {__sync_fetch_and_add(&MM_minflt, ru.ru_minflt - fltv[0]);
+               __sync_fetch_and_add(&MM_majflt, ru.ru_majflt - fltv[1]);
+              }
+#endif
+}
+
+/******************************************************************************/
+/*                                   H o t                                    */
+/******************************************************************************/
+  
+void XrdOssMio::Hot(XrdOssMioFile *mp, const char *path, int populated)
+{
+#if defined(_POSIX_MAPPED_FILES)
+   EPNAME("MioHot");
+   long long fltv[2];
+
+// Ask for transparent huge pages to back this mapping. Should the kernel not
+// support them, turn off the feature so we don't keep trying.
+//
+#ifdef MADV_HUGEPAGE
+   if (MM_huge)
+      {if (madvise(mp->Base, mp->Size, MADV_HUGEPAGE))
+          {if (errno == EINVAL)
+              {OssEroute.Emsg("Mio","Huge pages not supported; feature disabled.");
+               MM_huge = 0;
+              } else OssEroute.Emsg("Mio", errno, "advise huge pages for", path);
+          } else {DEBUG("Huge pages advised for " <<path);}
+      }
+#endif
+
+// Prefault the mapping now that any huge page advice is in effect, unless
+// mmap() already did so via MAP_POPULATE.
+//
+   if (MM_pflt && !populated)
+      {Faults(fltv, 1);
+#ifdef MADV_POPULATE_READ
+       if (madvise(mp->Base, mp->Size, MADV_POPULATE_READ))
+#endif
+          {char *Base = (char *)(mp->Base), *Bend = Base + mp->Size;
+           long long MY_pagsz = MM_pagsz;
+           while(Base < Bend) Base += (*Base ? MY_pagsz : MM_pagsz);
+          }
+       Faults(fltv, 0);
+       DEBUG("Prefaulted " <<mp->Size <<" bytes for " <<path);
+      }
+#endif
+}
+
+/******************************************************************************/
+/*                              R e s i d e n t                               */
+/******************************************************************************/
+
+// Resident() is applied to each mapping in a shard, with the shard lock held,
+// and adds the number of bytes in memory to the total pointed to by arg.
+//
+int XrdOssMio::Resident(const char *key, XrdOssMioFile *mp, void *arg)
+{
+#if defined(_POSIX_MAPPED_FILES)
+#ifdef __linux__
+   unsigned char vec[1024];
+#else
+   char vec[1024];
+#endif
+   long long *total = (long long *)arg, inMem = 0;
+   char *Base = (char *)(mp->Base);
+   off_t pages = (mp->Size + MM_pagsz - 1) / MM_pagsz;
+   int i, n;
+
+// Query residency a chunk of pages at a time
+//
+   while(pages > 0)
+        {n = (pages > (off_t)sizeof(vec) ? (int)sizeof(vec) : (int)pages);
+         if (mincore(Base, n*MM_pagsz, vec)) break;
+         for (i = 0; i < n; i++) if (vec[i] & 1) inMem += MM_pagsz;
+         Base += n*MM_pagsz; pages -= n;
+        }
+   *total += (inMem > mp->Size ? mp->Size : inMem);
+#endif
+   return 0;
+}
  
 /******************************************************************************/
 /*             X r d O s s d M i o F i l e   D e s t r u c t o r              */
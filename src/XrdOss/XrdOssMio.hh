@@ -56,28 +56,52 @@ static void          *preLoad(void *arg);
 
 static void           Recycle(XrdOssMioFile *mp);
 
-static void           Set(int V_off, int V_preld, int V_check);
+static void           Set(int V_off, int V_preld, int V_check,
+                          int V_huge=-1, int V_pflt=-1);
 
 static void           Set(long long V_max);
 
+static int            Stats(char *buff, int blen);
+
 private:
+static void Faults(long long *fltv, int beg);
+static void Hot(XrdOssMioFile *mp, const char *path, int populated);
 static int  Reclaim(off_t amount);
-static int  Reclaim(XrdOssMioFile *mp);
+static void Reclaim(XrdOssMioFile *mp);
+static int  Resident(const char *key, XrdOssMioFile *mp, void *arg);
+
+// Mappings are spread over MM_Shards independent shards keyed by the file's
+// device and inode. Each shard has its own lock, hash table and LRU list of
+// idle mappings so that opens of different files never contend.
+//
+static const int MM_Shards = 16;
+
+struct MioShard
+      {XrdSysMutex                 Mutex;
+       XrdOucHash<XrdOssMioFile>   Hash;
+       XrdOssMioFile              *Perm;
+       XrdOssMioFile              *Idle;
+       XrdOssMioFile              *IdleLast;
 
-static XrdOucHash<XrdOssMioFile> MM_Hash;
+       MioShard() : Perm(0), Idle(0), IdleLast(0) {}
+      };
 
-static XrdSysMutex    MM_Mutex;
-static XrdOssMioFile *MM_Perm;
-static XrdOssMioFile *MM_Idle;
-static XrdOssMioFile *MM_IdleLast;
+static MioShard   MM_Shard[MM_Shards];
+static int        MM_Rover;
 
 static char       MM_on;
 static char       MM_chk;
 static char       MM_okmlock;
 static char       MM_preld;
+static char       MM_huge;
+static char       MM_pflt;
 static long long  MM_max;
 static long long  MM_pagsz;
 static long long  MM_pages;
 static long long  MM_inuse;
+static long long  MM_maps;
+static long long  MM_reclaimed;
+static long long  MM_minflt;
+static long long  MM_majflt;
 };
 #endif
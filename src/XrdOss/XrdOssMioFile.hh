@@ -42,17 +42,20 @@ off_t Export(void **Addr) {*Addr = Base; return Size;}
 
        XrdOssMioFile(char *hname)
                     {strcpy(HashName, hname); 
-                     inUse = 1; Next = 0; Size = 0;
+                     inUse = 1; Next = 0; Prev = 0; Size = 0;
+                     onIdle = false;
                     }
       ~XrdOssMioFile();
 
 private:
 
 XrdOssMioFile *Next;
+XrdOssMioFile *Prev;
 dev_t          Dev;
 ino_t          Ino;
 int            Status;
 int            inUse;
+bool           onIdle;
 void          *Base;
 off_t          Size;
 char           HashName[64];
@@ -0,0 +1,368 @@
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d O s s U R i n g . c c                         */
+/*                                                                            */
+/* (c) 2026 by the contributors to the XRootD software suite                  */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#ifdef HAVE_IOURING
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "XrdOss/XrdOssTrace.hh"
+#include "XrdOss/XrdOssURing.hh"
+#include "XrdOuc/XrdOucIOVec.hh"
+#include "XrdSfs/XrdSfsAio.hh"
+#include "XrdSys/XrdSysAtomics.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysHeaders.hh"
+#include "XrdSys/XrdSysIOURing.hh"
+#include "XrdSys/XrdSysPthread.hh"
+#include "XrdSys/XrdSysTimer.hh"
+
+/******************************************************************************/
+/*                               G l o b a l s                                */
+/******************************************************************************/
+
+extern XrdOucTrace OssTrace;
+
+extern XrdSysError OssEroute;
+
+XrdSysIOURing *XrdOssURing::UR_Ring   = 0;
+int            XrdOssURing::UR_qdepth = 1024;
+int            XrdOssURing::UR_minvec = 2;
+int            XrdOssURing::UR_fail   = 0;
+char           XrdOssURing::UR_on     = 0;
+
+/******************************************************************************/
+/*                         L o c a l   C l a s s e s                          */
+/******************************************************************************/
+
+// Completions carry either the address of an XrdSfsAio object or, with the
+// low order bit set, the address of the following vector element. Both are
+// at least 8-byte aligned so the tag bit never collides.
+//
+namespace
+{
+const unsigned long long isVecTag = 1;
+
+class XrdOssURingGrp;
+
+struct XrdOssURingVec
+      {XrdOssURingGrp *grpP;
+       int             res;
+       bool            sent;
+      };
+
+class XrdOssURingGrp
+{
+public:
+
+XrdSysSemaphore done;
+int             pend;
+
+                XrdOssURingGrp() : done(0), pend(1) {}
+               ~XrdOssURingGrp() {}
+};
+}
+
+/******************************************************************************/
+/*                               D i s p l a y                                */
+/******************************************************************************/
+  
+void XrdOssURing::Display(XrdSysError &Eroute)
+{
+     char buff[128];
+
+     if (!UR_on) return;
+     snprintf(buff, sizeof(buff), "       oss.aio          uring qdepth %d "
+                                  "minvec %d", UR_qdepth, UR_minvec);
+     Eroute.Say(buff);
+}
+
+/******************************************************************************/
+/*                                  I n i t                                   */
+/******************************************************************************/
+
+/*
+  Function: Initialize the io_uring read engine.
+
+  Return:   True if successful, false otherwise. Upon failure reads continue to
+            use the POSIX aio and pread paths.
+*/
+
+int XrdOssURing::Init(XrdSysError &Eroute)
+{
+   EPNAME("URingInit");
+   struct io_uring_sqe mySqe;
+   struct io_uring_cqe myCqe;
+   XrdSysIOURing *rP;
+   pthread_t tid;
+   char buff[8];
+   int fd, rc;
+
+// Create the ring
+//
+   rP = new XrdSysIOURing();
+   if ((rc = rP->Init(UR_qdepth)))
+      {Eroute.Emsg("URingInit", -rc, "create io_uring; uring aio disabled.");
+       delete rP;
+       return 0;
+      }
+
+// Verify that the kernel supports non-vectored reads (Linux 5.6 or later) by
+// reading from /dev/null before any other request is on the ring.
+//
+   if ((fd = open("/dev/null", O_RDONLY)) < 0) rc = -errno;
+      else {memset(&mySqe, 0, sizeof(mySqe));
+            mySqe.opcode = IORING_OP_READ;
+            mySqe.fd     = fd;
+            mySqe.addr   = (unsigned long long)buff;
+            mySqe.len    = sizeof(buff);
+            if (!(rc = rP->Queue(mySqe)) && !(rc = rP->Wait(1)))
+               rc = (rP->Reap(&myCqe, 1) == 1 ? myCqe.res : -ETIMEDOUT);
+            close(fd);
+           }
+   if (rc)
+      {Eroute.Emsg("URingInit", -rc, "verify io_uring reads; uring aio "
+                                     "disabled.");
+       delete rP;
+       return 0;
+      }
+
+// Start the completion thread
+//
+   UR_Ring = rP;
+   if ((rc = XrdSysThread::Run(&tid, XrdOssURing::Reaper, (void *)0,
+                               0, "io_uring reaper")))
+      {Eroute.Emsg("URingInit", rc, "create io_uring reaper; uring aio "
+                                    "disabled.");
+       UR_Ring = 0;
+       delete rP;
+       return 0;
+      }
+
+// All done
+//
+   DEBUG("started io_uring reaper; qdepth=" <<UR_qdepth);
+   UR_on = 1;
+   return 1;
+}
+
+/******************************************************************************/
+/*                                  R e a d                                   */
+/******************************************************************************/
+
+/*
+  Function: Queue an asynchronous read described by the aio request object.
+
+  Output:   =0 -> Operation queued
+            >0 -> Operation not queued, the caller should use another method.
+*/
+
+int XrdOssURing::Read(XrdSfsAio *aiop, int fd)
+{
+   EPNAME("URingRead");
+   const char *tident = aiop->TIdent;
+   struct io_uring_sqe mySqe;
+   int rc;
+
+// Prepare the submission
+//
+   memset(&mySqe, 0, sizeof(mySqe));
+   mySqe.opcode    = IORING_OP_READ;
+   mySqe.fd        = fd;
+   mySqe.addr      = (unsigned long long)aiop->sfsAio.aio_buf;
+   mySqe.len       = (unsigned int)aiop->sfsAio.aio_nbytes;
+   mySqe.off       = (unsigned long long)aiop->sfsAio.aio_offset;
+   mySqe.user_data = (unsigned long long)aiop;
+
+// Queue and submit it. Failures are reported once every 1024 events.
+//
+   if ((rc = UR_Ring->Queue(mySqe)))
+      {int fcnt = AtomicInc(UR_fail);
+       if ((fcnt & 0x3ff) == 0) OssEroute.Emsg("URingRead", -rc, "queue read");
+       return 1;
+      }
+
+   TRACE(Debug, "Read " <<aiop->sfsAio.aio_nbytes <<'@'
+                        <<aiop->sfsAio.aio_offset <<" queued; aiocb="
+                        <<std::hex <<aiop <<std::dec);
+   return 0;
+}
+
+/******************************************************************************/
+/*                                 R e a d V                                  */
+/******************************************************************************/
+
+/*
+  Function: Perform all the reads specified in the readV vector as a single
+            io_uring submission and wait for all of them to complete.
+
+  Output:   Returns the number of bytes read upon success and -errno o/w. If
+            the number of bytes read is less than requested, it is considered
+            an error (-ESPIPE) as is the case for XrdOssFile::ReadV().
+*/
+
+ssize_t XrdOssURing::ReadV(int fd, XrdOucIOVec *readV, int n)
+{
+   XrdOssURingGrp  myGrp;
+   XrdOssURingVec  vecStack[64], *vecP;
+   struct io_uring_sqe mySqe;
+   ssize_t rdsz, totBytes = 0;
+   int i, rc = 0;
+
+// Allocate the completion vector
+//
+   vecP = (n <= 64 ? vecStack : new XrdOssURingVec[n]);
+
+// Queue every element without submitting; the ring pushes entries to the
+// kernel on its own should it fill up. Each element adds a reference to the
+// group so that the last completion wakes us up.
+//
+   memset(&mySqe, 0, sizeof(mySqe));
+   mySqe.opcode = IORING_OP_READ;
+   mySqe.fd     = fd;
+   for (i = 0; i < n; i++)
+       {vecP[i].grpP = &myGrp;
+        vecP[i].res  = 0;
+        vecP[i].sent = false;
+        if (rc || readV[i].size <= 0) continue;
+        mySqe.addr      = (unsigned long long)readV[i].data;
+        mySqe.len       = (unsigned int)readV[i].size;
+        mySqe.off       = (unsigned long long)readV[i].offset;
+        mySqe.user_data = (unsigned long long)&vecP[i] | isVecTag;
+        AtomicInc(myGrp.pend);
+        if ((rc = UR_Ring->Queue(mySqe, false))) AtomicDec(myGrp.pend);
+           else vecP[i].sent = true;
+       }
+
+// Submit the batch. Queued entries cannot be taken back and their completions
+// refer to our stack, so we must wait for them. Hence, a failed submission is
+// retried until the kernel has accepted everything (the reaper also submits
+// whatever is left each time it waits). Failures are reported once every 1024.
+//
+   while((rc = UR_Ring->Submit()) < 0)
+        {int fcnt = AtomicInc(UR_fail);
+         if ((fcnt & 0x3ff) == 0) OssEroute.Emsg("URingReadV",-rc,"submit reads");
+         XrdSysTimer::Wait(1);
+        }
+
+// Drop our reference. If anything is still pending, we must wait for the
+// reaper to tell us that all is done.
+//
+   if (AtomicDec(myGrp.pend) != 1) myGrp.done.Wait();
+
+// Check the results. Elements that could not be queued, were interrupted, or
+// came back short are (re)done synchronously to preserve ReadV() semantics.
+//
+   for (i = 0; i < n; i++)
+       {if (readV[i].size <= 0) continue;
+        rdsz = vecP[i].res;
+        if (!vecP[i].sent || rdsz == -EAGAIN || rdsz == -EINTR) rdsz = 0;
+        if (rdsz < 0) {totBytes = rdsz; break;}
+        if (rdsz < readV[i].size)
+           {ssize_t more;
+            do {more = pread(fd, readV[i].data+rdsz, readV[i].size-rdsz,
+                             readV[i].offset+rdsz);
+               } while(more < 0 && errno == EINTR);
+            if (more < 0) {totBytes = -errno; break;}
+            rdsz += more;
+            if (rdsz != readV[i].size) {totBytes = -ESPIPE; break;}
+           }
+        totBytes += rdsz;
+       }
+
+// All done
+//
+   if (vecP != vecStack) delete [] vecP;
+   return totBytes;
+}
+
+/******************************************************************************/
+/*                                R e a p e r                                 */
+/******************************************************************************/
+
+void *XrdOssURing::Reaper(void *arg)
+{
+   static const int maxCqe = 256;
+   struct io_uring_cqe cqeTab[maxCqe];
+   int i, n, rc;
+
+// Wait for completions and dispatch them
+//
+   do {if ((rc = UR_Ring->Wait(1)) < 0)
+          {OssEroute.Emsg("URingReaper", -rc, "wait for io_uring events");
+           XrdSysTimer::Wait(100);
+           continue;
+          }
+       while((n = UR_Ring->Reap(cqeTab, maxCqe)) > 0)
+            for (i = 0; i < n; i++) Done(cqeTab[i].user_data, cqeTab[i].res);
+      } while(1);
+
+   return (void *)0;
+}
+
+/******************************************************************************/
+/*                                   S e t                                    */
+/******************************************************************************/
+
+void XrdOssURing::Set(int qdepth, int minvec)
+{
+   if (qdepth > 0) UR_qdepth = qdepth;
+   if (minvec > 0) UR_minvec = minvec;
+}
+
+/******************************************************************************/
+/*                       P r i v a t e   M e t h o d s                        */
+/******************************************************************************/
+/******************************************************************************/
+/*                                  D o n e                                   */
+/******************************************************************************/
+
+void XrdOssURing::Done(unsigned long long utag, int res)
+{
+   EPNAME("URingDone");
+
+// Handle a vector element
+//
+   if (utag & isVecTag)
+      {XrdOssURingVec *vP = (XrdOssURingVec *)(utag & ~isVecTag);
+       XrdOssURingGrp *gP = vP->grpP;
+       vP->res = res;
+       if (AtomicDec(gP->pend) == 1) gP->done.Post();
+       return;
+      }
+
+// Handle an asynchronous read
+//
+   XrdSfsAio *aiop = (XrdSfsAio *)utag;
+   DEBUG("read completed for " <<aiop->TIdent <<"; result=" <<res
+         <<" aiocb=" <<std::hex <<aiop <<std::dec);
+   aiop->Result = res;
+   aiop->doneRead();
+}
+#endif
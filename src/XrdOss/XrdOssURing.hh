@@ -0,0 +1,69 @@
+#ifndef __XRDOSSURING_H__
+#define __XRDOSSURING_H__
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d O s s U R i n g . h h                         */
+/*                                                                            */
+/* (c) 2026 by the contributors to the XRootD software suite                  */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <sys/types.h>
+
+struct XrdOucIOVec;
+class XrdSfsAio;
+class XrdSysError;
+class XrdSysIOURing;
+
+// XrdOssURing issues file reads via a shared io_uring instance. Asynchronous
+// reads complete through the normal XrdSfsAio::doneRead() callback while a
+// vector read is submitted as a single batch and waited for as a whole.
+//
+class XrdOssURing
+{
+public:
+static void          Display(XrdSysError &Eroute);
+
+static int           Init(XrdSysError &Eroute);
+
+static char          isOn() {return UR_on;}
+
+static int           Read(XrdSfsAio *aiop, int fd);
+
+static ssize_t       ReadV(int fd, XrdOucIOVec *readV, int n);
+
+static void         *Reaper(void *arg);
+
+static void          Set(int qdepth, int minvec);
+
+static bool          useVec(int n) {return UR_on && n >= UR_minvec;}
+
+private:
+static void          Done(unsigned long long utag, int res);
+
+static XrdSysIOURing *UR_Ring;
+static int            UR_qdepth;
+static int            UR_minvec;
+static int            UR_fail;
+static char           UR_on;
+};
+#endif
@@ -0,0 +1,191 @@
+#ifndef __OUC_FLATHASH__
+#define __OUC_FLATHASH__
+/******************************************************************************/
+/*                                                                            */
+/*                     X r d O u c F l a t H a s h . h h                      */
+/*                                                                            */
+/* (c) 2026 by the contributors to the XRootD software suite                  */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "XrdOuc/XrdOucHash.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+/* XrdOucFlatHash is a drop-in replacement for XrdOucHash using open
+   addressing. Items live in a single power-of-two table and are found by
+   probing groups of 16 one-byte control tags, 16 at a time with SSE2 where
+   available. Keys of up to KeyInline-1 characters are held in the item
+   itself so that adding them needs no allocation; longer keys (and keys
+   added with Hash_data_is_key, whose address must not change) are strdup'd
+   as in XrdOucHash. All XrdOucHash_Options and lifetimes work the same way.
+
+   A table created read-mostly carries its own r/w lock: Find() then only
+   takes the read lock and leaves expired entries for the next update to
+   remove, so many threads may look up concurrently. Otherwise the table is,
+   like XrdOucHash, not thread safe. Note that the function passed to Apply()
+   of a read-mostly table must not call back into the table.
+*/
+
+template<class T>
+class XrdOucFlatHash_Item
+{
+public:
+static const int     KeyInline = 24;
+
+int                  Count() {return keycount;}
+
+T                   *Data() {return keydata;}
+
+unsigned long long   Hash() {return keyhash;}
+
+const char          *Key()  {return keyval ? keyval : keybuf;}
+
+time_t               Time() {return keytime;}
+
+void                 Update(int newcount, time_t newtime)
+                           {keycount = newcount;
+                            if (newtime) keytime = newtime;
+                           }
+
+int                  Same(unsigned long long KeyHash, const char *KeyVal)
+                         {return keyhash == KeyHash && !strcmp(Key(), KeyVal);}
+
+void                 Set(unsigned long long  KeyHash,
+                         const char         *KeyVal,
+                         int                 KeyLen,
+                         T                  *KeyData,
+                         time_t              KeyTime,
+                         XrdOucHash_Options  KeyOpts)
+                        {keyhash = KeyHash;
+                         if (KeyOpts & Hash_keep) keyval = KeyVal;
+                            else if (KeyLen < KeyInline
+                                 && !(KeyOpts & Hash_data_is_key))
+                                    {memcpy(keybuf, KeyVal, KeyLen+1);
+                                     keyval = 0;
+                                    }
+                            else if (!(keyval = strdup(KeyVal))) throw ENOMEM;
+                         if (KeyOpts & Hash_data_is_key) keydata = (T *)keyval;
+                            else keydata = KeyData;
+                         keytime = KeyTime;
+                         entopts = KeyOpts;
+                         keycount= 0;
+                        }
+
+void                 Clear()
+                          {if (!(entopts & Hash_keep))
+                              {if (keydata && keydata != (T *)keyval
+                               && !(entopts & Hash_keepdata))
+                                  {if (entopts & Hash_dofree) free(keydata);
+                                      else delete keydata;
+                                  }
+                               if (keyval) free((void *)keyval);
+                              }
+                           keydata = 0; keyval = 0; keycount = 0;
+                          }
+
+private:
+
+unsigned long long  keyhash;
+const char         *keyval;     // 0 when the key is in keybuf
+T                  *keydata;
+time_t              keytime;
+int                 keycount;
+XrdOucHash_Options  entopts;
+char                keybuf[KeyInline];
+};
+
+template<class T>
+class XrdOucFlatHash
+{
+public:
+
+// The methods behave exactly as the XrdOucHash methods of the same name.
+//
+T           *Add(const char *KeyVal, T *KeyData, const int LifeTime=0,
+                 XrdOucHash_Options opt=Hash_default);
+
+int          Del(const char *KeyVal, XrdOucHash_Options opt = Hash_default);
+
+T           *Find(const char *KeyVal, time_t *KeyTime=0);
+
+int          Num() {return hashnum;}
+
+void         Purge();
+
+T           *Rep(const char *KeyVal, T *KeyData, const int LifeTime=0,
+                 XrdOucHash_Options opt=Hash_default)
+                {return Add(KeyVal, KeyData, LifeTime,
+                            (XrdOucHash_Options)(opt | Hash_replace));}
+
+T           *Apply(int (*func)(const char *, T *, void *), void *Arg);
+
+// The constructor takes the XrdOucHash arguments, psize is not used and the
+// table is rounded up to a power of two of at least 16 items. The load is
+// capped at 87 percent. Specify rdmostly to allow concurrent lookups.
+//
+    XrdOucFlatHash(int psize = 89, int size=144, int load=80,
+                   bool rdmostly=false);
+   ~XrdOucFlatHash() {if (hashtable) {Purge(); free(hashtable);
+                                      free(hashctrl); hashtable = 0;
+                                     }
+                      delete hashlock;
+                     }
+
+private:
+static const int GroupSize = 16;
+
+int          Free(unsigned long long khash);
+
+static
+unsigned long long HashVal(const char *KeyVal, int &KeyLen);
+
+int          Holes(int grp);
+
+int          Match(int grp, signed char tag);
+
+void         Remove(int kent);
+
+void         Resize(int newsize);
+
+int          Search(unsigned long long khash, const char *kval);
+
+XrdOucFlatHash_Item<T> *hashtable;
+signed char            *hashctrl;   // Tag per item, <0 if empty or deleted
+XrdSysRWLock           *hashlock;   // Only for a read-mostly table
+int                     hashtablesize;
+int                     hashnum;
+int                     hashdel;    // Deleted items still occupying slots
+int                     hashmax;
+int                     hashload;
+};
+
+/******************************************************************************/
+/*                 A c t u a l   I m p l e m e n t a t i o n                  */
+/******************************************************************************/
+
+#include "XrdOuc/XrdOucFlatHash.icc"
+#endif
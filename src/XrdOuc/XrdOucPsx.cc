@@ -654,6 +654,7 @@ bool XrdOucPsx::ParseSet(XrdSysError *Eroute, XrdOucStream &Config)
          {"DebugLevel",            "*",0},                   // Default   -1
          {"DebugMask",             "*",0},                   // Default   -1
          {"DirlistAll",            "DirlistAll",0},
+         {"DirlistStat",           "DirlistStat",1},         // Default    0
          {"DataServerTTL",         "DataServerTTL",1},       // Default  300
          {"LBServerConn_ttl",      "LoadBalancerTTL",1},     // Default 1200
          {"LoadBalancerTTL",       "LoadBalancerTTL",1},     // Default 1200
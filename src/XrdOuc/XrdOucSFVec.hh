@@ -46,6 +46,6 @@ struct XrdOucSFVec {union {char *buffer;    //!< ->Data if fdnum < 0
                     int   sendsz;           //!< Length of data at offset
                     int   fdnum;            //!< File descriptor for data
 
-                    enum {sfMax = 16};      //!< Maximum number of elements
+                    enum {sfMax = 256};     //!< Maximum number of elements
                    };
 #endif
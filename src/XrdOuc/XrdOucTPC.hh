@@ -38,7 +38,8 @@ public:
 
 static
 const char *cgiC2Dst(const char *cKey, const char *xSrc, const char *xLfn,
-                     const char *xCks,       char *Buff, int Blen);
+                     const char *xCks,       char *Buff, int Blen,
+                     int         xStr=0);
 
 static
 const char *cgiC2Src(const char *cKey, const char *xDst, int xTTL,
@@ -61,6 +62,8 @@ const char *tpcOrg;
 static
 const char *tpcSrc;
 static
+const char *tpcStr;
+static
 const char *tpcTtl;
 
             XrdOucTPC() {}
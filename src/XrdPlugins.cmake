@@ -10,6 +10,7 @@ set( LIB_XRD_PSS        XrdPss-${PLUGIN_VERSION} )
 set( LIB_XRD_GPFS       XrdOssSIgpfsT-${PLUGIN_VERSION} )
 set( LIB_XRD_ZCRC32     XrdCksCalczcrc32-${PLUGIN_VERSION} )
 set( LIB_XRD_THROTTLE   XrdThrottle-${PLUGIN_VERSION} )
+set( LIB_XRD_TPCXFR     XrdOfsTPCXfr-${PLUGIN_VERSION} )
 
 #-------------------------------------------------------------------------------
 # Shared library version
@@ -25,7 +26,8 @@ add_library(
   XrdPss/XrdPssAioCB.cc      XrdPss/XrdPssAioCB.hh
   XrdPss/XrdPss.cc           XrdPss/XrdPss.hh
   XrdPss/XrdPssCks.cc        XrdPss/XrdPssCks.hh
-  XrdPss/XrdPssConfig.cc )
+  XrdPss/XrdPssConfig.cc
+  XrdPss/XrdPssPipe.cc       XrdPss/XrdPssPipe.hh )
 
 target_link_libraries(
   ${LIB_XRD_PSS}
@@ -133,6 +135,7 @@ add_library(
   XrdThrottle/XrdThrottleFileSystemConfig.cc
   XrdThrottle/XrdThrottleFile.cc
   XrdThrottle/XrdThrottleManager.cc    XrdThrottle/XrdThrottleManager.hh
+  XrdThrottle/XrdThrottleHTB.cc        XrdThrottle/XrdThrottleHTB.hh
 )
 
 target_link_libraries(
@@ -146,9 +149,29 @@ set_target_properties(
   INTERFACE_LINK_LIBRARIES ""
   LINK_INTERFACE_LIBRARIES "" )
 
+#-------------------------------------------------------------------------------
+# The in-process third party copy engine
+#-------------------------------------------------------------------------------
+add_library(
+  ${LIB_XRD_TPCXFR}
+  MODULE
+  XrdOfs/XrdOfsTPCXfrCl.cc )
+
+target_link_libraries(
+  ${LIB_XRD_TPCXFR}
+  XrdCl
+  XrdUtils
+  pthread )
+
+set_target_properties(
+  ${LIB_XRD_TPCXFR}
+  PROPERTIES
+  INTERFACE_LINK_LIBRARIES ""
+  LINK_INTERFACE_LIBRARIES "" )
+
 #-------------------------------------------------------------------------------
 # Install
 #-------------------------------------------------------------------------------
 install(
-  TARGETS ${LIB_XRD_PSS} ${LIB_XRD_BWM} ${LIB_XRD_GPFS} ${LIB_XRD_ZCRC32} ${LIB_XRD_THROTTLE} ${LIB_XRD_N2NO2P}
+  TARGETS ${LIB_XRD_PSS} ${LIB_XRD_BWM} ${LIB_XRD_GPFS} ${LIB_XRD_ZCRC32} ${LIB_XRD_THROTTLE} ${LIB_XRD_N2NO2P} ${LIB_XRD_TPCXFR}
   LIBRARY DESTINATION ${CMAKE_INSTALL_LIBDIR} )
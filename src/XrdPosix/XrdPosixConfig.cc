@@ -44,6 +44,7 @@
 #include "XrdPosix/XrdPosixFileRH.hh"
 #include "XrdPosix/XrdPosixMap.hh"
 #include "XrdPosix/XrdPosixPrepIO.hh"
+#include "XrdPosix/XrdPosixStatCache.hh"
 #include "XrdPosix/XrdPosixTrace.hh"
 #include "XrdPosix/XrdPosixXrootd.hh"
 #include "XrdPosix/XrdPosixXrootdPath.hh"
@@ -307,6 +308,8 @@ void XrdPosixConfig::SetEnv(const char *kword, int kval)
             XrdPosixGlobals::dlFlag = (kval ? XrdCl::DirListFlags::Locate
                                             : XrdCl::DirListFlags::None);
            }
+   else if (!strcmp(kword, "DirlistStat"))
+           XrdPosixStatCache::TTL = (kval > 0 ? kval : 0);
    else env->PutInt((std::string)kword, kval);
 }
   
@@ -31,6 +31,8 @@
 
 #include "XrdPosix/XrdPosixDir.hh"
 #include "XrdPosix/XrdPosixMap.hh"
+#include "XrdPosix/XrdPosixStatCache.hh"
+#include "XrdPosix/XrdPosixXrootd.hh"
 
 /******************************************************************************/
 /*                               G l o b a l s                                */
@@ -83,6 +85,14 @@ dirent64 *XrdPosixDir::nextEntry(dirent64 *dp)
    dp->d_reclen = d_nlen + dirhdrln;
    strncpy(dp->d_name, d_name, d_nlen);
    dp->d_name[d_nlen] = '\0';
+
+// Return the stat information for the entry if so wanted
+//
+   if (statBuf)
+      {XrdPosixXrootd::initStat(statBuf);
+       if (dirEnt->GetStatInfo())
+          XrdPosixStatCache::Set(*statBuf, *(dirEnt->GetStatInfo()));
+      }
    nxtEnt++;
    return dp;
 }
@@ -94,6 +104,7 @@ dirent64 *XrdPosixDir::nextEntry(dirent64 *dp)
 DIR *XrdPosixDir::Open()
 {
    static const size_t dEntSize = sizeof(dirent64) + maxDlen + 1;
+   XrdCl::DirListFlags::Flags dlFlags = XrdPosixGlobals::dlFlag;
    int rc;
 
 // Allocate a local dirent. Note that we get additional padding because on
@@ -102,18 +113,48 @@ DIR *XrdPosixDir::Open()
    if (!myDirEnt && !(myDirEnt = (dirent64 *)malloc(dEntSize)))
       {errno = ENOMEM; return (DIR *)0;}
 
+// Ask for the stat information of every entry (kXR_dstat) if someone wants it
+//
+   if (wantStat || XrdPosixStatCache::TTL) dlFlags |= XrdCl::DirListFlags::Stat;
+
 // Get the directory list
 //
    rc = XrdPosixMap::Result(DAdmin.Xrd.DirList(DAdmin.Url.GetPathWithParams(),
-                                               XrdPosixGlobals::dlFlag,
-                                               myDirVec, (uint16_t)0));
+                                               dlFlags, myDirVec, (uint16_t)0));
 
 // If we failed, return a zero pointer
 //
    if (rc) return (DIR *)0;
 
+// Remember the stat information so that a following stat() of any entry does
+// not need a round trip
+//
+   if (XrdPosixStatCache::TTL) XrdPosixStatCache::Add(DAdmin.Url, *myDirVec);
+
 // Finish up
 //
    numEnt = myDirVec->GetSize();
    return (DIR *)&fdNum;
 }
+
+/******************************************************************************/
+/*                               S t a t R e t                                */
+/******************************************************************************/
+
+int XrdPosixDir::StatRet(struct stat *buf)
+{
+
+// Record the buffer. If we already have the stat information we are done.
+//
+   statBuf = buf;
+   if (!buf || wantStat) return 0;
+   wantStat = true;
+   if (myDirVec && (!numEnt || myDirVec->At(0)->GetStatInfo())) return 0;
+
+// We need to list the directory again, this time with stat information. That
+// can only be done if no entries have been returned yet.
+//
+   if (nxtEnt) {statBuf = 0; wantStat = false; return ENOTSUP;}
+   delete myDirVec; myDirVec = 0;
+   return 0;
+}
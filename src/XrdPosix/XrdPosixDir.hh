@@ -40,6 +40,7 @@
 #endif
 
 #include <unistd.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 
 #include "XrdPosix/XrdPosixAdmin.hh"
@@ -50,7 +51,8 @@ class XrdPosixDir : public XrdPosixObject
 public:
                    XrdPosixDir(const char *path)
                               : DAdmin(path), myDirVec(0), myDirEnt(0),
-                                nxtEnt(0), numEnt(0), eNum(0)
+                                statBuf(0), nxtEnt(0), numEnt(0), eNum(0),
+                                wantStat(false)
                               {}
 
                   ~XrdPosixDir() {delete myDirVec;
@@ -75,6 +77,8 @@ static int         dirNo(DIR *dirP)  {return *(int *)dirP;}
                             }
        int         Status() {return eNum;}
 
+       int         StatRet(struct stat *buf);
+
        bool        Unread() {return myDirVec == 0;}
 
        using       XrdPosixObject::Who;
@@ -87,8 +91,10 @@ private:
   XrdPosixAdmin         DAdmin;
   XrdCl::DirectoryList *myDirVec;
   dirent64             *myDirEnt;
+  struct stat          *statBuf;
   uint32_t              nxtEnt;
   uint32_t              numEnt;
   int                   eNum;
+  bool                  wantStat;
 };
 #endif
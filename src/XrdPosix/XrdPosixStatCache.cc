@@ -0,0 +1,177 @@
+/******************************************************************************/
+/*                                                                            */
+/*                  X r d P o s i x S t a t C a c h e . c c                   */
+/*                                                                            */
+/* (c) 2026 by the contributors to the XRootD software suite                  */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+#include "XrdCl/XrdClURL.hh"
+#include "XrdCl/XrdClXRootDResponses.hh"
+#include "XrdOuc/XrdOucHash.hh"
+#include "XrdPosix/XrdPosixMap.hh"
+#include "XrdPosix/XrdPosixStatCache.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+/******************************************************************************/
+/*                        S t a t i c   M e m b e r s                         */
+/******************************************************************************/
+
+int XrdPosixStatCache::TTL = 0;
+
+namespace
+{
+XrdSysMutex              statMutex;
+XrdOucHash<struct stat>  statTab;
+
+static const int         maxEnt = 262144;
+}
+
+/******************************************************************************/
+/*                         L o c a l   M e t h o d s                          */
+/******************************************************************************/
+
+namespace
+{
+// Apply() removes expired entries on its own, so there is nothing to do here.
+//
+int Expired(const char *key, struct stat *sP, void *arg) {return 0;}
+
+// Keys are "login@host:port/path" with redundant slashes removed. The login
+// is part of the key as what may be listed and stat'ed depends on who asks.
+//
+void MakeKey(std::string &key, XrdCl::URL &url, const std::string *name=0)
+{
+   const std::string &path = url.GetPath();
+   char pbuff[16];
+   size_t pfxLen;
+
+   snprintf(pbuff, sizeof(pbuff), ":%d/", url.GetPort());
+   key  = url.GetUserName();
+   key += '@';
+   key += url.GetHostName();
+   key += pbuff;
+   pfxLen = key.size();
+
+   for (size_t i = 0; i < path.size(); i++)
+       if (path[i] != '/' || key[key.size()-1] != '/') key += path[i];
+
+   if (name) {if (key[key.size()-1] != '/') key += '/';
+              key += *name;
+             }
+   if (key.size() > pfxLen && key[key.size()-1] == '/') key.erase(key.size()-1);
+}
+}
+
+/******************************************************************************/
+/*                                   A d d                                    */
+/******************************************************************************/
+
+void XrdPosixStatCache::Add(XrdCl::URL &dirUrl, XrdCl::DirectoryList &dList)
+{
+   XrdCl::DirectoryList::Iterator it;
+   XrdCl::StatInfo *sInfo;
+   struct stat *sP;
+   std::string key;
+   XrdSysMutexHelper mHelp(statMutex);
+
+// Make room if need be. We first try to get rid of expired entries and if that
+// fails to make room we simply start over.
+//
+   if (statTab.Num() >= maxEnt)
+      {statTab.Apply(Expired, 0);
+       if (statTab.Num() >= maxEnt/2) statTab.Purge();
+      }
+
+// Add each entry that has stat information
+//
+   for (it = dList.Begin(); it != dList.End(); ++it)
+       {if (!(sInfo = (*it)->GetStatInfo())) continue;
+        if (statTab.Num() >= maxEnt) break;
+        MakeKey(key, dirUrl, &((*it)->GetName()));
+        sP = new struct stat;
+        memset(sP, 0, sizeof(struct stat));
+        Set(*sP, *sInfo);
+        statTab.Rep(key.c_str(), sP, TTL);
+       }
+}
+
+/******************************************************************************/
+/*                                   D e l                                    */
+/******************************************************************************/
+
+void XrdPosixStatCache::Del(XrdCl::URL &url)
+{
+   std::string key;
+   XrdSysMutexHelper mHelp(statMutex);
+
+   MakeKey(key, url);
+   statTab.Del(key.c_str());
+}
+
+/******************************************************************************/
+/*                                  F i n d                                   */
+/******************************************************************************/
+
+bool XrdPosixStatCache::Find(XrdCl::URL &url, struct stat &buf)
+{
+   struct stat *sP;
+   std::string key;
+   XrdSysMutexHelper mHelp(statMutex);
+
+// Look up the entry, expired entries are not returned
+//
+   MakeKey(key, url);
+   if (!(sP = statTab.Find(key.c_str()))) return false;
+
+// Return the fields that we know about
+//
+   buf.st_size   = sP->st_size;
+   buf.st_blocks = sP->st_blocks;
+   buf.st_atime  = buf.st_mtime = buf.st_ctime = sP->st_mtime;
+   buf.st_ino    = sP->st_ino;
+   buf.st_rdev   = sP->st_rdev;
+   buf.st_mode   = sP->st_mode;
+   return true;
+}
+
+/******************************************************************************/
+/*                                   S e t                                    */
+/******************************************************************************/
+
+void XrdPosixStatCache::Set(struct stat &buf, XrdCl::StatInfo &sInfo)
+{
+   dev_t stRdev;
+
+   buf.st_size   = static_cast<size_t>(sInfo.GetSize());
+   buf.st_blocks = buf.st_size/512+1;
+   buf.st_atime  = buf.st_mtime = buf.st_ctime
+                 = static_cast<time_t>(sInfo.GetModTime());
+   buf.st_ino    = static_cast<ino_t>(strtoll(sInfo.GetId().c_str(), 0, 10));
+   buf.st_mode   = XrdPosixMap::Flags2Mode(&stRdev, sInfo.GetFlags());
+   buf.st_rdev   = stRdev;
+}
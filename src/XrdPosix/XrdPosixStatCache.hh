@@ -0,0 +1,63 @@
+#ifndef __XRDPOSIXSTATCACHE_HH__
+#define __XRDPOSIXSTATCACHE_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                  X r d P o s i x S t a t C a c h e . h h                   */
+/*                                                                            */
+/* (c) 2026 by the contributors to the XRootD software suite                  */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <sys/stat.h>
+
+namespace XrdCl
+{
+class DirectoryList;
+class StatInfo;
+class URL;
+}
+
+//-----------------------------------------------------------------------------
+//! XrdPosixStatCache holds the stat information returned by directory listings
+//! made with kXR_dstat for a short time (TTL seconds). A Stat() of an entry
+//! that was just listed (e.g. ls -l or a fuse getattr) is then answered
+//! without a round trip. Entries are keyed by login, host, port, and path so
+//! that an entry is only returned for the login that listed it. Changes made
+//! through another login or elsewhere may go unseen for up to TTL seconds. The
+//! cache is disabled when TTL is zero, the default.
+//-----------------------------------------------------------------------------
+
+class XrdPosixStatCache
+{
+public:
+
+static void Add(XrdCl::URL &dirUrl, XrdCl::DirectoryList &dList);
+
+static void Del(XrdCl::URL &url);
+
+static bool Find(XrdCl::URL &url, struct stat &buf);
+
+static void Set(struct stat &buf, XrdCl::StatInfo &sInfo);
+
+static int  TTL;
+};
+#endif
@@ -65,6 +65,7 @@
 #include "XrdPosix/XrdPosixFileRH.hh"
 #include "XrdPosix/XrdPosixMap.hh"
 #include "XrdPosix/XrdPosixPrepIO.hh"
+#include "XrdPosix/XrdPosixStatCache.hh"
 #include "XrdPosix/XrdPosixTrace.hh"
 #include "XrdPosix/XrdPosixXrootd.hh"
 #include "XrdPosix/XrdPosixXrootdPath.hh"
@@ -563,6 +564,13 @@ int XrdPosixXrootd::Open(const char *path, int oflags, mode_t mode,
       else if (oflags & O_TRUNC && Opts & XrdPosixFile::isUpdt)
               XOflags |= XrdCl::OpenFlags::Delete;
 
+// A file opened for update invalidates any stat information we may have
+//
+   if (Opts & XrdPosixFile::isUpdt && XrdPosixStatCache::TTL)
+      {XrdCl::URL theUrl((std::string)path);
+       XrdPosixStatCache::Del(theUrl);
+      }
+
 // Allocate the new file object
 //
    if (!(fp = new XrdPosixFile(aOK, path, cbP, Opts)))
@@ -994,6 +1002,13 @@ int XrdPosixXrootd::Rename(const char *oldpath, const char *newpath)
        XrdPosixGlobals::theCache->Rename(oldF.path, newF.path);
       }
 
+// Forget any stat information we may have for either file
+//
+   if (XrdPosixStatCache::TTL)
+      {XrdPosixStatCache::Del(admin.Url);
+       XrdPosixStatCache::Del(newUrl);
+      }
+
 // Issue the rename
 //
   return XrdPosixMap::Result(admin.Xrd.Mv(admin.Url.GetPathWithParams(),
@@ -1037,6 +1052,10 @@ int XrdPosixXrootd::Rmdir(const char *path)
        XrdPosixGlobals::theCache->Rmdir(rmd.path);
       }
 
+// Forget any stat information we may have for it
+//
+   if (XrdPosixStatCache::TTL) XrdPosixStatCache::Del(admin.Url);
+
 // Issue the rmdir
 //
    return XrdPosixMap::Result(admin.Xrd.RmDir(admin.Url.GetPathWithParams()));
@@ -1096,6 +1115,11 @@ int XrdPosixXrootd::Stat(const char *path, struct stat *buf)
       if (rc < 0) {errno = -rc; return -1;}
      }
 
+// Check if the entry was recently listed along with its stat information
+//
+   if (XrdPosixStatCache::TTL && XrdPosixStatCache::Find(admin.Url, *buf))
+      return 0;
+
 // Issue the stat and verify that all went well
 //
    if (!admin.Stat(&stFlags, &stMtime, &stSize, &stId, &stRdev)) return -1;
@@ -1213,6 +1237,27 @@ int XrdPosixXrootd::Statvfs(const char *path, struct statvfs *buf)
    return 0;
 }
 
+/******************************************************************************/
+/*                               S t a t R e t                                */
+/******************************************************************************/
+
+int XrdPosixXrootd::StatRet(DIR *dirp, struct stat *buf)
+{
+   XrdPosixDir *dP;
+   int rc, fildes = XrdPosixDir::dirNo(dirp);
+
+// Find the object
+//
+   if (!(dP = XrdPosixObject::Dir(fildes))) {errno = EBADF; return -1;}
+
+// Set the stat buffer
+//
+   rc = dP->StatRet(buf);
+   dP->UnLock();
+   if (rc) {errno = rc; return -1;}
+   return 0;
+}
+
 /******************************************************************************/
 /*                                T e l l d i r                               */
 /******************************************************************************/
@@ -1256,6 +1301,10 @@ int XrdPosixXrootd::Truncate(const char *path, off_t Size)
        XrdPosixGlobals::theCache->Truncate(trunc.path, tSize);
       }
 
+// Forget any stat information we may have for it
+//
+   if (XrdPosixStatCache::TTL) XrdPosixStatCache::Del(admin.Url);
+
 // Issue the truncate to the origin
 //
    std::string urlp = admin.Url.GetPathWithParams();
@@ -1282,6 +1331,10 @@ int XrdPosixXrootd::Unlink(const char *path)
        XrdPosixGlobals::theCache->Unlink(remf.path);
       }
 
+// Forget any stat information we may have for it
+//
+   if (XrdPosixStatCache::TTL) XrdPosixStatCache::Del(admin.Url);
+
 // Issue the UnLink
 //
    return XrdPosixMap::Result(admin.Xrd.Rm(admin.Url.GetPathWithParams()));
@@ -1451,6 +1504,8 @@ void XrdPosixXrootd::setEnv(const char *kword, int kval)
             XrdPosixGlobals::dlFlag = (kval ? XrdCl::DirListFlags::Locate
                                             : XrdCl::DirListFlags::None);
            }
+   else if (!strcmp(kword, "DirlistStat"))
+           XrdPosixStatCache::TTL = (kval > 0 ? kval : 0);
    else env->PutInt((std::string)kword, kval);
 }
   
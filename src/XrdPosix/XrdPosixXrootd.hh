@@ -296,6 +296,16 @@ static int     Statfs(const char *path, struct statfs *buf);
 
 static int     Statvfs(const char *path, struct statvfs *buf);
 
+//-----------------------------------------------------------------------------
+//! StatRet() sets the buffer into which Readdir() and its variants place the
+//! stat information of each entry they return (readdir-plus). The listing is
+//! obtained with the stat information in a single request. A directory that
+//! was listed without it is listed again, which is only possible before any
+//! entry has been read. Returns 0 upon success and -1 with errno otherwise.
+//-----------------------------------------------------------------------------
+
+static int     StatRet(DIR *dirp, struct stat *buf); // Readdir extension!
+
 //-----------------------------------------------------------------------------
 //! Telldir() conforms to POSIX.1-2001 telldir()
 //-----------------------------------------------------------------------------
@@ -386,6 +396,7 @@ static void    setN2N(XrdOucName2Name *pN2N, int opts=0);
 static void    setSched(XrdScheduler *sP);
 
 private:
+friend class XrdPosixDir;
 
 static int  Fault(XrdPosixFile *fp, int ecode);
 static void initStat(struct stat *buf);
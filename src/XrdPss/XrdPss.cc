@@ -50,6 +50,7 @@
 #include "XrdFfs/XrdFfsPosix.hh"
 #include "XrdNet/XrdNetSecurity.hh"
 #include "XrdPss/XrdPss.hh"
+#include "XrdPss/XrdPssPipe.hh"
 #include "XrdPosix/XrdPosixConfig.hh"
 #include "XrdPosix/XrdPosixXrootd.hh"
 
@@ -598,6 +599,36 @@ int XrdPssDir::Readdir(char *buff, int blen)
    return -XRDOSS_E8002;
 }
 
+/******************************************************************************/
+/*                               S t a t R e t                                */
+/******************************************************************************/
+
+/*
+  Function: Set the stat buffer in which the stat information for each entry
+            returned by Readdir() is to be placed.
+
+  Input:    buff       - Pointer to the stat buffer.
+
+  Output:   Upon success, return 0.
+
+            Upon failure, returns a (-errno).
+
+  Notes:    The origin returns the stat information along with the listing
+            (kXR_dstat) so that no additional round trips are needed.
+
+  Warning: The caller must provide proper serialization.
+*/
+int XrdPssDir::StatRet(struct stat *buff)
+{
+// Check if this directory is actually open
+//
+   if (!myDir) return -XRDOSS_E8002;
+
+// Have the posix layer fill in the stat information on each readdir
+//
+   return (XrdPosixXrootd::StatRet(myDir, buff) ? -errno : XrdOssOK);
+}
+
 /******************************************************************************/
 /*                                 C l o s e                                  */
 /******************************************************************************/
@@ -754,6 +785,9 @@ ssize_t XrdPssFile::Read(void *buff, off_t offset, size_t blen)
 
      if (fd < 0) return (ssize_t)-XRDOSS_E8004;
 
+     if (XrdPssPipe::Chunk && blen > (size_t)XrdPssPipe::Chunk)
+        return XrdPssPipe::Read(fd, buff, offset, blen);
+
      return (retval = XrdPosixXrootd::Pread(fd, buff, blen, offset)) < 0
             ? (ssize_t)-errno : retval;
 }
@@ -781,6 +815,8 @@ ssize_t XrdPssFile::ReadV(XrdOucIOVec     *readV,     // In
 
     if (fd < 0) return (ssize_t)-XRDOSS_E8004;
 
+    if (XrdPssPipe::Chunk) return XrdPssPipe::ReadV(fd, readV, readCount);
+
     return (retval = XrdPosixXrootd::VRead(fd, readV, readCount)) < 0 ? (ssize_t)-errno : retval;;
 }
 
@@ -1083,7 +1119,7 @@ char *XrdPssSys::P2URL(int &retc, char *pbuff, int pblen,
    int   pfxLen, pathln;
    const char *theID = 0, *subPath;
    const char *fname = path;
-   char  idBuff[8], *idP, *retPath;
+   char  idBuff[16], *idP, *retPath;
    char  Apath[MAXPATHLEN*2+1];
 
 // If this is an outgoing proxy then we need to do someother work
@@ -1101,13 +1137,24 @@ char *XrdPssSys::P2URL(int &retc, char *pbuff, int pblen,
    pathln = strlen(fname);
 
 // If we have an Ident then usethe fd number as the userid. This allows us to
-// have one stream per open connection.
+// have one stream per open connection. When origin connections are shared we
+// fold the fd number into the pool so that requests from many clients are
+// pipelined over the same few connections.
 //
    if (Ident)
       {if (*Ident == '=') theID = Ident+1;
           else if ((Ident = index(Ident, ':')))
-                  {strncpy(idBuff, Ident+1, 7); idBuff[7] = 0;
-                   if ((idP = index(idBuff, '@'))) {*(idP+1)=0; theID=idBuff;}
+                  {if (pipeConns)
+                      {unsigned int fdNum = strtoul(Ident+1, &idP, 10);
+                       if (*idP == '@')
+                          {snprintf(idBuff, sizeof(idBuff), "%u@",
+                                    fdNum % (unsigned int)pipeConns);
+                           theID = idBuff;
+                          }
+                      } else {
+                       strncpy(idBuff, Ident+1, 7); idBuff[7] = 0;
+                       if ((idP = index(idBuff, '@'))) {*(idP+1)=0; theID=idBuff;}
+                      }
                   }
       }
 
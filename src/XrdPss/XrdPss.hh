@@ -50,6 +50,7 @@ public:
 int     Close(long long *retsz=0);
 int     Opendir(const char *, XrdOucEnv &);
 int     Readdir(char *buff, int blen);
+int     StatRet(struct stat *buff);
 
         // Constructor and destructor
         XrdPssDir(const char *tid) : tident(tid), myDir(0) {}
@@ -171,6 +172,7 @@ static const char  *hdrData;
 static const char  *urlRdr;
 static int          Streams;
 static int          Workers;
+static int          pipeConns; // Origin connections shared by all clients
 static int          Trace;
 
 static bool         outProxy; // True means outgoing proxy
@@ -206,6 +208,7 @@ int    xconf(XrdSysError *Eroute, XrdOucStream &Config);
 int    xdef( XrdSysError *Eroute, XrdOucStream &Config);
 int    xexp( XrdSysError *Eroute, XrdOucStream &Config);
 int    xperm(XrdSysError *errp,   XrdOucStream &Config);
+int    xpipe(XrdSysError *errp,   XrdOucStream &Config);
 int    xorig(XrdSysError *errp,   XrdOucStream &Config);
 };
 #endif
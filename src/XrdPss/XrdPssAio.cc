@@ -34,6 +34,7 @@
 #include "XrdPosix/XrdPosixXrootd.hh"
 #include "XrdPss/XrdPss.hh"
 #include "XrdPss/XrdPssAioCB.hh"
+#include "XrdPss/XrdPssPipe.hh"
 #include "XrdSfs/XrdSfsAio.hh"
 
 // All AIO interfaces are defined here.
@@ -75,6 +76,14 @@ int XrdPssFile::Fsync(XrdSfsAio *aiop)
 int XrdPssFile::Read(XrdSfsAio *aiop)
 {
 
+// Large reads are split into chunks that are sent to the origin in parallel
+//
+   if (XrdPssPipe::Chunk
+   &&  aiop->sfsAio.aio_nbytes > (size_t)XrdPssPipe::Chunk)
+      {XrdPssPipe::Read(fd, aiop);
+       return 0;
+      }
+
 // Execute this request in an asynchronous fashion
 //
    XrdPosixXrootd::Pread(fd, (void *)aiop->sfsAio.aio_buf,
@@ -49,6 +49,7 @@
 #include "XrdNet/XrdNetSecurity.hh"
 
 #include "XrdPss/XrdPss.hh"
+#include "XrdPss/XrdPssPipe.hh"
 
 #include "XrdSys/XrdSysError.hh"
 #include "XrdSys/XrdSysHeaders.hh"
@@ -105,6 +106,7 @@ const char  *XrdPssSys::hdrData   =  0;
 const char  *XrdPssSys::urlRdr    =  0;
 int          XrdPssSys::Streams   =512;
 int          XrdPssSys::Workers   = 16;
+int          XrdPssSys::pipeConns =  0;
 
 char         XrdPssSys::allChmod  =  0;
 char         XrdPssSys::allMkdir  =  0;
@@ -235,6 +237,11 @@ int XrdPssSys::Configure(const char *cfn)
 //
    if (LocalRoot) psxConfig->SetRoot(LocalRoot);
 
+// When pipelining, tell xrootd to open every file in async mode so that reads
+// and writes do not hold a thread while the origin responds.
+//
+   if (XrdPssPipe::Chunk) XrdOucEnv::Export("XRDXROOTD_FORCEAIO", "1");
+
 // Pre-screen any n2n library parameters
 //
    if (outProxy && psxConfig->xLfn2Pfn)
@@ -450,6 +457,7 @@ int XrdPssSys::ConfigXeq(char *var, XrdOucStream &Config)
    TS_PSX("inetmode",      ParseINet);
    TS_Xeq("origin",        xorig);
    TS_Xeq("permit",        xperm);
+   TS_Xeq("pipeline",      xpipe);
    TS_PSX("setopt",        ParseSet);
    TS_PSX("trace",         ParseTrace);
 
@@ -667,6 +675,71 @@ int XrdPssSys::xorig(XrdSysError *errp, XrdOucStream &Config)
    return tp != 0;
 }
   
+/******************************************************************************/
+/*                                 x p i p e                                  */
+/******************************************************************************/
+
+/* Function: xpipe
+
+   Purpose:  To parse the directive: pipeline [chunk <sz>] [conns <n>]
+                                              [substreams <n>]
+
+             chunk      reads and readv requests larger than <sz> are split
+                        into <sz> chunks sent to the origin in parallel.
+                        The default is 256k.
+             conns      the number of origin connections shared by all of the
+                        clients. The default is one connection per client.
+             substreams the number of substreams per origin connection over
+                        which the chunks are spread. The default is 4.
+
+   Output: 0 upon success or 1 upon failure.
+*/
+
+int XrdPssSys::xpipe(XrdSysError *Eroute, XrdOucStream &Config)
+{
+    long long chunk = 256*1024;
+    int conns = 0, strms = 4;
+    char *val;
+
+    while((val = Config.GetWord()))
+         {if (!strcmp("chunk", val))
+             {if (!(val = Config.GetWord()))
+                 {Eroute->Emsg("Config", "pipeline chunk not specified");
+                  return 1;
+                 }
+              if (XrdOuca2x::a2sz(*Eroute, "pipeline chunk", val, &chunk,
+                                  16*1024, 64*1024*1024)) return 1;
+             }
+          else if (!strcmp("conns", val))
+             {if (!(val = Config.GetWord()))
+                 {Eroute->Emsg("Config", "pipeline conns not specified");
+                  return 1;
+                 }
+              if (XrdOuca2x::a2i(*Eroute, "pipeline conns", val, &conns,
+                                 1, 4096)) return 1;
+             }
+          else if (!strcmp("substreams", val))
+             {if (!(val = Config.GetWord()))
+                 {Eroute->Emsg("Config", "pipeline substreams not specified");
+                  return 1;
+                 }
+              if (XrdOuca2x::a2i(*Eroute, "pipeline substreams", val, &strms,
+                                 1, 15)) return 1;
+             }
+          else {Eroute->Emsg("Config", "invalid pipeline option -", val);
+                return 1;
+               }
+         }
+
+// Record the values. An explicit setopt ParStreamsPerPhyConn takes precedence
+// over the substream count as setopt values are applied later on.
+//
+    XrdPssPipe::Chunk = static_cast<int>(chunk);
+    pipeConns = conns;
+    XrdPosixConfig::SetEnv("SubStreamsPerChannel", strms);
+    return 0;
+}
+
 /******************************************************************************/
 /*                                 x p e r m                                  */
 /******************************************************************************/
@@ -0,0 +1,258 @@
+/******************************************************************************/
+/*                                                                            */
+/*                         X r d P s s P i p e . c c                          */
+/*                                                                            */
+/* (c) 2026 by the contributors to the XRootD software suite                  */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <errno.h>
+
+#include <vector>
+
+#include "XrdOuc/XrdOucIOVec.hh"
+#include "XrdPosix/XrdPosixCallBack.hh"
+#include "XrdPosix/XrdPosixXrootd.hh"
+#include "XrdPss/XrdPssPipe.hh"
+#include "XrdSfs/XrdSfsAio.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+/******************************************************************************/
+/*                        S t a t i c   M e m b e r s                         */
+/******************************************************************************/
+
+int XrdPssPipe::Chunk = 0;
+
+/******************************************************************************/
+/*                         L o c a l   C l a s s e s                          */
+/******************************************************************************/
+
+namespace
+{
+class PipeReq;
+
+// Each chunk needs its own callback object as the posix layer records the
+// file being referenced in the callback.
+//
+class PipeCB : public XrdPosixCallBackIO
+{
+public:
+
+void     Complete(ssize_t Result);
+
+PipeReq *reqP;
+ssize_t  result;
+size_t   rlen;
+int      eNum;
+
+         PipeCB() : reqP(0), result(0), rlen(0), eNum(0) {}
+        ~PipeCB() {}
+};
+
+// A request tracks the outstanding chunks. The last chunk to complete either
+// wakes up the synchronous caller or finishes the aio request.
+//
+class PipeReq
+{
+public:
+
+void     Done();
+
+ssize_t  Result();
+
+XrdSysSemaphore ioSem;
+XrdSfsAio      *aiop;
+PipeCB         *cbV;
+int             numCB;
+int             pending;
+
+         PipeReq(int n, XrdSfsAio *aP=0)
+                : ioSem(0), aiop(aP), cbV(new PipeCB[n]), numCB(n), pending(n)
+                {for (int i = 0; i < n; i++) cbV[i].reqP = this;}
+        ~PipeReq() {delete [] cbV;}
+};
+}
+
+/******************************************************************************/
+/*                      P i p e C B : : C o m p l e t e                       */
+/******************************************************************************/
+
+void PipeCB::Complete(ssize_t Result)
+{
+   if ((result = Result) < 0) eNum = errno;
+   reqP->Done();
+}
+
+/******************************************************************************/
+/*                          P i p e R e q : : D o n e                         */
+/******************************************************************************/
+
+void PipeReq::Done()
+{
+// Nothing to do until the last chunk arrives
+//
+   if (__sync_sub_and_fetch(&pending, 1)) return;
+
+// A synchronous caller is waiting and will dispose of the request
+//
+   if (!aiop) {ioSem.Post(); return;}
+
+// Complete the aio request and get rid of ourselves
+//
+   aiop->Result = Result();
+   aiop->doneRead();
+   delete this;
+}
+
+/******************************************************************************/
+/*                        P i p e R e q : : R e s u l t                       */
+/******************************************************************************/
+
+ssize_t PipeReq::Result()
+{
+   ssize_t total = 0;
+   int i;
+
+// Any failed chunk fails the whole request
+//
+   for (i = 0; i < numCB; i++) if (cbV[i].result < 0) return -cbV[i].eNum;
+
+// The data is only contiguous up to the first short chunk
+//
+   for (i = 0; i < numCB; i++)
+       {total += cbV[i].result;
+        if ((size_t)cbV[i].result < cbV[i].rlen) break;
+       }
+   return total;
+}
+
+/******************************************************************************/
+/*                         L o c a l   M e t h o d s                          */
+/******************************************************************************/
+
+namespace
+{
+// Note that the request may be deleted as soon as the last chunk is issued
+// so it must not be referenced afterwards.
+//
+void Issue(int fd, PipeReq *rP, char *buff, off_t offset, size_t blen)
+{
+   PipeCB *cbP  = rP->cbV;
+   size_t  csz  = XrdPssPipe::Chunk;
+   int     n    = rP->numCB;
+
+   for (int i = 0; i < n; i++)
+       {if (csz > blen) csz = blen;
+        cbP[i].rlen = csz;
+        XrdPosixXrootd::Pread(fd, buff, csz, offset, &cbP[i]);
+        buff += csz; offset += csz; blen -= csz;
+       }
+}
+}
+
+/******************************************************************************/
+/*                                  R e a d                                   */
+/******************************************************************************/
+
+ssize_t XrdPssPipe::Read(int fd, void *buff, off_t offset, size_t blen)
+{
+   PipeReq rq((blen + Chunk - 1) / Chunk);
+
+// Issue all of the chunks and wait for them to complete
+//
+   Issue(fd, &rq, (char *)buff, offset, blen);
+   rq.ioSem.Wait();
+   return rq.Result();
+}
+
+/******************************************************************************/
+
+void XrdPssPipe::Read(int fd, XrdSfsAio *aiop)
+{
+   size_t blen = (size_t)aiop->sfsAio.aio_nbytes;
+   PipeReq *rP = new PipeReq((blen + Chunk - 1) / Chunk, aiop);
+
+// Issue all of the chunks, the last one to complete finishes the request
+//
+   Issue(fd, rP, (char *)aiop->sfsAio.aio_buf,
+                 (off_t)aiop->sfsAio.aio_offset, blen);
+}
+
+/******************************************************************************/
+/*                                G r o u p s                                 */
+/******************************************************************************/
+
+int XrdPssPipe::Groups(const XrdOucIOVec *readV, int n, int *gEnd)
+{
+   long long gsz = 0;
+   int i, numG = 0;
+
+// A new group starts when an element would overflow the chunk of a group that
+// already has data. Zero length elements ride along with the current group.
+//
+   for (i = 0; i < n; i++)
+       {if (readV[i].size && gsz && gsz + readV[i].size > Chunk)
+           {gEnd[numG++] = i; gsz = 0;}
+        gsz += readV[i].size;
+       }
+   if (n) gEnd[numG++] = n;
+   return numG;
+}
+
+/******************************************************************************/
+/*                                 R e a d V                                  */
+/******************************************************************************/
+
+ssize_t XrdPssPipe::ReadV(int fd, XrdOucIOVec *readV, int n)
+{
+   std::vector<int> gEnd(n > 0 ? n : 1);
+   PipeCB *cbP;
+   long long gsz;
+   int i, j, numG;
+
+// Group the elements so that each group fits into a chunk
+//
+   numG = Groups(readV, n, &gEnd[0]);
+
+// If everything fits into a single chunk just do a plain readv
+//
+   if (numG <= 1)
+      {ssize_t retval = XrdPosixXrootd::VRead(fd, readV, n);
+       return (retval < 0 ? (ssize_t)-errno : retval);
+      }
+
+// Issue each group as a separate readv
+//
+   PipeReq rq(numG);
+   cbP = rq.cbV;
+   for (i = 0, j = 0; j < numG; j++)
+       {int k = i;
+        for (gsz = 0; i < gEnd[j]; i++) gsz += readV[i].size;
+        cbP[j].rlen = gsz;
+        XrdPosixXrootd::VRead(fd, readV+k, i-k, &cbP[j]);
+       }
+
+// Wait for all of the groups to complete
+//
+   rq.ioSem.Wait();
+   return rq.Result();
+}
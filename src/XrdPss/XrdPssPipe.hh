@@ -0,0 +1,70 @@
+#ifndef __PSS_PIPE_HH__
+#define __PSS_PIPE_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                         X r d P s s P i p e . h h                          */
+/*                                                                            */
+/* (c) 2026 by the contributors to the XRootD software suite                  */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <sys/types.h>
+
+struct XrdOucIOVec;
+class  XrdSfsAio;
+
+//-----------------------------------------------------------------------------
+//! XrdPssPipe splits large proxy reads into chunks that are sent to the origin
+//! in parallel through the asynchronous posix interface. The chunks are spread
+//! over the substreams of the origin channel and the caller sees a single
+//! result once every chunk has completed. Results follow the oss convention:
+//! bytes read upon success and -errno upon failure.
+//-----------------------------------------------------------------------------
+
+class XrdPssPipe
+{
+public:
+
+static ssize_t Read(int fd, void *buff, off_t offset, size_t blen);
+
+static void    Read(int fd, XrdSfsAio *aiop);
+
+static ssize_t ReadV(int fd, XrdOucIOVec *readV, int n);
+
+//-----------------------------------------------------------------------------
+//! Split readv elements into groups of consecutive elements that fit into a
+//! chunk. Each group has at least one non-empty element no matter how large
+//! it is and zero length elements never start a group.
+//!
+//! @param  readV  Pointer to the readv elements.
+//! @param  n      Number of elements.
+//! @param  gEnd   Upon return, the index one past the last element of each
+//!                group. It must have room for n entries.
+//!
+//! @return The number of groups placed in gEnd.
+//-----------------------------------------------------------------------------
+
+static int     Groups(const XrdOucIOVec *readV, int n, int *gEnd);
+
+static int     Chunk;   // Split reads larger than this (0 -> do not split)
+};
+#endif
@@ -58,6 +58,7 @@ add_library(
                                 XrdOfs/XrdOfsTrace.hh
   XrdOfs/XrdOfsFS.cc
   XrdOfs/XrdOfsConfig.cc
+  XrdOfs/XrdOfsCksWrite.cc      XrdOfs/XrdOfsCksWrite.hh
   XrdOfs/XrdOfsConfigPI.cc      XrdOfs/XrdOfsConfigPI.hh
   XrdOfs/XrdOfsEvr.cc           XrdOfs/XrdOfsEvr.hh
   XrdOfs/XrdOfsEvs.cc           XrdOfs/XrdOfsEvs.hh
@@ -69,6 +70,7 @@ add_library(
   XrdOfs/XrdOfsTPCJob.cc        XrdOfs/XrdOfsTPCJob.hh
   XrdOfs/XrdOfsTPCInfo.cc       XrdOfs/XrdOfsTPCInfo.hh
   XrdOfs/XrdOfsTPCProg.cc       XrdOfs/XrdOfsTPCProg.hh
+                                XrdOfs/XrdOfsTPCXfr.hh
 
   #-----------------------------------------------------------------------------
   # XrdSfs - Standard File System (basic)
@@ -113,6 +115,7 @@ add_library(
   XrdOss/XrdOssSpace.cc        XrdOss/XrdOssSpace.hh
   XrdOss/XrdOssStage.cc        XrdOss/XrdOssStage.hh
   XrdOss/XrdOssStat.cc         XrdOss/XrdOssStatInfo.hh
+  XrdOss/XrdOssURing.cc        XrdOss/XrdOssURing.hh
                                XrdOss/XrdOssUnlink.cc
                                XrdOss/XrdOssError.hh
                                XrdOss/XrdOss.hh
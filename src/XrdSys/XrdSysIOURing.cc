@@ -0,0 +1,358 @@
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d S y s I O U R i n g . c c                       */
+/*                                                                            */
+/* (c) 2026 by the contributors to the XRootD software suite                  */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#ifdef HAVE_IOURING
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "XrdSys/XrdSysIOURing.hh"
+
+/******************************************************************************/
+/*                          L o c a l   M a c r o s                           */
+/******************************************************************************/
+
+// The kernel and user space share the ring indices so they must be accessed
+// with the appropriate memory ordering.
+//
+#define LoadAcq(x)    __atomic_load_n(x, __ATOMIC_ACQUIRE)
+#define StoreRel(x,v) __atomic_store_n(x, v, __ATOMIC_RELEASE)
+
+/******************************************************************************/
+/*                           C o n s t r u c t o r                            */
+/******************************************************************************/
+
+XrdSysIOURing::XrdSysIOURing()
+              : sqes(0), sqHead(0), sqTail(0), sqMask(0), sqArray(0),
+                sqEntries(0), sqPend(0), sqBusy(false), cqHead(0), cqTail(0),
+                cqMask(0), cqes(0), sqMap(MAP_FAILED), cqMap(MAP_FAILED),
+                sqMapSz(0), cqMapSz(0), sqeMapSz(0), ringFD(-1), bufRing(0),
+                bufBase(0), bufRingSz(0), bufSize(0), bufNum(0), bufTail(0)
+{}
+
+/******************************************************************************/
+/*                            D e s t r u c t o r                             */
+/******************************************************************************/
+
+XrdSysIOURing::~XrdSysIOURing()
+{
+   if (sqes) munmap(sqes, sqeMapSz);
+   if (cqMap != MAP_FAILED && cqMap != sqMap) munmap(cqMap, cqMapSz);
+   if (sqMap != MAP_FAILED) munmap(sqMap, sqMapSz);
+   if (ringFD >= 0) close(ringFD);
+   if (bufRing) munmap(bufRing, bufRingSz);
+   if (bufBase) free(bufBase);
+}
+
+/******************************************************************************/
+/*                                  I n i t                                   */
+/******************************************************************************/
+
+int XrdSysIOURing::Init(unsigned int entries, unsigned int cqSize)
+{
+   struct io_uring_params parms;
+   char *sqP, *cqP;
+   void *sqeP;
+
+// Create the ring
+//
+   memset(&parms, 0, sizeof(parms));
+   if (cqSize)
+      {parms.flags      = IORING_SETUP_CQSIZE;
+       parms.cq_entries = cqSize;
+      }
+   if ((ringFD = syscall(__NR_io_uring_setup, entries, &parms)) < 0)
+      return -errno;
+   fcntl(ringFD, F_SETFD, FD_CLOEXEC);
+
+// Calculate the sizes of the two rings. Newer kernels allow both rings to be
+// mapped with a single mmap() call.
+//
+   sqMapSz = parms.sq_off.array + parms.sq_entries * sizeof(unsigned int);
+   cqMapSz = parms.cq_off.cqes  + parms.cq_entries * sizeof(struct io_uring_cqe);
+   if (parms.features & IORING_FEAT_SINGLE_MMAP)
+      {if (cqMapSz > sqMapSz) sqMapSz = cqMapSz;
+       cqMapSz = sqMapSz;
+      }
+
+// Map the submission ring
+//
+   sqMap = mmap(0, sqMapSz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                ringFD, IORING_OFF_SQ_RING);
+   if (sqMap == MAP_FAILED) return -errno;
+
+// Map the completion ring, if need be
+//
+   if (parms.features & IORING_FEAT_SINGLE_MMAP) cqMap = sqMap;
+      else {cqMap = mmap(0, cqMapSz, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, ringFD, IORING_OFF_CQ_RING);
+            if (cqMap == MAP_FAILED) return -errno;
+           }
+
+// Map the submission queue entries
+//
+   sqeMapSz = parms.sq_entries * sizeof(struct io_uring_sqe);
+   sqeP = mmap(0, sqeMapSz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+               ringFD, IORING_OFF_SQES);
+   if (sqeP == MAP_FAILED) return -errno;
+   sqes = static_cast<struct io_uring_sqe *>(sqeP);
+
+// Establish pointers to the shared ring indices
+//
+   sqP       = static_cast<char *>(sqMap);
+   sqHead    = reinterpret_cast<unsigned int *>(sqP + parms.sq_off.head);
+   sqTail    = reinterpret_cast<unsigned int *>(sqP + parms.sq_off.tail);
+   sqMask    = reinterpret_cast<unsigned int *>(sqP + parms.sq_off.ring_mask);
+   sqArray   = reinterpret_cast<unsigned int *>(sqP + parms.sq_off.array);
+   sqEntries = parms.sq_entries;
+
+   cqP       = static_cast<char *>(cqMap);
+   cqHead    = reinterpret_cast<unsigned int *>(cqP + parms.cq_off.head);
+   cqTail    = reinterpret_cast<unsigned int *>(cqP + parms.cq_off.tail);
+   cqMask    = reinterpret_cast<unsigned int *>(cqP + parms.cq_off.ring_mask);
+   cqes      = reinterpret_cast<struct io_uring_cqe *>(cqP + parms.cq_off.cqes);
+   return 0;
+}
+
+/******************************************************************************/
+/*                             P u t B u f f e r                              */
+/******************************************************************************/
+
+void XrdSysIOURing::PutBuffer(unsigned int bid)
+{
+#ifdef XRDSYSIOURING_BUFRING
+   struct io_uring_buf_ring *brP;
+   struct io_uring_buf *bP;
+
+// The first entry overlays the ring tail so only the buffer fields are set.
+// We index the ring ourselves as the kernel's flexible array member is offset
+// by the empty struct it needs when compiled as C++. Any number of threads may
+// return buffers so we serialize this.
+//
+   bufMutex.Lock();
+   brP = static_cast<struct io_uring_buf_ring *>(bufRing);
+   bP = static_cast<struct io_uring_buf *>(bufRing) + (bufTail & (bufNum-1));
+   bP->addr = reinterpret_cast<unsigned long long>(bufBase + bid*bufSize);
+   bP->len  = bufSize;
+   bP->bid  = static_cast<unsigned short>(bid);
+   bufTail++;
+   StoreRel(&brP->tail, bufTail);
+   bufMutex.UnLock();
+#endif
+}
+
+/******************************************************************************/
+/*                                 Q u e u e                                  */
+/******************************************************************************/
+
+int XrdSysIOURing::Queue(const struct io_uring_sqe &sqe, bool doSub)
+{
+   unsigned int tail, idx;
+   int rc;
+
+// Serialize access to the submission queue
+//
+   sqMutex.Lock();
+
+// If the ring is full, push what we have to the kernel to make room. This is
+// done even when another thread is submitting as we need the room right now.
+//
+   tail = *sqTail;
+   if (tail - LoadAcq(sqHead) >= sqEntries)
+      {if ((rc = Enter(sqPend, 0, 0)) > 0) sqPend -= rc;
+       if (tail - LoadAcq(sqHead) >= sqEntries)
+          {sqMutex.UnLock(); return (rc < 0 ? rc : -EBUSY);}
+      }
+
+// Copy the entry into the ring and make it visible to the kernel
+//
+   idx = tail & *sqMask;
+   sqes[idx] = sqe;
+   sqArray[idx] = idx;
+   StoreRel(sqTail, tail+1);
+   sqPend++;
+
+// If another thread is submitting, it will pick up this entry as well.
+// Otherwise, submit everything that is queued if so wanted.
+//
+   if (!doSub || sqBusy) sqMutex.UnLock();
+      else Flush();
+   return 0;
+}
+
+/******************************************************************************/
+/*                                  R e a p                                   */
+/******************************************************************************/
+
+int XrdSysIOURing::Reap(struct io_uring_cqe *cqe, int maxcqe)
+{
+   unsigned int head = *cqHead, tail = LoadAcq(cqTail), mask = *cqMask;
+   int n = 0;
+
+// Copy out whatever is available
+//
+   while(head != tail && n < maxcqe) cqe[n++] = cqes[head++ & mask];
+
+// Return the entries to the kernel
+//
+   StoreRel(cqHead, head);
+   return n;
+}
+
+/******************************************************************************/
+/*                            S e t B u f f e r s                             */
+/******************************************************************************/
+
+int XrdSysIOURing::SetBuffers(unsigned int bsz, unsigned int nbufs)
+{
+#ifdef XRDSYSIOURING_BUFRING
+   struct io_uring_buf_reg bReg;
+   void *mP, *bP;
+   unsigned int i;
+   int rc;
+
+// Validate the arguments
+//
+   if (!bsz || !nbufs || nbufs > 32768 || (nbufs & (nbufs-1)) || bufRing)
+      return -EINVAL;
+
+// Allocate the buffers and the page aligned ring that describes them
+//
+   bufRingSz = nbufs * sizeof(struct io_uring_buf);
+   mP = mmap(0, bufRingSz, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+             -1, 0);
+   if (mP == MAP_FAILED) return -errno;
+   if ((rc = posix_memalign(&bP, sysconf(_SC_PAGESIZE), (size_t)bsz*nbufs)))
+      {munmap(mP, bufRingSz);
+       return -rc;
+      }
+
+// Register the ring as buffer group zero
+//
+   memset(&bReg, 0, sizeof(bReg));
+   bReg.ring_addr    = reinterpret_cast<unsigned long long>(mP);
+   bReg.ring_entries = nbufs;
+   bReg.bgid         = 0;
+   if (syscall(__NR_io_uring_register, ringFD, IORING_REGISTER_PBUF_RING,
+               &bReg, 1) < 0)
+      {rc = -errno;
+       munmap(mP, bufRingSz);
+       free(bP);
+       return rc;
+      }
+
+// Hand all of the buffers to the kernel
+//
+   bufRing = mP;
+   bufBase = static_cast<char *>(bP);
+   bufSize = bsz;
+   bufNum  = nbufs;
+   for (i = 0; i < nbufs; i++) PutBuffer(i);
+   return 0;
+#else
+   return -ENOTSUP;
+#endif
+}
+
+/******************************************************************************/
+/*                                S u b m i t                                 */
+/******************************************************************************/
+
+int XrdSysIOURing::Submit()
+{
+   sqMutex.Lock();
+   if (!sqPend || sqBusy) {sqMutex.UnLock(); return 0;}
+   return Flush();
+}
+
+/******************************************************************************/
+/*                                  W a i t                                   */
+/******************************************************************************/
+
+int XrdSysIOURing::Wait(unsigned int minWait)
+{
+   int rc;
+
+// Submit anything outstanding. We must not hold the queue lock nor be the
+// submitter while waiting as others rely on the submitter to make progress.
+//
+   if ((rc = Submit()) < 0) return rc;
+
+// Wait for completions
+//
+   if ((rc = Enter(0, minWait, IORING_ENTER_GETEVENTS)) < 0 && rc != -EINTR)
+      return rc;
+   return 0;
+}
+
+/******************************************************************************/
+/*                       P r i v a t e   M e t h o d s                        */
+/******************************************************************************/
+/******************************************************************************/
+/*                                 E n t e r                                  */
+/******************************************************************************/
+
+int XrdSysIOURing::Enter(unsigned int toSub, unsigned int minWait,
+                         unsigned int flags)
+{
+   int rc;
+
+   do {rc = syscall(__NR_io_uring_enter, ringFD, toSub, minWait, flags, 0, 0);}
+      while(rc < 0 && errno == EINTR && !minWait);
+   return (rc < 0 ? -errno : rc);
+}
+
+/******************************************************************************/
+/*                                 F l u s h                                  */
+/******************************************************************************/
+
+// Called with sqMutex held, which is released upon return. Entries queued by
+// other threads while we are in the kernel are submitted by us as well.
+//
+int XrdSysIOURing::Flush()
+{
+   unsigned int toSub;
+   int rc = 0, numSub = 0;
+
+   sqBusy = true;
+   while((toSub = sqPend))
+        {sqMutex.UnLock();
+         rc = Enter(toSub, 0, 0);
+         sqMutex.Lock();
+         if (rc <= 0) break;
+         sqPend -= rc; numSub += rc;
+        }
+   sqBusy = false;
+   sqMutex.UnLock();
+   return (rc < 0 ? rc : numSub);
+}
+#endif
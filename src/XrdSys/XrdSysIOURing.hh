@@ -0,0 +1,191 @@
+#ifndef __XRDSYSIOURING_HH__
+#define __XRDSYSIOURING_HH__
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d S y s I O U R i n g . h h                       */
+/*                                                                            */
+/* (c) 2026 by the contributors to the XRootD software suite                  */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#ifdef HAVE_IOURING
+
+#include <linux/io_uring.h>
+
+// Provided buffer rings came with multishot receives. The register opcode is
+// an enumerator, not a macro, so we key off the multishot receive flag.
+//
+#ifdef IORING_RECV_MULTISHOT
+#define XRDSYSIOURING_BUFRING
+#endif
+
+#include "XrdSys/XrdSysPthread.hh"
+
+//-----------------------------------------------------------------------------
+//! XrdSysIOURing is a minimal wrapper around a Linux io_uring instance. It
+//! uses the raw system calls so that no external library is required. Any
+//! number of threads may queue submissions but only one thread may reap
+//! completions at any one time. Submissions are combined: a thread that finds
+//! another thread already submitting simply leaves its entry for that thread
+//! so that concurrent submitters share a single system call.
+//-----------------------------------------------------------------------------
+
+class XrdSysIOURing
+{
+public:
+
+//-----------------------------------------------------------------------------
+//! Obtain the address of a provided buffer.
+//!
+//! @param  bid     The buffer id as reported in the completion flags.
+//!
+//! @return Pointer to the buffer.
+//-----------------------------------------------------------------------------
+
+inline
+char     *Buffer(unsigned int bid) {return bufBase + bid*bufSize;}
+
+//-----------------------------------------------------------------------------
+//! Initialize the ring.
+//!
+//! @param  entries The number of submission queue entries (rounded up to the
+//!                 next power of two by the kernel).
+//! @param  cqSize  The number of completion queue entries. When zero, the
+//!                 kernel default (twice the submission entries) is used.
+//!                 Multishot requests need more room than that.
+//!
+//! @return =0      The ring is ready for use.
+//! @return <0      Initialization failed, the value is -errno.
+//-----------------------------------------------------------------------------
+
+int       Init(unsigned int entries, unsigned int cqSize=0);
+
+//-----------------------------------------------------------------------------
+//! Return a provided buffer to the kernel once its contents were consumed.
+//!
+//! @param  bid     The buffer id as reported in the completion flags.
+//-----------------------------------------------------------------------------
+
+void      PutBuffer(unsigned int bid);
+
+//-----------------------------------------------------------------------------
+//! Place a submission on the ring.
+//!
+//! @param  sqe     The fully prepared submission entry to be copied.
+//! @param  doSub   When true, all queued entries are submitted to the kernel
+//!                 unless another thread is already doing so, in which case
+//!                 that thread submits this entry as well. Otherwise, they
+//!                 are submitted by a later call to Submit(), Queue(), or
+//!                 Wait().
+//!
+//! @return =0      The entry was queued. A failure to submit it is reported
+//!                 by a later call to Submit() or Wait().
+//! @return <0      The entry could not be queued, the value is -errno.
+//-----------------------------------------------------------------------------
+
+int       Queue(const struct io_uring_sqe &sqe, bool doSub=true);
+
+//-----------------------------------------------------------------------------
+//! Reap available completions without waiting.
+//!
+//! @param  cqe     Pointer to an array to receive the completions.
+//! @param  maxcqe  The number of elements in the array.
+//!
+//! @return The number of completions placed in the array.
+//-----------------------------------------------------------------------------
+
+int       Reap(struct io_uring_cqe *cqe, int maxcqe);
+
+//-----------------------------------------------------------------------------
+//! Register a ring of buffers that the kernel selects from for requests that
+//! specify IOSQE_BUFFER_SELECT with buffer group zero (e.g. multishot recv).
+//!
+//! @param  bsz     The size of each buffer.
+//! @param  nbufs   The number of buffers, a power of two up to 32768.
+//!
+//! @return =0      The buffers are registered and available to the kernel.
+//! @return <0      Registration failed, the value is -errno. The ring remains
+//!                 usable without provided buffers.
+//-----------------------------------------------------------------------------
+
+int       SetBuffers(unsigned int bsz, unsigned int nbufs);
+
+//-----------------------------------------------------------------------------
+//! Submit all queued entries to the kernel. If another thread is currently
+//! submitting, that thread submits them instead.
+//!
+//! @return >=0     The number of entries submitted by this call.
+//! @return <0      Submission failed, the value is -errno. The entries that
+//!                 were not consumed remain queued.
+//-----------------------------------------------------------------------------
+
+int       Submit();
+
+//-----------------------------------------------------------------------------
+//! Submit all queued entries and wait for completions to become available.
+//!
+//! @param  minWait The minimum number of completions to wait for.
+//!
+//! @return =0      Completions are available (or the wait was interrupted).
+//! @return <0      The wait failed, the value is -errno.
+//-----------------------------------------------------------------------------
+
+int       Wait(unsigned int minWait=1);
+
+          XrdSysIOURing();
+         ~XrdSysIOURing();
+
+private:
+
+int       Enter(unsigned int toSub, unsigned int minWait, unsigned int flags);
+int       Flush();
+
+XrdSysMutex          sqMutex;
+struct io_uring_sqe *sqes;
+unsigned int        *sqHead;
+unsigned int        *sqTail;
+unsigned int        *sqMask;
+unsigned int        *sqArray;
+unsigned int         sqEntries;
+unsigned int         sqPend;
+bool                 sqBusy;
+unsigned int        *cqHead;
+unsigned int        *cqTail;
+unsigned int        *cqMask;
+struct io_uring_cqe *cqes;
+void                *sqMap;
+void                *cqMap;
+size_t               sqMapSz;
+size_t               cqMapSz;
+size_t               sqeMapSz;
+int                  ringFD;
+
+XrdSysMutex          bufMutex;
+void                *bufRing;
+char                *bufBase;
+size_t               bufRingSz;
+unsigned int         bufSize;
+unsigned int         bufNum;
+unsigned short       bufTail;
+};
+#endif
+#endif
@@ -27,6 +27,7 @@
 /* specific prior written permission of the institution or contributor.       */
 /******************************************************************************/
 
+#include <algorithm>
 #include <errno.h>
 #include <fcntl.h>
 #include <signal.h>
@@ -34,6 +35,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <time.h>
+#include <vector>
 #include <sys/stat.h>
 #include <sys/types.h>
 #ifndef WIN32
@@ -99,6 +101,262 @@ void Snatch(struct iovec *iov, int iovnum) // Called with logger mutex locked!
 }
 }
 
+/******************************************************************************/
+/*                  A s y n c h r o n o u s   L o g g i n g                   */
+/******************************************************************************/
+
+// In asynchronous mode every thread that logs has its own ring of records. A
+// ring is only added to by its thread and only emptied by the drainer so that
+// no lock is needed to log a message. Records carry a global sequence number
+// which the drainer uses to order a batch gathered from all of the rings.
+//
+namespace
+{
+struct LogRec
+      {unsigned int seq;     // Global sequence number
+       int          mlen;    // Message length, <0 -> pad to end of the ring
+//     char         msg;     // Message text follows the header
+      };
+
+static const int recHdr = sizeof(LogRec);
+
+struct LogRing
+      {LogRing  *next;
+       char     *buff;
+       long long head;       // Bytes added,   only set by the owning thread
+       long long tail;       // Bytes removed, only set by the drainer
+       int       orphan;     // The owning thread has exited
+       int       llen;       // Length of the cerr line being built
+       char      line[2048]; // The cerr line being built
+      };
+
+struct LogSeg
+      {unsigned int seq;
+       int          mlen;
+       char        *msg;
+       bool operator<(const LogSeg &rhs) const
+                     {return static_cast<int>(seq - rhs.seq) < 0;}
+      };
+
+class LogCerr : public std::streambuf
+{
+protected:
+virtual int             overflow(int c);
+virtual std::streamsize xsputn(const char *s, std::streamsize n);
+};
+
+XrdSysLogger         *aqLogger = 0;
+LogRing              *ringList = 0;   // All rings, new ones are added up front
+XrdSysMutex           ringMutex;      // Serializes ringList
+pthread_key_t         ringKey;
+XrdSysMutex           drainMutex;     // Serializes draining
+XrdSysMutex           traceMutex;     // Serializes trace lines
+XrdSysCondVar        &wakeCV = *new XrdSysCondVar(0); // Wakes the writer
+XrdSysCondVar        &roomCV = *new XrdSysCondVar(0); // Wakes ring waiters
+XrdSysSemaphore       aqDone(0);      // Posted when the writer has ended
+std::vector<LogRing*> aqRings;        // Drainer's ring snapshot
+std::vector<long long>aqHeads;        // Drainer's ring heads
+std::vector<LogSeg>   aqSegs;         // Drainer's records
+unsigned int          aqSeq     = 0;
+int                   aqBsz     = 0;
+int                   aqDrops   = 0;  // Messages dropped since last report
+int                   aqIdle    = 0;  // Writer is waiting for messages
+int                   aqWaiting = 0;  // Threads waiting for ring space
+int                   aqStop    = 0;  // Writer is to end
+bool                  aqBlock   = false;
+
+static const int      aqMaxIOV  = 512;
+
+inline long long RingFree(LogRing *rP)
+{
+   return aqBsz - (rP->head - __sync_fetch_and_add(&rP->tail, 0));
+}
+
+inline void WakeWriter(bool always)
+{
+   if (always || __sync_fetch_and_add(&aqIdle, 0))
+      {wakeCV.Lock(); wakeCV.Signal(); wakeCV.UnLock();}
+}
+
+void RingGone(void *arg) // Called at thread exit, the drainer frees the ring
+{
+   LogRing *rP = (LogRing *)arg;
+
+   __sync_fetch_and_or(&rP->orphan, 1);
+}
+
+LogRing *GetRing()
+{
+   LogRing *rP;
+
+// Use this thread's ring if it already has one
+//
+   if ((rP = (LogRing *)pthread_getspecific(ringKey))) return rP;
+
+// Allocate a new ring
+//
+   rP = new LogRing;
+   if (!(rP->buff = (char *)malloc(aqBsz))) {delete rP; return 0;}
+   rP->head = rP->tail = 0;
+   rP->orphan = 0;
+   rP->llen   = 0;
+   if (pthread_setspecific(ringKey, rP))
+      {free(rP->buff); delete rP; return 0;}
+
+// Make it visible to the drainer
+//
+   ringMutex.Lock();
+   rP->next = ringList;
+   ringList = rP;
+   ringMutex.UnLock();
+   return rP;
+}
+
+bool RingPending()
+{
+   XrdSysMutexHelper rHelp(ringMutex);
+   LogRing *rP = ringList;
+
+   while(rP)
+        {if (__sync_fetch_and_add(&rP->head, 0) != rP->tail) return true;
+         rP = rP->next;
+        }
+   return false;
+}
+
+// Returns false if the message cannot be placed in a ring and must be written
+// synchronously. A message dropped because the ring is full counts as placed.
+//
+bool RingPut(LogRing *rP, struct iovec *iov, int iovcnt)
+{
+   LogRec *recP;
+   char   *mP;
+   long long need;
+   int mlen = 0, rlen, pos, rest;
+
+// Calculate the record length, excessively long messages are not buffered
+//
+   for (int i = 0; i < iovcnt; i++) mlen += iov[i].iov_len;
+   rlen = (recHdr + mlen + 7) & ~7;
+   if (rlen > aqBsz/2) return false;
+
+// A record never wraps; the end of the ring is padded out if need be
+//
+   pos  = static_cast<int>(rP->head % aqBsz);
+   rest = aqBsz - pos;
+   need = (rlen <= rest ? rlen : rest + rlen);
+
+// Wait for room or drop the message, as configured
+//
+   if (RingFree(rP) < need)
+      {if (!aqBlock) {__sync_fetch_and_add(&aqDrops, 1); return true;}
+       __sync_fetch_and_add(&aqWaiting, 1);
+       roomCV.Lock();
+       while(RingFree(rP) < need) {WakeWriter(true); roomCV.Wait(100);}
+       roomCV.UnLock();
+       __sync_fetch_and_sub(&aqWaiting, 1);
+      }
+
+// Pad out the end of the ring if the record does not fit there
+//
+   if (rlen > rest)
+      {recP = (LogRec *)(rP->buff + pos);
+       recP->mlen = -rest;
+       pos = 0;
+      }
+
+// Copy in the message
+//
+   recP = (LogRec *)(rP->buff + pos);
+   mP   = rP->buff + pos + recHdr;
+   for (int i = 0; i < iovcnt; i++)
+       {memcpy(mP, iov[i].iov_base, iov[i].iov_len);
+        mP += iov[i].iov_len;
+       }
+   recP->mlen = mlen;
+   recP->seq  = __sync_fetch_and_add(&aqSeq, 1);
+
+// Publish the record and wake up the writer if it is waiting for work
+//
+   __sync_synchronize();
+   rP->head += need;
+   __sync_synchronize();
+   WakeWriter(false);
+   return true;
+}
+
+bool RingPut(struct iovec *iov, int iovcnt)
+{
+   LogRing *rP = GetRing();
+
+   return (rP ? RingPut(rP, iov, iovcnt) : false);
+}
+
+// Collect what cerr is given into lines, each line becomes a record
+//
+void RingLine(const char *data, int dlen)
+{
+   LogRing *rP = GetRing();
+   const char *nlP;
+   int n;
+
+// Without a ring write out the data as is
+//
+   if (!rP)
+      {struct iovec iov = {(char *)data, (size_t)dlen};
+       aqLogger->Put(1, &iov);
+       return;
+      }
+
+// Add the data to the line and queue full lines
+//
+   while(dlen > 0)
+        {nlP = (const char *)memchr(data, '\n', dlen);
+         n   = (nlP ? nlP - data + 1 : dlen);
+         if (n > (int)sizeof(rP->line) - rP->llen)
+            {n = (int)sizeof(rP->line) - rP->llen; nlP = 0;}
+         memcpy(rP->line + rP->llen, data, n);
+         rP->llen += n; data += n; dlen -= n;
+         if (nlP || rP->llen == (int)sizeof(rP->line))
+            {struct iovec iov = {rP->line, (size_t)rP->llen};
+             RingPut(rP, &iov, 1);
+             rP->llen = 0;
+            }
+        }
+}
+
+// Write out whatever is still buffered when the process exits normally. The
+// writer is stopped first as static objects it uses are about to be destroyed.
+// The condition variables are never destroyed as other threads may still be
+// waiting on them.
+//
+void RingExit()
+{
+   LogRing *rP = (LogRing *)pthread_getspecific(ringKey);
+
+   if (rP && rP->llen)
+      {struct iovec iov = {rP->line, (size_t)rP->llen};
+       RingPut(rP, &iov, 1);
+       rP->llen = 0;
+      }
+   __sync_fetch_and_or(&aqStop, 1);
+   WakeWriter(true);
+   aqDone.Wait();
+}
+
+int LogCerr::overflow(int c)
+{
+   if (c != EOF) {char cc = static_cast<char>(c); RingLine(&cc, 1);}
+   return (c == EOF ? 0 : c);
+}
+
+std::streamsize LogCerr::xsputn(const char *s, std::streamsize n)
+{
+   RingLine(s, static_cast<int>(n));
+   return n;
+}
+}
+
 /******************************************************************************/
 /*                         L o c a l   D e f i n e s                          */
 /******************************************************************************/
@@ -117,6 +375,12 @@ void  *XrdSysLoggerMN(void *carg)
        return (void *)0;
       }
 
+void  *XrdSysLoggerAW(void *carg)
+      {XrdSysLogger *lp = (XrdSysLogger *)carg;
+       lp->aHandler();
+       return (void *)0;
+      }
+
 struct XrdSysLoggerRP
       {XrdSysLogger   *logger;
        XrdSysSemaphore active;
@@ -152,7 +416,7 @@ XrdSysLogger::XrdSysLogger(int ErrFD, int dorotate)
    lfhTID  = 0;
    hiRes   = false;
    fifoFN  = 0;
-   reserved1 = 0;
+   isAsync = false;
 
 // Establish default log file name
 //
@@ -354,6 +618,10 @@ void XrdSysLogger::Put(int iovcnt, struct iovec *iov)
        iov[0].iov_len  = TimeStamp(tVal, tID, tbuff, sizeof(tbuff), hiRes);
       }
 
+// In asynchronous mode the message goes into this thread's ring
+//
+   if (isAsync && RingPut(iov, iovcnt)) return;
+
 // Obtain the serailization mutex if need be
 //
    Logger_Mutex.Lock();
@@ -377,6 +645,80 @@ void XrdSysLogger::Put(int iovcnt, struct iovec *iov)
    Logger_Mutex.UnLock();
 }
   
+/******************************************************************************/
+/*                              s e t A s y n c                               */
+/******************************************************************************/
+
+int XrdSysLogger::setAsync(int bsz, bool block)
+{
+   static LogCerr *cerrBuf = 0;
+   pthread_t tid;
+   int rc;
+
+// This can only be done once
+//
+   if (isAsync || aqLogger) return -EBUSY;
+   if ((rc = pthread_key_create(&ringKey, RingGone))) return -rc;
+   aqLogger = this;
+   aqBsz    = (bsz < 16384 ? 16384 : (bsz + 7) & ~7);
+   aqBlock  = block;
+
+// Start the writer
+//
+   if ((rc = XrdSysThread::Run(&tid, XrdSysLoggerAW, (void *)this, 0,
+                               "Log writer")))
+      return (rc > 0 ? -rc : -errno);
+   atexit(RingExit);
+
+// Switch over. Trace lines go through cerr and are serialized by the logger
+// mutex which we hold, so no trace line is in progress while we do this.
+//
+   Logger_Mutex.Lock();
+   if (eFD == STDERR_FILENO)
+      {cerrBuf = new LogCerr;
+       cerr.rdbuf(cerrBuf);
+      }
+   __sync_synchronize();
+   isAsync = true;
+   Logger_Mutex.UnLock();
+   return 0;
+}
+
+/******************************************************************************/
+/*                              t r a c e B e g                               */
+/******************************************************************************/
+
+char *XrdSysLogger::traceBeg()
+{
+
+// Trace lines are serialized by the logger mutex unless we are asynchronous.
+// Lines are formatted using cerr whose state (e.g. hex, width) all threads
+// share, so a trace mutex serializes them then. It is never held across log
+// I/O as the line goes into the thread's ring and the writer does the I/O.
+// The mode only changes once and under the logger mutex; recheck it in case
+// it changed while we waited.
+//
+   do {if (isAsync) {traceMutex.Lock(); break;}
+       Logger_Mutex.Lock();
+       if (!isAsync) break;
+       Logger_Mutex.UnLock();
+      } while(1);
+
+   Time(TBuff);
+   return TBuff;
+}
+
+/******************************************************************************/
+/*                              t r a c e E n d                               */
+/******************************************************************************/
+
+char XrdSysLogger::traceEnd()
+{
+   if (isAsync) traceMutex.UnLock();
+      else Logger_Mutex.UnLock();
+   return '\n';
+}
+
 /******************************************************************************/
 /* Private:                         T i m e                                   */
 /******************************************************************************/
@@ -448,6 +790,103 @@ int XrdSysLogger::TimeStamp(struct timeval &tVal, unsigned long tID,
 /******************************************************************************/
 /*                       P r i v a t e   M e t h o d s                        */
 /******************************************************************************/
+/******************************************************************************/
+/*                                 D r a i n                                  */
+/******************************************************************************/
+
+// Write out everything that is in the rings. Returns the number of messages.
+
+int XrdSysLogger::Drain()
+{
+   XrdSysMutexHelper dHelp(drainMutex);
+   struct iovec iov[aqMaxIOV];
+   LogRing *rP, *pP = 0;
+   LogRec  *recP;
+   char     tbuff[32], dbuff[80];
+   long long pos;
+   int drops, n, retc;
+
+// Snapshot the rings, freeing the ones whose thread is gone once empty
+//
+   aqRings.clear(); aqHeads.clear(); aqSegs.clear();
+   ringMutex.Lock();
+   rP = ringList;
+   while(rP)
+        {if (__sync_fetch_and_add(&rP->orphan, 0)
+         &&  __sync_fetch_and_add(&rP->head, 0) == rP->tail)
+            {LogRing *xP = rP;
+             rP = rP->next;
+             if (pP) pP->next = rP;
+                else ringList = rP;
+             free(xP->buff);
+             delete xP;
+             continue;
+            }
+         aqRings.push_back(rP);
+         aqHeads.push_back(__sync_fetch_and_add(&rP->head, 0));
+         pP = rP; rP = rP->next;
+        }
+   ringMutex.UnLock();
+
+// Gather the records and order them
+//
+   for (unsigned int i = 0; i < aqRings.size(); i++)
+       {rP = aqRings[i];
+        for (pos = rP->tail; pos < aqHeads[i];)
+            {recP = (LogRec *)(rP->buff + pos % aqBsz);
+             if (recP->mlen < 0) {pos -= recP->mlen; continue;}
+             LogSeg seg = {recP->seq, recP->mlen, (char *)(recP+1)};
+             aqSegs.push_back(seg);
+             pos += (recHdr + recP->mlen + 7) & ~7;
+            }
+       }
+   std::sort(aqSegs.begin(), aqSegs.end());
+
+// Report dropped messages first
+//
+   n = 0;
+   if ((drops = __sync_fetch_and_and(&aqDrops, 0)))
+      {struct timeval tVal;
+       gettimeofday(&tVal, 0);
+       iov[0].iov_base = tbuff;
+       iov[0].iov_len  = TimeStamp(tVal, XrdSysThread::Num(), tbuff,
+                                   sizeof(tbuff), hiRes);
+       iov[1].iov_base = dbuff;
+       iov[1].iov_len  = snprintf(dbuff, sizeof(dbuff),
+                                  "Logger: %d message%s dropped!\n",
+                                  drops, (drops == 1 ? "" : "s"));
+       n = 2;
+      }
+
+// Write out the records in as few writes as possible. We hold the logger
+// mutex so that this does not collide with log file rotation.
+//
+   Logger_Mutex.Lock();
+   for (unsigned int i = 0; i <= aqSegs.size(); i++)
+       {if (i < aqSegs.size())
+           {iov[n].iov_base = aqSegs[i].msg;
+            iov[n].iov_len  = aqSegs[i].mlen;
+            if (++n < aqMaxIOV) continue;
+           }
+        if (!n) break;
+        if (tFifo) for (int k = 0; k < n; k++) Snatch(&iov[k], 1);
+           else do {retc = writev(eFD, (const struct iovec *)iov, n);}
+                   while (retc < 0 && errno == EINTR);
+        n = 0;
+       }
+   Logger_Mutex.UnLock();
+
+// Release the space and wake up anyone waiting for it
+//
+   __sync_synchronize();
+   for (unsigned int i = 0; i < aqRings.size(); i++)
+       __sync_lock_test_and_set(&aqRings[i]->tail, aqHeads[i]);
+   if (__sync_fetch_and_add(&aqWaiting, 0))
+      {roomCV.Lock(); roomCV.Broadcast(); roomCV.UnLock();}
+
+   return static_cast<int>(aqSegs.size());
+}
+
 /******************************************************************************/
 /*                              F i f o M a k e                               */
 /******************************************************************************/
@@ -798,6 +1237,31 @@ void XrdSysLogger::Trim()
 }
 #endif
 
+/******************************************************************************/
+/*                              a H a n d l e r                               */
+/******************************************************************************/
+
+void XrdSysLogger::aHandler()
+{
+
+// Write out messages as they come in. When all rings are empty wait to be
+// woken up; we double check under the lock so that a wakeup is never lost.
+//
+   while(!__sync_fetch_and_add(&aqStop, 0))
+        {if (Drain()) continue;
+         wakeCV.Lock();
+         __sync_fetch_and_add(&aqIdle, 1);
+         if (!RingPending() && !aqStop) wakeCV.Wait(1000);
+         __sync_fetch_and_and(&aqIdle, 0);
+         wakeCV.UnLock();
+        }
+
+// The process is exiting, write out what is left and tell it we are done
+//
+   while(Drain()) {}
+   aqDone.Post();
+}
+
 /******************************************************************************/
 /*                              z H a n d l e r                               */
 /******************************************************************************/
@@ -836,6 +1300,7 @@ void XrdSysLogger::zHandler()
                   continue;
                  }
 
+         if (isAsync) Drain();
          Logger_Mutex.Lock();
          ReBind();
 
@@ -149,7 +149,7 @@ void Capture(XrdOucTListFIFO *tFIFO);
 //! Flush any pending output
 //-----------------------------------------------------------------------------
 
-void Flush() {fsync(eFD);}
+void Flush() {if (isAsync) Drain(); fsync(eFD);}
 
 //-----------------------------------------------------------------------------
 //! Get the file descriptor passed at construction time.
@@ -182,6 +182,26 @@ int  ParseKeep(const char *arg);
 
 void Put(int iovcnt, struct iovec *iov);
 
+//-----------------------------------------------------------------------------
+//! Switch to asynchronous logging. Afterwards, each thread formats its messages
+//! into its own buffer and a background thread writes them out in batches so
+//! that logging threads never wait for the log file. Trace lines written to
+//! cerr are handled the same way. Log file rotation is unaffected. Buffered
+//! messages are written out when the process exits normally; fatal error paths
+//! that end the process otherwise must call Flush() first. There is no way to
+//! switch back to synchronous logging.
+//!
+//! @param  bsz       The size of each thread's buffer in bytes.
+//! @param  block     When true, a thread whose buffer is full waits until the
+//!                   messages in it have been written. Otherwise, the message
+//!                   is dropped and the number of dropped messages is logged.
+//!
+//! @return  0        Processing successful.
+//! @return <0        Unable to start, returned value is -errno of the reason.
+//-----------------------------------------------------------------------------
+
+int  setAsync(int bsz, bool block);
+
 //-----------------------------------------------------------------------------
 //! Set call-out to logging plug-in on or off.
 //-----------------------------------------------------------------------------
@@ -220,7 +240,7 @@ void setRotate(int onoff) {doLFR = onoff;}
 //! @return pointer to the time buffer to be used as the msg timestamp.
 //-----------------------------------------------------------------------------
 
-char *traceBeg() {Logger_Mutex.Lock(); Time(TBuff); return TBuff;}
+char *traceBeg();
 
 //-----------------------------------------------------------------------------
 //! Stop trace message serialization. This method must be preceeded by a call
@@ -229,7 +249,7 @@ char *traceBeg() {Logger_Mutex.Lock(); Time(TBuff); return TBuff;}
 //! @return pointer to a new line character to terminate the message.
 //-----------------------------------------------------------------------------
 
-char  traceEnd() {Logger_Mutex.UnLock(); return '\n';}
+char  traceEnd();
 
 //-----------------------------------------------------------------------------
 //! Get the log file routing.
@@ -246,7 +266,15 @@ const char *xlogFN() {return (ePath ? ePath : "stderr");}
 
 void        zHandler();
 
+//-----------------------------------------------------------------------------
+//! Internal method to write asynchronous messages. This is public because it
+//! needs to be called by an external thread.
+//-----------------------------------------------------------------------------
+
+void        aHandler();
+
 private:
+int         Drain();
 int         FifoMake();
 void        FifoWait();
 int         Time(char *tbuff);
@@ -270,7 +298,7 @@ int        baseFD;
 char      *ePath;
 char       Filesfx[8];
 int        eInt;
-int        reserved1;
+bool       isAsync;
 char      *fifoFN;
 bool       hiRes;
 bool       doLFR;
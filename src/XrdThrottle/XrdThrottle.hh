@@ -234,6 +234,12 @@ private:
    int
    xloadshed(XrdOucStream &Config);
 
+   int
+   xclass(XrdOucStream &Config);
+
+   int
+   xclassify(XrdOucStream &Config);
+
    int
    xtrace(XrdOucStream &Config);
 
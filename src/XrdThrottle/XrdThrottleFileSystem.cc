@@ -90,7 +90,10 @@ int
 FileSystem::getStats(char *buff,
                      int   blen)
 {
-   return m_sfs_ptr->getStats(buff, blen);
+   int len = m_sfs_ptr->getStats(buff, blen);
+   if (!buff) return len + m_throttle.Stats(0, 0);
+   if (len < 0 || len >= blen) return len;
+   return len + m_throttle.Stats(buff+len, blen-len);
 }
 
 const char *
@@ -114,7 +114,7 @@ FileSystem::Initialize(FileSystem      *&fs,
    }
 }
 
-#define TS_Xeq(key, func) NoGo = (strcmp(key, var) == 0) ? func(Config) : 0
+#define TS_Xeq(key, func) if (strcmp(key, var) == 0) NoGo = func(Config)
 int
 FileSystem::Configure(XrdSysError & log, XrdSfsFileSystem *native_fs)
 {
@@ -136,9 +136,10 @@ FileSystem::Configure(XrdSysError & log, XrdSfsFileSystem *native_fs)
    std::string fslib = OFS_NAME;
 
    char *var, *val;
-   int NoGo = 0;
+   int NoGo = 0, cfgErr = 0;
    while( (var = Config.GetMyFirstWord()) )
    {
+      NoGo = 0;
       if (strcmp("throttle.fslib", var) == 0)
       {
          val = Config.GetWord();
@@ -147,12 +148,24 @@ FileSystem::Configure(XrdSysError & log, XrdSfsFileSystem *native_fs)
       }
       TS_Xeq("throttle.throttle", xthrottle);
       TS_Xeq("throttle.loadshed", xloadshed);
+      TS_Xeq("throttle.class", xclass);
+      TS_Xeq("throttle.classify", xclassify);
       TS_Xeq("throttle.trace", xtrace);
       if (NoGo)
       {
          log.Emsg("Config", "Throttle configuration failed.");
+         cfgErr = 1;
       }
    }
+   if (cfgErr) return 1;
+
+   // Resolve the throttle classes, if any, now that the global limits are known.
+   std::string err;
+   if (!m_throttle.ConfigClasses(err))
+   {
+      log.Emsg("Config", "Invalid throttle classes;", err.c_str());
+      return 1;
+   }
 
    // Load the filesystem object.
    m_sfs_ptr = native_fs ? native_fs : LoadFS(fslib, m_eroute, m_config_file);
@@ -278,6 +291,135 @@ int FileSystem::xloadshed(XrdOucStream &Config)
     return 0;
 }
 
+/******************************************************************************/
+/*                               x c l a s s                                  */
+/******************************************************************************/
+
+/* Function: xclass
+
+   Purpose:  To parse the directive: class <name> [parent <pname>] [weight <w>]
+                                            [rate <drate>] [ceil <dceil>]
+                                            [iops <irate>] [iopsceil <iceil>]
+                                            [burst <ms>]
+
+             <name>     name of the class; the class "default" is used for
+                        clients that are not classified.
+             <pname>    parent class, which must already be defined. Without
+                        one the class is placed under the global limits.
+             <w>        weight used to share the parent's rate among the
+                        classes that have no rate of their own (default 1).
+             <drate>    assured bytes per second.
+             <dceil>    maximum bytes per second, borrowing unused rate from
+                        the parent (default is the parent's ceiling).
+             <irate>    assured IOPS.
+             <iceil>    maximum IOPS.
+             <ms>       burst size expressed in milliseconds of the rate
+                        (default 1000).
+
+   Output: 0 upon success or !0 upon failure.
+*/
+int
+FileSystem::xclass(XrdOucStream &Config)
+{
+    XrdThrottleHTB::Limits lim;
+    std::string name, parent, err;
+    long long val64;
+    int burst;
+    char *val;
+
+    if (!(val = Config.GetWord()) || !val[0])
+       {m_eroute.Emsg("Config", "throttle class name not specified."); return 1;}
+    name = val;
+
+    while ((val = Config.GetWord()))
+    {
+       float *fP = 0;
+       const char *what = 0;
+       if (strcmp("parent", val) == 0)
+       {
+          if (!(val = Config.GetWord()))
+             {m_eroute.Emsg("Config", "parent class not specified."); return 1;}
+          parent = val;
+          continue;
+       }
+       else if (strcmp("weight", val) == 0)
+       {
+          if (!(val = Config.GetWord()))
+             {m_eroute.Emsg("Config", "class weight not specified."); return 1;}
+          if (XrdOuca2x::a2ll(m_eroute,"class weight",val,&val64,1,1000000)) return 1;
+          lim.weight = static_cast<float>(val64);
+          continue;
+       }
+       else if (strcmp("burst", val) == 0)
+       {
+          if (!(val = Config.GetWord()))
+             {m_eroute.Emsg("Config", "class burst not specified."); return 1;}
+          if (XrdOuca2x::a2i(m_eroute,"class burst",val,&burst,1,60000)) return 1;
+          lim.burst = static_cast<float>(burst)/1000.0;
+          continue;
+       }
+       else if (strcmp("rate",     val) == 0) {fP = &lim.data_min; what = "class rate";}
+       else if (strcmp("ceil",     val) == 0) {fP = &lim.data_max; what = "class ceil";}
+       else if (strcmp("iops",     val) == 0) {fP = &lim.iops_min; what = "class iops";}
+       else if (strcmp("iopsceil", val) == 0) {fP = &lim.iops_max; what = "class iopsceil";}
+       else
+       {
+          m_eroute.Emsg("Config", "unknown class option", val);
+          return 1;
+       }
+       if (!(val = Config.GetWord()))
+          {m_eroute.Emsg("Config", what, "not specified."); return 1;}
+       if (XrdOuca2x::a2sz(m_eroute,what,val,&val64,fP == &lim.data_min || fP == &lim.iops_min ? 0 : 1)) return 1;
+       *fP = static_cast<float>(val64);
+    }
+
+    if (!m_throttle.Classes().AddClass(name, parent, lim, err))
+       {m_eroute.Emsg("Config", err.c_str()); return 1;}
+    return 0;
+}
+
+/******************************************************************************/
+/*                            x c l a s s i f y                               */
+/******************************************************************************/
+
+/* Function: xclassify
+
+   Purpose:  To parse the directive: classify {user|group|vo} <id> <class>
+
+             <id>       the user, group, or VO name as set by authentication.
+             <class>    the class its requests are throttled in.
+
+             A user mapping takes precedence over a group mapping which takes
+             precedence over a VO mapping.
+
+   Output: 0 upon success or !0 upon failure.
+*/
+int
+FileSystem::xclassify(XrdOucStream &Config)
+{
+    XrdThrottleHTB::MapType type;
+    std::string id, err;
+    char *val;
+
+    if (!(val = Config.GetWord()))
+       {m_eroute.Emsg("Config", "classify type not specified."); return 1;}
+         if (strcmp("user",  val) == 0) type = XrdThrottleHTB::mapUser;
+    else if (strcmp("group", val) == 0) type = XrdThrottleHTB::mapGroup;
+    else if (strcmp("vo",    val) == 0) type = XrdThrottleHTB::mapVO;
+    else {m_eroute.Emsg("Config", "invalid classify type", val); return 1;}
+
+    if (!(val = Config.GetWord()) || !val[0])
+       {m_eroute.Emsg("Config", "classify id not specified."); return 1;}
+    id = val;
+
+    if (!(val = Config.GetWord()) || !val[0])
+       {m_eroute.Emsg("Config", "classify class not specified."); return 1;}
+
+    if (!m_throttle.Classes().AddMapping(type, id, val, err))
+       {m_eroute.Emsg("Config", err.c_str()); return 1;}
+    return 0;
+}
+
 /******************************************************************************/
 /*                                x t r a c e                                 */
 /******************************************************************************/
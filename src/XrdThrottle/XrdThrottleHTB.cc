@@ -0,0 +1,372 @@
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "XrdSec/XrdSecEntity.hh"
+#include "XrdSys/XrdSysTimer.hh"
+
+#include "XrdThrottle/XrdThrottleHTB.hh"
+
+/*
+ * The root class holds the global limits; it always exists.
+ */
+XrdThrottleHTB::XrdThrottleHTB() : m_default(-1)
+{
+   m_classes.push_back(new Class("root", -1, Limits()));
+}
+
+XrdThrottleHTB::~XrdThrottleHTB()
+{
+   for (size_t i=0; i<m_classes.size(); i++) delete m_classes[i];
+}
+
+/*
+ * Define a class.  The parent must have been defined before the child,
+ * which keeps the tree acyclic and lets Finalize work top-down.
+ */
+bool
+XrdThrottleHTB::AddClass(const std::string &name, const std::string &parent,
+                         const Limits &lim, std::string &err)
+{
+   if (Find(name) >= 0)
+   {
+      err = "class " + name + " already defined";
+      return false;
+   }
+   int pid = parent.empty() ? 0 : Find(parent);
+   if (pid < 0)
+   {
+      err = "parent class " + parent + " not defined";
+      return false;
+   }
+   if (lim.weight <= 0)
+   {
+      err = "class " + name + " weight must be positive";
+      return false;
+   }
+   m_classes.push_back(new Class(name, pid, lim));
+   if (name == "default") m_default = m_classes.size()-1;
+   return true;
+}
+
+/*
+ * Map a user, group, or VO name to a class.
+ */
+bool
+XrdThrottleHTB::AddMapping(MapType type, const std::string &key,
+                           const std::string &cname, std::string &err)
+{
+   int cid = Find(cname);
+   if (cid < 0)
+   {
+      err = "class " + cname + " not defined";
+      return false;
+   }
+   m_map[type][key] = cid;
+   return true;
+}
+
+/*
+ * Throttle a request of the given class.  Returns 1 if the request had to
+ * wait and 0 otherwise.
+ */
+int
+XrdThrottleHTB::Apply(int cid, int reqsize, int reqops)
+{
+   if (cid < 0 || cid >= static_cast<int>(m_classes.size())) cid = m_default;
+   const double need[2] = {static_cast<double>(reqsize), static_cast<double>(reqops)};
+   long long start = 0, now;
+   double wait;
+
+   while ((wait = Admit(cid, need, (now = Now()))) > 0)
+   {
+      if (!start) start = now;
+      int ms = static_cast<int>(wait*1000) + 1;
+      XrdSysTimer::Wait(ms > 1000 ? 1000 : ms);
+   }
+   Charge(cid, need);
+
+   if (start)
+   {
+      Class &c = *m_classes[cid];
+      c.mtx.Lock();
+      c.delays++;
+      c.delay_ns += Now() - start;
+      c.mtx.UnLock();
+   }
+   return start != 0;
+}
+
+/*
+ * Pick the class for a client: user mappings first, then any of its
+ * groups, then any of its VOs, else the default class.
+ */
+int
+XrdThrottleHTB::Classify(const XrdSecEntity *client) const
+{
+   std::map<std::string, int>::const_iterator it;
+   const char *names[mapNum] = {0, 0, 0};
+
+   if (!client) return m_default;
+   names[mapUser]  = client->name;
+   names[mapGroup] = client->grps;
+   names[mapVO]    = client->vorg;
+
+   for (int t=0; t<mapNum; t++)
+   {
+      if (!names[t] || m_map[t].empty()) continue;
+      if (t == mapUser)
+      {
+         if ((it = m_map[t].find(names[t])) != m_map[t].end()) return it->second;
+         continue;
+      }
+      // Groups and VOs are blank-separated lists
+      const char *cur = names[t];
+      while (*cur)
+      {
+         while (*cur == ' ') cur++;
+         const char *end = cur;
+         while (*end && *end != ' ') end++;
+         if (end != cur &&
+             (it = m_map[t].find(std::string(cur, end-cur))) != m_map[t].end())
+            return it->second;
+         cur = end;
+      }
+   }
+   return m_default;
+}
+
+/*
+ * Resolve the configured limits into bucket rates.  Run once after the
+ * configuration has been read.
+ */
+bool
+XrdThrottleHTB::Finalize(float data_cap, float iops_cap, std::string &err)
+{
+   Limits rlim;
+   rlim.data_min = rlim.data_max = data_cap;
+   rlim.iops_min = rlim.iops_max = iops_cap;
+   rlim.burst    = 1;
+   m_classes[0]->lim = rlim;
+
+   if (m_default < 0)
+   {
+      m_classes.push_back(new Class("default", 0, Limits()));
+      m_default = m_classes.size()-1;
+   }
+
+   SetBucket(m_classes[0]->assured[0], data_cap, 1);
+   SetBucket(m_classes[0]->ceiling[0], data_cap, 1);
+   SetBucket(m_classes[0]->assured[1], iops_cap, 1);
+   SetBucket(m_classes[0]->ceiling[1], iops_cap, 1);
+
+   for (size_t i=1; i<m_classes.size(); i++)
+   {
+      Class &c = *m_classes[i];
+      Class &p = *m_classes[c.parent];
+      double burst = c.lim.burst > 0 ? c.lim.burst : 1;
+      float  cmin[2] = {c.lim.data_min, c.lim.iops_min};
+      float  cmax[2] = {c.lim.data_max, c.lim.iops_max};
+
+      for (int d=0; d<2; d++)
+      {
+         double amin, amax;
+
+         // The assured rate is either explicit or a weighted share of what
+         // the parent has left after its explicitly assured children.
+         if (cmin[d] >= 0) amin = cmin[d];
+         else if (p.assured[d].rate < 0) amin = -1;
+         else
+         {
+            double left = p.assured[d].rate, wsum = 0;
+            for (size_t j=1; j<m_classes.size(); j++)
+            {
+               Class &s = *m_classes[j];
+               if (s.parent != c.parent) continue;
+               float smin = d ? s.lim.iops_min : s.lim.data_min;
+               if (smin >= 0) left -= smin;
+               else wsum += s.lim.weight;
+            }
+            amin = (left > 0 && wsum > 0) ? left * c.lim.weight / wsum : 0;
+         }
+
+         // The ceiling defaults to the parent's ceiling.
+         amax = (cmax[d] >= 0) ? cmax[d] : p.ceiling[d].rate;
+         if (amax >= 0 && (amin < 0 || amin > amax))
+         {
+            if (cmin[d] >= 0)
+            {
+               err = "class " + c.name + " assured rate exceeds its ceiling";
+               return false;
+            }
+            amin = amax;
+         }
+         SetBucket(c.assured[d], amin, burst);
+         SetBucket(c.ceiling[d], amax, burst);
+      }
+   }
+
+   long long now = Now();
+   for (size_t i=0; i<m_classes.size(); i++) m_classes[i]->last_ns = now;
+   return true;
+}
+
+/*
+ * Report per-class counters for the summary monitoring stream.
+ */
+int
+XrdThrottleHTB::Stats(char *buff, int blen)
+{
+   static const char statfmt1[] = "<stats id=\"throttle\"><mode>htb</mode>";
+   static const char statfmt2[] = "<class><name>%s</name><bytes>%lld</bytes>"
+                                  "<ops>%lld</ops><delays>%lld</delays>"
+                                  "<dlyms>%lld</dlyms></class>";
+   static const char statfmt3[] = "</stats>";
+   int len, n;
+
+   if (!Active()) return 0;
+
+   if (!buff)
+   {
+      len = sizeof(statfmt1) + sizeof(statfmt3);
+      for (size_t i=0; i<m_classes.size(); i++)
+         len += sizeof(statfmt2) + m_classes[i]->name.size() + 4*20;
+      return len;
+   }
+
+   if ((len = snprintf(buff, blen, statfmt1)) >= blen) return 0;
+   for (size_t i=0; i<m_classes.size(); i++)
+   {
+      Class &c = *m_classes[i];
+      c.mtx.Lock();
+      n = snprintf(buff+len, blen-len, statfmt2, c.name.c_str(), c.bytes,
+                   c.ops, c.delays, c.delay_ns/1000000);
+      c.mtx.UnLock();
+      if ((len += n) >= blen) return 0;
+   }
+   if ((len += snprintf(buff+len, blen-len, statfmt3)) >= blen) return 0;
+   return len;
+}
+
+/******************************************************************************/
+/*                       P r i v a t e   M e t h o d s                        */
+/******************************************************************************/
+
+/*
+ * Check whether the request may proceed.  Walking from the class towards
+ * the root, every class must be under its ceiling until one is found that
+ * is under its assured rate and can therefore lend.  Returns zero if the
+ * request may go, else the number of seconds until it is worth retrying.
+ */
+double
+XrdThrottleHTB::Admit(int cid, const double need[2], long long now)
+{
+   double lendWait = -1;
+
+   for (int i=cid; i>=0; i=m_classes[i]->parent)
+   {
+      Class &c = *m_classes[i];
+      double ceilWait = 0, myWait = 0;
+      bool   canLend = true;
+
+      // A class with a zero assured rate never lends and so has no wait
+      // of its own (myWait < 0).
+      c.mtx.Lock();
+      Refill(c, now);
+      for (int d=0; d<2; d++)
+      {
+         if (!need[d]) continue;
+         const Bucket &cb = c.ceiling[d], &ab = c.assured[d];
+         if (cb.rate > 0 && cb.tokens < 0 && -cb.tokens/cb.rate > ceilWait)
+            ceilWait = -cb.tokens/cb.rate;
+         if (ab.rate == 0) {canLend = false; myWait = -1;}
+         else if (ab.rate > 0 && ab.tokens < 0)
+         {
+            canLend = false;
+            if (myWait >= 0 && -ab.tokens/ab.rate > myWait)
+               myWait = -ab.tokens/ab.rate;
+         }
+      }
+      c.mtx.UnLock();
+
+      if (ceilWait > 0) return ceilWait;
+      if (canLend) return 0;
+      if (myWait > 0 && (lendWait < 0 || myWait < lendWait)) lendWait = myWait;
+   }
+   return lendWait > 0 ? lendWait : 0.001;
+}
+
+/*
+ * Charge the request against every class from the leaf to the root and
+ * count it there.  The full debt is kept, even when a request is larger
+ * than the bucket depth, so that the long-run rate never exceeds the limit;
+ * Admit() holds back later requests until the debt has been paid off.
+ */
+void
+XrdThrottleHTB::Charge(int cid, const double need[2])
+{
+   for (int i=cid; i>=0; i=m_classes[i]->parent)
+   {
+      Class &c = *m_classes[i];
+      c.mtx.Lock();
+      c.bytes += static_cast<long long>(need[0]);
+      c.ops   += static_cast<long long>(need[1]);
+      for (int d=0; d<2; d++)
+      {
+         Bucket *b[2] = {&c.assured[d], &c.ceiling[d]};
+         for (int k=0; k<2; k++)
+         {
+            if (b[k]->rate <= 0) continue;
+            b[k]->tokens -= need[d];
+         }
+      }
+      c.mtx.UnLock();
+   }
+}
+
+int
+XrdThrottleHTB::Find(const std::string &name) const
+{
+   for (size_t i=0; i<m_classes.size(); i++)
+      if (m_classes[i]->name == name) return i;
+   return -1;
+}
+
+/*
+ * Add the tokens accumulated since the last look; the class lock is held.
+ */
+void
+XrdThrottleHTB::Refill(Class &c, long long now)
+{
+   double dt = (now - c.last_ns) / 1000000000.0;
+   if (dt <= 0) return;
+   c.last_ns = now;
+   for (int d=0; d<2; d++)
+   {
+      Bucket *b[2] = {&c.assured[d], &c.ceiling[d]};
+      for (int k=0; k<2; k++)
+      {
+         if (b[k]->rate <= 0) continue;
+         b[k]->tokens += b[k]->rate * dt;
+         if (b[k]->tokens > b[k]->depth) b[k]->tokens = b[k]->depth;
+      }
+   }
+}
+
+long long
+XrdThrottleHTB::Now()
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ts.tv_sec*1000000000LL + ts.tv_nsec;
+}
+
+void
+XrdThrottleHTB::SetBucket(Bucket &b, double rate, double burst)
+{
+   b.rate   = rate;
+   b.depth  = rate > 0 ? rate * burst : 0;
+   if (rate > 0 && b.depth < 1) b.depth = 1;
+   b.tokens = b.depth;
+}
@@ -0,0 +1,117 @@
+/*
+ * XrdThrottleHTB
+ *
+ * A hierarchical token-bucket throttle.  Requests are classified by
+ * user, group, or VO into classes arranged in a tree under a root class
+ * that holds the global limits.  Every class has an assured rate, which
+ * it is guaranteed, and a ceiling rate, up to which it may borrow unused
+ * rate from its ancestors.  Classes with no explicit assured rate split
+ * what their parent has left over according to their weight.
+ *
+ * Each class keeps two token buckets (assured and ceiling) for bytes and
+ * two for operations.  Buckets are refilled lazily from a monotonic clock
+ * whenever a request looks at them, so there is no periodic recompute and
+ * no global lock or condition variable; a request that has to wait sleeps
+ * for as long as the blocking bucket needs to refill.
+ */
+
+#ifndef __XrdThrottleHTB_hh_
+#define __XrdThrottleHTB_hh_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "XrdSys/XrdSysPthread.hh"
+
+class XrdSecEntity;
+
+class XrdThrottleHTB
+{
+public:
+
+enum MapType {mapUser = 0, mapGroup, mapVO, mapNum};
+
+struct Limits
+{
+   float data_min;      // Assured bytes/s; negative means weighted share
+   float data_max;      // Ceiling bytes/s; negative means parent's ceiling
+   float iops_min;      // Assured ops/s
+   float iops_max;      // Ceiling ops/s
+   float weight;        // Weight used to split the parent's rate
+   float burst;         // Bucket depth in seconds of the rate
+
+   Limits() : data_min(-1), data_max(-1), iops_min(-1), iops_max(-1),
+              weight(1), burst(-1) {}
+};
+
+bool        Active() const {return m_classes.size() > 1;}
+
+bool        AddClass(const std::string &name, const std::string &parent,
+                     const Limits &lim, std::string &err);
+
+bool        AddMapping(MapType type, const std::string &key,
+                       const std::string &cname, std::string &err);
+
+int         Apply(int cid, int reqsize, int reqops);
+
+int         Classify(const XrdSecEntity *client) const;
+
+bool        Finalize(float data_cap, float iops_cap, std::string &err);
+
+int         Stats(char *buff, int blen);
+
+            XrdThrottleHTB();
+
+           ~XrdThrottleHTB();
+
+private:
+
+struct Bucket
+{
+   double tokens;
+   double rate;         // Negative means unlimited
+   double depth;
+
+   Bucket() : tokens(0), rate(-1), depth(0) {}
+};
+
+struct Class
+{
+   XrdSysMutex  mtx;
+   std::string  name;
+   int          parent;
+   Limits       lim;
+   Bucket       assured[2];  // [0] bytes, [1] ops
+   Bucket       ceiling[2];
+   long long    last_ns;
+   long long    bytes;
+   long long    ops;
+   long long    delays;
+   long long    delay_ns;
+
+   Class(const std::string &n, int p, const Limits &l)
+        : name(n), parent(p), lim(l), last_ns(0),
+          bytes(0), ops(0), delays(0), delay_ns(0) {}
+};
+
+double      Admit(int cid, const double need[2], long long now);
+
+void        Charge(int cid, const double need[2]);
+
+int         Find(const std::string &name) const;
+
+void        Refill(Class &c, long long now);
+
+static
+long long   Now();
+
+static
+void        SetBucket(Bucket &b, double rate, double burst);
+
+std::vector<Class *>               m_classes;  // [0] is the root
+std::map<std::string, int>         m_map[mapNum];
+int                                m_default;
+};
+
+#endif
@@ -5,6 +5,7 @@
 #include "XrdSys/XrdSysTimer.hh"
 
 #include "XrdOuc/XrdOucEnv.hh"
+#include "XrdSec/XrdSecEntity.hh"
 
 #define XRD_TRACE m_trace->
 #include "XrdThrottle/XrdThrottleTrace.hh"
@@ -44,6 +45,14 @@ void
 XrdThrottleManager::Init()
 {
    TRACE(DEBUG, "Initializing the throttle manager.");
+   m_io_wait.tv_sec = 0;
+   m_io_wait.tv_nsec = 0;
+
+   // With classes the token buckets do all of the throttling. The recompute
+   // thread is then only needed to wake up requests waiting for the
+   // concurrency limit and to reset the load-shed counter.
+   if (m_htb.Active() && m_concurrency_limit < 0 && !m_loadshed_port) return;
+
    // Initialize all our shares to zero.
    m_primary_bytes_shares.reserve(m_max_users);
    m_secondary_bytes_shares.reserve(m_max_users);
@@ -58,9 +67,6 @@ XrdThrottleManager::Init()
       m_secondary_ops_shares[i] = 0;
    }
 
-   m_io_wait.tv_sec = 0;
-   m_io_wait.tv_nsec = 0;
-
    int rc;
    pthread_t tid;
    if ((rc = XrdSysThread::Run(&tid, XrdThrottleManager::RecomputeBootstrap, static_cast<void *>(this), 0, "Buffer Manager throttle")))
@@ -111,6 +117,19 @@ XrdThrottleManager::StealShares(int uid, int &reqsize, int &reqops)
 void
 XrdThrottleManager::Apply(int reqsize, int reqops, int uid)
 {
+   // With classes the uid is the class and each request is throttled on
+   // its own against the class buckets.
+   if (m_htb.Active())
+   {
+      if (m_htb.Apply(uid, reqsize, reqops))
+      {
+         TRACE(BANDWIDTH, "Request for class " << uid << " was delayed by its token buckets.");
+         AtomicBeg(m_compute_var);
+         AtomicInc(m_loadshed_limit_hit);
+         AtomicEnd(m_compute_var);
+      }
+      return;
+   }
    if (m_bytes_per_second < 0)
       reqsize = 0;
    if (m_ops_per_second < 0)
@@ -196,9 +215,41 @@ XrdThrottleManager::RecomputeInternal()
    float total_bytes_shares = m_bytes_per_second / intervals_per_second;
    float total_ops_shares   = m_ops_per_second / intervals_per_second;
 
+   // The fair shares are not used when the classes are active.
+   AtomicBeg(m_compute_var);
+   if (!m_htb.Active()) RecomputeShares(total_bytes_shares, total_ops_shares);
+
+   // Reset the loadshed limit counter.
+   int limit_hit = AtomicFAZ(m_loadshed_limit_hit);
+   TRACE(DEBUG, "Throttle limit hit " << limit_hit << " times during last interval.");
+
+   AtomicEnd(m_compute_var);
+
+   // Update the IO counters
+   m_compute_var.Lock();
+   m_stable_io_counter = AtomicGet(m_io_counter);
+   time_t secs; AtomicFZAP(secs, m_io_wait.tv_sec);
+   long nsecs; AtomicFZAP(nsecs, m_io_wait.tv_nsec);
+   m_stable_io_wait.tv_sec += static_cast<long>(secs * intervals_per_second);
+   m_stable_io_wait.tv_nsec += static_cast<long>(nsecs * intervals_per_second);
+   while (m_stable_io_wait.tv_nsec > 1000000000)
+   {
+      m_stable_io_wait.tv_nsec -= 1000000000;
+      m_stable_io_wait.tv_nsec --;
+   }
+   m_compute_var.UnLock();
+   TRACE(IOLOAD, "Current IO counter is " << m_stable_io_counter << "; total IO wait time is " << (m_stable_io_wait.tv_sec*1000+m_stable_io_wait.tv_nsec/1000000) << "ms.");
+   m_compute_var.Broadcast();
+}
+
+/*
+ * Hand out the fair shares for the next interval; the compute lock is held.
+ */
+void
+XrdThrottleManager::RecomputeShares(float total_bytes_shares, float total_ops_shares)
+{
    // Compute the number of active users; a user is active if they used
    // any primary share during the last interval;
-   AtomicBeg(m_compute_var);
    float active_users = 0;
    long bytes_used = 0;
    for (int i=0; i<m_max_users; i++)
@@ -233,28 +284,6 @@ XrdThrottleManager::RecomputeInternal()
       m_primary_bytes_shares[i] = m_last_round_allocation;
       m_primary_ops_shares[i] = ops_shares;
    }
-
-   // Reset the loadshed limit counter.
-   int limit_hit = AtomicFAZ(m_loadshed_limit_hit);
-   TRACE(DEBUG, "Throttle limit hit " << limit_hit << " times during last interval.");
-
-   AtomicEnd(m_compute_var);
-
-   // Update the IO counters
-   m_compute_var.Lock();
-   m_stable_io_counter = AtomicGet(m_io_counter);
-   time_t secs; AtomicFZAP(secs, m_io_wait.tv_sec);
-   long nsecs; AtomicFZAP(nsecs, m_io_wait.tv_nsec);
-   m_stable_io_wait.tv_sec += static_cast<long>(secs * intervals_per_second);
-   m_stable_io_wait.tv_nsec += static_cast<long>(nsecs * intervals_per_second);
-   while (m_stable_io_wait.tv_nsec > 1000000000)
-   {
-      m_stable_io_wait.tv_nsec -= 1000000000;
-      m_stable_io_wait.tv_nsec --;
-   }
-   m_compute_var.UnLock();
-   TRACE(IOLOAD, "Current IO counter is " << m_stable_io_counter << "; total IO wait time is " << (m_stable_io_wait.tv_sec*1000+m_stable_io_wait.tv_nsec/1000000) << "ms.");
-   m_compute_var.Broadcast();
 }
 
 /*
@@ -275,6 +304,16 @@ XrdThrottleManager::GetUid(const char *username)
    return hval;
 }
 
+/*
+ * Get the uid for a client; this is its class if classes are defined.
+ */
+int
+XrdThrottleManager::GetUid(const XrdSecEntity *client)
+{
+   if (m_htb.Active()) return m_htb.Classify(client);
+   return GetUid(client->name);
+}
+
 /*
  * Create an IO timer object; increment the number of outstanding IOs.
  */
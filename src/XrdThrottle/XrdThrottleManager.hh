@@ -33,7 +33,9 @@
 #include <time.h>
 
 #include "XrdSys/XrdSysPthread.hh"
+#include "XrdThrottle/XrdThrottleHTB.hh"
 
+class XrdSecEntity;
 class XrdSysError;
 class XrdOucTrace;
 class XrdThrottleTimer;
@@ -58,11 +60,18 @@ void        SetThrottles(float reqbyterate, float reqoprate, int concurrency, fl
 void        SetLoadShed(std::string &hostname, unsigned port, unsigned frequency)
             {m_loadshed_host = hostname; m_loadshed_port = port; m_loadshed_frequency = frequency;}
 
-//int         Stats(char *buff, int blen, int do_sync=0) {return m_pool.Stats(buff, blen, do_sync);}
+XrdThrottleHTB &Classes() {return m_htb;}
+
+bool        ConfigClasses(std::string &err)
+            {return !m_htb.Active() || m_htb.Finalize(m_bytes_per_second, m_ops_per_second, err);}
+
+int         Stats(char *buff, int blen) {return m_htb.Stats(buff, blen);}
 
 static
 int         GetUid(const char *username);
 
+int         GetUid(const XrdSecEntity *client);
+
 XrdThrottleTimer StartIOTimer();
 
 void        PrepLoadShed(const char *opaque, std::string &lsOpaque);
@@ -85,6 +94,8 @@ void        Recompute();
 
 void        RecomputeInternal();
 
+void        RecomputeShares(float total_bytes_shares, float total_ops_shares);
+
 static
 void *      RecomputeBootstrap(void *pp);
 
@@ -114,6 +125,9 @@ std::vector<int> m_primary_ops_shares;
 std::vector<int> m_secondary_ops_shares;
 int         m_last_round_allocation;
 
+// Hierarchical token-bucket classes; when defined they replace the shares
+XrdThrottleHTB m_htb;
+
 // Active IO counter
 int         m_io_counter;
 struct timespec m_io_wait;
@@ -46,6 +46,7 @@ add_library(
                                 XrdSys/XrdSysIOEventsPollKQ.icc
                                 XrdSys/XrdSysIOEventsPollPoll.icc
                                 XrdSys/XrdSysIOEventsPollPort.icc
+  XrdSys/XrdSysIOURing.cc       XrdSys/XrdSysIOURing.hh
                                 XrdSys/XrdSysAtomics.hh
                                 XrdSys/XrdSysHeaders.hh
   XrdSys/XrdSysError.cc         XrdSys/XrdSysError.hh
@@ -73,6 +74,8 @@ add_library(
   XrdOuc/XrdOucEnv.cc           XrdOuc/XrdOucEnv.hh
                                 XrdOuc/XrdOucHash.hh
                                 XrdOuc/XrdOucHash.icc
+                                XrdOuc/XrdOucFlatHash.hh
+                                XrdOuc/XrdOucFlatHash.icc
   XrdOuc/XrdOucERoute.cc        XrdOuc/XrdOucERoute.hh
                                 XrdOuc/XrdOucErrInfo.hh
   XrdOuc/XrdOucExport.cc        XrdOuc/XrdOucExport.hh
@@ -162,6 +165,8 @@ add_library(
                                 Xrd/XrdPollDev.icc
                                 Xrd/XrdPollE.hh
                                 Xrd/XrdPollE.icc
+                                Xrd/XrdPollU.hh
+                                Xrd/XrdPollU.icc
                                 Xrd/XrdPollPoll.hh
                                 Xrd/XrdPollPoll.icc
   Xrd/XrdProtocol.cc            Xrd/XrdProtocol.hh
@@ -173,13 +178,14 @@ add_library(
   # XrdCks
   #-----------------------------------------------------------------------------
   XrdCks/XrdCksAssist.cc           XrdCks/XrdCksAssist.hh
+  XrdCks/XrdCksCalcadler32.cc      XrdCks/XrdCksCalcadler32.hh
   XrdCks/XrdCksCalccrc32.cc        XrdCks/XrdCksCalccrc32.hh
+  XrdCks/XrdCksCalccrc32c.cc       XrdCks/XrdCksCalccrc32c.hh
   XrdCks/XrdCksCalcmd5.cc          XrdCks/XrdCksCalcmd5.hh
   XrdCks/XrdCksConfig.cc           XrdCks/XrdCksConfig.hh
   XrdCks/XrdCksLoader.cc           XrdCks/XrdCksLoader.hh
   XrdCks/XrdCksManager.cc          XrdCks/XrdCksManager.hh
   XrdCks/XrdCksManOss.cc           XrdCks/XrdCksManOss.hh
-                                   XrdCks/XrdCksCalcadler32.hh
                                    XrdCks/XrdCksCalc.hh
                                    XrdCks/XrdCksData.hh
                                    XrdCks/XrdCks.hh
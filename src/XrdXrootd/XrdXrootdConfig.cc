@@ -331,6 +331,11 @@ int XrdXrootdProtocol::Configure(char *parms, XrdProtocol_Config *pi)
    else if (!as_noaio) XrdXrootdAioReq::Init(as_segsize, as_maxperreq, as_maxpersrv);
    else eDest.Say("Config warning: asynchronous I/O has been disabled!");
 
+// The filesystem may ask that all files be opened in async mode (e.g. a proxy
+// where each i/o takes a network round trip).
+//
+   if (getenv("XRDXROOTD_FORCEAIO")) as_force = 1;
+
 // Create the file lock manager
 //
    Locker = (XrdXrootdFileLock *)new XrdXrootdFileLock1();
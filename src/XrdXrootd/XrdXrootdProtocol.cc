@@ -318,6 +318,11 @@ int dlen, rc;
        return (XrdProtocol *)0;
       }
 
+// We only read the link through its methods, so the poller may receive
+// requests on our behalf if it can do so.
+//
+   lp->armRecvQ();
+
 // Get a protocol object off the stack (if none, allocate a new one)
 //
    if (!(xp = ProtStack.Pop())) xp = new XrdXrootdProtocol();
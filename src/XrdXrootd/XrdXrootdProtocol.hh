@@ -67,6 +67,7 @@
 class XrdNetSocket;
 class XrdOucEnv;
 class XrdOucErrInfo;
+struct XrdOucIOVec;
 class XrdOucReqID;
 class XrdOucStream;
 class XrdOucTList;
@@ -165,6 +166,7 @@ enum RD_func {RD_chmod = 0, RD_chksum,  RD_dirlist, RD_locate, RD_mkdir,
        int   do_Qxattr();
        int   do_Read();
        int   do_ReadV();
+       int   do_ReadVSF(XrdOucIOVec *rdVec, int rdVecNum, int Quantum);
        int   do_ReadAll(int asyncOK=1);
        int   do_ReadNone(int &retc, int &pathID);
        int   do_Rm();
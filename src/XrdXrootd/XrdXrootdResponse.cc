@@ -293,18 +293,27 @@ int XrdXrootdResponse::Send(int fdnum, long long offset, int dlen)
 
 int XrdXrootdResponse::Send(XrdOucSFVec *sfvec, int sfvnum, int dlen)
 {
-   static kXR_unt16 isOK = static_cast<kXR_unt16>(htons(kXR_ok));
+   return Send(kXR_ok, sfvec, sfvnum, dlen);
+}
+ 
+/******************************************************************************/
 
-   TRACES(RSP, "sendfile " <<dlen <<" data bytes");
+int XrdXrootdResponse::Send(XResponseType rcode,
+                            XrdOucSFVec *sfvec, int sfvnum, int dlen)
+{
+
+   TRACES(RSP, "sendfile " <<dlen <<" data bytes; status=" <<rcode);
 
+// The bridge only takes a sendfile vector as the final response
+//
    if (Bridge)
-      {if (Bridge->Send(sfvec, sfvnum, dlen) >= 0) return 0;
+      {if (rcode == kXR_ok && Bridge->Send(sfvec, sfvnum, dlen) >= 0) return 0;
        return Link->setEtext("send failure");
       }
 
 // We are only called should sendfile be enabled for this response
 //
-   Resp.status = isOK;
+   Resp.status = static_cast<kXR_unt16>(htons(rcode));
    Resp.dlen   = static_cast<kXR_int32>(htonl(dlen));
    sfvec[0].buffer = (char *)&Resp;
    sfvec[0].sendsz = sizeof(Resp);
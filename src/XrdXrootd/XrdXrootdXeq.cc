@@ -2146,6 +2146,14 @@ int XrdXrootdProtocol::do_ReadV()
    if (!FTab) return Response.Send(kXR_FileNotOpen,
                               "readv does not refer to an open file");
 
+// When the segments are large enough for sendfile to pay off, try to have the
+// kernel copy them to the socket. Each segment costs an extra system call for
+// its header, so we want them to average twice the minimum sendfile size. We
+// fall through when sendfile is not possible.
+//
+   if (totSZ - rdVecLen >= static_cast<long long>(as_minsfsz) * 2 * rdVBreak
+   &&  (k = do_ReadVSF(rdVec, rdVBreak, Quantum)) != 1) return k;
+
 // Preset the previous and current file handle to be the handle of the first
 // element and make sure the file is actually open.
 //
@@ -2219,6 +2227,101 @@ int XrdXrootdProtocol::do_ReadV()
    return (Quantum != Qleft ? Response.Send(argp->buff, Quantum-Qleft) : 0);
 }
 
+/******************************************************************************/
+/*                             d o _ R e a d V S F                            */
+/******************************************************************************/
+  
+int XrdXrootdProtocol::do_ReadVSF(XrdOucIOVec *rdVec, int rdVecNum, int Quantum)
+{
+// Here the readv response is sent using sendfile. The readahead_list header of
+// each segment is placed in the data buffer and interleaved with the file
+// segment itself in the sendfile vector so that each response frame is sent
+// with a single call. We return 1, having sent nothing, should any segment not
+// qualify; the caller then reads the data as usual.
+//
+   static const int hdrSZ  = sizeof(readahead_list);
+   static const int segMax = (XrdOucSFVec::sfMax - 1) / 2;
+   XrdOucSFVec sfVec[XrdOucSFVec::sfMax];
+   XrdXrootdFile *fP = 0;
+   struct readahead_list *hdrP = (readahead_list *)argp->buff;
+   XrdSfsXferSize rdVXfr = 0;
+   int currFH = 0, i, k, rdVBeg, segN, sfN, sfLen;
+   int rvMon = Monitor.InOut();
+   int ioMon = (rvMon > 1);
+   char vType = (ioMon ? XROOTD_MON_READU : XROOTD_MON_READV);
+
+// Bridged responses and links that can't do sendfile must take the read path
+//
+   if (!Response.isOurs() || !XrdLink::sfOK) return 1;
+
+// Every file must be open with a descriptor we can use and every segment must
+// lie within the file as we can't report a short read after the fact.
+//
+   for (i = 0; i < rdVecNum; i++)
+       {if (!i || rdVec[i].info != currFH)
+           {currFH = rdVec[i].info;
+            if (!(fP = FTab->Get(currFH))) return Response.Send(kXR_FileNotOpen,
+                                      "readv does not refer to an open file");
+            if (!fP->sfEnabled || fP->fdNum < 0) return 1;
+           }
+        if (rdVec[i].offset + rdVec[i].size > fP->Stats.fSize) return 1;
+       }
+
+// Account for the request for each run of segments against the same file
+//
+   rvSeq++; rdVBeg = 0;
+   for (i = 0; i <= rdVecNum; i++)
+       {if (i == rdVecNum || rdVec[i].info != rdVec[rdVBeg].info)
+           {fP = FTab->Get(rdVec[rdVBeg].info);
+            fP->Stats.rvOps(rdVXfr, i - rdVBeg);
+            if (rvMon)
+               {Monitor.Agent->Add_rv(fP->Stats.FileID, htonl(rdVXfr),
+                                      htons(i - rdVBeg), rvSeq, vType);
+                if (ioMon) for (k = rdVBeg; k < i; k++)
+                    Monitor.Agent->Add_rd(fP->Stats.FileID,
+                            htonl(rdVec[k].size), htonll(rdVec[k].offset));
+               }
+            if (i == rdVecNum) break;
+            rdVBeg = i; rdVXfr = 0;
+           }
+        rdVXfr += rdVec[i].size;
+       }
+
+// Now build the frames. Element zero of the vector is reserved for the
+// response header. A frame is flushed when the vector is full or when the next
+// segment would make it larger than the transfer unit.
+//
+   sfN = 1; segN = sfLen = 0;
+   for (i = 0; i < rdVecNum; i++, hdrP++)
+       {if (segN && (segN >= segMax || sfLen+hdrSZ+rdVec[i].size > Quantum))
+           {if (Response.Send(kXR_oksofar, sfVec, sfN, sfLen) < 0) return -1;
+            sfN = 1; segN = sfLen = 0;
+           }
+        if (!i || rdVec[i].info != currFH)
+           {currFH = rdVec[i].info; fP = FTab->Get(currFH);}
+        memcpy(hdrP->fhandle, &currFH, sizeof(hdrP->fhandle));
+        hdrP->rlen   = htonl(rdVec[i].size);
+        hdrP->offset = htonll(rdVec[i].offset);
+        sfVec[sfN].buffer = (char *)hdrP;
+        sfVec[sfN].sendsz = hdrSZ;
+        sfVec[sfN].fdnum  = -1;
+        sfN++;
+        if (rdVec[i].size)
+           {sfVec[sfN].offset = rdVec[i].offset;
+            sfVec[sfN].sendsz = rdVec[i].size;
+            sfVec[sfN].fdnum  = fP->fdNum;
+            sfN++;
+           }
+        sfLen += hdrSZ + rdVec[i].size; segN++;
+        TRACEP(FS,"fh=" <<currFH <<" readV sendfile " << rdVec[i].size
+                  <<'@' <<rdVec[i].offset);
+       }
+
+// Send the final frame
+//
+   return Response.Send(kXR_ok, sfVec, sfN, sfLen);
+}
+
 /******************************************************************************/
 /*                                 d o _ R m                                  */
 /******************************************************************************/
@@ -0,0 +1,285 @@
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d A c c B e n c h . c c                         */
+/*                                                                            */
+/* (c) 2026 by the contributors to the XRootD software suite                  */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <string>
+#include <vector>
+
+#include "XrdAcc/XrdAccCapability.hh"
+#include "XrdSys/XrdSysXSLock.hh"
+
+/******************************************************************************/
+/*                       L o c a l   F u n c t i o n s                        */
+/******************************************************************************/
+
+namespace
+{
+XrdAccCapability        *walkList;
+XrdAccCapability        *trieList;
+XrdAccPrivCaps          *listRes;
+std::vector<std::string> paths;
+XrdSysXSLock             listLock;
+int                      passes;
+int                      errors = 0;
+
+static const char *areas[] = {"data", "mc", "user", "group", "temp", "unmerged"};
+static const int   numAreas = sizeof(areas)/sizeof(areas[0]);
+
+double Now()
+{
+   struct timeval tv;
+   gettimeofday(&tv, 0);
+   return tv.tv_sec + tv.tv_usec/1000000.0;
+}
+
+void Report(const char *what, long long num, double secs)
+{
+   printf("%-12s %10lld lookups in %8.3f sec (%8.1f ns/lookup)\n",
+          what, num, secs, secs*1000000000.0/num);
+}
+
+// Build a list of rules looking like a large authorization database: one or
+// more paths per user spread over a few experiment areas, some of them
+// denials, plus a template shared by a slice of the rules.
+//
+XrdAccCapability *MakeRules(int numRules)
+{
+   XrdAccCapability *tmpl, *capList, *last, *cap;
+   XrdAccPrivCaps    caps;
+   char path[256];
+
+   caps.pprivs = XrdAccPriv_Readdir;
+   sprintf(path, "/store/%s/", areas[0]);
+   tmpl = new XrdAccCapability(path, caps);
+   caps.pprivs = XrdAccPriv_All;
+   strcat(path, "priv");
+   tmpl->Add(new XrdAccCapability(path, caps));
+
+   sprintf(path, "/store/%s/user0", areas[2]);
+   capList = last = new XrdAccCapability(path, caps);
+   for (int i = 1; i < numRules; i++)
+       {if (i % 500 == 0) cap = new XrdAccCapability(tmpl);
+           else {sprintf(path, "/store/%s/%s%d", areas[i % numAreas],
+                         (i % 7 ? "user" : "prod"), i/numAreas);
+                 caps.pprivs = (i % 3 ? XrdAccPriv_All : XrdAccPriv_Read);
+                 caps.nprivs = (i % 11 ? XrdAccPriv_None : XrdAccPriv_Delete);
+                 cap = new XrdAccCapability(path, caps);
+                }
+        last->Add(cap);
+        last = cap;
+       }
+   caps.pprivs = XrdAccPriv_Lookup;
+   caps.nprivs = XrdAccPriv_None;
+   last->Add(new XrdAccCapability((char *)"/store", caps));
+   return capList;
+}
+
+// Make up an access log that hits rules at every position in the list, with
+// some paths that no rule covers.
+//
+void MakeLog(int numRules, int numPaths)
+{
+   char path[512];
+   int n;
+
+   for (int i = 0; i < numPaths; i++)
+       {n = (int)((i * 7919LL) % numRules);
+        switch(i % 4)
+              {case 0: sprintf(path, "/store/%s/%s%d/run%d/file%d.root",
+                               areas[n % numAreas], (n % 7 ? "user" : "prod"),
+                               n/numAreas, i % 1000, i);
+                       break;
+               case 1: sprintf(path, "/store/%s/user%d",
+                               areas[n % numAreas], n/numAreas);
+                       break;
+               case 2: sprintf(path, "/store/%s/priv/f%d", areas[0], i);
+                       break;
+               default: sprintf(path, "/other/%s/%d", areas[n % numAreas], i);
+                       break;
+              }
+        paths.push_back(path);
+       }
+}
+
+// Read the paths from a recorded access log. The path is taken to be the
+// first blank separated token on a line that starts with a slash.
+//
+bool ReadLog(const char *fn)
+{
+   FILE *fP = fopen(fn, "r");
+   char line[4096], *tok, *save;
+
+   if (!fP) {perror(fn); return false;}
+   while(fgets(line, sizeof(line), fP))
+        {tok = strtok_r(line, " \t\n", &save);
+         while(tok && *tok != '/') tok = strtok_r(0, " \t\n", &save);
+         if (tok) paths.push_back(tok);
+        }
+   fclose(fP);
+   return true;
+}
+
+double Replay(XrdAccCapability *capList, XrdAccPrivCaps *res)
+{
+   double tBeg = Now();
+
+   for (unsigned int i = 0; i < paths.size(); i++)
+       {res[i] = XrdAccPrivCaps();
+        capList->Privs(res[i], paths[i].c_str(), paths[i].size());
+       }
+   return Now() - tBeg;
+}
+
+// Concurrent replays: before the lookups took a shared lock on the tables
+//
+void *ListReader(void *arg)
+{
+   long long k = (long long)arg;
+   for (int n = 0; n < passes; n++)
+       for (unsigned int i = 0; i < paths.size(); i++)
+           {XrdAccPrivCaps caps;
+            k = (k + 1) % paths.size();
+            listLock.Lock(xs_Shared);
+            walkList->Privs(caps, paths[k].c_str(), paths[k].size());
+            listLock.UnLock(xs_Shared);
+            if (caps.pprivs != listRes[k].pprivs)
+               __sync_fetch_and_add(&errors, 1);
+           }
+   return 0;
+}
+
+void *TrieReader(void *arg)
+{
+   long long k = (long long)arg;
+   for (int n = 0; n < passes; n++)
+       for (unsigned int i = 0; i < paths.size(); i++)
+           {XrdAccPrivCaps caps;
+            k = (k + 1) % paths.size();
+            trieList->Privs(caps, paths[k].c_str(), paths[k].size());
+            if (caps.pprivs != listRes[k].pprivs)
+               __sync_fetch_and_add(&errors, 1);
+           }
+   return 0;
+}
+
+void Threads(const char *tab, void *(*reader)(void *), int numT)
+{
+   pthread_t tid[64];
+   double tBeg = Now();
+   char what[32];
+   int i;
+
+   for (i = 0; i < numT; i++)
+       pthread_create(&tid[i], 0, reader,
+                      (void *)(long long)(i*paths.size()/numT));
+   for (i = 0; i < numT; i++) pthread_join(tid[i], 0);
+   snprintf(what, sizeof(what), "%s %dthr", tab, numT);
+   Report(what, (long long)passes*paths.size()*numT, Now() - tBeg);
+}
+}
+
+/******************************************************************************/
+/*                                  m a i n                                   */
+/******************************************************************************/
+
+// Usage: xrdaccbench [-f <logfile>] [<numrules> [<numthreads>]]
+//
+// Builds a capability list of the given number of rules (default 5000) and
+// replays an access log through it, first walking the list and then through
+// the compiled trie, checking that both give the same privileges for every
+// path. The paths come from the given log file, where the first token that
+// starts with a slash on each line is taken as the path, or are made up. Then
+// times concurrent replays by the given number of threads (default 4) with the
+// list walk under a shared lock and with the trie.
+//
+int main(int argc, char *argv[])
+{
+   const char *logFN = 0;
+   XrdAccPrivCaps *trieRes;
+   double tBeg, tList, tTrie;
+   int numRules = 5000, numT = 4, n, argp = 1;
+
+// Get the arguments
+//
+   if (argc > 2 && !strcmp(argv[1], "-f")) {logFN = argv[2]; argp = 3;}
+   if ((argc > argp   && (numRules = atoi(argv[argp])) <= 0)
+   ||  (argc > argp+1 && ((numT = atoi(argv[argp+1])) <= 0 || numT > 64)))
+      {fprintf(stderr, "Usage: xrdaccbench [-f <logfile>] "
+                       "[<numrules> [<numthreads>]]\n");
+       return 1;
+      }
+
+// Build the rules and the access log
+//
+   walkList = MakeRules(numRules);
+   trieList = MakeRules(numRules);
+   if (logFN) {if (!ReadLog(logFN)) return 1;}
+      else MakeLog(numRules, 200000);
+   if (paths.empty()) {fprintf(stderr, "xrdaccbench: no paths!\n"); return 1;}
+   printf("%d rules, %d paths\n", numRules, (int)paths.size());
+   listRes = new XrdAccPrivCaps[paths.size()];
+   trieRes = new XrdAccPrivCaps[paths.size()];
+
+// Replay by walking the list, then compile it and replay through the trie
+//
+   tList = Replay(walkList, listRes);
+   Report("list", paths.size(), tList);
+
+   tBeg = Now();
+   trieList->Compile();
+   printf("compile      %8.3f sec\n", Now() - tBeg);
+
+   tTrie = Replay(trieList, trieRes);
+   Report("trie", paths.size(), tTrie);
+
+// Verify the results
+//
+   for (unsigned int i = n = 0; i < paths.size(); i++)
+       if (listRes[i].pprivs != trieRes[i].pprivs
+       ||  listRes[i].nprivs != trieRes[i].nprivs)
+          {if (n++ < 10) fprintf(stderr, "Mismatch for %s\n", paths[i].c_str());
+          }
+   if (n) {fprintf(stderr, "accbench: %d mismatches!\n", n); return 2;}
+
+// Run the concurrent replays, the list walk is much slower so fewer passes
+//
+   printf("Concurrent replays:\n");
+   passes = 1;
+   Threads("list+lock", ListReader, numT);
+   passes = (tTrie > 0 ? (int)(tList/tTrie) : 1);
+   if (passes < 1) passes = 1;
+      else if (passes > 20) passes = 20;
+   Threads("trie", TrieReader, numT);
+
+   if (errors) {fprintf(stderr, "accbench: %d errors!\n", errors); return 2;}
+   printf("All lookups verified.\n");
+   return 0;
+}
@@ -0,0 +1,186 @@
+/******************************************************************************/
+/*                                                                            */
+/*                        X r d C k s B e n c h . c c                         */
+/*                                                                            */
+/* (c) 2026 by the contributors to the XRootD software suite                  */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <zlib.h>
+
+#include "XrdCks/XrdCksCalc.hh"
+#include "XrdCks/XrdCksCalcadler32.hh"
+#include "XrdCks/XrdCksCalccrc32.hh"
+#include "XrdCks/XrdCksCalccrc32c.hh"
+
+/******************************************************************************/
+/*                       L o c a l   F u n c t i o n s                        */
+/******************************************************************************/
+
+namespace
+{
+const char *adlerEng[] = {"scalar", "ssse3", "avx2", "neon"};
+const char *crcEng[]   = {"table", "sse4.2", "armv8crc"};
+
+double Now()
+{
+   struct timeval tv;
+   gettimeofday(&tv, 0);
+   return tv.tv_sec + tv.tv_usec/1000000.0;
+}
+
+unsigned int Value(XrdCksCalc &calc)
+{
+   return ntohl(*(unsigned int *)calc.Final());
+}
+
+unsigned int Digest(XrdCksCalc &calc, const char *buff, int blen, int seg)
+{
+   calc.Init();
+   while(blen > 0)
+        {int n = (blen < seg ? blen : seg);
+         calc.Update(buff, n); buff += n; blen -= n;
+        }
+   return Value(calc);
+}
+
+void Report(const char *what, const char *eng, long long nbytes, double secs)
+{
+   printf("%-8s %-9s %8.1f MB/s\n", what, eng, nbytes/secs/1000000.0);
+}
+
+// Time the calculator over the buffer, repeated until at least a second
+//
+void Time(XrdCksCalc &calc, const char *what, const char *eng,
+          const char *buff, int blen)
+{
+   long long nbytes = 0;
+   double tBeg = Now(), tNow;
+
+   calc.Init();
+   do {calc.Update(buff, blen); nbytes += blen;}
+      while((tNow = Now()) - tBeg < 1.0);
+   calc.Final();
+   Report(what, eng, nbytes, tNow - tBeg);
+}
+}
+
+/******************************************************************************/
+/*                                  m a i n                                   */
+/******************************************************************************/
+
+// Usage: xrdcksbench [<bufsize>]
+//
+// Verifies that every checksum engine this cpu supports gives the same answer
+// as the portable one (adler32 is also checked against zlib) over buffers of
+// odd sizes and alignments, then reports the throughput of each engine when
+// checksumming a buffer of the given size (default 1 MB) over and over.
+//
+int main(int argc, char *argv[])
+{
+   XrdCksCalcadler32 adler;
+   XrdCksCalccrc32   crc32;
+   XrdCksCalccrc32c  crc32c;
+   const char       *dfltAdler, *dfltCrc;
+   char             *buff;
+   unsigned int      vRef, vNow;
+   int               i, j, seg, bsz = 1024*1024, vsz, nBad = 0;
+
+// Get the buffer size
+//
+   if (argc > 1 && (bsz = atoi(argv[1])) <= 0)
+      {fprintf(stderr, "Usage: xrdcksbench [<bufsize>]\n"); return 1;}
+   vsz  = (bsz > 20000 ? bsz : 20000) + 64;
+   buff = (char *)malloc(vsz);
+   srandom(1);
+   for (i = 0; i < vsz; i++) buff[i] = random() & 0xff;
+   dfltAdler = adler.Engine();
+   dfltCrc   = crc32c.Engine();
+
+// Check the standard crc32c test vector
+//
+   if (Digest(crc32c, "123456789", 9, 9) != 0xe3069283)
+      {fprintf(stderr, "bench: crc32c test vector failed using %s!\n", dfltCrc);
+       nBad++;
+      }
+
+// Verify the adler32 engines against zlib, all 255's is the worst case for
+// the lane sums. Lengths and segment sizes straddle the vector widths and
+// the 5552 byte reduction interval.
+//
+   for (j = 0; j < 2; j++)
+       {if (j) memset(buff, 0xff, vsz);
+        for (i = 0; i < 300; i++)
+            {int off = i % 37, len = (i * 977) % 20000;
+             seg = (i % 3 ? len+1 : 1 + i*13);
+             vRef = adler32(adler32(0L, Z_NULL, 0),
+                            (const Bytef *)buff+off, len);
+             for (unsigned k = 0; k < sizeof(adlerEng)/sizeof(char *); k++)
+                 {if (!XrdCksCalcadler32::Engine(adlerEng[k])) continue;
+                  if ((vNow = Digest(adler, buff+off, len, seg)) != vRef)
+                     {fprintf(stderr, "bench: adler32 %s %08x != %08x for "
+                              "len %d off %d\n", adlerEng[k], vNow, vRef,
+                              len, off);
+                      nBad++;
+                     }
+                 }
+             XrdCksCalccrc32c::Engine("table");
+             vRef = Digest(crc32c, buff+off, len, seg);
+             for (unsigned k = 1; k < sizeof(crcEng)/sizeof(char *); k++)
+                 {if (!XrdCksCalccrc32c::Engine(crcEng[k])) continue;
+                  if ((vNow = Digest(crc32c, buff+off, len, seg)) != vRef)
+                     {fprintf(stderr, "bench: crc32c %s %08x != %08x for "
+                              "len %d off %d\n", crcEng[k], vNow, vRef,
+                              len, off);
+                      nBad++;
+                     }
+                 }
+            }
+       }
+   for (i = 0; i < vsz; i++) buff[i] = random() & 0xff;
+   if (nBad) {fprintf(stderr, "bench: %d mismatches!\n", nBad); return 2;}
+   printf("All engines agree; default adler32 %s, crc32c %s.\n",
+          dfltAdler, dfltCrc);
+
+// Now time them
+//
+   for (unsigned k = 0; k < sizeof(adlerEng)/sizeof(char *); k++)
+       if (XrdCksCalcadler32::Engine(adlerEng[k]))
+          Time(adler, "adler32", adlerEng[k], buff, bsz);
+   {long long nbytes = 0;
+    uLong     a = adler32(0L, Z_NULL, 0);
+    double    tBeg = Now(), tNow;
+    do {a = adler32(a, (const Bytef *)buff, bsz); nbytes += bsz;}
+       while((tNow = Now()) - tBeg < 1.0);
+    Report("adler32", "zlib", nbytes, tNow - tBeg);
+   }
+   for (unsigned k = 0; k < sizeof(crcEng)/sizeof(char *); k++)
+       if (XrdCksCalccrc32c::Engine(crcEng[k]))
+          Time(crc32c, "crc32c", crcEng[k], buff, bsz);
+   Time(crc32, "crc32", "table", buff, bsz);
+   return 0;
+}
@@ -0,0 +1,215 @@
+/******************************************************************************/
+/*                                                                            */
+/*                       X r d H a s h B e n c h . c c                        */
+/*                                                                            */
+/* (c) 2026 by the contributors to the XRootD software suite                  */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "XrdOuc/XrdOucFlatHash.hh"
+#include "XrdOuc/XrdOucHash.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+/******************************************************************************/
+/*                       L o c a l   F u n c t i o n s                        */
+/******************************************************************************/
+
+namespace
+{
+int    numKeys;
+char **keys;
+char **miss;
+int   *vals;
+int    errors = 0;
+
+double Now()
+{
+   struct timeval tv;
+   gettimeofday(&tv, 0);
+   return tv.tv_sec + tv.tv_usec/1000000.0;
+}
+
+void Report(const char *tab, const char *what, int num, double secs)
+{
+   printf("%-5s %-8s %9d ops in %8.3f sec (%6.1f ns/op)\n",
+          tab, what, num, secs, secs*1000000000.0/num);
+}
+
+// Short keys fit inline in a flat hash item, long ones do not
+//
+void MakeKeys(bool shortKeys)
+{
+   char buff[128];
+
+   for (int i = 0; i < numKeys; i++)
+       {if (shortKeys) sprintf(buff, "u%d", i);
+           else sprintf(buff, "/store/data/Run2017%c/run%07d/file%d.root",
+                        'A'+i%8, i/100, i);
+        free(keys[i]); keys[i] = strdup(buff);
+        strcat(buff, "x");
+        free(miss[i]); miss[i] = strdup(buff);
+       }
+}
+
+template<class H>
+void Bench(const char *tab)
+{
+   H *hp = new H();
+   double tBeg;
+   int i, n;
+
+   tBeg = Now();
+   for (i = 0; i < numKeys; i++) hp->Add(keys[i], &vals[i], 0, Hash_keepdata);
+   Report(tab, "add", numKeys, Now() - tBeg);
+
+   tBeg = Now();
+   for (i = n = 0; i < numKeys; i++)
+       if (hp->Find(keys[(i*7919LL) % numKeys]) == &vals[(i*7919LL) % numKeys])
+          n++;
+   Report(tab, "hit", numKeys, Now() - tBeg);
+   if (n != numKeys) {fprintf(stderr, "%s: %d hits missing!\n", tab, numKeys-n);
+                      errors++;
+                     }
+
+   tBeg = Now();
+   for (i = n = 0; i < numKeys; i++) if (hp->Find(miss[i])) n++;
+   Report(tab, "miss", numKeys, Now() - tBeg);
+   if (n) {fprintf(stderr, "%s: %d false hits!\n", tab, n); errors++;}
+
+   tBeg = Now();
+   for (i = 0; i < numKeys; i += 2) hp->Del(keys[i]);
+   for (i = 0; i < numKeys; i += 2) hp->Add(keys[i], &vals[i], 0, Hash_keepdata);
+   for (i = 0; i < numKeys; i++) hp->Del(keys[i]);
+   Report(tab, "churn", numKeys*2, Now() - tBeg);
+   if (hp->Num()) {fprintf(stderr, "%s: %d items left!\n", tab, hp->Num());
+                   errors++;
+                  }
+   delete hp;
+}
+
+// Concurrent lookups: the chained table needs a lock around it, the flat
+// table is created read-mostly
+//
+XrdOucHash<int>     *lockTab;
+XrdSysMutex          lockMtx;
+XrdOucFlatHash<int> *flatTab;
+int                  lookups;
+
+void *LockReader(void *arg)
+{
+   long long k = (long long)arg;
+   for (int i = 0; i < lookups; i++)
+       {k = (k + 7919) % numKeys;
+        lockMtx.Lock();
+        if (!lockTab->Find(keys[k])) __sync_fetch_and_add(&errors, 1);
+        lockMtx.UnLock();
+       }
+   return 0;
+}
+
+void *FlatReader(void *arg)
+{
+   long long k = (long long)arg;
+   for (int i = 0; i < lookups; i++)
+       {k = (k + 7919) % numKeys;
+        if (!flatTab->Find(keys[k])) __sync_fetch_and_add(&errors, 1);
+       }
+   return 0;
+}
+
+void Threads(const char *tab, void *(*reader)(void *), int numT)
+{
+   pthread_t tid[64];
+   double tBeg = Now();
+   char what[16];
+   int i;
+
+   for (i = 0; i < numT; i++)
+       pthread_create(&tid[i], 0, reader, (void *)(long long)(i*numKeys/numT));
+   for (i = 0; i < numT; i++) pthread_join(tid[i], 0);
+   sprintf(what, "%dthr", numT);
+   Report(tab, what, lookups*numT, Now() - tBeg);
+}
+}
+
+/******************************************************************************/
+/*                                  m a i n                                   */
+/******************************************************************************/
+
+// Usage: xrdhashbench [<numkeys> [<numthreads>]]
+//
+// Adds, finds, misses and deletes the specified number of keys (default
+// 1000000) in an XrdOucHash ("chain") and an XrdOucFlatHash ("flat"), once
+// with short and once with path-like keys, and reports the per-operation
+// cost. Then times concurrent lookups by the given number of threads
+// (default 4) on a mutex protected XrdOucHash and a read-mostly
+// XrdOucFlatHash.
+//
+int main(int argc, char *argv[])
+{
+   int numT = 4;
+
+// Get the arguments
+//
+   numKeys = 1000000;
+   if ((argc > 1 && (numKeys = atoi(argv[1])) <= 0)
+   ||  (argc > 2 && ((numT = atoi(argv[2])) <= 0 || numT > 64)))
+      {fprintf(stderr, "Usage: xrdhashbench [<numkeys> [<numthreads>]]\n");
+       return 1;
+      }
+   keys = (char **)calloc(numKeys, sizeof(char *));
+   miss = (char **)calloc(numKeys, sizeof(char *));
+   vals = new int[numKeys];
+
+// Run the single threaded benchmarks
+//
+   printf("Short keys:\n");
+   MakeKeys(true);
+   Bench<XrdOucHash<int> >("chain");
+   Bench<XrdOucFlatHash<int> >("flat");
+
+   printf("Path keys:\n");
+   MakeKeys(false);
+   Bench<XrdOucHash<int> >("chain");
+   Bench<XrdOucFlatHash<int> >("flat");
+
+// Run the concurrent lookups
+//
+   printf("Concurrent path lookups:\n");
+   lockTab = new XrdOucHash<int>();
+   flatTab = new XrdOucFlatHash<int>(0, 144, 80, true);
+   for (int i = 0; i < numKeys; i++)
+       {lockTab->Add(keys[i], &vals[i], 0, Hash_keepdata);
+        flatTab->Add(keys[i], &vals[i], 0, Hash_keepdata);
+       }
+   lookups = numKeys;
+   Threads("chain", LockReader, numT);
+   Threads("flat",  FlatReader, numT);
+
+   if (errors) {fprintf(stderr, "hashbench: %d errors!\n", errors); return 2;}
+   printf("All lookups verified.\n");
+   return 0;
+}
@@ -0,0 +1,311 @@
+/******************************************************************************/
+/*                                                                            */
+/*                       X r d P o l l B e n c h . c c                        */
+/*                                                                            */
+/* (c) 2026 by the contributors to the XRootD software suite                  */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "Xrd/XrdInet.hh"
+#include "Xrd/XrdLink.hh"
+#include "Xrd/XrdPoll.hh"
+#include "Xrd/XrdProtocol.hh"
+#include "Xrd/XrdScheduler.hh"
+#include "XrdNet/XrdNetAddr.hh"
+#include "XrdOuc/XrdOucTrace.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysLogger.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+/******************************************************************************/
+/*                         L o c a l   C l a s s e s                          */
+/******************************************************************************/
+
+namespace
+{
+// The echo protocol simply sends back whatever arrives on the link
+//
+class echoProt : public XrdProtocol
+{
+public:
+
+void         DoIt() {}
+
+XrdProtocol *Match(XrdLink *lp) {return this;}
+
+int          Process(XrdLink *lp)
+                    {char buff[64];
+                     int rlen = lp->Recv(buff, sizeof(buff));
+                     if (rlen <= 0) return -1;
+                     return (lp->Send(buff, rlen) < 0 ? -1 : 1);
+                    }
+
+void         Recycle(XrdLink *lp, int consec, const char *reason) {}
+
+int          Stats(char *buff, int blen, int do_sync) {return 0;}
+
+             echoProt() : XrdProtocol("echo") {}
+            ~echoProt() {}
+};
+
+// The results of a run are passed from the child running it to the parent
+//
+struct benchResult
+      {double  wallTime;    // Elapsed seconds for all round trips
+       double  cpuTime;     // User plus system seconds for all round trips
+       int     rc;          // Zero if the run succeeded
+      };
+
+echoProt  theEcho;
+int       lstFD, numMsgs = 10000;
+
+double Now()
+{
+   struct timeval tv;
+   gettimeofday(&tv, 0);
+   return tv.tv_sec + tv.tv_usec/1000000.0;
+}
+
+double CPU()
+{
+   struct rusage ru;
+   getrusage(RUSAGE_SELF, &ru);
+   return ru.ru_utime.tv_sec + ru.ru_utime.tv_usec/1000000.0
+        + ru.ru_stime.tv_sec + ru.ru_stime.tv_usec/1000000.0;
+}
+
+// Connect a client to ourselves and hand the server side to the poller
+//
+int Connect()
+{
+   struct sockaddr_in sa;
+   socklen_t slen = sizeof(sa);
+   XrdNetAddr netAddr;
+   XrdLink *lp;
+   int cFD, sFD, one = 1;
+
+   getsockname(lstFD, (struct sockaddr *)&sa, &slen);
+   if ((cFD = socket(AF_INET, SOCK_STREAM, 0)) < 0
+   ||  connect(cFD, (struct sockaddr *)&sa, slen)
+   ||  (sFD = accept(lstFD, 0, 0)) < 0)
+      {fprintf(stderr, "bench: unable to connect; %s\n", strerror(errno));
+       exit(3);
+      }
+   setsockopt(cFD, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+   setsockopt(sFD, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+   netAddr.Set(sFD);
+   if (!(lp = XrdLink::Alloc(netAddr)))
+      {fprintf(stderr, "bench: unable to allocate link\n"); exit(3);}
+   lp->setProtocol(&theEcho);
+   if (!XrdPoll::Attach(lp))
+      {fprintf(stderr, "bench: unable to attach link\n"); exit(3);}
+   lp->armRecvQ();
+   lp->Enable();
+   return cFD;
+}
+
+// Each active client does the specified number of round trips
+//
+void *Client(void *carg)
+{
+   int cFD = *(int *)carg;
+   char buff[8] = "xrdpoll";
+
+   for (int i = 0; i < numMsgs; i++)
+       {if (write(cFD, buff, sizeof(buff)) != (ssize_t)sizeof(buff)
+        ||  recv(cFD, buff, sizeof(buff), MSG_WAITALL) != (ssize_t)sizeof(buff))
+           {fprintf(stderr, "bench: echo failed; %s\n", strerror(errno));
+            exit(4);
+           }
+       }
+   return 0;
+}
+
+// Run the benchmark with the named poller. This is done in a child process
+// as the poller is selected once per process.
+//
+int Run(const char *pName, int numIdle, int numAct, benchResult &res)
+{
+   XrdSysLogger    Logger;
+   XrdSysError     eDest(&Logger, "bench");
+   XrdOucTrace     Trace(&eDest);
+   XrdScheduler   &Sched = *(new XrdScheduler(&eDest, &Trace, 8, 256, 0));
+   XrdInet         netTCP(&eDest, &Trace);
+   struct sockaddr_in sa;
+   pthread_t  *tids;
+   int        *cFD, i, maxFD = (numIdle + numAct)*2 + 64;
+   double      tBeg, cBeg;
+
+// Select the poller
+//
+   if (!XrdPoll::SetPoller(pName))
+      {fprintf(stderr, "bench: poller '%s' is not supported\n", pName);
+       return 1;
+      }
+
+// Initialize the link and poller subsystems
+//
+   Sched.Start();
+   XrdLink::Init(&eDest, &Trace, &Sched);
+   XrdLink::Init(&netTCP);
+   XrdPoll::Init(&eDest, &Trace, &Sched);
+   if (!XrdLink::Setup(maxFD, 0) || !XrdPoll::Setup(maxFD)) return 2;
+
+// Create a loopback listener
+//
+   memset(&sa, 0, sizeof(sa));
+   sa.sin_family      = AF_INET;
+   sa.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+   if ((lstFD = socket(AF_INET, SOCK_STREAM, 0)) < 0
+   ||  bind(lstFD, (struct sockaddr *)&sa, sizeof(sa))
+   ||  listen(lstFD, 1024))
+      {fprintf(stderr, "bench: unable to listen; %s\n", strerror(errno));
+       return 2;
+      }
+
+// Create the idle and active links
+//
+   for (i = 0; i < numIdle; i++) Connect();
+   cFD  = new int[numAct];
+   tids = new pthread_t[numAct];
+   for (i = 0; i < numAct; i++) cFD[i] = Connect();
+
+// Run the active clients (the scheduler is never deleted)
+//
+   tBeg = Now(); cBeg = CPU();
+   for (i = 0; i < numAct; i++) pthread_create(&tids[i], 0, Client, &cFD[i]);
+   for (i = 0; i < numAct; i++) pthread_join(tids[i], 0);
+   res.wallTime = Now() - tBeg;
+   res.cpuTime  = CPU()  - cBeg;
+   return 0;
+}
+}
+
+/******************************************************************************/
+/*                                  m a i n                                   */
+/******************************************************************************/
+
+// Usage: xrdpollbench [-p {default|uring}] [-i <idle>] [-a <active>] [-n <msgs>]
+//
+// Creates the specified number of idle (default 1000) and active (default 16)
+// loopback links, attaches them to the network pollers, and has each active
+// client do <msgs> echo round trips (default 10000). Each poller (or only the
+// one selected with -p) is run in turn and the average round trip latency,
+// the aggregate message rate, and the CPU time used are reported side by side
+// along with how the io_uring poller compares to the default one.
+//
+int main(int argc, char *argv[])
+{
+   const char *pList[] = {"default", "uring"}, *pOnly = 0;
+   const int   pNum = sizeof(pList)/sizeof(pList[0]);
+   benchResult res[pNum];
+   struct rlimit rlim;
+   int    i, c, pfd[2], status, numIdle = 1000, numAct = 16, maxFD, numRun = 0;
+   pid_t  pid;
+
+// Process the options
+//
+   while((c = getopt(argc, argv, "a:i:n:p:")) != -1)
+        {switch(c)
+               {case 'a': numAct  = atoi(optarg); break;
+                case 'i': numIdle = atoi(optarg); break;
+                case 'n': numMsgs = atoi(optarg); break;
+                case 'p': pOnly   = optarg;       break;
+                default:  numAct  = -1;           break;
+               }
+        }
+   if (numAct <= 0 || numIdle < 0 || numMsgs <= 0
+   ||  (pOnly && strcmp(pOnly, "default") && strcmp(pOnly, "uring")))
+      {fprintf(stderr, "Usage: xrdpollbench [-p {default|uring}] [-i <idle>] "
+                       "[-a <active>] [-n <msgs>]\n");
+       return 1;
+      }
+
+// Make sure we have enough file descriptors (two per link)
+//
+   getrlimit(RLIMIT_NOFILE, &rlim);
+   maxFD = (numIdle + numAct)*2 + 64;
+   if (rlim.rlim_cur < (rlim_t)maxFD)
+      {rlim.rlim_cur = (rlim.rlim_max < (rlim_t)maxFD ? rlim.rlim_max : maxFD);
+       setrlimit(RLIMIT_NOFILE, &rlim);
+       if ((int)rlim.rlim_cur < maxFD)
+          {fprintf(stderr, "bench: too few file descriptors available\n");
+           return 1;
+          }
+      }
+
+// Run each poller in its own process
+//
+   printf("%d idle, %d active links, %d round trips each\n",
+          numIdle, numAct, numMsgs);
+   printf("%-8s %9s %12s %12s %9s\n",
+          "poller", "sec", "us/trip", "msgs/sec", "cpu sec");
+   for (i = 0; i < pNum; i++)
+       {res[i].rc = -1;
+        if (pOnly && strcmp(pOnly, pList[i])) continue;
+        fflush(stdout);
+        if (pipe(pfd) || (pid = fork()) < 0)
+           {fprintf(stderr, "bench: unable to fork; %s\n", strerror(errno));
+            return 2;
+           }
+        if (!pid)
+           {close(pfd[0]);
+            res[i].rc = Run(pList[i], numIdle, numAct, res[i]);
+            if (write(pfd[1], &res[i], sizeof(res[i])) != sizeof(res[i]))
+               _exit(5);
+            _exit(0);
+           }
+        close(pfd[1]);
+        if (read(pfd[0], &res[i], sizeof(res[i])) != sizeof(res[i]))
+           res[i].rc = -1;
+        close(pfd[0]);
+        waitpid(pid, &status, 0);
+        if (res[i].rc)
+           {printf("%-8s failed\n", pList[i]);
+            continue;
+           }
+        numRun++;
+        printf("%-8s %9.3f %12.1f %12.0f %9.3f\n", pList[i], res[i].wallTime,
+               res[i].wallTime*1000000.0/numMsgs,
+               (double)numAct*numMsgs/res[i].wallTime, res[i].cpuTime);
+       }
+
+// Compare the io_uring poller to the default one
+//
+   if (!res[0].rc && !res[1].rc)
+      printf("uring vs default: %.2fx message rate, %.2fx cpu per message\n",
+             res[0].wallTime/res[1].wallTime, res[1].cpuTime/res[0].cpuTime);
+   return (numRun ? 0 : 2);
+}
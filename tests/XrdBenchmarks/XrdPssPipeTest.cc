@@ -0,0 +1,151 @@
+/******************************************************************************/
+/*                                                                            */
+/*                     X r d P s s P i p e T e s t . c c                      */
+/*                                                                            */
+/* (c) 2026 by the contributors to the XRootD software suite                  */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "XrdOuc/XrdOucIOVec.hh"
+#include "XrdPss/XrdPssPipe.hh"
+
+/******************************************************************************/
+/*                       L o c a l   F u n c t i o n s                        */
+/******************************************************************************/
+
+namespace
+{
+static const int K = 1024;
+
+// Verify that the groups cover every element in order, that a group only
+// exceeds the chunk when it has a single non-empty element, and that no group
+// holds only empty elements unless all of them are empty.
+//
+bool Verify(const XrdOucIOVec *readV, int n, const int *gEnd, int numG)
+{
+   long long gsz;
+   int i = 0, j, nzCnt;
+
+   if (n && (numG < 1 || gEnd[numG-1] != n)) return false;
+   for (j = 0; j < numG; j++)
+       {if (gEnd[j] <= i) return false;
+        for (gsz = 0, nzCnt = 0; i < gEnd[j]; i++)
+            {gsz += readV[i].size;
+             if (readV[i].size) nzCnt++;
+            }
+        if (gsz > XrdPssPipe::Chunk && nzCnt > 1) return false;
+        if (!nzCnt && numG > 1) return false;
+       }
+   return true;
+}
+
+// Group the element sizes and compare the group ends with the expected ones
+//
+bool Check(const char *what, const int *sizes, int n,
+                             const int *expect, int numE)
+{
+   XrdOucIOVec readV[16];
+   int gEnd[16], i, numG;
+   bool ok;
+
+   for (i = 0; i < n; i++)
+       {readV[i].offset = (long long)i * 1024 * K;
+        readV[i].size   = sizes[i];
+        readV[i].info   = 0;
+        readV[i].data   = 0;
+       }
+
+   numG = XrdPssPipe::Groups(readV, n, gEnd);
+   ok = numG == numE && Verify(readV, n, gEnd, numG);
+   for (i = 0; ok && i < numG; i++) ok = gEnd[i] == expect[i];
+
+   printf("%-24s %d elements -> %d groups %s\n", what, n, numG,
+          (ok ? "ok" : "FAILED"));
+   return ok;
+}
+
+// Group random sizes, including many empty elements, and verify the result
+//
+bool Random(int iters)
+{
+   XrdOucIOVec readV[64];
+   int gEnd[64], i, n, numG, bad = 0;
+
+   srand(1);
+   while(iters--)
+        {n = rand() % 64 + 1;
+         for (i = 0; i < n; i++)
+             {readV[i].offset = 0;
+              readV[i].size   = (rand() % 3 ? rand() % (384*K) : 0);
+             }
+         numG = XrdPssPipe::Groups(readV, n, gEnd);
+         if (!Verify(readV, n, gEnd, numG)) bad++;
+        }
+
+   printf("%-24s %s\n", "random", (bad ? "FAILED" : "ok"));
+   return !bad;
+}
+}
+
+/******************************************************************************/
+/*                                  m a i n                                   */
+/******************************************************************************/
+
+// Usage: xrdpsspipetest
+//
+// Checks how XrdPssPipe groups readv elements into chunks, in particular when
+// some elements have zero length. Returns 2 if any check fails.
+//
+int main(int argc, char *argv[])
+{
+   static const int s1[] = {0, 300*K, 10};
+   static const int e1[] = {2, 3};
+   static const int s2[] = {300*K, 0};
+   static const int e2[] = {2};
+   static const int s3[] = {100*K, 0, 100*K, 0, 100*K, 0};
+   static const int e3[] = {4, 6};
+   static const int s4[] = {0, 0, 0};
+   static const int e4[] = {3};
+   static const int s5[] = {256*K, 0, 1, 256*K};
+   static const int e5[] = {2, 3, 4};
+   int numBad = 0;
+
+   XrdPssPipe::Chunk = 256*K;
+
+#define CHECK(w, s, e) \
+   if (!Check(w, s, sizeof(s)/sizeof(int), e, sizeof(e)/sizeof(int))) numBad++
+
+   CHECK("leading empty",   s1, e1);
+   CHECK("trailing empty",  s2, e2);
+   CHECK("interleaved",     s3, e3);
+   CHECK("all empty",       s4, e4);
+   CHECK("full chunk",      s5, e5);
+   if (!Random(10000)) numBad++;
+
+   if (numBad)
+      {fprintf(stderr, "test: %d group checks failed!\n", numBad); return 2;}
+   printf("All group checks passed.\n");
+   return 0;
+}
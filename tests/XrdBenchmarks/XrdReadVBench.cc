@@ -0,0 +1,157 @@
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d R e a d V B e n c h . c c                       */
+/*                                                                            */
+/* (c) 2026 by the contributors to the XRootD software suite                  */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "XrdCl/XrdClFile.hh"
+
+/******************************************************************************/
+/*                       L o c a l   F u n c t i o n s                        */
+/******************************************************************************/
+
+namespace
+{
+double Now()
+{
+   struct timeval tv;
+   gettimeofday(&tv, 0);
+   return tv.tv_sec + tv.tv_usec/1000000.0;
+}
+
+// Spread the chunks over the file so that they are not contiguous
+//
+void MakeChunks(XrdCl::ChunkList &chunks, char *buff, int numSegs,
+                uint32_t segSz, uint64_t fSize)
+{
+   uint64_t slots = fSize / segSz;
+
+   chunks.clear();
+   for (int i = 0; i < numSegs; i++)
+       chunks.push_back(XrdCl::ChunkInfo(((i*7919ULL) % slots) * segSz,
+                                         segSz, buff + (uint64_t)i*segSz));
+}
+
+int Verify(const XrdCl::ChunkList &chunks, const char *lfn, uint32_t segSz)
+{
+   char *lbuff = new char[segSz];
+   int fd, bad = 0;
+
+   if ((fd = open(lfn, O_RDONLY)) < 0)
+      {perror(lfn); delete [] lbuff; return 1;}
+
+   for (size_t i = 0; i < chunks.size(); i++)
+       {if (pread(fd, lbuff, segSz, chunks[i].offset) != (ssize_t)segSz
+        ||  memcmp(lbuff, chunks[i].buffer, segSz)) bad++;
+       }
+   close(fd);
+   delete [] lbuff;
+   if (bad) fprintf(stderr, "readvbench: %d segments differ!\n", bad);
+   return bad;
+}
+}
+
+/******************************************************************************/
+/*                                  m a i n                                   */
+/******************************************************************************/
+
+// Usage: xrdreadvbench <url> [<segsz> [<iters> [<localfile>]]]
+//
+// Issues the given number of readv requests (default 100), each with 1024
+// segments of the given size (default 65536) spread over the file at <url>,
+// one after the other, and reports the data rate and request rate. When the
+// same file is available locally, the data of the last request is compared
+// against it. Run it against a server with and without "xrootd.async nosf"
+// to compare sendfile and read based readv responses.
+//
+int main(int argc, char *argv[])
+{
+   static const int numSegs = 1024;
+   XrdCl::File       file;
+   XrdCl::StatInfo  *sInfo = 0;
+   XrdCl::ChunkList  chunks;
+   XrdCl::XRootDStatus st;
+   uint32_t segSz = 65536;
+   int iters = 100, rc;
+   double tBeg, secs;
+   char *buff;
+
+// Get the arguments
+//
+   if (argc < 2
+   ||  (argc > 2 && (int)(segSz = atoi(argv[2])) <= 0)
+   ||  (argc > 3 && (iters = atoi(argv[3])) <= 0))
+      {fprintf(stderr,
+               "Usage: xrdreadvbench <url> [<segsz> [<iters> [<localfile>]]]\n");
+       return 1;
+      }
+
+// Open the file and get its size
+//
+   if (!(st = file.Open(argv[1], XrdCl::OpenFlags::Read)).IsOK()
+   ||  !(st = file.Stat(false, sInfo)).IsOK())
+      {fprintf(stderr, "readvbench: %s\n", st.ToString().c_str()); return 2;}
+   if (sInfo->GetSize() < segSz)
+      {fprintf(stderr, "readvbench: file is smaller than a segment\n");
+       return 2;
+      }
+
+   buff = new char[(size_t)numSegs * segSz];
+   MakeChunks(chunks, buff, numSegs, segSz, sInfo->GetSize());
+   delete sInfo;
+
+// Run the requests
+//
+   tBeg = Now();
+   for (int i = 0; i < iters; i++)
+       {XrdCl::VectorReadInfo *vInfo = 0;
+        if (!(st = file.VectorRead(chunks, 0, vInfo)).IsOK())
+           {fprintf(stderr, "readvbench: %s\n", st.ToString().c_str());
+            return 2;
+           }
+        delete vInfo;
+       }
+   secs = Now() - tBeg;
+
+   printf("%d readv x %d segs x %u bytes in %.3f sec: "
+          "%.1f MB/s %.1f req/s\n", iters, numSegs, segSz, secs,
+          (double)iters*numSegs*segSz/secs/1000000.0, iters/secs);
+
+// Verify the data if we can
+//
+   st = file.Close();
+   rc = (argc > 4 && Verify(chunks, argv[4], segSz) ? 3 : 0);
+   delete [] buff;
+   return rc;
+}
@@ -0,0 +1,136 @@
+/******************************************************************************/
+/*                                                                            */
+/*                      X r d S c h e d B e n c h . c c                       */
+/*                                                                            */
+/* (c) 2026 by the contributors to the XRootD software suite                  */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "Xrd/XrdJob.hh"
+#include "Xrd/XrdScheduler.hh"
+#include "XrdOuc/XrdOucTrace.hh"
+#include "XrdSys/XrdSysError.hh"
+#include "XrdSys/XrdSysLogger.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+/******************************************************************************/
+/*                         L o c a l   C l a s s e s                          */
+/******************************************************************************/
+
+namespace
+{
+XrdSysCondVar firedCV(0);
+int           numFired = 0;
+
+class benchJob : public XrdJob
+{
+public:
+
+void DoIt() {firedCV.Lock(); numFired++; firedCV.Signal(); firedCV.UnLock();}
+
+     benchJob() : XrdJob(".bench") {}
+    ~benchJob() {}
+};
+
+double Now()
+{
+   struct timeval tv;
+   gettimeofday(&tv, 0);
+   return tv.tv_sec + tv.tv_usec/1000000.0;
+}
+
+void Report(const char *what, int num, double secs)
+{
+   printf("%-8s %9d timers in %8.3f sec (%.1f ns/timer)\n",
+          what, num, secs, secs*1000000000.0/num);
+}
+}
+
+/******************************************************************************/
+/*                                  m a i n                                   */
+/******************************************************************************/
+
+// Usage: xrdschedbench [<numtimers>]
+//
+// Inserts and then cancels the specified number of timers (default 1000000)
+// spread over the next 12 days and reports the per-timer cost of each. Then
+// verifies that a few short timers actually fire.
+//
+int main(int argc, char *argv[])
+{
+   XrdSysLogger    Logger;
+   XrdSysError     eDest(&Logger, "bench");
+   XrdOucTrace     Trace(&eDest);
+   XrdScheduler   &Sched = *(new XrdScheduler(&eDest, &Trace, 2, 8, 0));
+   benchJob       *jobs, tJob[3];
+   time_t          now = time(0);
+   double          tBeg;
+   int             i, numT = 1000000;
+
+// Get the number of timers
+//
+   if (argc > 1 && (numT = atoi(argv[1])) <= 0)
+      {fprintf(stderr, "Usage: xrdschedbench [<numtimers>]\n"); return 1;}
+   jobs = new benchJob[numT];
+   srandom(static_cast<unsigned int>(now));
+
+// Insert the timers
+//
+   tBeg = Now();
+   for (i = 0; i < numT; i++)
+       Sched.Schedule(&jobs[i], now + 1 + random() % (12*24*60*60));
+   Report("insert", numT, Now() - tBeg);
+
+// Reschedule them, this implicitly cancels the previous timer
+//
+   tBeg = Now();
+   for (i = 0; i < numT; i++)
+       Sched.Schedule(&jobs[i], now + 1 + random() % (12*24*60*60));
+   Report("resched", numT, Now() - tBeg);
+
+// Cancel all of the timers in random order
+//
+   tBeg = Now();
+   for (i = 0; i < numT; i++) Sched.Cancel(&jobs[(i*7919LL) % numT]);
+   for (i = 0; i < numT; i++) Sched.Cancel(&jobs[i]);
+   Report("cancel", numT, Now() - tBeg);
+
+// Make sure that timers actually fire (the scheduler is never deleted)
+//
+   Sched.Start();
+   for (i = 0; i < 3; i++) Sched.Schedule(&tJob[i], time(0) + i + 1);
+   firedCV.Lock();
+   for (i = 0; i < 10 && numFired < 3; i++) firedCV.Wait(1);
+   i = numFired;
+   firedCV.UnLock();
+   if (i < 3)
+      {fprintf(stderr, "bench: only %d of 3 test timers fired!\n", i); return 2;}
+   printf("All test timers fired.\n");
+   return 0;
+}
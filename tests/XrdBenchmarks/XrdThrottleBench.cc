@@ -0,0 +1,165 @@
+/******************************************************************************/
+/*                                                                            */
+/*                   X r d T h r o t t l e B e n c h . c c                    */
+/*                                                                            */
+/* (c) 2026 by the contributors to the XRootD software suite                  */
+/*                                                                            */
+/* This file is part of the XRootD software suite.                            */
+/*                                                                            */
+/* XRootD is free software: you can redistribute it and/or modify it under    */
+/* the terms of the GNU Lesser General Public License as published by the     */
+/* Free Software Foundation, either version 3 of the License, or (at your     */
+/* option) any later version.                                                 */
+/*                                                                            */
+/* XRootD is distributed in the hope that it will be useful, but WITHOUT      */
+/* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      */
+/* FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public       */
+/* License for more details.                                                  */
+/*                                                                            */
+/* You should have received a copy of the GNU Lesser General Public License   */
+/* along with XRootD in a file called COPYING.LESSER (LGPL license) and file  */
+/* COPYING (GPL license).  If not, see <http://www.gnu.org/licenses/>.        */
+/*                                                                            */
+/* The copyright holder's institutional names and contributor's names may not */
+/* be used to endorse or promote products derived from this software without  */
+/* specific prior written permission of the institution or contributor.       */
+/******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "XrdSec/XrdSecEntity.hh"
+#include "XrdSys/XrdSysPthread.hh"
+#include "XrdThrottle/XrdThrottleHTB.hh"
+
+/******************************************************************************/
+/*                         L o c a l   C l a s s e s                          */
+/******************************************************************************/
+
+namespace
+{
+struct benchArg
+{
+   XrdThrottleHTB *htb;
+   int             cid;
+   int             reqsz;
+   double          tEnd;
+   long long       bytes;
+};
+
+double Now()
+{
+   struct timeval tv;
+   gettimeofday(&tv, 0);
+   return tv.tv_sec + tv.tv_usec/1000000.0;
+}
+
+void *Worker(void *pp)
+{
+   benchArg *aP = (benchArg *)pp;
+
+   while (Now() < aP->tEnd)
+        {aP->htb->Apply(aP->cid, aP->reqsz, 1);
+         aP->bytes += aP->reqsz;
+        }
+   return (void *)0;
+}
+
+/******************************************************************************/
+/*                       L o c a l   F u n c t i o n s                        */
+/******************************************************************************/
+
+// Run numT threads issuing reqsz byte requests in the class mapped to user
+// "bench" and return the achieved rate in bytes per second.
+//
+double Run(XrdThrottleHTB &htb, int numT, int reqsz, int secs)
+{
+   XrdSecEntity  client;
+   benchArg      args[16];
+   pthread_t     tid[16];
+   long long     total = 0;
+   double        tBeg = Now();
+   int           i;
+
+   client.name = (char *)"bench";
+   for (i = 0; i < numT; i++)
+       {args[i].htb   = &htb;
+        args[i].cid   = htb.Classify(&client);
+        args[i].reqsz = reqsz;
+        args[i].tEnd  = tBeg + secs;
+        args[i].bytes = 0;
+        XrdSysThread::Run(&tid[i], Worker, &args[i], XRDSYSTHREAD_HOLD, "bench");
+       }
+   for (i = 0; i < numT; i++)
+       {XrdSysThread::Join(tid[i], 0);
+        total += args[i].bytes;
+       }
+   return total / (Now() - tBeg);
+}
+
+// Check that requests much larger than the bucket depth are held to the
+// configured rate over the long run, both by a class ceiling and by the
+// global limit in the root class.
+//
+bool Check(const char *what, bool atRoot, int numT, int reqsz, int secs)
+{
+   XrdThrottleHTB         htb;
+   XrdThrottleHTB::Limits lim;
+   std::string            err;
+   const double           limit = 4*1024*1024;
+   double                 rate;
+   bool                   ok;
+
+   lim.burst = 0.1;
+   if (!atRoot) lim.data_max = limit;
+   if (!htb.AddClass("bench", "", lim, err)
+   ||  !htb.AddMapping(XrdThrottleHTB::mapUser, "bench", "bench", err)
+   ||  !htb.Finalize(atRoot ? limit : -1, -1, err))
+      {fprintf(stderr, "bench: %s\n", err.c_str()); return false;}
+
+// The first burst is free, allow for it when judging the rate
+//
+   rate = Run(htb, numT, reqsz, secs);
+   ok = rate <= limit*1.1 + (limit*0.1 + reqsz*numT)/secs && rate >= limit*0.8;
+   printf("%-8s %2d threads %8d byte requests: %7.2f MB/s, limit %.2f MB/s %s\n",
+          what, numT, reqsz, rate/(1024*1024), limit/(1024*1024),
+          (ok ? "ok" : "FAILED"));
+   return ok;
+}
+}
+
+/******************************************************************************/
+/*                                  m a i n                                   */
+/******************************************************************************/
+
+// Usage: xrdthrottlebench [<seconds>]
+//
+// Issues requests of one, two, and eight times the bucket depth against a
+// class ceiling and against the global limit for the specified number of
+// seconds (default 5) each and verifies that the long-run rate stays within
+// 10% of the limit. Returns 2 if it does not.
+//
+int main(int argc, char *argv[])
+{
+   static const int reqSize[] = {400*1024, 800*1024, 3200*1024};
+   int i, secs = 5, numBad = 0;
+
+// Get the number of seconds
+//
+   if (argc > 1 && (secs = atoi(argv[1])) <= 0)
+      {fprintf(stderr, "Usage: xrdthrottlebench [<seconds>]\n"); return 1;}
+
+// Run each request size against each limit
+//
+   for (i = 0; i < (int)(sizeof(reqSize)/sizeof(int)); i++)
+       {if (!Check("ceil", false, 4, reqSize[i], secs)) numBad++;
+        if (!Check("root", true,  4, reqSize[i], secs)) numBad++;
+       }
+
+   if (numBad)
+      {fprintf(stderr, "bench: %d of 6 rate checks failed!\n", numBad); return 2;}
+   printf("All rate checks passed.\n");
+   return 0;
+}
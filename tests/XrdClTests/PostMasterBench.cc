@@ -0,0 +1,187 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2026 by the contributors to the XRootD software suite
+//------------------------------------------------------------------------------
+// XRootD is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// XRootD is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public License
+// along with XRootD.  If not, see <http://www.gnu.org/licenses/>.
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// Measure the request rate the post master sustains with many requests in
+// flight on a single channel. Every request is an asynchronous kXR_ping so
+// the cost is dominated by SID allocation, response matching and dispatch.
+//
+// Usage: xrdclpostmasterbench <url> [<requests> [<inflight> [<threads>]]]
+//------------------------------------------------------------------------------
+
+#include "XrdCl/XrdClFileSystem.hh"
+#include "XrdCl/XrdClURL.hh"
+#include "XrdSys/XrdSysPthread.hh"
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+namespace
+{
+  //----------------------------------------------------------------------------
+  // Bookkeeping shared by all the issuing threads
+  //----------------------------------------------------------------------------
+  struct BenchState
+  {
+    BenchState(): cond( 0 ), inFlight( 0 ), done( 0 ), failed( 0 ),
+                  maxInFlight( 0 ), toIssue( 0 ), fs( 0 ) {}
+
+    XrdSysCondVar        cond;
+    uint32_t             inFlight;
+    uint64_t             done;
+    uint64_t             failed;
+    uint32_t             maxInFlight;
+    uint64_t             toIssue;
+    XrdCl::FileSystem   *fs;
+  };
+
+  //----------------------------------------------------------------------------
+  // Response handler counting the completions
+  //----------------------------------------------------------------------------
+  class PingHandler: public XrdCl::ResponseHandler
+  {
+    public:
+      PingHandler( BenchState *state ): pState( state ) {}
+
+      virtual void HandleResponse( XrdCl::XRootDStatus *status,
+                                   XrdCl::AnyObject    *response )
+      {
+        pState->cond.Lock();
+        if( !status->IsOK() )
+          ++pState->failed;
+        ++pState->done;
+        --pState->inFlight;
+        pState->cond.Broadcast();
+        pState->cond.UnLock();
+        delete status;
+        delete response;
+      }
+
+    private:
+      BenchState *pState;
+  };
+
+  //----------------------------------------------------------------------------
+  // Issue pings while keeping the number in flight under the limit
+  //----------------------------------------------------------------------------
+  void *IssueThread( void *arg )
+  {
+    BenchState  *state = (BenchState*)arg;
+    PingHandler  handler( state );
+
+    while( true )
+    {
+      state->cond.Lock();
+      while( state->inFlight >= state->maxInFlight )
+        state->cond.Wait();
+      if( !state->toIssue )
+      {
+        state->cond.UnLock();
+        break;
+      }
+      --state->toIssue;
+      ++state->inFlight;
+      state->cond.UnLock();
+
+      if( !state->fs->Ping( &handler ).IsOK() )
+      {
+        state->cond.Lock();
+        ++state->failed;
+        ++state->done;
+        --state->inFlight;
+        state->cond.Broadcast();
+        state->cond.UnLock();
+      }
+    }
+
+    //--------------------------------------------------------------------------
+    // The handler lives on our stack, so wait until everything came back
+    //--------------------------------------------------------------------------
+    state->cond.Lock();
+    while( state->inFlight )
+      state->cond.Wait();
+    state->cond.UnLock();
+    return 0;
+  }
+
+  double Now()
+  {
+    timeval tv;
+    gettimeofday( &tv, 0 );
+    return tv.tv_sec + tv.tv_usec/1000000.0;
+  }
+}
+
+int main( int argc, char **argv )
+{
+  if( argc < 2 )
+  {
+    fprintf( stderr, "Usage: %s <url> [<requests> [<inflight> "
+                     "[<threads>]]]\n", argv[0] );
+    return 1;
+  }
+
+  XrdCl::URL url( argv[1] );
+  if( !url.IsValid() )
+  {
+    fprintf( stderr, "Invalid url: %s\n", argv[1] );
+    return 1;
+  }
+
+  uint64_t requests = argc > 2 ? strtoull( argv[2], 0, 10 ) : 200000;
+  uint32_t inFlight = argc > 3 ? strtoul( argv[3], 0, 10 )  : 4096;
+  uint32_t nThreads = argc > 4 ? strtoul( argv[4], 0, 10 )  : 4;
+  if( !requests || !inFlight || !nThreads )
+  {
+    fprintf( stderr, "Requests, in flight and threads must be positive\n" );
+    return 1;
+  }
+
+  //----------------------------------------------------------------------------
+  // Make sure the channel is up before we start the clock
+  //----------------------------------------------------------------------------
+  XrdCl::FileSystem fs( url );
+  XrdCl::XRootDStatus st = fs.Ping();
+  if( !st.IsOK() )
+  {
+    fprintf( stderr, "Unable to ping %s: %s\n", argv[1],
+             st.ToStr().c_str() );
+    return 2;
+  }
+
+  BenchState state;
+  state.fs          = &fs;
+  state.toIssue     = requests;
+  state.maxInFlight = inFlight;
+
+  pthread_t *tids = new pthread_t[nThreads];
+  double start = Now();
+  for( uint32_t i = 0; i < nThreads; ++i )
+    pthread_create( &tids[i], 0, IssueThread, &state );
+  for( uint32_t i = 0; i < nThreads; ++i )
+    pthread_join( tids[i], 0 );
+  double elapsed = Now() - start;
+  delete [] tids;
+
+  printf( "%llu requests, %u in flight, %u threads: %.3f s, %.0f req/s, "
+          "%llu failed\n", (unsigned long long)state.done, inFlight, nThreads,
+          elapsed, state.done/elapsed, (unsigned long long)state.failed );
+  return state.failed ? 3 : 0;
+}
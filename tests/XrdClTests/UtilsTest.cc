@@ -29,6 +29,9 @@
 #include "XrdCl/XrdClTaskManager.hh"
 #include "XrdCl/XrdClSIDManager.hh"
 #include "XrdCl/XrdClPropertyList.hh"
+#include "XrdCl/XrdClReadAhead.hh"
+#include "XrdCl/XrdClXRootDResponses.hh"
+#include "XrdSys/XrdSysPthread.hh"
 
 //------------------------------------------------------------------------------
 // Declaration
@@ -42,12 +45,14 @@ class UtilsTest: public CppUnit::TestCase
       CPPUNIT_TEST( TaskManagerTest );
       CPPUNIT_TEST( SIDManagerTest );
       CPPUNIT_TEST( PropertyListTest );
+      CPPUNIT_TEST( ReadAheadFailureTest );
     CPPUNIT_TEST_SUITE_END();
     void URLTest();
     void AnyTest();
     void TaskManagerTest();
     void SIDManagerTest();
     void PropertyListTest();
+    void ReadAheadFailureTest();
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION( UtilsTest );
@@ -459,3 +464,100 @@ void UtilsTest::PropertyListTest()
   for( size_t i = 0; i < v1.size(); ++i )
     CPPUNIT_ASSERT( v1[i] == v2[i] );
 }
+
+//------------------------------------------------------------------------------
+// Handler counting the read responses
+//------------------------------------------------------------------------------
+class ReadCountHandler: public XrdCl::ResponseHandler
+{
+  public:
+    ReadCountHandler( XrdSysCondVar &cond, int &ok, int &failed ):
+      pCond( cond ), pOk( ok ), pFailed( failed ) {}
+
+    virtual void HandleResponse( XrdCl::XRootDStatus *status,
+                                 XrdCl::AnyObject    *response )
+    {
+      XrdSysCondVarHelper scopedLock( pCond );
+      if( status->IsOK() )
+        ++pOk;
+      else
+        ++pFailed;
+      pCond.Signal();
+      delete status;
+      delete response;
+      delete this;
+    }
+
+  private:
+    XrdSysCondVar &pCond;
+    int           &pOk;
+    int           &pFailed;
+};
+
+//------------------------------------------------------------------------------
+// Read-ahead block failing with several reads waiting for it
+//------------------------------------------------------------------------------
+void UtilsTest::ReadAheadFailureTest()
+{
+  using namespace XrdCl;
+
+  const uint32_t blockSize = 4096;
+  ReadAhead      readAhead( blockSize, 16*blockSize, 0 );
+  XrdSysCondVar  cond( 0 );
+  int            ok = 0, failed = 0;
+  char           buffer[1024];
+
+  //----------------------------------------------------------------------------
+  // Read sequentially until the blocks ahead are requested
+  //----------------------------------------------------------------------------
+  ReadAhead::RequestList toSend;
+  for( uint64_t off = 0; off < 3*1024; off += 1024 )
+    CPPUNIT_ASSERT( !readAhead.Read( off, 1024, buffer, 0, toSend ) );
+
+  ReadAhead::Request *failing = 0;
+  for( size_t i = 0; i < toSend.size(); ++i )
+    if( toSend[i].offset == blockSize )
+      failing = &toSend[i];
+  CPPUNIT_ASSERT( failing );
+  ResponseHandler *failHandler = failing->handler;
+
+  //----------------------------------------------------------------------------
+  // Queue several reads on the block in flight, then fail it
+  //----------------------------------------------------------------------------
+  ReadAhead::RequestList more;
+  for( uint64_t off = 3*1024; off < 2*blockSize; off += 1024 )
+    CPPUNIT_ASSERT( readAhead.Read( off, 1024, buffer,
+                                    new ReadCountHandler( cond, ok, failed ),
+                                    more ) );
+  toSend.insert( toSend.end(), more.begin(), more.end() );
+
+  failHandler->HandleResponse( new XRootDStatus( stError, errErrorResponse ),
+                               0 );
+
+  //----------------------------------------------------------------------------
+  // Let the other blocks arrive
+  //----------------------------------------------------------------------------
+  for( size_t i = 0; i < toSend.size(); ++i )
+  {
+    if( toSend[i].handler == failHandler )
+      continue;
+    AnyObject *response = new AnyObject();
+    response->Set( new ChunkInfo( toSend[i].offset, toSend[i].size,
+                                  toSend[i].buffer ) );
+    toSend[i].handler->HandleResponse( new XRootDStatus(), response );
+  }
+
+  //----------------------------------------------------------------------------
+  // The read from block 0 succeeds, the ones from the failed block do not
+  //----------------------------------------------------------------------------
+  cond.Lock();
+  for( int i = 0; i < 10 && ok + failed < 5; ++i )
+    cond.Wait( 1 );
+  cond.UnLock();
+  CPPUNIT_ASSERT( ok == 1 );
+  CPPUNIT_ASSERT( failed == 4 );
+
+  readAhead.Drain();
+  ReadAhead::Stats stats = readAhead.GetStats();
+  CPPUNIT_ASSERT( stats.hits == 5 );
+}